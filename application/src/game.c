@@ -10,6 +10,11 @@ bool game_create(game* inst)
     inst->window_title  = "Game Application";
     inst->window_width  = 1024;
     inst->window_height = 768;
+    inst->frame_rate_limit = 60;
+    inst->update_rate = 60;
+    inst->max_update_steps = 5;
+    inst->frame_pipelining = true;
+    inst->window_event_thread = true;
 
     inst->initialize = game_initialize;
     inst->update     = game_update;
@@ -25,6 +30,20 @@ void game_destroy(game* inst)
 {
 }
 
+static void camera_state_set(camera* c, vec3 position, vec3 rotation)
+{
+    // NOTE: Неизменное состояние не записывается, чтобы не пересчитывать данные камеры и видимость.
+    if(!vec3_compare(camera_position_get(c), position, 0.0f))
+    {
+        camera_position_set(c, position);
+    }
+
+    if(!vec3_compare(camera_rotation_euler_get(c), rotation, 0.0f))
+    {
+        camera_rotation_euler_set(c, rotation);
+    }
+}
+
 bool game_initialize(game* inst)
 {
     game_state* state = inst->state;
@@ -33,6 +52,11 @@ bool game_initialize(game* inst)
     state->world_camera = camera_system_get_default();
     camera_position_set(state->world_camera, vec3_create(47.65f, 14.88f, -6.06f));
     camera_rotation_euler_set(state->world_camera, vec3_create(-0.16f, 1.55f, 0.0f));
+
+    state->camera_position_current = camera_position_get(state->world_camera);
+    state->camera_rotation_current = camera_rotation_euler_get(state->world_camera);
+    state->camera_position_previous = state->camera_position_current;
+    state->camera_rotation_previous = state->camera_rotation_current;
     return true;
 }
 
@@ -40,6 +64,11 @@ bool game_update(game* inst, f32 delta_time)
 {
     game_state* state = inst->state;
 
+    // NOTE: Шаг начинается с состояния предыдущего шага, а не с интерполированного для отрисовки.
+    camera_state_set(state->world_camera, state->camera_position_current, state->camera_rotation_current);
+    state->camera_position_previous = state->camera_position_current;
+    state->camera_rotation_previous = state->camera_rotation_current;
+
     if(input_keyboard_key_press_detect('M'))
     {
         static u64 alloc_count = 0;
@@ -119,6 +148,47 @@ bool game_update(game* inst, f32 delta_time)
         );
     }
 
+    if(input_keyboard_key_press_detect('F'))
+    {
+        frame_pacer_stats stats;
+        if(application_frame_stats_get(&stats))
+        {
+            kdebug(
+                "Frames: %llu, target %.3f ms, avg %.3f ms, jitter %.3f ms, max deviation %.3f ms, oversleep %.3f ms, missed %llu",
+                stats.frame_count, stats.target_ms, stats.average_frame_ms, stats.jitter_ms, stats.max_deviation_ms,
+                stats.oversleep_ms, stats.missed_deadlines
+            );
+        }
+    }
+
+    if(input_keyboard_key_press_detect('U'))
+    {
+        // Переключение ограничения частоты кадров.
+        application_frame_rate_limit_set(inst->frame_rate_limit ? 0 : 60);
+    }
+
+    if(input_keyboard_key_press_detect('G'))
+    {
+        renderer_gpu_timings_log();
+    }
+
+    if(input_keyboard_key_press_detect('B'))
+    {
+        renderer_geometry_buffer_stats_log();
+    }
+
+    if(input_keyboard_key_press_detect('L'))
+    {
+        // Статистика вызовов рисования и уровней детализации за последний кадр.
+        renderer_draw_stats_log();
+    }
+
+    if(input_keyboard_key_press_detect('O'))
+    {
+        // Сохранение трассировки профилировщика (только при сборке с KPROFILER_FLAG).
+        event_send(EVENT_CODE_PROFILER_DUMP, inst, null);
+    }
+
     if(input_keyboard_key_press_detect('1'))
     {
         event_context data = {};
@@ -140,11 +210,25 @@ bool game_update(game* inst, f32 delta_time)
         event_send(EVENT_CODE_SET_RENDER_MODE, inst, &data);
     }
 
+    state->camera_position_current = camera_position_get(state->world_camera);
+    state->camera_rotation_current = camera_rotation_euler_get(state->world_camera);
     return true;
 }
 
-bool game_render(game* inst, f32 delta_time)
+bool game_render(game* inst, f32 delta_time, f32 alpha)
 {
+    game_state* state = inst->state;
+
+    // Отрисовывается состояние между двумя последними шагами обновления.
+    vec3 position = vec3_add(
+        state->camera_position_previous,
+        vec3_mul_scalar(vec3_sub(state->camera_position_current, state->camera_position_previous), alpha)
+    );
+    vec3 rotation = vec3_add(
+        state->camera_rotation_previous,
+        vec3_mul_scalar(vec3_sub(state->camera_rotation_current, state->camera_rotation_previous), alpha)
+    );
+    camera_state_set(state->world_camera, position, rotation);
     return true;
 }
 
@@ -9,12 +9,18 @@
 typedef struct game_state {
     f32 delta_time;
     camera* world_camera;
+
+    // Состояние камеры на предыдущем и текущем шагах обновления (для интерполяции при отрисовке).
+    vec3 camera_position_previous;
+    vec3 camera_position_current;
+    vec3 camera_rotation_previous;
+    vec3 camera_rotation_current;
 } game_state;
 
 bool game_initialize(game* inst);
 
 bool game_update(game* inst, f32 delta_time);
 
-bool game_render(game* inst, f32 delta_time);
+bool game_render(game* inst, f32 delta_time, f32 alpha);
 
 void game_on_resize(game* inst, i32 width, i32 height);
@@ -1,11 +1,10 @@
 #version 450
 
-// Должно соответствовать vertex_3d.
-layout(location = 0) in vec3 in_position; // Локальные координаты вершин.
-layout(location = 1) in vec3 in_normal;   // Локальные нормали вершин.
-layout(location = 2) in vec2 in_texcoord; // Текстурный координаты.
+// Должно соответствовать vertex_3d_packed.
+layout(location = 0) in vec4 in_position;       // Локальные координаты вершин в диапазоне геометрии [0, 1], w - направление битангенса.
+layout(location = 1) in vec4 in_normal_tangent; // Октаэдрические нормаль (xy) и касательная (zw).
+layout(location = 2) in vec2 in_texcoord;       // Текстурный координаты.
 layout(location = 3) in vec4 in_color;
-layout(location = 4) in vec4 in_tangent;
 
 // Порядок должен соответствовать глобальным uniform-переменным в shadercfg.
 layout(set = 0, binding = 0) uniform global_uniform_object {
@@ -19,6 +18,8 @@ layout(set = 0, binding = 0) uniform global_uniform_object {
 layout(push_constant) uniform push_constants {
     // Гарантируется всего 128 байт.
     mat4 model;         // Мировая матрица (масштаб, вращение и положение объекта в мире).
+    vec4 position_offset; // Минимальная точка диапазона квантования геометрии (xyz).
+    vec4 position_scale;  // Размер диапазона квантования геометрии (xyz).
 } u_push_constants;
 
 layout(location = 0) out int out_mode;
@@ -34,20 +35,35 @@ layout(location = 1) out struct dto {
     vec4 tangent;
 } out_dto;
 
+// Октаэдрическое декодирование единичного вектора (должно соответствовать geometry_utils.c).
+vec3 octahedral_decode(vec2 e)
+{
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0);
+    v.x += v.x >= 0.0 ? -t : t;
+    v.y += v.y >= 0.0 ? -t : t;
+    return normalize(v);
+}
+
 // В вершинном щейдере main применяется к каждой вершине.
 // NOTE: vec4, где дополнительное значение w == 1 - для точки, w == 0 - для вектора.
 void main()
 {
+    // Распаковка вершины.
+    vec3 position = u_push_constants.position_offset.xyz + in_position.xyz * u_push_constants.position_scale.xyz;
+    vec3 normal = octahedral_decode(in_normal_tangent.xy);
+    vec4 tangent = vec4(octahedral_decode(in_normal_tangent.zw), in_position.w * 2.0 - 1.0);
+
     out_dto.tex_coord = in_texcoord;
     out_dto.color = in_color;
-    out_dto.frag_position = vec3(u_push_constants.model * vec4(in_position, 1.0)); // Позиция в мировом пространстве.
+    out_dto.frag_position = vec3(u_push_constants.model * vec4(position, 1.0)); // Позиция в мировом пространстве.
 
     mat3 m3_model = mat3(u_push_constants.model);
-    out_dto.normal = normalize(m3_model * in_normal);
-    out_dto.tangent = vec4(normalize(m3_model * in_tangent.xyz), in_tangent.w);
+    out_dto.normal = normalize(m3_model * normal);
+    out_dto.tangent = vec4(normalize(m3_model * tangent.xyz), tangent.w);
     out_dto.ambient = global_ubo.ambient_color;
     out_dto.view_position = global_ubo.view_position;
-    gl_Position = global_ubo.projection * global_ubo.view * u_push_constants.model * vec4(in_position, 1.0);
+    gl_Position = global_ubo.projection * global_ubo.view * u_push_constants.model * vec4(position, 1.0);
 
     out_mode = global_ubo.mode;
 }
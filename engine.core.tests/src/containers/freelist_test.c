@@ -477,6 +477,53 @@ u8 freelist_test6()
     return true;
 }
 
+u8 freelist_test7()
+{
+    u64 total_size = 512;
+
+    freelist* list = null;  
+    u64 freelist_requirement = 0;
+
+    list = freelist_create(total_size, &freelist_requirement, null);
+    void* memory = kallocate(freelist_requirement, MEMORY_TAG_ARRAY);
+    list = freelist_create(total_size, &freelist_requirement, memory);
+    // Начало зоны тестов!
+
+    u64 largest = freelist_largest_free_block(list);
+    expect_should_be(total_size, largest);
+
+    // Четыре блока по 128 байт, затем освобождение первого и третьего: две дыры по 128 байт.
+    u64 offsets[4];
+    for(u32 i = 0; i < 4; ++i)
+    {
+        bool result = freelist_allocate_block(list, 128, &offsets[i]);
+        expect_to_be_true(result);
+    }
+
+    largest = freelist_largest_free_block(list);
+    expect_should_be(0, largest);
+
+    expect_to_be_true(freelist_free_block(list, 128, offsets[0]));
+    expect_to_be_true(freelist_free_block(list, 128, offsets[2]));
+
+    largest = freelist_largest_free_block(list);
+    expect_should_be(128, largest);
+
+    u64 free_space = freelist_free_space(list);
+    expect_should_be(256, free_space);
+
+    // Освобождение соседнего блока объединяет дыры.
+    expect_to_be_true(freelist_free_block(list, 128, offsets[1]));
+
+    largest = freelist_largest_free_block(list);
+    expect_should_be(384, largest);
+
+    // Конец зоны тестов!
+    freelist_destroy(list);
+    kfree(memory, freelist_requirement, MEMORY_TAG_ARRAY);
+    return true;
+}
+
 void freelist_register_tests()
 {
     // NOTE: Для проведения этих тестов рекомендуется в freelist.h NODE_START установть в 1.
@@ -487,4 +534,5 @@ void freelist_register_tests()
     test_managet_register_test(freelist_test4, "Freelist allocate and free multiple entries of varying sizes.");
     test_managet_register_test(freelist_test5, "Freelist allocate to full and fail when trying to allocate more.");
     test_managet_register_test(freelist_test6, "Freelist should randomly allocate and free.");
+    test_managet_register_test(freelist_test7, "Freelist should report the largest free block.");
 }
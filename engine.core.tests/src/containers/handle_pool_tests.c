@@ -0,0 +1,94 @@
+#include "containers/handle_pool_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <containers/handle_pool.h>
+#include <memory/memory.h>
+
+u8 handle_pool_test1()
+{
+    handle_pool* pool = null;
+    u64 pool_requirement = 0;
+
+    pool = handle_pool_create(16, &pool_requirement, null);
+    expect_pointer_should_be(null, pool);
+
+    void* memory = kallocate(pool_requirement, MEMORY_TAG_ARRAY);
+    pool = handle_pool_create(16, &pool_requirement, memory);
+    expect_pointer_should_not_be(null, pool);
+    expect_should_be(memory, pool);
+    expect_should_be(16, handle_pool_capacity(pool));
+    expect_should_be(0, handle_pool_count(pool));
+
+    handle_pool_destroy(pool);
+    kfree(memory, pool_requirement, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+u8 handle_pool_test2()
+{
+    const u32 capacity = 8;
+    u64 pool_requirement = 0;
+    handle_pool_create(capacity, &pool_requirement, null);
+    void* memory = kallocate(pool_requirement, MEMORY_TAG_ARRAY);
+    handle_pool* pool = handle_pool_create(capacity, &pool_requirement, memory);
+    // Начало зоны тестов!
+
+    // Слоты выдаются по порядку индексов.
+    khandle handles[8];
+    for(u32 i = 0; i < capacity; ++i)
+    {
+        expect_to_be_true(handle_pool_acquire(pool, &handles[i]));
+        expect_should_be(i, handles[i].index);
+        expect_to_be_true(handle_pool_valid(pool, handles[i]));
+    }
+    expect_should_be(capacity, handle_pool_count(pool));
+
+    // Пул заполнен.
+    khandle extra;
+    expect_to_be_false(handle_pool_acquire(pool, &extra));
+    expect_should_be(INVALID_ID, extra.index);
+
+    // Освобожденный слот используется повторно первым, старый дескриптор устаревает.
+    expect_to_be_true(handle_pool_release(pool, handles[3]));
+    expect_to_be_false(handle_pool_valid(pool, handles[3]));
+    expect_should_be(capacity - 1, handle_pool_count(pool));
+
+    khandle reused;
+    expect_to_be_true(handle_pool_acquire(pool, &reused));
+    expect_should_be(3, reused.index);
+    expect_should_not_be(handles[3].generation, reused.generation);
+    expect_to_be_true(handle_pool_valid(pool, reused));
+    expect_to_be_false(handle_pool_valid(pool, handles[3]));
+
+    // Повторное освобождение устаревшего дескриптора не затрагивает новый.
+    expect_to_be_false(handle_pool_release(pool, handles[3]));
+    expect_to_be_true(handle_pool_valid(pool, reused));
+
+    // Получение дескриптора по индексу.
+    khandle by_index;
+    expect_to_be_true(handle_pool_handle_get(pool, 3, &by_index));
+    expect_should_be(reused.generation, by_index.generation);
+    expect_to_be_false(handle_pool_handle_get(pool, capacity, &by_index));
+    expect_to_be_false(handle_pool_valid(pool, KHANDLE_INVALID));
+
+    // Освобождение всех слотов.
+    handles[3] = reused;
+    for(u32 i = 0; i < capacity; ++i)
+    {
+        expect_to_be_true(handle_pool_release(pool, handles[i]));
+    }
+    expect_should_be(0, handle_pool_count(pool));
+    expect_to_be_false(handle_pool_handle_get(pool, 0, &by_index));
+
+    // Конец зоны тестов!
+    handle_pool_destroy(pool);
+    kfree(memory, pool_requirement, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+void handle_pool_register_tests()
+{
+    test_managet_register_test(handle_pool_test1, "Handle pool should create and destroy successfully.");
+    test_managet_register_test(handle_pool_test2, "Handle pool should acquire, reuse slots and detect stale handles.");
+}
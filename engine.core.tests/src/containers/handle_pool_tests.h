@@ -0,0 +1,3 @@
+#pragma once
+
+void handle_pool_register_tests();
@@ -0,0 +1,247 @@
+#include "containers/radix_sort_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <containers/radix_sort.h>
+#include <math/math_types.h>
+#include <memory/memory.h>
+#include <clock.h>
+#include <logger.h>
+
+#define SORT_COUNT       4096
+#define BENCHMARK_COUNT  16384
+#define BENCHMARK_FRAMES 50
+
+u8 radix_sort_test1()
+{
+    f32* values = kallocate_tc(f32, SORT_COUNT, MEMORY_TAG_ARRAY);
+    u32* keys = kallocate_tc(u32, SORT_COUNT, MEMORY_TAG_ARRAY);
+    u32* indices = kallocate_tc(u32, SORT_COUNT, MEMORY_TAG_ARRAY);
+    u32* scratch = kallocate_tc(u32, SORT_COUNT * 2, MEMORY_TAG_ARRAY);
+
+    // Отрицательные, нулевые, повторяющиеся и большие значения.
+    u32 seed = 7;
+    for(u32 i = 0; i < SORT_COUNT; ++i)
+    {
+        switch(i % 5)
+        {
+            case 0: values[i] = random_unit(&seed) * 1000.0f; break;
+            case 1: values[i] = random_unit(&seed) * 0.001f; break;
+            case 2: values[i] = (f32)((seed >> 8) % 16) - 8.0f; random_unit(&seed); break;
+            case 3: values[i] = 0.0f; break;
+            default: values[i] = random_unit(&seed) * 1e30f; break;
+        }
+    }
+
+    // По возрастанию: порядок не убывает, равные ключи сохраняют исходный порядок.
+    for(u32 i = 0; i < SORT_COUNT; ++i)
+    {
+        keys[i] = radix_sort_key_f32(values[i]);
+        indices[i] = i;
+    }
+    radix_sort(SORT_COUNT, keys, indices, scratch);
+
+    for(u32 i = 0; i < SORT_COUNT; ++i)
+    {
+        expect_should_be(radix_sort_key_f32(values[indices[i]]), keys[i]);
+        if(i == 0) continue;
+        expect_to_be_true(values[indices[i - 1]] <= values[indices[i]]);
+        if(values[indices[i - 1]] == values[indices[i]])
+        {
+            expect_to_be_true(indices[i - 1] < indices[i]);
+        }
+    }
+
+    // По убыванию через инвертированный ключ.
+    for(u32 i = 0; i < SORT_COUNT; ++i)
+    {
+        keys[i] = ~radix_sort_key_f32(values[i]);
+        indices[i] = i;
+    }
+    radix_sort(SORT_COUNT, keys, indices, scratch);
+
+    for(u32 i = 1; i < SORT_COUNT; ++i)
+    {
+        expect_to_be_true(values[indices[i - 1]] >= values[indices[i]]);
+        if(values[indices[i - 1]] == values[indices[i]])
+        {
+            expect_to_be_true(indices[i - 1] < indices[i]);
+        }
+    }
+
+    // Все индексы сохранились.
+    kzero_tc(scratch, u32, SORT_COUNT);
+    for(u32 i = 0; i < SORT_COUNT; ++i)
+    {
+        scratch[indices[i]]++;
+    }
+    for(u32 i = 0; i < SORT_COUNT; ++i)
+    {
+        expect_should_be(1, scratch[i]);
+    }
+
+    // Пустой массив и один элемент.
+    radix_sort(0, keys, indices, scratch);
+    keys[0] = 5;
+    indices[0] = 9;
+    radix_sort(1, keys, indices, scratch);
+    expect_should_be(5, keys[0]);
+    expect_should_be(9, indices[0]);
+
+    // Нечетное количество выполненных проходов (различается только младший байт).
+    keys[0] = 0x10000003; keys[1] = 0x10000001; keys[2] = 0x10000002;
+    indices[0] = 0; indices[1] = 1; indices[2] = 2;
+    radix_sort(3, keys, indices, scratch);
+    expect_should_be(0x10000001, keys[0]);
+    expect_should_be(1, indices[0]);
+    expect_should_be(2, indices[1]);
+    expect_should_be(0, indices[2]);
+
+    kfree_tc(values, f32, SORT_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(keys, u32, SORT_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(indices, u32, SORT_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(scratch, u32, SORT_COUNT * 2, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+#if KBENCHMARK_FLAG
+
+// Копия прежней сортировки геометрий с прозрачностью для сравнения.
+typedef struct legacy_item {
+    mat4 model;
+    void* geometry;
+    u32 lod;
+    f32 distance;
+} legacy_item;
+
+static void legacy_swap(legacy_item* a, legacy_item* b)
+{
+    legacy_item t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static i32 legacy_partition(legacy_item* arr, i32 low_index, i32 high_index)
+{
+    legacy_item pivot = arr[high_index];
+    i32 i = (low_index - 1);
+
+    for(i32 j = low_index; j <= high_index - 1; ++j)
+    {
+        if(arr[j].distance > pivot.distance)
+        {
+            ++i;
+            legacy_swap(&arr[i], &arr[j]);
+        }
+    }
+
+    legacy_swap(&arr[i + 1], &arr[high_index]);
+    return i + 1;
+}
+
+static void legacy_quick_sort(legacy_item* arr, i32 low_index, i32 high_index)
+{
+    if(low_index < high_index)
+    {
+        i32 partition_index = legacy_partition(arr, low_index, high_index);
+        legacy_quick_sort(arr, low_index, partition_index - 1);
+        legacy_quick_sort(arr, partition_index + 1, high_index);
+    }
+}
+
+u8 radix_sort_test2()
+{
+    legacy_item* source = kallocate_tc(legacy_item, BENCHMARK_COUNT, MEMORY_TAG_ARRAY);
+    legacy_item* legacy = kallocate_tc(legacy_item, BENCHMARK_COUNT, MEMORY_TAG_ARRAY);
+    u32* keys = kallocate_tc(u32, BENCHMARK_COUNT, MEMORY_TAG_ARRAY);
+    u32* indices = kallocate_tc(u32, BENCHMARK_COUNT, MEMORY_TAG_ARRAY);
+    u32* scratch = kallocate_tc(u32, BENCHMARK_COUNT * 2, MEMORY_TAG_ARRAY);
+
+    u32 seed = 31;
+    kzero_tc(source, legacy_item, BENCHMARK_COUNT);
+    for(u32 i = 0; i < BENCHMARK_COUNT; ++i)
+    {
+        f32 x = random_unit(&seed) * 500.0f;
+        f32 z = random_unit(&seed) * 500.0f;
+        source[i].distance = x * x + z * z;
+    }
+
+    clock timer;
+    f64 legacy_ms = 0;
+    f64 radix_ms = 0;
+
+    // Каждый кадр сортируется весь список геометрий с прозрачностью (от дальних к ближним).
+    for(u32 frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+    {
+        kcopy_tc(legacy, source, legacy_item, BENCHMARK_COUNT);
+        clock_start(&timer);
+        legacy_quick_sort(legacy, 0, BENCHMARK_COUNT - 1);
+        clock_update(&timer);
+        legacy_ms += timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+        clock_start(&timer);
+        for(u32 i = 0; i < BENCHMARK_COUNT; ++i)
+        {
+            keys[i] = ~radix_sort_key_f32(source[i].distance);
+            indices[i] = i;
+        }
+        radix_sort(BENCHMARK_COUNT, keys, indices, scratch);
+        clock_update(&timer);
+        radix_ms += timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+    }
+
+    kinfor(
+        "Transparent sort (%u items, %u frames): quick sort %8.3f ms, radix sort %8.3f ms (x%.2f)",
+        BENCHMARK_COUNT, BENCHMARK_FRAMES, legacy_ms, radix_ms, legacy_ms / radix_ms
+    );
+
+    // Порядок совпадает с прежней сортировкой.
+    for(u32 i = 0; i < BENCHMARK_COUNT; ++i)
+    {
+        expect_float_to_be(legacy[i].distance, source[indices[i]].distance);
+    }
+
+    // Худший случай быстрой сортировки: список уже упорядочен.
+    clock_start(&timer);
+    legacy_quick_sort(legacy, 0, BENCHMARK_COUNT - 1);
+    clock_update(&timer);
+    legacy_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    clock_start(&timer);
+    for(u32 i = 0; i < BENCHMARK_COUNT; ++i)
+    {
+        keys[i] = ~radix_sort_key_f32(legacy[i].distance);
+        indices[i] = i;
+    }
+    radix_sort(BENCHMARK_COUNT, keys, indices, scratch);
+    clock_update(&timer);
+    radix_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    kinfor(
+        "Transparent sort presorted (%u items): quick sort %8.3f ms, radix sort %8.3f ms (x%.2f)",
+        BENCHMARK_COUNT, legacy_ms, radix_ms, legacy_ms / radix_ms
+    );
+
+    for(u32 i = 0; i < BENCHMARK_COUNT; ++i)
+    {
+        expect_should_be(i, indices[i]);
+    }
+
+    kfree_tc(source, legacy_item, BENCHMARK_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(legacy, legacy_item, BENCHMARK_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(keys, u32, BENCHMARK_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(indices, u32, BENCHMARK_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(scratch, u32, BENCHMARK_COUNT * 2, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+#endif
+
+void radix_sort_register_tests()
+{
+    test_managet_register_test(radix_sort_test1, "Radix sort should order float keys stably in both directions.");
+#if KBENCHMARK_FLAG
+    test_managet_register_test(radix_sort_test2, "Transparent geometry sort micro-benchmark.");
+#endif
+}
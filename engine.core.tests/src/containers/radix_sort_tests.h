@@ -0,0 +1,3 @@
+#pragma once
+
+void radix_sort_register_tests();
@@ -0,0 +1,201 @@
+#include "debug/profiler_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <debug/profiler.h>
+#include <event.h>
+#include <platform/file.h>
+#include <platform/thread.h>
+#include <memory/memory.h>
+#include <kstring.h>
+#include <logger.h>
+
+#define TRACE_PATH     "profiler_test_trace.json"
+#define TRACE_MAX_SIZE KIBIBYTES(64)
+
+static void* event_memory = null;
+static u64 event_memory_requirement = 0;
+static void* profiler_memory = null;
+static u64 profiler_memory_requirement = 0;
+
+static bool systems_start(u32 max_thread_count, u32 max_zone_count_per_thread)
+{
+    event_system_initialize(&event_memory_requirement, null);
+    event_memory = kallocate(event_memory_requirement, MEMORY_TAG_ARRAY);
+    event_system_initialize(&event_memory_requirement, event_memory);
+
+    profiler_system_config config = { max_thread_count, max_zone_count_per_thread };
+    profiler_system_initialize(&profiler_memory_requirement, null, &config);
+    profiler_memory = kallocate(profiler_memory_requirement, MEMORY_TAG_ARRAY);
+    return profiler_system_initialize(&profiler_memory_requirement, profiler_memory, &config);
+}
+
+static void systems_stop()
+{
+    profiler_system_shutdown();
+    event_system_shutdown();
+    kfree(profiler_memory, profiler_memory_requirement, MEMORY_TAG_ARRAY);
+    kfree(event_memory, event_memory_requirement, MEMORY_TAG_ARRAY);
+    profiler_memory = null;
+    event_memory = null;
+}
+
+static void zone_record(const char* name)
+{
+    profiler_zone zone = profiler_zone_begin(name);
+    profiler_zone_end(&zone);
+}
+
+// Сохраняет трассировку и читает ее в буфер как строку.
+static bool trace_read(char* buffer, u64* out_size)
+{
+    if(!profiler_dump(TRACE_PATH)) return false;
+
+    file* f = null;
+    if(!platform_file_open(TRACE_PATH, FILE_MODE_READ | FILE_MODE_BINARY, &f)) return false;
+
+    u64 size = platform_file_size(f);
+    bool result = size < TRACE_MAX_SIZE && platform_file_read_all_bytes(f, buffer, out_size);
+    platform_file_close(f);
+
+    if(result) buffer[*out_size] = '\0';
+    return result;
+}
+
+// Количество вхождений подстроки.
+static u32 substring_count(const char* str, const char* sub)
+{
+    u32 count = 0;
+    u64 sub_length = string_length(sub);
+    for(const char* c = str; *c; ++c)
+    {
+        if(string_nequal(c, sub, sub_length)) count++;
+    }
+    return count;
+}
+
+u8 profiler_test1()
+{
+    expect_to_be_true(systems_start(2, 4));
+    // Начало зоны тестов!
+
+    // Кольцевой буфер на 4 зоны: сохраняются только последние.
+    const char* names[10] = {
+        "zone_0", "zone_1", "zone_2", "zone_3", "zone_4", "zone_5", "zone_6", "zone_7", "zone_8", "zone_9"
+    };
+    for(u32 i = 0; i < 10; ++i)
+    {
+        zone_record(names[i]);
+    }
+
+    char* trace = kallocate(TRACE_MAX_SIZE, MEMORY_TAG_STRING);
+    u64 size = 0;
+    expect_to_be_true(trace_read(trace, &size));
+
+    // Формат Chrome trace: заголовок, метаданные потока, зоны с полной длительностью и завершение.
+    const char* header = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    const char* footer = "\n]}\n";
+    expect_to_be_true(string_nequal(trace, header, string_length(header)));
+    expect_to_be_true(size >= string_length(footer) && string_equal(trace + size - string_length(footer), footer));
+    expect_should_be(1, substring_count(trace, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Main 0\"}}"));
+    expect_should_be(4, substring_count(trace, "\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":"));
+
+    char name[32];
+    for(u32 i = 0; i < 10; ++i)
+    {
+        string_format(name, "{\"name\":\"%s\",\"ph\":\"X\"", names[i]);
+        expect_should_be(i >= 6 ? 1 : 0, substring_count(trace, name));
+    }
+
+    kfree(trace, TRACE_MAX_SIZE, MEMORY_TAG_STRING);
+
+    // Конец зоны тестов!
+    systems_stop();
+    return true;
+}
+
+typedef struct worker_context {
+    const char* name;
+    // Поток удерживает буфер до сигнала release (если семафоры заданы).
+    platform_semaphore* recorded;
+    platform_semaphore* release;
+} worker_context;
+
+static void worker_run(void* params)
+{
+    worker_context* context = params;
+    zone_record(context->name);
+
+    if(context->recorded)
+    {
+        platform_semaphore_signal(context->recorded);
+        platform_semaphore_wait(context->release);
+    }
+}
+
+static void worker_start_and_join(worker_context* context)
+{
+    platform_thread thread;
+    if(platform_thread_create(worker_run, context, &thread))
+    {
+        platform_thread_join(&thread);
+    }
+}
+
+u8 profiler_test2()
+{
+    expect_to_be_true(systems_start(2, 16));
+    // Начало зоны тестов!
+
+    zone_record("main_zone");
+
+    // Завершившиеся потоки освобождают буфер: последовательные потоки используют один и тот же.
+    worker_context sequential = { "worker_zone", null, null };
+    for(u32 i = 0; i < 5; ++i)
+    {
+        worker_start_and_join(&sequential);
+    }
+
+    // Пока буфер занят, зоны других потоков отбрасываются (с однократным предупреждением).
+    platform_semaphore recorded;
+    platform_semaphore release;
+    expect_to_be_true(platform_semaphore_create(0, &recorded));
+    expect_to_be_true(platform_semaphore_create(0, &release));
+
+    worker_context holder = { "holder_zone", &recorded, &release };
+    platform_thread holder_thread;
+    expect_to_be_true(platform_thread_create(worker_run, &holder, &holder_thread));
+    platform_semaphore_wait(&recorded);
+
+    kdebug("Note: The following warning is intentionally caused by this test.");
+    worker_context dropped = { "dropped_zone", null, null };
+    worker_start_and_join(&dropped);
+    worker_start_and_join(&dropped);
+
+    platform_semaphore_signal(&release);
+    platform_thread_join(&holder_thread);
+    platform_semaphore_destroy(&recorded);
+    platform_semaphore_destroy(&release);
+
+    char* trace = kallocate(TRACE_MAX_SIZE, MEMORY_TAG_STRING);
+    u64 size = 0;
+    expect_to_be_true(trace_read(trace, &size));
+
+    expect_should_be(2, substring_count(trace, "\"ph\":\"M\""));
+    expect_should_be(1, substring_count(trace, "{\"name\":\"main_zone\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"));
+    expect_should_be(5, substring_count(trace, "{\"name\":\"worker_zone\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"));
+    expect_should_be(1, substring_count(trace, "{\"name\":\"holder_zone\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"));
+    expect_should_be(0, substring_count(trace, "dropped_zone"));
+
+    kfree(trace, TRACE_MAX_SIZE, MEMORY_TAG_STRING);
+
+    // Конец зоны тестов!
+    systems_stop();
+    return true;
+}
+
+void profiler_register_tests()
+{
+    test_managet_register_test(profiler_test1, "Profiler should keep the newest zones after ring wraparound and dump Chrome trace JSON.");
+    test_managet_register_test(profiler_test2, "Profiler should reuse buffers of finished threads and drop zones over the thread limit.");
+}
@@ -10,7 +10,22 @@
 #include "memory/dynamic_allocator_tests.h"
 #include "containers/hashtable_tests.h"
 #include "containers/freelist_test.h"
+#include "containers/handle_pool_tests.h"
+#include "containers/radix_sort_tests.h"
+#include "debug/profiler_tests.h"
+#include "renderer/camera_tests.h"
+#include "fixed_timestep_tests.h"
+#include "frame_pacer_tests.h"
+#include "frame_pipeline_tests.h"
 #include "string/kstring_tests.h"
+#include "resources/obj_parser_tests.h"
+#include "math/geometry_optimizer_tests.h"
+#include "math/geometry_utils_tests.h"
+#include "math/kmath_tests.h"
+#include "math/bvh_tests.h"
+#include "systems/transform_system_tests.h"
+#include "systems/scene_system_tests.h"
+#include "systems/camera_system_tests.h"
 
 int main()
 {
@@ -27,8 +42,23 @@ int main()
     linear_allocator_register_tests();
     hashtable_register_tests();
     string_register_tests();
+    obj_parser_register_tests();
     freelist_register_tests();
+    handle_pool_register_tests();
+    radix_sort_register_tests();
+    profiler_register_tests();
     dynamic_allocator_register_tests();
+    geometry_optimizer_register_tests();
+    geometry_utils_register_tests();
+    kmath_register_tests();
+    bvh_register_tests();
+    transform_system_register_tests();
+    scene_system_register_tests();
+    camera_register_tests();
+    camera_system_register_tests();
+    fixed_timestep_register_tests();
+    frame_pacer_register_tests();
+    frame_pipeline_register_tests();
 
     // INFO: Конец регистрации тестов.
 
@@ -82,7 +82,7 @@ if(kabs(expected - actual) > K_FLOAT_EPSILON)
     @param actual Фактическое значение.
 */
 #define expect_to_be_true(actual)                                                    \
-if(actual != true)                                                                   \
+if((actual) != true)                                                                 \
 {                                                                                    \
     kerror("--> Expected true, but got: false. In %s:%d.", __FILE_NAME__, __LINE__); \
     return false;                                                                    \
@@ -93,7 +93,7 @@ if(actual != true)
     @param actual Фактическое значение.
 */
 #define expect_to_be_false(actual)                                                   \
-if(actual != false)                                                                  \
+if((actual) != false)                                                                \
 {                                                                                    \
     kerror("--> Expected false, but got: true. In %s:%d.", __FILE_NAME__, __LINE__); \
     return false;                                                                    \
@@ -0,0 +1,115 @@
+#include "fixed_timestep_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <fixed_timestep.h>
+#include <math/kmath.h>
+
+// Простая симуляция: скорость, изменяющаяся от положения, интегрируется явным методом Эйлера.
+typedef struct simulation {
+    f64 position;
+    f64 velocity;
+    u64 steps;
+} simulation;
+
+static void simulation_step(simulation* sim, f64 step)
+{
+    sim->velocity += -sim->position * step;
+    sim->position += sim->velocity * step;
+    sim->steps++;
+}
+
+// Выполняет симуляцию длительностью duration секунд кадрами переменной длительности.
+static simulation simulation_run(f64 duration, f64 min_frame, f64 max_frame, u32 seed)
+{
+    fixed_timestep ts;
+    fixed_timestep_create(&ts, 120, 8);
+
+    simulation sim = { 1.0, 0.0, 0 };
+    f64 time = 0.0;
+    while(time < duration)
+    {
+        f64 frame = min_frame + (max_frame - min_frame) * random_fraction(&seed);
+        frame = KMIN(frame, duration - time);
+        time += frame;
+
+        f64 step = 0;
+        u32 steps = fixed_timestep_advance(&ts, frame, &step);
+        for(u32 i = 0; i < steps; ++i)
+        {
+            simulation_step(&sim, step);
+        }
+    }
+    return sim;
+}
+
+u8 fixed_timestep_test1()
+{
+    fixed_timestep ts;
+    fixed_timestep_create(&ts, 60, 5);
+    f64 step = 0;
+
+    // Кадр короче шага: обновлений нет, время накапливается.
+    expect_should_be(0, fixed_timestep_advance(&ts, 0.010, &step));
+    expect_float_to_be(1.0f / 60.0f, (f32)step);
+    f32 alpha = fixed_timestep_alpha(&ts);
+    expect_to_be_true(alpha > 0.59f && alpha < 0.61f);
+
+    // Накопленное время дает шаг.
+    expect_should_be(1, fixed_timestep_advance(&ts, 0.010, &step));
+    alpha = fixed_timestep_alpha(&ts);
+    expect_to_be_true(alpha > 0.19f && alpha < 0.21f);
+
+    // Задержка: шаги ограничены, лишнее время отбрасывается, остаток для интерполяции сохраняется.
+    expect_should_be(5, fixed_timestep_advance(&ts, 1.0, &step));
+    expect_to_be_true(ts.dropped_time > 0.9 && ts.dropped_time < 1.0);
+    alpha = fixed_timestep_alpha(&ts);
+    expect_to_be_true(alpha >= 0.0f && alpha < 1.0f);
+    expect_should_be(6, ts.step_count);
+
+    // Отрицательное время кадра игнорируется.
+    expect_should_be(0, fixed_timestep_advance(&ts, -1.0, &step));
+
+    // Без фиксированного шага: одно обновление за кадр длительностью кадра.
+    fixed_timestep_create(&ts, 0, 0);
+    expect_should_be(1, fixed_timestep_advance(&ts, 0.025, &step));
+    expect_float_to_be(0.025f, (f32)step);
+    expect_float_to_be(1.0f, fixed_timestep_alpha(&ts));
+
+    return true;
+}
+
+u8 fixed_timestep_test2()
+{
+    // Одна и та же симуляция при 30, 144 и неравномерной частоте кадров.
+    simulation slow = simulation_run(4.0, 1.0 / 30.0, 1.0 / 30.0, 1);
+    simulation fast = simulation_run(4.0, 1.0 / 144.0, 1.0 / 144.0, 2);
+    simulation jitter = simulation_run(4.0, 0.001, 0.050, 3);
+
+    // Количество шагов определяется длительностью, а не частотой кадров (с точностью до последнего шага).
+    expect_to_be_true(slow.steps >= 479 && slow.steps <= 480);
+    expect_to_be_true(fast.steps >= 479 && fast.steps <= 480);
+    expect_to_be_true(jitter.steps >= 479 && jitter.steps <= 480);
+
+    // При равном количестве шагов результат совпадает побитово.
+    simulation reference = { 1.0, 0.0, 0 };
+    for(u32 i = 0; i < 480; ++i)
+    {
+        if(reference.steps == slow.steps) expect_to_be_true(reference.position == slow.position);
+        if(reference.steps == fast.steps) expect_to_be_true(reference.position == fast.position);
+        if(reference.steps == jitter.steps) expect_to_be_true(reference.position == jitter.position);
+        simulation_step(&reference, 1.0 / 120.0);
+    }
+    if(reference.steps == slow.steps) expect_to_be_true(reference.position == slow.position);
+    if(reference.steps == fast.steps) expect_to_be_true(reference.position == fast.position);
+    if(reference.steps == jitter.steps) expect_to_be_true(reference.position == jitter.position);
+
+    return true;
+}
+
+void fixed_timestep_register_tests()
+{
+    test_managet_register_test(fixed_timestep_test1, "Fixed timestep should accumulate time, limit catch-up steps and report alpha.");
+    test_managet_register_test(fixed_timestep_test2, "Fixed timestep simulation should not depend on frame rate.");
+}
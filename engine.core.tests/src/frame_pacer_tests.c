@@ -0,0 +1,187 @@
+#include "frame_pacer_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <frame_pacer.h>
+#include <math/kmath.h>
+
+#define MS_TO_NS 1000000ULL
+
+// Управляемые часы: время идет только при вызовах и засыпаниях.
+typedef struct test_clock {
+    u64 now_ns;
+    // Продвижение времени при каждом опросе (активное ожидание должно завершаться).
+    u64 tick_ns;
+    // Пересыпание при каждом засыпании.
+    u64 oversleep_ns;
+    u32 sleep_count;
+} test_clock;
+
+static u64 test_clock_now_ns(void* user_data)
+{
+    test_clock* c = user_data;
+    c->now_ns += c->tick_ns;
+    return c->now_ns;
+}
+
+static void test_clock_sleep_until_ns(u64 deadline_ns, void* user_data)
+{
+    test_clock* c = user_data;
+    c->now_ns = KMAX(c->now_ns, deadline_ns + c->oversleep_ns);
+    c->sleep_count++;
+}
+
+static void pacer_create(frame_pacer* pacer, test_clock* c, u32 target_fps)
+{
+    frame_pacer_create(pacer, target_fps);
+    frame_pacer_clock c_source = { test_clock_now_ns, test_clock_sleep_until_ns, c };
+    frame_pacer_clock_set(pacer, &c_source);
+}
+
+static bool f64_close(f64 expected, f64 actual, f64 tolerance)
+{
+    return (expected > actual ? expected - actual : actual - expected) <= tolerance * KMAX(1.0, expected);
+}
+
+u8 frame_pacer_test1()
+{
+    test_clock c = { 1000 * MS_TO_NS, 0, 0, 0 };
+    frame_pacer pacer;
+    frame_pacer_stats stats;
+
+    // Без ограничения: статистика по известным интервалам (среднее 10 мс, выборочная дисперсия 10 мс^2).
+    pacer_create(&pacer, &c, 0);
+    u64 intervals_ms[5] = { 10, 12, 8, 14, 6 };
+    frame_pacer_wait(&pacer);
+    for(u32 i = 0; i < 5; ++i)
+    {
+        c.now_ns += intervals_ms[i] * MS_TO_NS;
+        frame_pacer_wait(&pacer);
+    }
+
+    frame_pacer_stats_get(&pacer, &stats);
+    expect_should_be(5, stats.frame_count);
+    expect_should_be(0, c.sleep_count);
+    expect_to_be_true(f64_close(10.0, stats.average_frame_ms, 1e-12));
+    expect_to_be_true(f64_close(6.0, stats.last_frame_ms, 1e-12));
+    expect_to_be_true(f64_close(ksqrt_f64(10.0), stats.jitter_ms, 1e-12));
+    // Отклонение от текущего среднего: 0, 1, 2, 3, 4 мс.
+    expect_to_be_true(f64_close(4.0, stats.max_deviation_ms, 1e-12));
+
+    // Малая дисперсия на больших интервалах (интервалы около секунды, различие в 2 нс) вычисляется точно.
+    frame_pacer_stats_reset(&pacer);
+    frame_pacer_wait(&pacer);
+    for(u32 i = 0; i < 8; ++i)
+    {
+        c.now_ns += 1000 * MS_TO_NS + ((i & 1) ? 3 : 1);
+        frame_pacer_wait(&pacer);
+    }
+    frame_pacer_stats_get(&pacer, &stats);
+    f64 mean_ns = 0, m2_ns = 0;
+    for(u32 i = 0; i < 8; ++i)
+    {
+        f64 interval = (f64)(1000 * MS_TO_NS + ((i & 1) ? 3 : 1));
+        f64 delta = interval - mean_ns;
+        mean_ns += delta / (i + 1);
+        m2_ns += delta * (interval - mean_ns);
+    }
+    expect_to_be_true(f64_close(ksqrt_f64(m2_ns / 7) * 0.000001, stats.jitter_ms, 1e-9));
+
+    // Сброс статистики.
+    frame_pacer_stats_reset(&pacer);
+    frame_pacer_stats_get(&pacer, &stats);
+    expect_should_be(0, stats.frame_count);
+    expect_to_be_true(stats.jitter_ms == 0.0);
+
+    return true;
+}
+
+u8 frame_pacer_test2()
+{
+    test_clock c = { 1000 * MS_TO_NS, 1000, 0, 0 };
+    frame_pacer pacer;
+    frame_pacer_stats stats;
+
+    pacer_create(&pacer, &c, 50);
+    const u64 period = 20 * MS_TO_NS;
+
+    // Первый кадр начинается сразу и задает расписание.
+    frame_pacer_wait(&pacer);
+    u64 deadline = c.now_ns + period;
+
+    // Короткий кадр: ожидание до точного начала следующего.
+    c.now_ns += 5 * MS_TO_NS;
+    frame_pacer_wait(&pacer);
+    expect_to_be_true(c.now_ns >= deadline && c.now_ns <= deadline + c.tick_ns);
+    expect_should_be(1, c.sleep_count);
+    deadline += period;
+
+    // Опоздание меньше периода: расписание сохраняется, следующий кадр короче.
+    c.now_ns += 25 * MS_TO_NS;
+    frame_pacer_wait(&pacer);
+    expect_to_be_true(c.now_ns > deadline);
+    deadline += period;
+    c.now_ns += 5 * MS_TO_NS;
+    frame_pacer_wait(&pacer);
+    expect_to_be_true(c.now_ns >= deadline && c.now_ns <= deadline + c.tick_ns);
+
+    frame_pacer_stats_get(&pacer, &stats);
+    expect_should_be(0, stats.missed_deadlines);
+
+    // Опоздание больше периода: кадр пропущен, расписание переносится от момента опоздания,
+    // следующий кадр не начинается сразу (без серии коротких кадров).
+    c.now_ns += 70 * MS_TO_NS;
+    frame_pacer_wait(&pacer);
+    u64 rescheduled = c.now_ns + period;
+    frame_pacer_stats_get(&pacer, &stats);
+    expect_should_be(1, stats.missed_deadlines);
+
+    c.now_ns += 5 * MS_TO_NS;
+    frame_pacer_wait(&pacer);
+    expect_to_be_true(c.now_ns >= rescheduled && c.now_ns <= rescheduled + c.tick_ns);
+    frame_pacer_stats_get(&pacer, &stats);
+    expect_should_be(1, stats.missed_deadlines);
+    expect_to_be_true(f64_close(20.0, stats.target_ms, 1e-12));
+
+    return true;
+}
+
+u8 frame_pacer_test3()
+{
+    // Планировщик пересыпает на 1 мс: первый кадр опаздывает, далее засыпание раньше на оценку пересыпания.
+    test_clock c = { 1000 * MS_TO_NS, 1000, 1 * MS_TO_NS, 0 };
+    frame_pacer pacer;
+    frame_pacer_stats stats;
+
+    pacer_create(&pacer, &c, 50);
+    const u64 period = 20 * MS_TO_NS;
+
+    frame_pacer_wait(&pacer);
+    u64 deadline = c.now_ns + period;
+
+    c.now_ns += 5 * MS_TO_NS;
+    frame_pacer_wait(&pacer);
+    expect_to_be_true(c.now_ns > deadline + c.tick_ns);
+    frame_pacer_stats_get(&pacer, &stats);
+    expect_to_be_true(stats.oversleep_ms >= 1.0 && stats.oversleep_ms <= 1.01);
+
+    for(u32 i = 0; i < 4; ++i)
+    {
+        deadline += period;
+        c.now_ns += 5 * MS_TO_NS;
+        frame_pacer_wait(&pacer);
+        expect_to_be_true(c.now_ns >= deadline && c.now_ns <= deadline + c.tick_ns);
+    }
+
+    frame_pacer_stats_get(&pacer, &stats);
+    expect_should_be(0, stats.missed_deadlines);
+    return true;
+}
+
+void frame_pacer_register_tests()
+{
+    test_managet_register_test(frame_pacer_test1, "Frame pacer should compute mean, jitter and deviation with Welford statistics.");
+    test_managet_register_test(frame_pacer_test2, "Frame pacer should keep its schedule after small delays and reschedule after a missed deadline.");
+    test_managet_register_test(frame_pacer_test3, "Frame pacer should wake early by the estimated scheduler oversleep.");
+}
@@ -0,0 +1,236 @@
+#include "frame_pipeline_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <frame_pipeline.h>
+#include <memory/memory.h>
+#include <platform/time.h>
+#include <platform/thread.h>
+#include <logger.h>
+
+#define SLOT_VALUE_COUNT    256
+#define CORRECTNESS_FRAMES  2000
+#define BENCHMARK_FRAMES    200
+#define BENCHMARK_STAGE_NS  500000ULL
+
+// Данные кадра: номер и значения, заполненные производителем.
+typedef struct test_slot {
+    u64 frame;
+    u64 values[SLOT_VALUE_COUNT];
+} test_slot;
+
+typedef struct test_consumer {
+    u64 expected_frame;
+    u64 errors;
+    u64 work_ns;
+    // Ожидание вместо вычислений (например, ожидание завершения кадра на GPU).
+    bool wait;
+} test_consumer;
+
+// Имитация нагрузки активным ожиданием.
+static void busy_work(u64 duration_ns)
+{
+    u64 end = platform_time_absolute_ns() + duration_ns;
+    while(platform_time_absolute_ns() < end);
+}
+
+static bool test_consume(void* slot, void* user_data)
+{
+    test_slot* s = slot;
+    test_consumer* c = user_data;
+
+    if(s->frame != c->expected_frame) c->errors++;
+    c->expected_frame++;
+
+    if(c->wait)
+    {
+        platform_thread_sleep_until_ns(platform_time_absolute_ns() + c->work_ns);
+    }
+    else
+    {
+        busy_work(c->work_ns);
+    }
+
+    // Данные слота не изменялись производителем во время обработки.
+    for(u32 i = 0; i < SLOT_VALUE_COUNT; ++i)
+    {
+        if(s->values[i] != s->frame * SLOT_VALUE_COUNT + i) c->errors++;
+    }
+    return true;
+}
+
+static frame_pipeline* pipeline_create(bool threaded, test_consumer* consumer, void** out_memory, u64* out_requirement)
+{
+    frame_pipeline_config config = { sizeof(test_slot), test_consume, consumer, threaded };
+    frame_pipeline_create(&config, out_requirement, null);
+    *out_memory = kallocate(*out_requirement, MEMORY_TAG_ARRAY);
+    return frame_pipeline_create(&config, out_requirement, *out_memory);
+}
+
+static void pipeline_destroy(frame_pipeline* pipeline, void* memory, u64 requirement)
+{
+    frame_pipeline_destroy(pipeline);
+    kfree(memory, requirement, MEMORY_TAG_ARRAY);
+}
+
+// Производит кадры и возвращает затраченное время в миллисекундах.
+static f64 pipeline_run(frame_pipeline* pipeline, u32 frame_count, u64 produce_ns)
+{
+    u64 start = platform_time_absolute_ns();
+    for(u32 frame = 0; frame < frame_count; ++frame)
+    {
+        // Симуляция кадра до получения слота, затем заполнение неизменяемых данных кадра.
+        busy_work(produce_ns);
+
+        test_slot* slot = frame_pipeline_acquire(pipeline);
+        slot->frame = frame;
+        for(u32 i = 0; i < SLOT_VALUE_COUNT; ++i)
+        {
+            slot->values[i] = (u64)frame * SLOT_VALUE_COUNT + i;
+        }
+        frame_pipeline_submit(pipeline);
+    }
+    frame_pipeline_wait_idle(pipeline);
+    return (platform_time_absolute_ns() - start) * 0.000001;
+}
+
+u8 frame_pipeline_test1()
+{
+    test_consumer consumer = {};
+    void* memory = null;
+    u64 requirement = 0;
+    frame_pipeline* pipeline = pipeline_create(true, &consumer, &memory, &requirement);
+    expect_to_be_true(pipeline != null);
+
+    // Кадры обрабатываются по порядку и без гонок за данные слотов.
+    pipeline_run(pipeline, CORRECTNESS_FRAMES, 0);
+    expect_should_be(CORRECTNESS_FRAMES, consumer.expected_frame);
+    expect_should_be(0, consumer.errors);
+    expect_to_be_false(frame_pipeline_failed(pipeline));
+
+    frame_pipeline_stats stats;
+    frame_pipeline_stats_get(pipeline, &stats);
+    expect_should_be(CORRECTNESS_FRAMES, stats.frame_count);
+
+    // Слоты различаются и доступны по индексу.
+    expect_to_be_true(frame_pipeline_slot_get(pipeline, 0) != frame_pipeline_slot_get(pipeline, 1));
+
+    pipeline_destroy(pipeline, memory, requirement);
+    return true;
+}
+
+typedef struct gated_consumer {
+    platform_semaphore entered;
+    platform_semaphore release;
+    u64 consumed;
+} gated_consumer;
+
+// Обработчик, который сообщает о начале кадра и ждет разрешения на его завершение.
+static bool gated_consume(void* slot, void* user_data)
+{
+    gated_consumer* c = user_data;
+    platform_semaphore_signal(&c->entered);
+    platform_semaphore_wait(&c->release);
+    __atomic_add_fetch(&c->consumed, 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+u8 frame_pipeline_test3()
+{
+    gated_consumer consumer = {};
+    expect_to_be_true(platform_semaphore_create(0, &consumer.entered));
+    expect_to_be_true(platform_semaphore_create(0, &consumer.release));
+
+    u64 requirement = 0;
+    frame_pipeline_config config = { sizeof(test_slot), gated_consume, &consumer, true };
+    frame_pipeline_create(&config, &requirement, null);
+    void* memory = kallocate(requirement, MEMORY_TAG_ARRAY);
+    frame_pipeline* pipeline = frame_pipeline_create(&config, &requirement, memory);
+    expect_to_be_true(pipeline != null);
+
+    test_slot* first = frame_pipeline_acquire(pipeline);
+    first->frame = 0;
+    frame_pipeline_submit(pipeline);
+
+    // Пока обработчик занят кадром N, производитель получает слот и отправляет кадр N+1.
+    platform_semaphore_wait(&consumer.entered);
+    test_slot* second = frame_pipeline_acquire(pipeline);
+    expect_to_be_true(second != first);
+    second->frame = 1;
+    frame_pipeline_submit(pipeline);
+    expect_should_be(0, __atomic_load_n(&consumer.consumed, __ATOMIC_ACQUIRE));
+
+    platform_semaphore_signal(&consumer.release);
+    platform_semaphore_signal(&consumer.release);
+    frame_pipeline_wait_idle(pipeline);
+    expect_should_be(2, __atomic_load_n(&consumer.consumed, __ATOMIC_ACQUIRE));
+
+    pipeline_destroy(pipeline, memory, requirement);
+    platform_semaphore_destroy(&consumer.entered);
+    platform_semaphore_destroy(&consumer.release);
+    return true;
+}
+
+#if KBENCHMARK_FLAG
+
+// Сравнивает последовательное и конвейерное выполнение кадров.
+static bool pipeline_benchmark(test_consumer* consumer, const char* name, f64* out_serial_ms, f64* out_pipelined_ms)
+{
+    void* memory = null;
+    u64 requirement = 0;
+
+    // Последовательное выполнение: обработка сразу при отправке.
+    frame_pipeline* pipeline = pipeline_create(false, consumer, &memory, &requirement);
+    f64 serial_ms = pipeline_run(pipeline, BENCHMARK_FRAMES, BENCHMARK_STAGE_NS);
+    pipeline_destroy(pipeline, memory, requirement);
+
+    consumer->expected_frame = 0;
+    pipeline = pipeline_create(true, consumer, &memory, &requirement);
+    f64 pipelined_ms = pipeline_run(pipeline, BENCHMARK_FRAMES, BENCHMARK_STAGE_NS);
+
+    frame_pipeline_stats stats;
+    frame_pipeline_stats_get(pipeline, &stats);
+    pipeline_destroy(pipeline, memory, requirement);
+
+    kinfor(
+        "Frame pipeline, %s (%u frames, %.2f ms per stage): serial %8.3f ms, pipelined %8.3f ms (x%.2f), producer wait %.3f ms",
+        name, BENCHMARK_FRAMES, BENCHMARK_STAGE_NS * 0.000001, serial_ms, pipelined_ms, serial_ms / pipelined_ms,
+        stats.producer_wait_ms
+    );
+
+    *out_serial_ms = serial_ms;
+    *out_pipelined_ms = pipelined_ms;
+    return consumer->errors == 0;
+}
+
+u8 frame_pipeline_test2()
+{
+    f64 serial_ms = 0;
+    f64 pipelined_ms = 0;
+
+    // Обработчик ожидает (как поток отрисовки ожидает GPU): стадии перекрываются и на одном процессоре.
+    test_consumer waiting = { 0, 0, BENCHMARK_STAGE_NS, true };
+    expect_to_be_true(pipeline_benchmark(&waiting, "waiting consumer", &serial_ms, &pipelined_ms));
+    expect_to_be_true(pipelined_ms < serial_ms * 0.8);
+
+    // Обе стадии заняты вычислениями: перекрытие возможно только с двумя и более процессорами.
+    test_consumer busy = { 0, 0, BENCHMARK_STAGE_NS, false };
+    expect_to_be_true(pipeline_benchmark(&busy, "busy consumer", &serial_ms, &pipelined_ms));
+    if(platform_thread_processor_count() > 1)
+    {
+        expect_to_be_true(pipelined_ms < serial_ms * 0.8);
+    }
+
+    return true;
+}
+
+#endif
+
+void frame_pipeline_register_tests()
+{
+    test_managet_register_test(frame_pipeline_test1, "Frame pipeline should hand off slots in order without data races.");
+    test_managet_register_test(frame_pipeline_test3, "Frame pipeline should accept frame N+1 while frame N is consumed.");
+#if KBENCHMARK_FLAG
+    test_managet_register_test(frame_pipeline_test2, "Frame pipeline throughput micro-benchmark.");
+#endif
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void frame_pipeline_register_tests();
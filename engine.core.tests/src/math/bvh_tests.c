@@ -0,0 +1,395 @@
+#include "math/bvh_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <math/bvh.h>
+#include <math/kmath.h>
+#include <memory/memory.h>
+#include <clock.h>
+#include <logger.h>
+
+#define ITEM_COUNT 2000
+
+static extents_3d random_box(u32* seed, f32 range, f32 size)
+{
+    vec3 center = vec3_create(random_unit(seed) * range, random_unit(seed) * range * 0.5f, random_unit(seed) * range);
+    vec3 half = vec3_create(
+        (random_unit(seed) + 1.1f) * size, (random_unit(seed) + 1.1f) * size, (random_unit(seed) + 1.1f) * size
+    );
+    return (extents_3d){ vec3_sub(center, half), vec3_add(center, half) };
+}
+
+static bool box_overlap(extents_3d a, extents_3d b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x
+        && a.min.y <= b.max.y && a.max.y >= b.min.y
+        && a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+static bool box_in_frustum(const frustum* f, extents_3d b)
+{
+    vec3 center = extents_3d_half(b);
+    vec3 half = vec3_mul_scalar(vec3_sub(b.max, b.min), 0.5f);
+    return frustum_intersects_aabb(f, &center, &half);
+}
+
+static bool box_in_sphere(extents_3d b, vec3 center, f32 radius)
+{
+    vec3 closest = vec3_create(
+        KMAX(b.min.x, KMIN(center.x, b.max.x)), KMAX(b.min.y, KMIN(center.y, b.max.y)), KMAX(b.min.z, KMIN(center.z, b.max.z))
+    );
+    return vec3_distance_squared(closest, center) <= radius * radius;
+}
+
+// Расстояние входа луча в прямоугольник или -1 если луч его не пересекает.
+static f32 box_ray(extents_3d b, vec3 origin, vec3 direction, f32 max_distance)
+{
+    f32 tmin = 0.0f;
+    f32 tmax = max_distance;
+    for(u32 a = 0; a < 3; ++a)
+    {
+        f32 inv = 1.0f / direction.elements[a];
+        f32 t1 = (b.min.elements[a] - origin.elements[a]) * inv;
+        f32 t2 = (b.max.elements[a] - origin.elements[a]) * inv;
+        tmin = KMAX(tmin, KMIN(t1, t2));
+        tmax = KMIN(tmax, KMAX(t1, t2));
+    }
+    return tmin <= tmax && tmin < max_distance ? tmin : -1.0f;
+}
+
+// Усеченная пирамида камеры в точке position с поворотом rotation (радианы).
+static frustum camera_frustum(vec3 position, vec3 rotation, f32 far)
+{
+    mat4 world = mat4_mul(mat4_euler_xyz(rotation.x, rotation.y, rotation.z), mat4_translation(position));
+    mat4 projection = mat4_perspective(deg_to_rad(60.0f), 16.0f / 9.0f, 0.1f, far);
+    return frustum_from_view_projection(mat4_mul(mat4_inverse(world), projection));
+}
+
+// Помечает найденные объекты и сверяет их с ожидаемыми.
+static bool results_match(const u32* found, u32 found_count, const bool* expected, const bool* alive, u8* marks)
+{
+    kzero_tc(marks, u8, ITEM_COUNT);
+    for(u32 i = 0; i < found_count; ++i)
+    {
+        if(found[i] >= ITEM_COUNT || marks[found[i]] || !alive[found[i]])
+        {
+            kerror("--> Unexpected or duplicate item %u.", found[i]);
+            return false;
+        }
+        marks[found[i]] = 1;
+    }
+
+    for(u32 i = 0; i < ITEM_COUNT; ++i)
+    {
+        if(alive[i] && expected[i] != (marks[i] != 0))
+        {
+            kerror("--> Item %u: expected %s.", i, expected[i] ? "found" : "not found");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Сверяет все виды запросов с полным перебором.
+static bool queries_match(const bvh* tree, const extents_3d* boxes, const bool* alive, u32* seed)
+{
+    u32 found[ITEM_COUNT];
+    bool expected[ITEM_COUNT];
+    u8 marks[ITEM_COUNT];
+
+    for(u32 q = 0; q < 20; ++q)
+    {
+        extents_3d box = random_box(seed, 100.0f, 15.0f);
+        for(u32 i = 0; i < ITEM_COUNT; ++i) expected[i] = box_overlap(boxes[i], box);
+        u32 count = bvh_query_aabb(tree, box, found, ITEM_COUNT);
+        if(!results_match(found, count, expected, alive, marks)) return false;
+
+        vec3 center = extents_3d_half(box);
+        f32 radius = 5.0f + (random_unit(seed) + 1.0f) * 20.0f;
+        for(u32 i = 0; i < ITEM_COUNT; ++i) expected[i] = box_in_sphere(boxes[i], center, radius);
+        count = bvh_query_sphere(tree, center, radius, found, ITEM_COUNT);
+        if(!results_match(found, count, expected, alive, marks)) return false;
+
+        vec3 rotation = vec3_create(random_unit(seed) * 0.5f, random_unit(seed) * K_PI, 0.0f);
+        frustum f = camera_frustum(center, rotation, 80.0f);
+        for(u32 i = 0; i < ITEM_COUNT; ++i) expected[i] = box_in_frustum(&f, boxes[i]);
+        count = bvh_query_frustum(tree, &f, found, ITEM_COUNT);
+        if(!results_match(found, count, expected, alive, marks)) return false;
+
+        vec3 direction = vec3_create(random_unit(seed), random_unit(seed) * 0.3f, random_unit(seed));
+        f32 best = 1000.0f;
+        for(u32 i = 0; i < ITEM_COUNT; ++i)
+        {
+            if(!alive[i]) continue;
+            f32 t = box_ray(boxes[i], center, direction, best);
+            if(t >= 0.0f && t < best) best = t;
+        }
+
+        bvh_ray_hit hit;
+        bool hit_found = bvh_raycast(tree, center, direction, 1000.0f, null, null, &hit);
+        if(hit_found != (best < 1000.0f) || (hit_found && kabs(hit.distance - best) > 1e-4f * KMAX(1.0f, best)))
+        {
+            kerror("--> Ray hit mismatch: expected %f, got %s %f.", best, hit_found ? "hit" : "miss", hit.distance);
+            return false;
+        }
+    }
+    return true;
+}
+
+u8 bvh_test1()
+{
+    u64 memory_requirement = 0;
+    bvh* tree = bvh_create(ITEM_COUNT, &memory_requirement, null);
+    expect_pointer_should_be(null, tree);
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    tree = bvh_create(ITEM_COUNT, &memory_requirement, memory);
+    expect_pointer_should_not_be(null, tree);
+    // Начало зоны тестов!
+
+    extents_3d boxes[ITEM_COUNT];
+    khandle proxies[ITEM_COUNT];
+    bool alive[ITEM_COUNT];
+    u32 seed = 23;
+
+    for(u32 i = 0; i < ITEM_COUNT; ++i)
+    {
+        boxes[i] = random_box(&seed, 100.0f, 2.0f);
+        expect_to_be_true(bvh_insert(tree, boxes[i], i, &proxies[i]));
+        alive[i] = true;
+    }
+
+    // Объекты вне дерева проверяются перебором.
+    expect_to_be_true(queries_match(tree, boxes, alive, &seed));
+
+    bvh_build(tree);
+    expect_should_be(ITEM_COUNT, bvh_count(tree));
+    expect_to_be_true(bvh_node_count(tree) < ITEM_COUNT * 2);
+    expect_to_be_true(queries_match(tree, boxes, alive, &seed));
+
+    // Перемещение части объектов с обновлением границ ветвей.
+    for(u32 i = 0; i < ITEM_COUNT; i += 10)
+    {
+        vec3 offset = vec3_create(random_unit(&seed) * 5.0f, random_unit(&seed) * 5.0f, random_unit(&seed) * 5.0f);
+        boxes[i].min = vec3_add(boxes[i].min, offset);
+        boxes[i].max = vec3_add(boxes[i].max, offset);
+        expect_to_be_true(bvh_move(tree, proxies[i], boxes[i]));
+    }
+    bvh_update(tree);
+    expect_to_be_true(queries_match(tree, boxes, alive, &seed));
+
+    // Удаление и повторное добавление (слоты используются повторно до перестроения).
+    for(u32 i = 3; i < ITEM_COUNT; i += 97)
+    {
+        expect_to_be_true(bvh_remove(tree, proxies[i]));
+        alive[i] = false;
+    }
+    expect_to_be_false(bvh_move(tree, proxies[3], boxes[3]));
+    expect_to_be_true(queries_match(tree, boxes, alive, &seed));
+
+    for(u32 i = 3; i < ITEM_COUNT; i += 194)
+    {
+        boxes[i] = random_box(&seed, 100.0f, 2.0f);
+        expect_to_be_true(bvh_insert(tree, boxes[i], i, &proxies[i]));
+        alive[i] = true;
+    }
+    expect_to_be_true(queries_match(tree, boxes, alive, &seed));
+
+    bvh_update(tree);
+    expect_to_be_true(queries_match(tree, boxes, alive, &seed));
+
+    // Конец зоны тестов!
+    bvh_destroy(tree);
+    kfree(memory, memory_requirement, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+u8 bvh_test2()
+{
+    // Плоскости из параметров камеры и из матрицы вида-проекции одинаково классифицируют точки.
+    u32 seed = 5;
+    for(u32 c = 0; c < 8; ++c)
+    {
+        vec3 position = vec3_create(random_unit(&seed) * 10.0f, random_unit(&seed) * 10.0f, random_unit(&seed) * 10.0f);
+        mat4 world = mat4_mul(mat4_euler_xyz(random_unit(&seed), random_unit(&seed) * K_PI, 0.0f), mat4_translation(position));
+        vec3 right = vec3_create(world.data[0], world.data[1], world.data[2]);
+        vec3 up = vec3_create(world.data[4], world.data[5], world.data[6]);
+        vec3 forward = vec3_create(-world.data[8], -world.data[9], -world.data[10]);
+
+        f32 fov = deg_to_rad(70.0f);
+        frustum from_camera = frustum_create(&position, &forward, &right, &up, 1.5f, fov, 0.5f, 50.0f);
+        frustum from_matrix = frustum_from_view_projection(mat4_mul(mat4_inverse(world), mat4_perspective(fov, 1.5f, 0.5f, 50.0f)));
+
+        // Точка перед камерой внутри, позади снаружи.
+        vec3 ahead = vec3_add(position, vec3_mul_scalar(forward, 10.0f));
+        vec3 behind = vec3_sub(position, vec3_mul_scalar(forward, 10.0f));
+        expect_to_be_true(frustum_intersects_sphere(&from_camera, &ahead, 0.0f));
+        expect_to_be_true(frustum_intersects_sphere(&from_matrix, &ahead, 0.0f));
+        expect_to_be_false(frustum_intersects_sphere(&from_camera, &behind, 0.0f));
+        expect_to_be_false(frustum_intersects_sphere(&from_matrix, &behind, 0.0f));
+
+        for(u32 i = 0; i < 1000; ++i)
+        {
+            vec3 point = vec3_add(position, vec3_create(random_unit(&seed) * 60.0f, random_unit(&seed) * 60.0f, random_unit(&seed) * 60.0f));
+
+            // Точки у границ пропускаются из-за разной погрешности построения плоскостей.
+            bool near_boundary = false;
+            for(u32 s = 0; s < FRUSTUM_SIDES_MAX; ++s)
+            {
+                near_boundary |= kabs(plane_signed_distance(&from_camera.sides[s], &point)) < 1e-2f;
+            }
+            if(near_boundary) continue;
+
+            expect_should_be(
+                frustum_intersects_sphere(&from_camera, &point, 0.0f), frustum_intersects_sphere(&from_matrix, &point, 0.0f)
+            );
+        }
+    }
+    return true;
+}
+
+#if KBENCHMARK_FLAG
+
+#define BENCH_SOURCE_COUNT 400
+#define BENCH_INSTANCES    64
+#define BENCH_ITEM_COUNT   (BENCH_SOURCE_COUNT * BENCH_INSTANCES)
+#define BENCH_QUERIES      100
+
+u8 bvh_test3()
+{
+    /*
+        NOTE: Модель Sponza не входит в состав тестов, поэтому границы ее геометрий имитируются: 400 частей
+              разного размера (колонны, арки, драпировки) внутри здания 60x25x30, размноженного сеткой 8x8.
+    */
+    u32 seed = 11;
+    extents_3d source[BENCH_SOURCE_COUNT];
+    for(u32 i = 0; i < BENCH_SOURCE_COUNT; ++i)
+    {
+        f32 size = (i % 10 == 0) ? 6.0f : 0.6f;
+        extents_3d b = random_box(&seed, 1.0f, size);
+        vec3 offset = vec3_create(random_unit(&seed) * 30.0f, (random_unit(&seed) + 1.0f) * 12.5f, random_unit(&seed) * 15.0f);
+        source[i] = (extents_3d){ vec3_add(b.min, offset), vec3_add(b.max, offset) };
+    }
+
+    u64 memory_requirement = 0;
+    bvh_create(BENCH_ITEM_COUNT, &memory_requirement, null);
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    bvh* tree = bvh_create(BENCH_ITEM_COUNT, &memory_requirement, memory);
+
+    extents_3d* boxes = kallocate_tc(extents_3d, BENCH_ITEM_COUNT, MEMORY_TAG_ARRAY);
+    khandle* proxies = kallocate_tc(khandle, BENCH_ITEM_COUNT, MEMORY_TAG_ARRAY);
+    u32* found = kallocate_tc(u32, BENCH_ITEM_COUNT, MEMORY_TAG_ARRAY);
+
+    for(u32 n = 0; n < BENCH_INSTANCES; ++n)
+    {
+        vec3 offset = vec3_create((n % 8) * 70.0f, 0.0f, (n / 8) * 40.0f);
+        for(u32 i = 0; i < BENCH_SOURCE_COUNT; ++i)
+        {
+            u32 index = n * BENCH_SOURCE_COUNT + i;
+            boxes[index] = (extents_3d){ vec3_add(source[i].min, offset), vec3_add(source[i].max, offset) };
+            bvh_insert(tree, boxes[index], index, &proxies[index]);
+        }
+    }
+
+    clock timer;
+    clock_start(&timer);
+    bvh_build(tree);
+    clock_update(&timer);
+    f64 build_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    // Перемещение каждого десятого объекта и обновление границ.
+    for(u32 i = 0; i < BENCH_ITEM_COUNT; i += 10)
+    {
+        boxes[i].min.y += 0.5f;
+        boxes[i].max.y += 0.5f;
+        bvh_move(tree, proxies[i], boxes[i]);
+    }
+    clock_start(&timer);
+    bvh_update(tree);
+    clock_update(&timer);
+    f64 refit_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    // Камеры внутри сетки зданий, смотрящие вдоль нее.
+    frustum frustums[BENCH_QUERIES];
+    vec3 origins[BENCH_QUERIES];
+    vec3 directions[BENCH_QUERIES];
+    for(u32 q = 0; q < BENCH_QUERIES; ++q)
+    {
+        origins[q] = vec3_create((random_unit(&seed) + 1.0f) * 280.0f, 5.0f + (random_unit(&seed) + 1.0f) * 5.0f, (random_unit(&seed) + 1.0f) * 160.0f);
+        f32 yaw = random_unit(&seed) * K_PI;
+        frustums[q] = camera_frustum(origins[q], vec3_create(0.0f, yaw, 0.0f), 150.0f);
+        directions[q] = vec3_create(-ksin(yaw), random_unit(&seed) * 0.2f, -kcos(yaw));
+    }
+
+    u32 tree_visible = 0;
+    clock_start(&timer);
+    for(u32 q = 0; q < BENCH_QUERIES; ++q)
+    {
+        tree_visible += bvh_query_frustum(tree, &frustums[q], found, BENCH_ITEM_COUNT);
+    }
+    clock_update(&timer);
+    f64 frustum_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    u32 linear_visible = 0;
+    clock_start(&timer);
+    for(u32 q = 0; q < BENCH_QUERIES; ++q)
+    {
+        for(u32 i = 0; i < BENCH_ITEM_COUNT; ++i)
+        {
+            if(box_in_frustum(&frustums[q], boxes[i])) found[linear_visible++ % BENCH_ITEM_COUNT] = i;
+        }
+    }
+    clock_update(&timer);
+    f64 frustum_linear_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    u32 tree_hits = 0;
+    bvh_ray_hit hit;
+    clock_start(&timer);
+    for(u32 q = 0; q < BENCH_QUERIES; ++q)
+    {
+        tree_hits += bvh_raycast(tree, origins[q], directions[q], 1000.0f, null, null, &hit);
+    }
+    clock_update(&timer);
+    f64 ray_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    u32 linear_hits = 0;
+    clock_start(&timer);
+    for(u32 q = 0; q < BENCH_QUERIES; ++q)
+    {
+        f32 best = 1000.0f;
+        for(u32 i = 0; i < BENCH_ITEM_COUNT; ++i)
+        {
+            f32 t = box_ray(boxes[i], origins[q], directions[q], best);
+            if(t >= 0.0f && t < best) best = t;
+        }
+        linear_hits += best < 1000.0f;
+    }
+    clock_update(&timer);
+    f64 ray_linear_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    kinfor("BVH over %u items (%u nodes):", BENCH_ITEM_COUNT, bvh_node_count(tree));
+    kinfor("  build %8.3f ms, refit (10%% moved) %8.3f ms", build_ms, refit_ms);
+    kinfor("  %u frustum queries: bvh %8.3f ms, linear %8.3f ms (x%.2f)", BENCH_QUERIES, frustum_ms, frustum_linear_ms, frustum_linear_ms / frustum_ms);
+    kinfor("  %u raycasts:        bvh %8.3f ms, linear %8.3f ms (x%.2f)", BENCH_QUERIES, ray_ms, ray_linear_ms, ray_linear_ms / ray_ms);
+
+    expect_should_be(linear_visible, tree_visible);
+    expect_should_be(linear_hits, tree_hits);
+
+    kfree_tc(boxes, extents_3d, BENCH_ITEM_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(proxies, khandle, BENCH_ITEM_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(found, u32, BENCH_ITEM_COUNT, MEMORY_TAG_ARRAY);
+    bvh_destroy(tree);
+    kfree(memory, memory_requirement, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+#endif
+
+void bvh_register_tests()
+{
+    test_managet_register_test(bvh_test1, "BVH queries should match brute force after build, refit, insert and remove.");
+    test_managet_register_test(bvh_test2, "Frustum planes from camera and from view-projection should agree.");
+#if KBENCHMARK_FLAG
+    test_managet_register_test(bvh_test3, "BVH build, refit and query micro-benchmark.");
+#endif
+}
@@ -0,0 +1,252 @@
+#include "math/geometry_optimizer_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <math/geometry_optimizer.h>
+#include <memory/memory.h>
+
+#define GRID_SIZE 32
+
+// Регулярная сетка GRID_SIZE x GRID_SIZE квадратов с перемешанными треугольниками.
+static void grid_create(vertex_3d** out_vertices, u32* out_vertex_count, u32** out_indices, u32* out_index_count)
+{
+    u32 side = GRID_SIZE + 1;
+    u32 vertex_count = side * side;
+    u32 index_count = GRID_SIZE * GRID_SIZE * 6;
+
+    vertex_3d* vertices = kallocate_tc(vertex_3d, vertex_count, MEMORY_TAG_ARRAY);
+    u32* indices = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    kzero_tc(vertices, vertex_3d, vertex_count);
+
+    for(u32 y = 0; y < side; ++y)
+    {
+        for(u32 x = 0; x < side; ++x)
+        {
+            vertices[y * side + x].position = vec3_create(x, y, 0);
+        }
+    }
+
+    u32 i = 0;
+    for(u32 y = 0; y < GRID_SIZE; ++y)
+    {
+        for(u32 x = 0; x < GRID_SIZE; ++x)
+        {
+            u32 a = y * side + x;
+            indices[i++] = a;
+            indices[i++] = a + 1;
+            indices[i++] = a + side + 1;
+            indices[i++] = a;
+            indices[i++] = a + side + 1;
+            indices[i++] = a + side;
+        }
+    }
+
+    // Перемешивание треугольников (линейный конгруэнтный генератор).
+    u32 seed = 12345;
+    u32 triangle_count = index_count / 3;
+    for(u32 t = triangle_count - 1; t > 0; --t)
+    {
+        seed = seed * 1664525U + 1013904223U;
+        u32 r = (seed >> 8) % (t + 1);
+        for(u32 k = 0; k < 3; ++k)
+        {
+            u32 swap = indices[t * 3 + k];
+            indices[t * 3 + k] = indices[r * 3 + k];
+            indices[r * 3 + k] = swap;
+        }
+    }
+
+    *out_vertices = vertices;
+    *out_vertex_count = vertex_count;
+    *out_indices = indices;
+    *out_index_count = index_count;
+}
+
+static void grid_destroy(vertex_3d* vertices, u32 vertex_count, u32* indices, u32 index_count)
+{
+    kfree_tc(vertices, vertex_3d, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(indices, u32, index_count, MEMORY_TAG_ARRAY);
+}
+
+// Сумма хешей треугольников (не зависит от порядка треугольников).
+static u64 triangles_checksum(const u32* indices, u32 index_count)
+{
+    u64 checksum = 0;
+    for(u32 i = 0; i < index_count; i += 3)
+    {
+        u64 hash = ((u64)indices[i] * 73856093ULL) ^ ((u64)indices[i + 1] * 19349663ULL) ^ ((u64)indices[i + 2] * 83492791ULL);
+        checksum += hash * 0x9E3779B97F4A7C15ULL;
+    }
+    return checksum;
+}
+
+u8 geometry_optimizer_test1()
+{
+    vertex_3d* vertices;
+    u32* indices;
+    u32 vertex_count, index_count;
+    grid_create(&vertices, &vertex_count, &indices, &index_count);
+
+    u64 checksum = triangles_checksum(indices, index_count);
+
+    geometry_vertex_cache_stats before, after;
+    geometry_analyze_vertex_cache(index_count, indices, vertex_count, GEOMETRY_VERTEX_CACHE_SIZE, &before);
+    geometry_optimize_vertex_cache(index_count, indices, vertex_count);
+    geometry_analyze_vertex_cache(index_count, indices, vertex_count, GEOMETRY_VERTEX_CACHE_SIZE, &after);
+
+    // Набор треугольников не изменяется.
+    expect_should_be(checksum, triangles_checksum(indices, index_count));
+
+    // Перемешанная сетка близка к худшему случаю, упорядоченная - к 0.5-0.8 промахам на треугольник.
+    expect_to_be_true(before.acmr > 1.5f);
+    expect_to_be_true(after.acmr < 0.9f);
+    expect_to_be_true(after.atvr < 1.6f);
+
+    grid_destroy(vertices, vertex_count, indices, index_count);
+    return true;
+}
+
+u8 geometry_optimizer_test2()
+{
+    vertex_3d* vertices;
+    u32* indices;
+    u32 vertex_count, index_count;
+    grid_create(&vertices, &vertex_count, &indices, &index_count);
+
+    geometry_optimize_vertex_cache(index_count, indices, vertex_count);
+    u64 checksum = triangles_checksum(indices, index_count);
+
+    geometry_vertex_cache_stats before, after;
+    geometry_analyze_vertex_cache(index_count, indices, vertex_count, GEOMETRY_VERTEX_CACHE_SIZE, &before);
+    geometry_optimize_overdraw(index_count, indices, vertex_count, vertices, 1.05f);
+    geometry_analyze_vertex_cache(index_count, indices, vertex_count, GEOMETRY_VERTEX_CACHE_SIZE, &after);
+
+    // Переставляются только кластеры треугольников.
+    expect_should_be(checksum, triangles_checksum(indices, index_count));
+    expect_to_be_true(after.acmr < before.acmr * 1.1f);
+
+    grid_destroy(vertices, vertex_count, indices, index_count);
+    return true;
+}
+
+u8 geometry_optimizer_test3()
+{
+    vertex_3d* vertices;
+    u32* indices;
+    u32 vertex_count, index_count;
+    grid_create(&vertices, &vertex_count, &indices, &index_count);
+
+    // Копия исходных данных для проверки.
+    vertex_3d* source_vertices = kallocate_tc(vertex_3d, vertex_count, MEMORY_TAG_ARRAY);
+    u32* source_indices = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    kcopy_tc(source_vertices, vertices, vertex_3d, vertex_count);
+    kcopy_tc(source_indices, indices, u32, index_count);
+
+    u32 used = geometry_optimize_vertex_fetch(index_count, indices, vertex_count, sizeof(vertex_3d), vertices);
+    expect_should_be(vertex_count, used);
+
+    // Вершины пронумерованы в порядке первого использования и указывают на те же данные.
+    u32 next = 0;
+    for(u32 i = 0; i < index_count; ++i)
+    {
+        expect_to_be_true(indices[i] <= next);
+        if(indices[i] == next) next++;
+
+        vec3 expected = source_vertices[source_indices[i]].position;
+        vec3 actual = vertices[indices[i]].position;
+        expect_float_to_be(expected.x, actual.x);
+        expect_float_to_be(expected.y, actual.y);
+    }
+
+    kfree_tc(source_vertices, vertex_3d, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(source_indices, u32, index_count, MEMORY_TAG_ARRAY);
+    grid_destroy(vertices, vertex_count, indices, index_count);
+    return true;
+}
+
+// Сумма площадей треугольников плоской сетки с учетом ориентации (развернутые треугольники уменьшают сумму).
+static f32 grid_signed_area(const vertex_3d* vertices, const u32* indices, u32 index_count, u32* out_flipped)
+{
+    f32 area = 0.0f;
+    *out_flipped = 0;
+
+    for(u32 i = 0; i < index_count; i += 3)
+    {
+        vec3 p0 = vertices[indices[i + 0]].position;
+        vec3 p1 = vertices[indices[i + 1]].position;
+        vec3 p2 = vertices[indices[i + 2]].position;
+        f32 z = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0)).z * 0.5f;
+
+        if(z <= 0.0f)
+        {
+            (*out_flipped)++;
+        }
+        area += z;
+    }
+
+    return area;
+}
+
+u8 geometry_optimizer_test4()
+{
+    vertex_3d* vertices;
+    u32* indices;
+    u32 vertex_count, index_count;
+    grid_create(&vertices, &vertex_count, &indices, &index_count);
+
+    u32* lod = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    u32 target_index_count = index_count / 10;
+    f32 error = 1.0f;
+    u32 lod_index_count = geometry_simplify(index_count, indices, vertex_count, vertices, target_index_count, 0.01f, lod, &error);
+
+    // Плоская сетка упрощается без ошибки, граница сохраняется, треугольники не разворачиваются.
+    u32 flipped = 0;
+    f32 area = grid_signed_area(vertices, lod, lod_index_count, &flipped);
+    expect_to_be_true(lod_index_count <= target_index_count);
+    expect_to_be_true(lod_index_count % 3 == 0);
+    expect_to_be_true(error < 1e-4f);
+    expect_should_be(0, flipped);
+    expect_to_be_true(kabs(area - GRID_SIZE * GRID_SIZE) < 1e-2f);
+
+    kfree_tc(lod, u32, index_count, MEMORY_TAG_ARRAY);
+    grid_destroy(vertices, vertex_count, indices, index_count);
+    return true;
+}
+
+u8 geometry_optimizer_test5()
+{
+    vertex_3d* vertices;
+    u32* indices;
+    u32 vertex_count, index_count;
+    grid_create(&vertices, &vertex_count, &indices, &index_count);
+
+    // Неровная поверхность: ошибка ограничивает упрощение.
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        vertices[v].position.z = ksin(vertices[v].position.x * 0.7f) * kcos(vertices[v].position.y * 0.9f) * 2.0f;
+    }
+
+    u32* lod = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    f32 strict_error = 0.0f;
+    f32 loose_error = 0.0f;
+    u32 strict_count = geometry_simplify(index_count, indices, vertex_count, vertices, 0, 0.001f, lod, &strict_error);
+    u32 loose_count = geometry_simplify(index_count, indices, vertex_count, vertices, 0, 0.5f, lod, &loose_error);
+
+    expect_to_be_true(strict_error <= 0.001f);
+    expect_to_be_true(loose_error <= 0.5f);
+    expect_to_be_true(strict_count > index_count / 2);
+    expect_to_be_true(loose_count < strict_count);
+
+    kfree_tc(lod, u32, index_count, MEMORY_TAG_ARRAY);
+    grid_destroy(vertices, vertex_count, indices, index_count);
+    return true;
+}
+
+void geometry_optimizer_register_tests()
+{
+    test_managet_register_test(geometry_optimizer_test1, "Vertex cache optimization should keep triangles and reduce ACMR.");
+    test_managet_register_test(geometry_optimizer_test2, "Overdraw optimization should keep triangles and bound ACMR.");
+    test_managet_register_test(geometry_optimizer_test3, "Vertex fetch optimization should renumber vertices by first use.");
+    test_managet_register_test(geometry_optimizer_test4, "Simplification should collapse flat geometry without flips.");
+    test_managet_register_test(geometry_optimizer_test5, "Simplification should respect the error limit.");
+}
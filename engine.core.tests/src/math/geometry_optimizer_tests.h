@@ -0,0 +1,3 @@
+#pragma once
+
+void geometry_optimizer_register_tests();
@@ -0,0 +1,230 @@
+#include "math/geometry_utils_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <math/geometry_utils.h>
+#include <math/kmath.h>
+#include <memory/memory.h>
+
+#define VERTEX_COUNT 1024
+
+u8 geometry_utils_test1()
+{
+    vertex_3d* vertices = kallocate_tc(vertex_3d, VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    vertex_3d_packed* packed = kallocate_tc(vertex_3d_packed, VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    vertex_3d* unpacked = kallocate_tc(vertex_3d, VERTEX_COUNT, MEMORY_TAG_ARRAY);
+
+    u32 seed = 4242;
+    for(u32 i = 0; i < VERTEX_COUNT; ++i)
+    {
+        vertex_3d* v = &vertices[i];
+        v->position = vec3_create(random_unit(&seed) * 100.0f, random_unit(&seed) * 5.0f + 20.0f, random_unit(&seed) * 0.1f);
+        v->normal = vec3_normalized(vec3_create(random_unit(&seed), random_unit(&seed), random_unit(&seed)));
+        v->texcoord = vec2_create(random_unit(&seed) * 8.0f, random_unit(&seed));
+        v->color = vec4_create(0.5f + random_unit(&seed) * 0.5f, 0.5f, 0.25f, 1.0f);
+        vec3 tangent = vec3_normalized(vec3_create(random_unit(&seed), random_unit(&seed), random_unit(&seed)));
+        v->tangent = vec4_from_vec3(tangent, (i & 1) ? 1.0f : -1.0f);
+    }
+
+    extents_3d range;
+    geometry_pack_vertices(VERTEX_COUNT, vertices, packed, &range);
+    geometry_unpack_vertices(VERTEX_COUNT, packed, &range, unpacked);
+
+    // Диапазон совпадает с ограничивающим объемом.
+    for(u32 i = 0; i < VERTEX_COUNT; ++i)
+    {
+        for(u32 a = 0; a < 3; ++a)
+        {
+            expect_to_be_true(vertices[i].position.elements[a] >= range.min.elements[a]);
+            expect_to_be_true(vertices[i].position.elements[a] <= range.max.elements[a]);
+        }
+    }
+
+    vec3 size = vec3_sub(range.max, range.min);
+    for(u32 i = 0; i < VERTEX_COUNT; ++i)
+    {
+        const vertex_3d* expected = &vertices[i];
+        const vertex_3d* actual = &unpacked[i];
+
+        // Ошибка положения не более половины шага квантования (с запасом на округление f32).
+        for(u32 a = 0; a < 3; ++a)
+        {
+            f32 step = size.elements[a] / 65535.0f;
+            f32 error = kabs(expected->position.elements[a] - actual->position.elements[a]);
+            expect_to_be_true(error <= step * 0.5f + 1e-5f);
+        }
+
+        // Ошибка направления нормали и касательной менее 0.01 градуса.
+        expect_to_be_true(vec3_dot(expected->normal, actual->normal) > 0.99999f);
+        expect_to_be_true(vec3_dot(vec3_from_vec4(expected->tangent), vec3_from_vec4(actual->tangent)) > 0.99999f);
+        expect_float_to_be(expected->tangent.w, actual->tangent.w);
+
+        // Относительная ошибка half float не более 2^-11.
+        expect_to_be_true(kabs(expected->texcoord.x - actual->texcoord.x) <= kabs(expected->texcoord.x) * 0.00049f + 1e-7f);
+        expect_to_be_true(kabs(expected->texcoord.y - actual->texcoord.y) <= kabs(expected->texcoord.y) * 0.00049f + 1e-7f);
+
+        for(u32 c = 0; c < 4; ++c)
+        {
+            expect_to_be_true(kabs(expected->color.elements[c] - actual->color.elements[c]) <= 0.5f / 255.0f + 1e-6f);
+        }
+    }
+
+    kfree_tc(vertices, vertex_3d, VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(packed, vertex_3d_packed, VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(unpacked, vertex_3d, VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+u8 geometry_utils_test2()
+{
+    // Плоскость (вырожденная ось z) с нулевыми нормалями и касательными, как у геометрии по умолчанию.
+    vertex_3d vertices[4];
+    kzero_tc(vertices, vertex_3d, 4);
+    vertices[0].position = vec3_create(-5.0f, -5.0f, 2.0f);
+    vertices[1].position = vec3_create( 5.0f,  5.0f, 2.0f);
+    vertices[2].position = vec3_create(-5.0f,  5.0f, 2.0f);
+    vertices[3].position = vec3_create( 5.0f, -5.0f, 2.0f);
+    vertices[1].texcoord = vec2_create(1.0f, 1.0f);
+
+    vertex_3d_packed packed[4];
+    vertex_3d unpacked[4];
+    extents_3d range;
+    geometry_pack_vertices(4, vertices, packed, &range);
+    geometry_unpack_vertices(4, packed, &range, unpacked);
+
+    expect_float_to_be(2.0f, range.min.z);
+    expect_float_to_be(2.0f, range.max.z);
+
+    for(u32 i = 0; i < 4; ++i)
+    {
+        // Крайние значения диапазона восстанавливаются точно.
+        expect_float_to_be(vertices[i].position.x, unpacked[i].position.x);
+        expect_float_to_be(vertices[i].position.y, unpacked[i].position.y);
+        expect_float_to_be(vertices[i].position.z, unpacked[i].position.z);
+        expect_float_to_be(vertices[i].texcoord.x, unpacked[i].texcoord.x);
+        expect_float_to_be(vertices[i].texcoord.y, unpacked[i].texcoord.y);
+
+        // Нулевой вектор кодируется как (0, 0, 1).
+        expect_float_to_be(1.0f, unpacked[i].normal.z);
+        expect_float_to_be(0.0f, unpacked[i].color.w);
+    }
+
+    return true;
+}
+
+// Эталонная последовательная генерация нормалей (вершина получает значение последнего треугольника).
+static void reference_generate_normals(vertex_3d* vertices, u32 index_count, const u32* indices)
+{
+    for(u32 i = 0; i < index_count; i += 3)
+    {
+        u32 i0 = indices[i + 0];
+        u32 i1 = indices[i + 1];
+        u32 i2 = indices[i + 2];
+
+        vec3 edge1 = vec3_sub(vertices[i1].position, vertices[i0].position);
+        vec3 edge2 = vec3_sub(vertices[i2].position, vertices[i0].position);
+        vec3 normal = vec3_normalized(vec3_cross(edge1, edge2));
+
+        vertices[i0].normal = normal;
+        vertices[i1].normal = normal;
+        vertices[i2].normal = normal;
+    }
+}
+
+// Эталонная последовательная генерация касательных.
+static void reference_generate_tangent(vertex_3d* vertices, u32 index_count, const u32* indices)
+{
+    for(u32 i = 0; i < index_count; i += 3)
+    {
+        u32 i0 = indices[i + 0];
+        u32 i1 = indices[i + 1];
+        u32 i2 = indices[i + 2];
+
+        vec3 edge1 = vec3_sub(vertices[i1].position, vertices[i0].position);
+        vec3 edge2 = vec3_sub(vertices[i2].position, vertices[i0].position);
+
+        f32 deltaU1 = vertices[i1].texcoord.x - vertices[i0].texcoord.x;
+        f32 deltaV1 = vertices[i1].texcoord.y - vertices[i0].texcoord.y;
+        f32 deltaU2 = vertices[i2].texcoord.x - vertices[i0].texcoord.x;
+        f32 deltaV2 = vertices[i2].texcoord.y - vertices[i0].texcoord.y;
+
+        f32 fc = 1.0f / (deltaU1 * deltaV2 - deltaU2 * deltaV1);
+        vec3 tangent = vec3_normalized((vec3){{
+            (fc * (deltaV2 * edge1.x - deltaV1 * edge2.x)),
+            (fc * (deltaV2 * edge1.y - deltaV1 * edge2.y)),
+            (fc * (deltaV2 * edge1.z - deltaV1 * edge2.z))
+        }});
+
+        f32 handedness = ((deltaV1 * deltaU2 - deltaV2 * deltaU1) < 0.0f) ? -1.0f : 1.0f;
+        vec4 t4 = vec4_from_vec3(tangent, handedness);
+
+        vertices[i0].tangent = t4;
+        vertices[i1].tangent = t4;
+        vertices[i2].tangent = t4;
+    }
+}
+
+#define GENERATE_VERTEX_COUNT 4096
+#define GENERATE_TRIANGLE_COUNT 9001
+
+u8 geometry_utils_test3()
+{
+    u32 index_count = GENERATE_TRIANGLE_COUNT * 3;
+    vertex_3d* expected = kallocate_tc(vertex_3d, GENERATE_VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    vertex_3d* actual = kallocate_tc(vertex_3d, GENERATE_VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    u32* indices = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+
+    u32 seed = 777;
+    for(u32 i = 0; i < GENERATE_VERTEX_COUNT; ++i)
+    {
+        vertex_3d* v = &expected[i];
+        v->position = vec3_create(random_unit(&seed) * 50.0f, random_unit(&seed) * 50.0f, random_unit(&seed) * 50.0f);
+        v->normal = vec3_create(7.0f, 7.0f, 7.0f);
+        v->texcoord = vec2_create(random_unit(&seed) * 4.0f, random_unit(&seed) * 4.0f);
+        v->color = vec4_one();
+        v->tangent = vec4_create(7.0f, 7.0f, 7.0f, 7.0f);
+    }
+
+    // Общие вершины в случайном порядке, последние 16 вершин не используются.
+    for(u32 i = 0; i < index_count; ++i)
+    {
+        seed = seed * 1664525U + 1013904223U;
+        indices[i] = (seed >> 8) % (GENERATE_VERTEX_COUNT - 16);
+    }
+
+    kcopy_tc(actual, expected, vertex_3d, GENERATE_VERTEX_COUNT);
+
+    reference_generate_normals(expected, index_count, indices);
+    reference_generate_tangent(expected, index_count, indices);
+    geometry_generate_normals(GENERATE_VERTEX_COUNT, actual, index_count, indices);
+    geometry_generate_tangent(GENERATE_VERTEX_COUNT, actual, index_count, indices);
+
+    for(u32 i = 0; i < GENERATE_VERTEX_COUNT; ++i)
+    {
+        for(u32 a = 0; a < 3; ++a)
+        {
+            expect_float_to_be(expected[i].normal.elements[a], actual[i].normal.elements[a]);
+        }
+        for(u32 a = 0; a < 4; ++a)
+        {
+            expect_float_to_be(expected[i].tangent.elements[a], actual[i].tangent.elements[a]);
+        }
+    }
+
+    // Неиспользуемые вершины не изменяются.
+    expect_float_to_be(7.0f, actual[GENERATE_VERTEX_COUNT - 1].normal.x);
+    expect_float_to_be(7.0f, actual[GENERATE_VERTEX_COUNT - 1].tangent.w);
+
+    kfree_tc(expected, vertex_3d, GENERATE_VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(actual, vertex_3d, GENERATE_VERTEX_COUNT, MEMORY_TAG_ARRAY);
+    kfree_tc(indices, u32, index_count, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+void geometry_utils_register_tests()
+{
+    test_managet_register_test(geometry_utils_test1, "Vertex packing should round-trip within quantization error.");
+    test_managet_register_test(geometry_utils_test2, "Vertex packing should handle flat geometry and zero vectors.");
+    test_managet_register_test(geometry_utils_test3, "Normal and tangent generation should match sequential per-face results.");
+}
@@ -0,0 +1,263 @@
+#include "math/kmath_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <math/kmath.h>
+#include <platform/math.h>
+#include <clock.h>
+#include <logger.h>
+
+#define SAMPLE_COUNT     256
+#define BENCHMARK_ROUNDS 2000
+
+// Матрица трансформации со случайным положением, вращением и масштабом (всегда обратима).
+static mat4 random_transform(u32* seed)
+{
+    vec3 position = vec3_create(random_unit(seed) * 50.0f, random_unit(seed) * 50.0f, random_unit(seed) * 50.0f);
+    vec3 scale = vec3_create(1.25f + random_unit(seed), 1.25f + random_unit(seed), 1.25f + random_unit(seed));
+    return mat4_from_translation_rotation_scale(position, random_quat(seed), scale);
+}
+
+u8 kmath_test1()
+{
+    // NOTE: При сборке с FMA результаты отличаются от скалярных в последних разрядах.
+    const f32 tolerance = 1e-5f;
+    u32 seed = 1337;
+
+    for(u32 i = 0; i < SAMPLE_COUNT; ++i)
+    {
+        mat4 a = random_transform(&seed);
+        mat4 b = random_transform(&seed);
+        expect_to_be_true(mat4_close(mat4_mul_scalar(a, b), mat4_mul(a, b), tolerance));
+
+        // Обратная матрица вычисляется другим способом, поэтому допуск больше.
+        mat4 inverse = mat4_inverse(a);
+        expect_to_be_true(mat4_close(mat4_inverse_scalar(a), inverse, 1e-3f));
+        expect_to_be_true(mat4_close(mat4_identity(), mat4_mul(a, inverse), 1e-4f));
+
+        quat q0 = random_quat(&seed);
+        quat q1 = random_quat(&seed);
+        expect_to_be_true(vec4_close(quat_mul_scalar(q0, q1), quat_mul(q0, q1), tolerance));
+
+        // Ненормализованный кватернион: нормализация входит в преобразование.
+        quat q2 = vec4_mul_scalar(q0, 3.0f);
+        expect_to_be_true(mat4_close(quat_to_mat4_scalar(q2), quat_to_mat4(q2), tolerance));
+
+        vec3 v = vec3_create(random_unit(&seed) * 10.0f, random_unit(&seed) * 10.0f, random_unit(&seed) * 10.0f);
+        f32 w = (i & 1) ? 1.0f : 0.0f;
+        vec3 expected = vec3_transform_scalar(v, w, a);
+        vec3 actual = vec3_transform(v, w, a);
+        expect_to_be_true(vec4_close(vec4_from_vec3(expected, 0.0f), vec4_from_vec3(actual, 0.0f), tolerance));
+    }
+
+    // Частные случаи: единичная матрица и единичный кватернион.
+    mat4 identity = mat4_identity();
+    expect_to_be_true(mat4_close(identity, mat4_inverse(identity), 0.0f));
+    expect_to_be_true(mat4_close(identity, quat_to_mat4(quat_identity()), 0.0f));
+    expect_to_be_true(vec4_close(quat_identity(), quat_mul(quat_identity(), quat_identity()), 0.0f));
+    return true;
+}
+
+u8 kmath_test3()
+{
+    // Точные функции совпадают с платформенными.
+    u32 seed = 99;
+    for(u32 i = 0; i < 100000; ++i)
+    {
+        f32 x = random_unit(&seed) * 1e4f;
+        expect_to_be_true(ksqrt(kabs(x)) == platform_math_sqrt(platform_math_abs(x)));
+        expect_to_be_true(kfloor(x) == platform_math_floor(x));
+        expect_to_be_true(kceil(x) == platform_math_ceil(x));
+    }
+
+    f32 special[] = { -0.0f, 0.0f, -0.5f, 0.5f, -1.0f, 2.5f, 8388607.5f, -8388608.0f, 1e20f, K_INFINITY };
+    for(u32 i = 0; i < sizeof(special) / sizeof(f32); ++i)
+    {
+        expect_to_be_true(kfloor(special[i]) == platform_math_floor(special[i]));
+        expect_to_be_true(kceil(special[i]) == platform_math_ceil(special[i]));
+    }
+    expect_to_be_true(__builtin_signbit(kceil(-0.5f)) != 0);
+
+    // Приближения в пределах заявленной ошибки (с запасом на ошибку платформенных функций).
+    f32 sin_error = 0.0f;
+    f32 tan_error = 0.0f;
+    f32 atan_error = 0.0f;
+    f32 rsqrt_error = 0.0f;
+    for(u32 i = 0; i < 100000; ++i)
+    {
+        f32 angle = random_unit(&seed) * 1e4f;
+        sin_error = KMAX(sin_error, kabs(ksin_fast(angle) - platform_math_sin(angle)));
+        sin_error = KMAX(sin_error, kabs(kcos_fast(angle) - platform_math_cos(angle)));
+
+        f32 half_fov = random_unit(&seed) * 1.4f;
+        f32 tangent = platform_math_tan(half_fov);
+        tan_error = KMAX(tan_error, kabs(ktan_fast(half_fov) - tangent) / KMAX(kabs(tangent), 1e-3f));
+
+        f32 x = random_unit(&seed) * 100.0f;
+        atan_error = KMAX(atan_error, kabs(katan_fast(x) - platform_math_atan(x)));
+
+        f32 y = kabs(x) + 1e-3f;
+        f32 expected = 1.0f / platform_math_sqrt(y);
+        rsqrt_error = KMAX(rsqrt_error, kabs(krsqrt_fast(y) - expected) / expected);
+    }
+
+    kdebug(
+        "Approximation errors: sin/cos %e, tan (relative) %e, atan %e, rsqrt (relative) %e.",
+        sin_error, tan_error, atan_error, rsqrt_error
+    );
+    expect_to_be_true(sin_error < 2.5e-7f);
+    expect_to_be_true(tan_error < 1e-6f);
+    expect_to_be_true(atan_error < 2e-6f);
+    expect_to_be_true(rsqrt_error < 5e-6f);
+    expect_to_be_true(ksin_fast(0.0f) == 0.0f);
+    expect_to_be_true(katan_fast(0.0f) == 0.0f);
+
+    // Быстрые варианты функций совпадают с точными в пределах ошибки приближений.
+    for(u32 i = 0; i < SAMPLE_COUNT; ++i)
+    {
+        f32 x = random_unit(&seed) * K_PI;
+        f32 y = random_unit(&seed) * K_PI;
+        f32 z = random_unit(&seed) * K_PI;
+        expect_to_be_true(mat4_close(mat4_euler_xyz(x, y, z), mat4_euler_xyz_fast(x, y, z), 1e-6f));
+
+        vec3 axis = vec3_normalized(vec3_create(random_unit(&seed), random_unit(&seed), random_unit(&seed) + 2.0f));
+        expect_to_be_true(vec4_close(quat_from_axis_angle(axis, x, true), quat_from_axis_angle_fast(axis, x, true), 1e-6f));
+
+        mat4 m = random_transform(&seed);
+        expect_to_be_true(vec3_close(mat4_forward(m), mat4_forward_fast(m), 1e-5f));
+        expect_to_be_true(vec3_close(mat4_up(m), mat4_up_fast(m), 1e-5f));
+        expect_to_be_true(vec3_close(mat4_right(m), mat4_right_fast(m), 1e-5f));
+
+        f32 fov = 0.5f + 1.0f * (random_unit(&seed) + 1.0f);
+        expect_to_be_true(mat4_close(mat4_perspective(fov, 1.5f, 0.1f, 1000.0f), mat4_perspective_fast(fov, 1.5f, 0.1f, 1000.0f), 1e-5f));
+    }
+    return true;
+}
+
+#if KBENCHMARK_FLAG
+
+/*
+    @brief Выполняет выражение для всех образцов BENCHMARK_ROUNDS раз и возвращает время в миллисекундах.
+    NOTE: Выражение читает входные данные по индексу j (сдвигается каждый раунд) и сохраняет результат
+          по индексу i, чтобы вычисления не были удалены компилятором и не зависели друг от друга.
+*/
+#define BENCHMARK(...)                                           \
+    ({                                                           \
+        clock timer;                                             \
+        clock_start(&timer);                                     \
+        for(u32 round = 0; round < BENCHMARK_ROUNDS; ++round)    \
+        {                                                        \
+            for(u32 i = 0; i < SAMPLE_COUNT; ++i)                \
+            {                                                    \
+                u32 j = (i + round) & (SAMPLE_COUNT - 1);        \
+                __VA_ARGS__;                                     \
+            }                                                    \
+        }                                                        \
+        clock_update(&timer);                                    \
+        timer.elapsed * K_SEC_TO_MS_MULTIPLIER;                  \
+    })
+
+#define BENCHMARK_LOG(name, scalar_ms, simd_ms) \
+    kinfor("  %-16s scalar %8.3f ms, simd %8.3f ms (x%.2f)", name, scalar_ms, simd_ms, (scalar_ms) / (simd_ms))
+
+#define BENCHMARK_VARIANTS_LOG(name, precise_ms, fast_ms) \
+    kinfor("  %-20s precise %8.3f ms, fast %8.3f ms (x%.2f)", name, precise_ms, fast_ms, (precise_ms) / (fast_ms))
+
+// Результаты измерений (глобальные, чтобы компилятор не удалил их сохранение).
+static mat4 out_matrices[SAMPLE_COUNT];
+static quat out_quats[SAMPLE_COUNT];
+static vec3 out_vectors[SAMPLE_COUNT];
+
+u8 kmath_test2()
+{
+    mat4 matrices[SAMPLE_COUNT];
+    quat quats[SAMPLE_COUNT];
+    vec3 vectors[SAMPLE_COUNT];
+
+    u32 seed = 7;
+    for(u32 i = 0; i < SAMPLE_COUNT; ++i)
+    {
+        matrices[i] = random_transform(&seed);
+        quats[i] = random_quat(&seed);
+        vectors[i] = vec3_create(random_unit(&seed), random_unit(&seed), random_unit(&seed));
+    }
+
+    kinfor("kmath micro-benchmark (%u operations each):", SAMPLE_COUNT * BENCHMARK_ROUNDS);
+
+    f64 scalar_ms = BENCHMARK(out_matrices[i] = mat4_mul_scalar(matrices[j], matrices[i]));
+    f64 simd_ms = BENCHMARK(out_matrices[i] = mat4_mul(matrices[j], matrices[i]));
+    BENCHMARK_LOG("mat4_mul", scalar_ms, simd_ms);
+
+    scalar_ms = BENCHMARK(out_matrices[i] = mat4_inverse_scalar(matrices[j]));
+    simd_ms = BENCHMARK(out_matrices[i] = mat4_inverse(matrices[j]));
+    BENCHMARK_LOG("mat4_inverse", scalar_ms, simd_ms);
+
+    scalar_ms = BENCHMARK(out_quats[i] = quat_mul_scalar(quats[j], quats[i]));
+    simd_ms = BENCHMARK(out_quats[i] = quat_mul(quats[j], quats[i]));
+    BENCHMARK_LOG("quat_mul", scalar_ms, simd_ms);
+
+    scalar_ms = BENCHMARK(out_matrices[i] = quat_to_mat4_scalar(quats[j]));
+    simd_ms = BENCHMARK(out_matrices[i] = quat_to_mat4(quats[j]));
+    BENCHMARK_LOG("quat_to_mat4", scalar_ms, simd_ms);
+
+    scalar_ms = BENCHMARK(out_vectors[i] = vec3_transform_scalar(vectors[j], 1.0f, matrices[i]));
+    simd_ms = BENCHMARK(out_vectors[i] = vec3_transform(vectors[j], 1.0f, matrices[i]));
+    BENCHMARK_LOG("vec3_transform", scalar_ms, simd_ms);
+    return true;
+}
+
+u8 kmath_test4()
+{
+    vec3 vectors[SAMPLE_COUNT];
+    vec3 axes[SAMPLE_COUNT];
+    f32 angles[SAMPLE_COUNT];
+
+    u32 seed = 3;
+    for(u32 i = 0; i < SAMPLE_COUNT; ++i)
+    {
+        vectors[i] = vec3_create(random_unit(&seed) * 10.0f, random_unit(&seed) * 10.0f, random_unit(&seed) * 10.0f + 11.0f);
+        axes[i] = vec3_normalized(vec3_create(random_unit(&seed), random_unit(&seed), random_unit(&seed) + 2.0f));
+        angles[i] = random_unit(&seed) * K_2PI;
+    }
+
+    kinfor("kmath precise and fast variants (%u operations each):", SAMPLE_COUNT * BENCHMARK_ROUNDS);
+
+    // Прежняя реализация: вызов функции платформы из библиотеки.
+    f64 platform_ms = BENCHMARK(
+        vec3 v = vectors[j]; f32 length = platform_math_sqrt(vec3_length_squared(v));
+        out_vectors[i] = vec3_create(v.x / length, v.y / length, v.z / length)
+    );
+    f64 precise_ms = BENCHMARK(out_vectors[i] = vec3_normalized(vectors[j]));
+    f64 fast_ms = BENCHMARK(out_vectors[i] = vec3_normalized_fast(vectors[j]));
+    kinfor("  %-20s platform %8.3f ms, precise %8.3f ms, fast %8.3f ms", "vec3_normalized", platform_ms, precise_ms, fast_ms);
+
+    precise_ms = BENCHMARK(out_quats[i] = quat_from_axis_angle(axes[j], angles[j], true));
+    fast_ms = BENCHMARK(out_quats[i] = quat_from_axis_angle_fast(axes[j], angles[j], true));
+    BENCHMARK_VARIANTS_LOG("quat_from_axis_angle", precise_ms, fast_ms);
+
+    precise_ms = BENCHMARK(out_matrices[i] = mat4_euler_xyz(angles[j], angles[i], 0.5f * angles[j]));
+    fast_ms = BENCHMARK(out_matrices[i] = mat4_euler_xyz_fast(angles[j], angles[i], 0.5f * angles[j]));
+    BENCHMARK_VARIANTS_LOG("mat4_euler_xyz", precise_ms, fast_ms);
+
+    precise_ms = BENCHMARK(out_vectors[i] = mat4_forward(out_matrices[j]));
+    fast_ms = BENCHMARK(out_vectors[i] = mat4_forward_fast(out_matrices[j]));
+    BENCHMARK_VARIANTS_LOG("mat4_forward", precise_ms, fast_ms);
+
+    precise_ms = BENCHMARK(out_matrices[i] = mat4_perspective(1.0f + 0.1f * angles[j], 1.5f, 0.1f, 1000.0f));
+    fast_ms = BENCHMARK(out_matrices[i] = mat4_perspective_fast(1.0f + 0.1f * angles[j], 1.5f, 0.1f, 1000.0f));
+    BENCHMARK_VARIANTS_LOG("mat4_perspective", precise_ms, fast_ms);
+    return true;
+}
+
+#endif
+
+void kmath_register_tests()
+{
+    test_managet_register_test(kmath_test1, "SIMD math operations should match the scalar implementation.");
+    test_managet_register_test(kmath_test3, "Inline and fast math functions should stay within documented error.");
+#if KBENCHMARK_FLAG
+    test_managet_register_test(kmath_test2, "SIMD math micro-benchmark against the scalar implementation.");
+    test_managet_register_test(kmath_test4, "Precise and fast math variants micro-benchmark.");
+#endif
+}
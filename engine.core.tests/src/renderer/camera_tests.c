@@ -0,0 +1,150 @@
+#include "renderer/camera_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <renderer/camera.h>
+#include <math/kmath.h>
+#include <clock.h>
+#include <logger.h>
+
+#define BENCHMARK_FRAMES    10000
+#define BENCHMARK_CONSUMERS 8
+
+u8 camera_test1()
+{
+    camera c = camera_create();
+    camera_projection_set(&c, deg_to_rad(70.0f), 1.5f, 0.5f, 500.0f);
+    camera_position_set(&c, vec3_create(3.0f, -2.0f, 7.0f));
+    camera_rotation_euler_set(&c, vec3_create(-0.3f, 1.1f, 0.2f));
+
+    const camera_block* b = camera_block_get(&c);
+    expect_to_be_true(b != null);
+
+    // Прежний расчет матрицы вида полным обращением мировой матрицы.
+    mat4 world = mat4_mul(mat4_euler_xyz(-0.3f, 1.1f, 0.2f), mat4_translation(vec3_create(3.0f, -2.0f, 7.0f)));
+    mat4 view = mat4_inverse(world);
+    mat4 projection = mat4_perspective(deg_to_rad(70.0f), 1.5f, 0.5f, 500.0f);
+    mat4 view_projection = mat4_mul(view, projection);
+
+    expect_to_be_true(mat4_close(view, b->view, 1e-4f));
+    expect_to_be_true(mat4_close(world, b->inverse_view, 1e-4f));
+    expect_to_be_true(mat4_close(projection, b->projection, 1e-4f));
+    expect_to_be_true(mat4_close(view_projection, b->view_projection, 1e-4f));
+    expect_to_be_true(mat4_close(mat4_identity(), mat4_mul(b->view_projection, b->inverse_view_projection), 1e-4f));
+    expect_to_be_true(mat4_close(mat4_identity(), mat4_mul(b->projection, b->inverse_projection), 1e-4f));
+
+    expect_to_be_true(vec3_close(mat4_forward(view), b->forward, 1e-5f));
+    expect_to_be_true(vec3_close(mat4_right(view), b->right, 1e-5f));
+    expect_to_be_true(vec3_close(mat4_up(view), b->up, 1e-5f));
+    expect_to_be_true(vec3_close(vec3_create(3.0f, -2.0f, 7.0f), b->position, 1e-5f));
+
+    // Плоскости пирамиды видимости совпадают с построенными по матрице.
+    frustum f = frustum_from_view_projection(view_projection);
+    for(u32 i = 0; i < FRUSTUM_SIDES_MAX; ++i)
+    {
+        expect_to_be_true(vec3_close(f.sides[i].normal, b->frustum.sides[i].normal, 1e-5f));
+        // NOTE: Расстояние до дальней плоскости порядка far_clip, поэтому допуск относительный.
+        expect_to_be_true(float_close(f.sides[i].distance, b->frustum.sides[i].distance, 1e-5f));
+    }
+
+    // Точка перед камерой видна, позади нет.
+    vec3 ahead = vec3_add(b->position, vec3_mul_scalar(b->forward, 10.0f));
+    vec3 behind = vec3_sub(b->position, vec3_mul_scalar(b->forward, 10.0f));
+    expect_to_be_true(frustum_intersects_sphere(&b->frustum, &ahead, 0.1f));
+    expect_to_be_false(frustum_intersects_sphere(&b->frustum, &behind, 0.1f));
+
+    return true;
+}
+
+u8 camera_test2()
+{
+    camera c = camera_create();
+    const camera_block* b = camera_block_get(&c);
+    u64 generation = b->generation;
+
+    // Без изменений блок не пересчитывается.
+    expect_to_be_false(camera_update(&c));
+    camera_aspect_set(&c, c.aspect);
+    expect_to_be_false(camera_update(&c));
+    expect_should_be(generation, camera_block_get(&c)->generation);
+
+    // Перемещение вперед использует кэшированное направление.
+    camera_yaw(&c, 0.5f);
+    vec3 forward = camera_block_get(&c)->forward;
+    camera_move_forward(&c, 2.0f);
+    expect_to_be_true(vec3_close(vec3_mul_scalar(forward, 2.0f), camera_position_get(&c), 1e-5f));
+    expect_to_be_true(camera_update(&c));
+    expect_to_be_true(b->generation > generation);
+
+    // Изменение проекции пересчитывает блок без изменения матрицы вида.
+    mat4 view = b->view;
+    generation = b->generation;
+    camera_aspect_set(&c, 2.0f);
+    expect_to_be_true(camera_update(&c));
+    expect_should_be(generation + 1, b->generation);
+    expect_to_be_true(mat4_close(view, b->view, 1e-4f));
+    expect_to_be_true(mat4_close(mat4_perspective(c.fov, 2.0f, c.near_clip, c.far_clip), b->projection, 1e-4f));
+
+    return true;
+}
+
+#if KBENCHMARK_FLAG
+
+// Результат измерений (глобальный, чтобы компилятор не удалил вычисления).
+static volatile f32 benchmark_sink = 0.0f;
+
+u8 camera_test3()
+{
+    camera c = camera_create();
+    clock timer;
+
+    // Прежний способ: каждый потребитель сам строит вид, проекцию, их произведение и пирамиду видимости.
+    clock_start(&timer);
+    for(u32 frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+    {
+        camera_yaw(&c, 0.001f);
+        for(u32 i = 0; i < BENCHMARK_CONSUMERS; ++i)
+        {
+            mat4 world = mat4_mul(mat4_euler_xyz(c.euler_rotation.x, c.euler_rotation.y, c.euler_rotation.z), mat4_translation(c.position));
+            mat4 view = mat4_inverse(world);
+            mat4 projection = mat4_perspective(c.fov, c.aspect, c.near_clip, c.far_clip);
+            frustum f = frustum_from_view_projection(mat4_mul(view, projection));
+            benchmark_sink = f.sides[0].distance + mat4_forward(view).x;
+        }
+    }
+    clock_update(&timer);
+    f64 legacy_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    clock_start(&timer);
+    for(u32 frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+    {
+        camera_yaw(&c, 0.001f);
+        camera_update(&c);
+        for(u32 i = 0; i < BENCHMARK_CONSUMERS; ++i)
+        {
+            const camera_block* b = camera_block_get(&c);
+            benchmark_sink = b->frustum.sides[0].distance + b->forward.x;
+        }
+    }
+    clock_update(&timer);
+    f64 block_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    kinfor(
+        "Camera data (%u frames, %u consumers): per consumer %8.3f ms, camera block %8.3f ms (x%.2f)",
+        BENCHMARK_FRAMES, BENCHMARK_CONSUMERS, legacy_ms, block_ms, legacy_ms / block_ms
+    );
+
+    return true;
+}
+
+#endif
+
+void camera_register_tests()
+{
+    test_managet_register_test(camera_test1, "Camera block should match view, projection and frustum computed directly.");
+    test_managet_register_test(camera_test2, "Camera block should be recomputed only after camera changes.");
+#if KBENCHMARK_FLAG
+    test_managet_register_test(camera_test3, "Camera block micro-benchmark.");
+#endif
+}
@@ -0,0 +1,663 @@
+#include "resources/obj_parser_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <resources/loaders/obj_parser.h>
+#include <containers/darray.h>
+#include <memory/memory.h>
+#include <kstring.h>
+#include <platform/string.h>
+#include <platform/thread.h>
+#include <clock.h>
+#include <logger.h>
+
+#define FLOAT_LINE_COUNT      8192
+#define THREADED_VERTEX_COUNT 32768
+#define THREADED_FACE_COUNT   65536
+#define BENCHMARK_VERTEX_COUNT 65536
+#define BENCHMARK_FACE_COUNT   131072
+
+// @brief Текст, собираемый построчно (размер буфера задается заранее).
+typedef struct test_text {
+    char* data;
+    u64 length;
+    u64 capacity;
+} test_text;
+
+static void text_create(test_text* text, u64 capacity)
+{
+    text->data = kallocate(capacity, MEMORY_TAG_STRING);
+    text->length = 0;
+    text->capacity = capacity;
+}
+
+static void text_destroy(test_text* text)
+{
+    kfree(text->data, text->capacity, MEMORY_TAG_STRING);
+    kzero_tc(text, test_text, 1);
+}
+
+static void text_append(test_text* text, const char* str)
+{
+    u64 length = string_length(str);
+    if(text->length + length > text->capacity)
+    {
+        kfatal("Function '%s': Test text buffer is too small.", __FUNCTION__);
+        return;
+    }
+
+    kcopy(text->data + text->length, str, length);
+    text->length += length;
+}
+
+// Количество представимых f32 между значениями (0 - битовое совпадение).
+static u32 f32_ulp_distance(f32 a, f32 b)
+{
+    union { f32 f; i32 i; } ua = { a }, ub = { b };
+    i32 ia = ua.i < 0 ? (i32)0x80000000 - ua.i : ua.i;
+    i32 ib = ub.i < 0 ? (i32)0x80000000 - ub.i : ub.i;
+    return ia > ib ? (u32)(ia - ib) : (u32)(ib - ia);
+}
+
+// Число в виде текста: десятичная запись, запись с экспонентой, целое или произвольный битовый образ f32.
+static void random_float_token(u32* seed, u32 kind, char* out)
+{
+    switch(kind % 4)
+    {
+        case 0:
+            string_format(out, "%.6f", random_unit(seed) * 1000.0f);
+            break;
+        case 1:
+            string_format(out, "%e", random_unit(seed) * 1e-3f);
+            break;
+        case 2:
+            string_format(out, "%d", (i32)(random_unit(seed) * 100000.0f));
+            break;
+        default:
+        {
+            // Показатель степени 2 в [-60, 60], 9 значащих цифр однозначно задают значение f32.
+            *seed = *seed * 1664525U + 1013904223U;
+            u32 exponent = 67 + (*seed >> 8) % 121;
+            *seed = *seed * 1664525U + 1013904223U;
+            union { u32 i; f32 f; } bits = { (*seed & 0x80000000) | (exponent << 23) | ((*seed >> 4) & 0x7FFFFF) };
+            string_format(out, "%.9g", bits.f);
+            break;
+        }
+    }
+}
+
+u8 obj_parser_test1()
+{
+    // Особые записи, которые должен понимать разбор, в дополнение к случайным числам.
+    const char* special[] = {
+        "0", "-0", "+1.5", "1e5", "1E-5", ".5", "5.", "-.25", "0.000001", "1000000", "3.4028234e38", "1.17549435e-38",
+        "123456789012345678901234", "0.0000000000000000000001234", "-7.000000000000000000000001", "1e+3", "2.5e0"
+    };
+    const u32 special_count = sizeof(special) / sizeof(const char*);
+    const u32 value_count = (FLOAT_LINE_COUNT + special_count) * 3;
+
+    char (*tokens)[64] = kallocate(sizeof(char[64]) * value_count, MEMORY_TAG_STRING);
+    test_text text;
+    text_create(&text, (u64)value_count * 64 + FLOAT_LINE_COUNT * 4);
+
+    u32 seed = 2024;
+    for(u32 i = 0; i < value_count; ++i)
+    {
+        if(i < special_count * 3)
+        {
+            string_copy(tokens[i], special[(i / 3 + i % 3) % special_count]);
+        }
+        else
+        {
+            random_float_token(&seed, i / 3, tokens[i]);
+        }
+    }
+
+    // Разделители: пробелы, табуляция и завершающий '\r' (файлы Windows).
+    for(u32 i = 0; i < value_count; i += 3)
+    {
+        text_append(&text, "v ");
+        text_append(&text, tokens[i]);
+        text_append(&text, "\t");
+        text_append(&text, tokens[i + 1]);
+        text_append(&text, "  ");
+        text_append(&text, tokens[i + 2]);
+        text_append(&text, (i / 3) & 1 ? "\r\n" : "\n");
+    }
+
+    obj_data data;
+    expect_to_be_true(obj_parse_buffer(text.data, text.length, 1, &data));
+    expect_should_be(value_count / 3, data.position_count);
+
+    // Эталон - стандартный разбор (sscanf "%f", т.е. strtof).
+    u32 exact = 0;
+    u32 max_ulp = 0;
+    for(u32 i = 0; i < value_count; ++i)
+    {
+        f32 expected = 0;
+        expect_to_be_true(string_to_f32(tokens[i], &expected));
+
+        f32 actual = data.positions[i / 3].elements[i % 3];
+        u32 ulp = f32_ulp_distance(expected, actual);
+        if(ulp == 0)
+        {
+            exact++;
+        }
+        else if(ulp > max_ulp)
+        {
+            max_ulp = ulp;
+            kerror("--> Float '%s': expected %.9g, but got: %.9g (%u ulp).", tokens[i], expected, actual, ulp);
+        }
+    }
+
+    kdebug("Float parse: %u of %u values match strtof exactly, max error %u ulp.", exact, value_count, max_ulp);
+    expect_should_be(value_count, exact);
+
+    obj_data_free(&data);
+    text_destroy(&text);
+    kfree(tokens, sizeof(char[64]) * value_count, MEMORY_TAG_STRING);
+    return true;
+}
+
+static bool face_vertex_is(obj_data* data, u64 face, u32 vertex, u32 position, u32 texcoord, u32 normal)
+{
+    obj_vertex_index_data* v = &data->faces[face].vertices[vertex];
+    if(v->position_index != position || v->texcoord_index != texcoord || v->normal_index != normal)
+    {
+        kerror(
+            "--> Face %llu vertex %u: expected %u/%u/%u, but got: %u/%u/%u.", face, vertex, position, texcoord, normal,
+            v->position_index, v->texcoord_index, v->normal_index
+        );
+        return false;
+    }
+    return true;
+}
+
+u8 obj_parser_test2()
+{
+    // Формы лицевых поверхностей, относительные индексы и ключевые слова в разном регистре.
+    const char* source =
+        "# comment\n"
+        "MtlLib first.mtl second.mtl\n"
+        "V 0 0 0\n"
+        "v 1 0 0\n"
+        "  v 0 1 0\n"
+        "vt 0 0\n"
+        "VT 1 0\n"
+        "vt 0 1\n"
+        "Vn 0 0 1\n"
+        "f 1 2 3\n"
+        "f 1/1 2/2 3/3\n"
+        "USEMTL red\n"
+        "f 1/1/1 2/2/1 3/3/1\n"
+        "F 1//1 2//1 3//1\n"
+        "g ignored\n"
+        "v 0 0 1\n"
+        "vt 1 1\n"
+        "f -4/-4 -3/-3 -1/-1\n"
+        "usemtl  blue \r\n"
+        "f -1//-1 -2//-1 -3//-1";
+
+    obj_data data;
+    expect_to_be_true(obj_parse_buffer(source, string_length(source), 1, &data));
+
+    expect_should_be(4, data.position_count);
+    expect_should_be(4, data.texcoord_count);
+    expect_should_be(1, data.normal_count);
+    expect_should_be(6, data.face_count);
+    expect_to_be_true(string_equal("first.mtl", data.material_filename));
+    expect_float_to_be(1.0f, data.positions[3].z);
+    expect_float_to_be(1.0f, data.texcoords[1].x);
+
+    expect_to_be_true(face_vertex_is(&data, 0, 2, 3, 0, 0));
+    expect_to_be_true(face_vertex_is(&data, 1, 1, 2, 2, 0));
+    expect_to_be_true(face_vertex_is(&data, 2, 2, 3, 3, 1));
+    expect_to_be_true(face_vertex_is(&data, 3, 0, 1, 0, 1));
+
+    // Отрицательные индексы отсчитываются от количества элементов, объявленных до строки.
+    expect_to_be_true(face_vertex_is(&data, 4, 0, 1, 1, 0));
+    expect_to_be_true(face_vertex_is(&data, 4, 1, 2, 2, 0));
+    expect_to_be_true(face_vertex_is(&data, 4, 2, 4, 4, 0));
+    expect_to_be_true(face_vertex_is(&data, 5, 0, 4, 0, 1));
+    expect_to_be_true(face_vertex_is(&data, 5, 2, 2, 0, 1));
+
+    // Поверхности до первого 'usemtl' попадают в группу без материала.
+    expect_should_be(3, data.group_count);
+    expect_to_be_true(string_equal("", data.groups[0].material_name));
+    expect_should_be(0, data.groups[0].first_face);
+    expect_should_be(2, data.groups[0].face_count);
+    expect_to_be_true(string_equal("red", data.groups[1].material_name));
+    expect_should_be(2, data.groups[1].first_face);
+    expect_should_be(3, data.groups[1].face_count);
+    expect_to_be_true(string_equal("blue", data.groups[2].material_name));
+    expect_should_be(5, data.groups[2].first_face);
+    expect_should_be(1, data.groups[2].face_count);
+
+    obj_data_free(&data);
+
+    // Индексы за пределами элементов файла (в том числе нулевые и объявленные позже) отклоняются.
+    const char* invalid[] = {
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n",
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 0 1 2\n",
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nf -4 1 2\n",
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nf 1/2 2/1 3/1\n",
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1//1 2//1 3//1\n",
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2\n",
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4294967299\n"
+    };
+    kdebug("Note: The following 7 errors message are intentionally caused by this test.");
+    for(u32 i = 0; i < sizeof(invalid) / sizeof(const char*); ++i)
+    {
+        expect_to_be_false(obj_parse_buffer(invalid[i], string_length(invalid[i]), 1, &data));
+        expect_pointer_should_be(null, data.faces);
+    }
+
+    // Пустой текст.
+    expect_to_be_true(obj_parse_buffer(source, 0, 4, &data));
+    expect_should_be(0, data.position_count);
+    expect_should_be(0, data.face_count);
+    expect_should_be(1, data.group_count);
+    obj_data_free(&data);
+    return true;
+}
+
+/*
+    @brief Создает obj текст: вершины, текстурные координаты и нормали вперемешку с поверхностями, которые
+           ссылаются на них абсолютными и относительными индексами, и группы материалов.
+*/
+static void generate_obj(test_text* text, u32 vertex_count, u32 face_count, u32 seed)
+{
+    char line[256];
+    u32 declared = 0;
+    u32 faces_per_vertex = face_count / vertex_count;
+
+    text_append(text, "mtllib generated.mtl\n");
+
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        string_format(
+            line, "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn %.6f %.6f %.6f\n",
+            random_unit(&seed) * 100.0f, random_unit(&seed) * 100.0f, random_unit(&seed) * 100.0f,
+            random_unit(&seed) * 0.5f + 0.5f, random_unit(&seed) * 0.5f + 0.5f,
+            random_unit(&seed), random_unit(&seed), random_unit(&seed)
+        );
+        text_append(text, line);
+        declared++;
+
+        if(v % 5000 == 4999)
+        {
+            string_format(line, "usemtl material_%u\n", v / 5000);
+            text_append(text, line);
+        }
+
+        if(declared < 3) continue;
+
+        for(u32 f = 0; f < faces_per_vertex; ++f)
+        {
+            seed = seed * 1664525U + 1013904223U;
+            u32 a = 1 + (seed >> 8) % declared;
+            u32 b = 1 + (seed >> 4) % declared;
+            if(f & 1)
+            {
+                // Относительные индексы на последние объявленные элементы.
+                string_format(line, "f -1/-1/-1 -2/-2/-2 %u/%u/%u\n", a, a, b);
+            }
+            else
+            {
+                string_format(line, "f %u/%u/%u %u//%u %u/%u\n", a, b, a, b, a, declared, declared);
+            }
+            text_append(text, line);
+        }
+    }
+}
+
+static bool bytes_equal(const void* a, const void* b, u64 size)
+{
+    const u8* pa = a;
+    const u8* pb = b;
+    for(u64 i = 0; i < size; ++i)
+    {
+        if(pa[i] != pb[i]) return false;
+    }
+    return true;
+}
+
+static bool obj_data_equal(obj_data* a, obj_data* b)
+{
+    if(a->position_count != b->position_count || a->normal_count != b->normal_count || a->texcoord_count != b->texcoord_count
+    || a->face_count != b->face_count || a->group_count != b->group_count)
+    {
+        kerror("--> Element counts differ.");
+        return false;
+    }
+
+    if(!bytes_equal(a->positions, b->positions, sizeof(vec3) * a->position_count)
+    || !bytes_equal(a->normals, b->normals, sizeof(vec3) * a->normal_count)
+    || !bytes_equal(a->texcoords, b->texcoords, sizeof(vec2) * a->texcoord_count)
+    || !bytes_equal(a->faces, b->faces, sizeof(obj_face_data) * a->face_count))
+    {
+        kerror("--> Element data differs.");
+        return false;
+    }
+
+    for(u64 i = 0; i < a->group_count; ++i)
+    {
+        if(!string_equal(a->groups[i].material_name, b->groups[i].material_name)
+        || a->groups[i].first_face != b->groups[i].first_face || a->groups[i].face_count != b->groups[i].face_count)
+        {
+            kerror("--> Group %llu differs.", i);
+            return false;
+        }
+    }
+
+    return string_equal(a->material_filename, b->material_filename);
+}
+
+u8 obj_parser_test3()
+{
+    test_text text;
+    text_create(&text, MEBIBYTES(16));
+    generate_obj(&text, THREADED_VERTEX_COUNT, THREADED_FACE_COUNT, 77);
+
+    // NOTE: Текст должен делиться хотя бы на 4 части (см. OBJ_PARSER_MIN_CHUNK_SIZE).
+    expect_to_be_true(text.length > KIBIBYTES(256) * 4);
+
+    obj_data single;
+    expect_to_be_true(obj_parse_buffer(text.data, text.length, 1, &single));
+    expect_should_be(THREADED_VERTEX_COUNT, single.position_count);
+    expect_to_be_true(string_equal("generated.mtl", single.material_filename));
+
+    // Все индексы (в том числе относительные на границах частей) разрешены в допустимые значения.
+    for(u64 i = 0; i < single.face_count; ++i)
+    {
+        for(u32 v = 0; v < 3; ++v)
+        {
+            obj_vertex_index_data* index = &single.faces[i].vertices[v];
+            expect_to_be_true(index->position_index >= 1 && index->position_index <= single.position_count);
+            expect_to_be_true(index->texcoord_index <= single.texcoord_count);
+            expect_to_be_true(index->normal_index <= single.normal_count);
+        }
+    }
+
+    u32 thread_counts[] = { 2, 4, 7, 16 };
+    for(u32 i = 0; i < sizeof(thread_counts) / sizeof(u32); ++i)
+    {
+        obj_data threaded;
+        expect_to_be_true(obj_parse_buffer(text.data, text.length, thread_counts[i], &threaded));
+        expect_to_be_true(obj_data_equal(&single, &threaded));
+        obj_data_free(&threaded);
+    }
+
+    obj_data_free(&single);
+    text_destroy(&text);
+    return true;
+}
+
+// Запись эталонного объединения вершин: цепочка вершин позиции в порядке добавления.
+typedef struct reference_entry {
+    u32 vertex_index;
+    u32 next;
+} reference_entry;
+
+/*
+    @brief Эталонное объединение вершин (прежний алгоритм): перебор всех вершин позиции с vertex_3d_equal.
+    @return Количество вершин, индексы записываются в out_indices.
+*/
+static u32 reference_convert(obj_data* data, obj_group_data* group, u32* out_indices)
+{
+    u64 corner_count = group->face_count * 3;
+    vertex_3d* vertices = kallocate_tc(vertex_3d, corner_count, MEMORY_TAG_ARRAY);
+    reference_entry* entries = kallocate_tc(reference_entry, corner_count, MEMORY_TAG_ARRAY);
+    u32* first = kallocate_tc(u32, data->position_count, MEMORY_TAG_ARRAY);
+    kset_tc(first, u32, data->position_count, 0xFF);
+    u32 vertex_count = 0;
+
+    for(u64 c = 0; c < corner_count; ++c)
+    {
+        obj_vertex_index_data* index = &data->faces[group->first_face + c / 3].vertices[c % 3];
+        vertex_3d vertex;
+        vertex.position = data->positions[index->position_index - 1];
+        vertex.texcoord = index->texcoord_index ? data->texcoords[index->texcoord_index - 1] : vec2_zero();
+        vertex.normal = index->normal_index ? data->normals[index->normal_index - 1] : vec3_create(0, 0, 1);
+        vertex.color = vec4_one();
+        vertex.tangent = vec4_zero();
+
+        u32* link = &first[index->position_index - 1];
+        while(*link != INVALID_ID && !vertex_3d_equal(vertices[entries[*link].vertex_index], vertex))
+        {
+            link = &entries[*link].next;
+        }
+
+        if(*link == INVALID_ID)
+        {
+            vertices[vertex_count] = vertex;
+            entries[vertex_count].vertex_index = vertex_count;
+            entries[vertex_count].next = INVALID_ID;
+            *link = vertex_count++;
+        }
+
+        out_indices[c] = entries[*link].vertex_index;
+    }
+
+    kfree_tc(vertices, vertex_3d, corner_count, MEMORY_TAG_ARRAY);
+    kfree_tc(entries, reference_entry, corner_count, MEMORY_TAG_ARRAY);
+    kfree_tc(first, u32, data->position_count, MEMORY_TAG_ARRAY);
+    return vertex_count;
+}
+
+static void config_create(geometry_config* config)
+{
+    kzero_tc(config, geometry_config, 1);
+    config->vertices = darray_create(vertex_3d);
+    config->indices = darray_create(u32);
+}
+
+static void config_destroy(geometry_config* config)
+{
+    darray_destroy(config->vertices);
+    darray_destroy(config->indices);
+}
+
+u8 obj_parser_test5()
+{
+    // Квадрат из двух треугольников, нормали с разными индексами и равными значениями (в том числе -0 и 0).
+    const char* source =
+        "v -1 -1 0\nv 1 -1 0\nv 1 1 0\nv -1 1 2\nv -1 -1 0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "vn 0 0 1\nvn 0 0 1\nvn -0 0 1\nvn 0 1 0\n"
+        "usemtl quad\n"
+        "f 1/1/1 2/2/1 3/3/1\n"
+        "f 1/1/2 3/3/3 4/4/2\n"
+        "f 1/1/4 2/2/1 5/1/1\n"
+        "f 1/2/1 2//1 3/3/1\n";
+
+    obj_data data;
+    expect_to_be_true(obj_parse_buffer(source, string_length(source), 1, &data));
+
+    geometry_config config;
+    config_create(&config);
+    obj_group_convert(&data, &data.groups[1], &config);
+    expect_to_be_true(string_equal("quad", config.material_name));
+
+    // Равные по значению вершины объединяются, другая нормаль, текстурная координата или позиция дает новую вершину.
+    u32 expected_indices[] = { 0, 1, 2, 0, 2, 3, 4, 1, 5, 6, 7, 2 };
+    expect_should_be(8, darray_length(config.vertices));
+    expect_should_be(12, darray_length(config.indices));
+    u32* indices = config.indices;
+    for(u32 i = 0; i < 12; ++i)
+    {
+        expect_should_be(expected_indices[i], indices[i]);
+    }
+
+    vertex_3d* vertices = config.vertices;
+    expect_float_to_be(0.0f, vertices[7].texcoord.x);
+    expect_float_to_be(1.0f, vertices[7].normal.z);
+    expect_float_to_be(1.0f, vertices[7].color.w);
+    expect_to_be_true(vec3_close(vec3_create(-1.0f, -1.0f, 0.0f), config.extents.min, 0.0f));
+    expect_to_be_true(vec3_close(vec3_create(1.0f, 1.0f, 2.0f), config.extents.max, 0.0f));
+
+    config_destroy(&config);
+    obj_data_free(&data);
+
+    // Сгенерированная модель: результат совпадает с эталонным объединением вершин.
+    test_text text;
+    text_create(&text, MEBIBYTES(16));
+    generate_obj(&text, THREADED_VERTEX_COUNT, THREADED_FACE_COUNT, 5);
+
+    // NOTE: Повтор значений нормалей и текстурных координат под другими индексами.
+    text_append(&text, "vn 0 0 1\nvn -0 0 1\nvt 0.5 0.5\nvt 0.5 0.5\n");
+
+    expect_to_be_true(obj_parse_buffer(text.data, text.length, 0, &data));
+    for(u64 f = 0; f < data.face_count; f += 3)
+    {
+        data.faces[f].vertices[0].normal_index = (u32)data.normal_count - (f & 1);
+        data.faces[f].vertices[1].texcoord_index = (u32)data.texcoord_count - (f & 1);
+    }
+
+    for(u64 g = 0; g < data.group_count; ++g)
+    {
+        obj_group_data* group = &data.groups[g];
+        if(!group->face_count) continue;
+
+        u64 corner_count = group->face_count * 3;
+        u32* reference = kallocate_tc(u32, corner_count, MEMORY_TAG_ARRAY);
+        u32 reference_count = reference_convert(&data, group, reference);
+
+        config_create(&config);
+        obj_group_convert(&data, group, &config);
+        expect_should_be(reference_count, darray_length(config.vertices));
+        expect_should_be(corner_count, darray_length(config.indices));
+        expect_to_be_true(bytes_equal(reference, config.indices, sizeof(u32) * corner_count));
+
+        config_destroy(&config);
+        kfree_tc(reference, u32, corner_count, MEMORY_TAG_ARRAY);
+    }
+
+    obj_data_free(&data);
+    text_destroy(&text);
+    return true;
+}
+
+#if KBENCHMARK_FLAG
+
+// Копия прежнего построчного разбора (sscanf и darray) для сравнения.
+typedef struct legacy_face {
+    i32 indices[9];
+} legacy_face;
+
+static void legacy_parse(const char* text, u64 size, vec3** positions, vec2** texcoords, vec3** normals, legacy_face** faces)
+{
+    char bufferline[512];
+    const char* end = text + size;
+
+    while(text < end)
+    {
+        u64 length = 0;
+        while(text + length < end && text[length] != '\n' && length < 511) length++;
+        kcopy(bufferline, text, length);
+        bufferline[length] = '\0';
+        text += length + 1;
+
+        if(length < 1 || bufferline[0] == '#')
+        {
+            continue;
+        }
+
+        if(string_nequali(bufferline, "v ", 2))
+        {
+            vec3 pos;
+            string_to_vec3(&bufferline[2], &pos);
+            darray_push(*positions, pos);
+        }
+        else if(string_nequali(bufferline, "vt ", 3))
+        {
+            vec2 tex;
+            string_to_vec2(&bufferline[3], &tex);
+            darray_push(*texcoords, tex);
+        }
+        else if(string_nequali(bufferline, "vn ", 3))
+        {
+            vec3 nor;
+            string_to_vec3(&bufferline[3], &nor);
+            darray_push(*normals, nor);
+        }
+        else if(string_nequali(bufferline, "f ", 2))
+        {
+            legacy_face face = {0};
+            platform_string_sscanf(
+                &bufferline[2], "%d/%d/%d %d/%d/%d %d/%d/%d",
+                &face.indices[0], &face.indices[1], &face.indices[2], &face.indices[3], &face.indices[4],
+                &face.indices[5], &face.indices[6], &face.indices[7], &face.indices[8]
+            );
+            darray_push(*faces, face);
+        }
+    }
+}
+
+u8 obj_parser_test4()
+{
+    test_text text;
+    text_create(&text, MEBIBYTES(32));
+    generate_obj(&text, BENCHMARK_VERTEX_COUNT, BENCHMARK_FACE_COUNT, 99);
+
+    clock timer;
+
+    vec3* positions = darray_create(vec3);
+    vec2* texcoords = darray_create(vec2);
+    vec3* normals = darray_create(vec3);
+    legacy_face* faces = darray_create(legacy_face);
+
+    clock_start(&timer);
+    legacy_parse(text.data, text.length, &positions, &texcoords, &normals, &faces);
+    clock_update(&timer);
+    f64 legacy_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    obj_data data;
+    clock_start(&timer);
+    expect_to_be_true(obj_parse_buffer(text.data, text.length, 1, &data));
+    clock_update(&timer);
+    f64 single_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    // Результат совпадает с прежним разбором.
+    expect_should_be(darray_length(positions), data.position_count);
+    expect_should_be(darray_length(faces), data.face_count);
+    for(u64 i = 0; i < data.position_count; ++i)
+    {
+        expect_to_be_true(vec3_close(positions[i], data.positions[i], 1e-6f));
+    }
+    obj_data_free(&data);
+
+    clock_start(&timer);
+    expect_to_be_true(obj_parse_buffer(text.data, text.length, 0, &data));
+    clock_update(&timer);
+    f64 threaded_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+    obj_data_free(&data);
+
+    f64 megabytes = text.length / (f64)MEBIBYTES(1);
+    kinfor(
+        "OBJ parse (%.1f MiB): legacy %8.3f ms, 1 thread %8.3f ms (x%.2f), %u threads %8.3f ms (x%.2f)",
+        megabytes, legacy_ms, single_ms, legacy_ms / single_ms, platform_thread_processor_count(), threaded_ms,
+        legacy_ms / threaded_ms
+    );
+
+    darray_destroy(positions);
+    darray_destroy(texcoords);
+    darray_destroy(normals);
+    darray_destroy(faces);
+    text_destroy(&text);
+    return true;
+}
+
+#endif
+
+void obj_parser_register_tests()
+{
+    test_managet_register_test(obj_parser_test1, "OBJ parser should read floats as strtof does.");
+    test_managet_register_test(obj_parser_test2, "OBJ parser should resolve face forms, relative indices and keywords.");
+    test_managet_register_test(obj_parser_test3, "OBJ parser output should not depend on thread count.");
+    test_managet_register_test(obj_parser_test5, "OBJ group conversion should merge equal vertices of a position.");
+#if KBENCHMARK_FLAG
+    test_managet_register_test(obj_parser_test4, "OBJ parser micro-benchmark.");
+#endif
+}
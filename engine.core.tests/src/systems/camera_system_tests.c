@@ -0,0 +1,51 @@
+#include "systems/camera_system_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <systems/camera_system.h>
+#include <memory/memory.h>
+#include <logger.h>
+
+u8 camera_system_test1()
+{
+    camera_system_config config = { 8 };
+    u64 memory_requirement = 0;
+    camera_system_initialize(&memory_requirement, null, &config);
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(camera_system_initialize(&memory_requirement, memory, &config));
+    // Начало зоны тестов!
+
+    // Повторное получение по имени возвращает ту же камеру.
+    camera* first = camera_system_acquire("first");
+    expect_pointer_should_not_be(null, first);
+    expect_pointer_should_be(first, camera_system_acquire("first"));
+    camera_position_set(first, vec3_create(1.0f, 2.0f, 3.0f));
+
+    // Камера освобождается после последнего освобождения, слот занимает другая камера.
+    camera_system_release("first");
+    camera_system_release("first");
+    camera* second = camera_system_acquire("second");
+    expect_pointer_should_be(first, second);
+    expect_float_to_be(0.0f, camera_position_get(second).x);
+
+    // Повторное освобождение старого имени не затрагивает камеру в том же слоте.
+    kdebug("Note: The following warning is intentionally caused by this test.");
+    camera_system_release("first");
+    camera_position_set(second, vec3_create(4.0f, 0.0f, 0.0f));
+    expect_pointer_should_be(second, camera_system_acquire("second"));
+    expect_float_to_be(4.0f, camera_position_get(second).x);
+
+    camera* third = camera_system_acquire("third");
+    expect_pointer_should_not_be(null, third);
+    expect_pointer_should_not_be(second, third);
+
+    // Конец зоны тестов!
+    camera_system_shutdown();
+    kfree(memory, memory_requirement, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+void camera_system_register_tests()
+{
+    test_managet_register_test(camera_system_test1, "Camera system should not release a reused slot through a stale name.");
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void camera_system_register_tests();
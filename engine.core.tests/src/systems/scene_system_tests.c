@@ -0,0 +1,361 @@
+#include "systems/scene_system_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <systems/scene_system.h>
+#include <systems/transform_system.h>
+#include <math/bvh.h>
+#include <math/kmath.h>
+#include <memory/memory.h>
+#include <clock.h>
+#include <logger.h>
+
+#define MESH_COUNT          40
+#define QUERY_BUFFER_SIZE   256
+#define BENCHMARK_INSTANCES 50000
+#define BENCHMARK_FRAMES    100
+
+static void* transform_memory = null;
+static u64 transform_memory_requirement = 0;
+static void* scene_memory = null;
+static u64 scene_memory_requirement = 0;
+
+static bool systems_start(u32 max_mesh_count, u32 max_geometry_count)
+{
+    transform_system_config transform_config = { max_mesh_count * 2 };
+    transform_system_initialize(&transform_memory_requirement, null, &transform_config);
+    transform_memory = kallocate(transform_memory_requirement, MEMORY_TAG_ARRAY);
+    if(!transform_system_initialize(&transform_memory_requirement, transform_memory, &transform_config)) return false;
+
+    scene_system_config scene_config = { max_mesh_count, max_geometry_count };
+    scene_system_initialize(&scene_memory_requirement, null, &scene_config);
+    scene_memory = kallocate(scene_memory_requirement, MEMORY_TAG_ARRAY);
+    return scene_system_initialize(&scene_memory_requirement, scene_memory, &scene_config);
+}
+
+static void systems_stop()
+{
+    scene_system_shutdown();
+    transform_system_shutdown();
+    kfree(scene_memory, scene_memory_requirement, MEMORY_TAG_ARRAY);
+    kfree(transform_memory, transform_memory_requirement, MEMORY_TAG_ARRAY);
+    scene_memory = null;
+    transform_memory = null;
+}
+
+static void systems_update()
+{
+    transform_system_update();
+    scene_system_update();
+}
+
+static void geometry_setup(geometry* g, vec3 center, f32 half_size)
+{
+    kzero_tc(g, geometry, 1);
+    g->center = center;
+    g->extents.min = vec3_sub(center, vec3_create(half_size, half_size, half_size));
+    g->extents.max = vec3_add(center, vec3_create(half_size, half_size, half_size));
+}
+
+/*
+    Проверяет, что объекты иерархии соответствуют геометриям сеток: каждая геометрия найдена по своим
+    мировым границам, объект указывает на свою сетку, а общее количество объектов совпадает.
+*/
+static bool scene_items_valid(u32 expected_item_count)
+{
+    mesh_packet_data data;
+    scene_system_get_mesh_packet_data(&data);
+    if(!data.culling_tree || bvh_count(data.culling_tree) != expected_item_count) return false;
+
+    u32 items[QUERY_BUFFER_SIZE];
+    u32 item_count = 0;
+
+    for(u32 i = 0; i < data.mesh_count; ++i)
+    {
+        mesh* m = &data.meshes[i];
+        mat4 model = transform_system_get_world(m->transform);
+
+        for(u32 j = 0; j < m->geometry_count; ++j)
+        {
+            if(!m->geometries[j]) continue;
+            item_count++;
+
+            vec3 center = vec3_transform(m->geometries[j]->center, 1.0f, model);
+            extents_3d point = { center, center };
+            u32 count = bvh_query_aabb(data.culling_tree, point, items, QUERY_BUFFER_SIZE);
+
+            bool found = false;
+            for(u32 k = 0; k < count && k < QUERY_BUFFER_SIZE; ++k)
+            {
+                if(items[k] >= data.item_capacity) return false;
+                const mesh_packet_item* item = &data.items[items[k]];
+                if(!item->geometry || item->mesh_index >= data.mesh_count) return false;
+                found |= item->mesh_index == i && item->geometry == m->geometries[j];
+            }
+
+            if(!found)
+            {
+                kerror("--> Geometry %u of mesh %u not found by its bounds.", j, i);
+                return false;
+            }
+        }
+    }
+
+    return item_count == expected_item_count;
+}
+
+u8 scene_system_test1()
+{
+    // Узлов геометрий ровно на MESH_COUNT сеток, слотов сеток на одну больше.
+    expect_to_be_true(systems_start(MESH_COUNT + 1, MESH_COUNT / 2 * 5));
+    // Начало зоны тестов!
+
+    geometry geometries[4];
+    geometry_setup(&geometries[0], vec3_create(0.0f, 0.0f, 0.0f), 1.0f);
+    geometry_setup(&geometries[1], vec3_create(0.0f, 3.0f, 0.0f), 0.5f);
+    geometry_setup(&geometries[2], vec3_create(2.0f, 0.0f, 0.0f), 1.0f);
+    geometry_setup(&geometries[3], vec3_create(0.0f, 0.0f, 2.0f), 0.5f);
+
+    // Экземпляры используют общие массивы геометрий, отсутствующие геометрии пропускаются.
+    geometry* model_a[2] = { &geometries[0], &geometries[1] };
+    geometry* model_b[3] = { &geometries[2], null, &geometries[3] };
+
+    khandle handles[MESH_COUNT];
+    bool alive[MESH_COUNT];
+    u32 item_count = 0;
+
+    for(u32 i = 0; i < MESH_COUNT; ++i)
+    {
+        khandle t = transform_system_create(vec3_create(i * 10.0f, 0.0f, 0.0f), quat_identity(), vec3_one(), KHANDLE_INVALID);
+        handles[i] = (i & 1) ? scene_system_mesh_add(3, model_b, t) : scene_system_mesh_add(2, model_a, t);
+        expect_should_not_be(INVALID_ID, handles[i].index);
+        alive[i] = true;
+        item_count += 2;
+    }
+
+    // Узлы геометрий закончились.
+    khandle t = transform_system_create(vec3_zero(), quat_identity(), vec3_one(), KHANDLE_INVALID);
+    expect_should_be(INVALID_ID, scene_system_mesh_add(3, model_b, t).index);
+    transform_system_destroy(t);
+
+    systems_update();
+    expect_should_be(MESH_COUNT, scene_system_mesh_count());
+    expect_to_be_true(scene_items_valid(item_count));
+
+    // Удаление: последние сетки переносятся на место удаленных.
+    u32 removed[5] = { 0, 7, 39, 20, 38 };
+    for(u32 i = 0; i < 5; ++i)
+    {
+        expect_to_be_true(scene_system_mesh_remove(handles[removed[i]]));
+        expect_to_be_false(scene_system_mesh_remove(handles[removed[i]]));
+        expect_pointer_should_be(null, scene_system_mesh_get(handles[removed[i]]));
+        alive[removed[i]] = false;
+        item_count -= 2;
+    }
+    expect_should_be(MESH_COUNT - 5, scene_system_mesh_count());
+    expect_to_be_true(scene_items_valid(item_count));
+
+    for(u32 i = 0; i < MESH_COUNT; ++i)
+    {
+        if(!alive[i]) continue;
+        mesh* m = scene_system_mesh_get(handles[i]);
+        expect_pointer_should_not_be(null, m);
+        expect_float_to_be(i * 10.0f, transform_system_get_world(m->transform).data[12]);
+    }
+
+    // Перемещение обновляет границы после обновления систем.
+    mesh* moved = scene_system_mesh_get(handles[3]);
+    transform_system_translate(moved->transform, vec3_create(0.0f, 1000.0f, 0.0f));
+    systems_update();
+    expect_to_be_true(scene_items_valid(item_count));
+
+    mesh_packet_data data;
+    scene_system_get_mesh_packet_data(&data);
+    u32 items[QUERY_BUFFER_SIZE];
+    extents_3d region = { vec3_create(-1e4f, 900.0f, -1e4f), vec3_create(1e4f, 1100.0f, 1e4f) };
+    expect_should_be(2, bvh_query_aabb(data.culling_tree, region, items, QUERY_BUFFER_SIZE));
+    expect_pointer_should_be(scene_system_mesh_get(handles[3]), &data.meshes[data.items[items[0]].mesh_index]);
+
+    // Освободившиеся узлы используются повторно.
+    for(u32 i = 0; i < 5; ++i)
+    {
+        khandle t = transform_system_create(vec3_create(-50.0f, 0.0f, i * 10.0f), quat_identity(), vec3_one(), KHANDLE_INVALID);
+        expect_should_not_be(INVALID_ID, scene_system_mesh_add(2, model_a, t).index);
+        item_count += 2;
+    }
+    systems_update();
+    expect_to_be_true(scene_items_valid(item_count));
+
+    // Конец зоны тестов!
+    systems_stop();
+    return true;
+}
+
+// Проверяет, что объект присутствует в опубликованном списке изменений.
+static bool item_changed(const mesh_packet_data* data, u32 item)
+{
+    for(u32 i = 0; i < data->changed_item_count; ++i)
+    {
+        if(data->changed_items[i] == item) return true;
+    }
+    return false;
+}
+
+u8 scene_system_test2()
+{
+    expect_to_be_true(systems_start(8, 16));
+    // Начало зоны тестов!
+
+    geometry geometries[2];
+    geometry_setup(&geometries[0], vec3_zero(), 1.0f);
+    geometry_setup(&geometries[1], vec3_create(0.0f, 2.0f, 0.0f), 0.5f);
+    geometry* model[2] = { &geometries[0], &geometries[1] };
+
+    khandle a = scene_system_mesh_add(2, model, transform_system_create(vec3_zero(), quat_identity(), vec3_one(), KHANDLE_INVALID));
+    khandle b = scene_system_mesh_add(2, model, transform_system_create(vec3_create(5.0f, 0.0f, 0.0f), quat_identity(), vec3_one(), KHANDLE_INVALID));
+    systems_update();
+
+    // Добавленные объекты публикуются обновлением.
+    mesh_packet_data data;
+    scene_system_get_mesh_packet_data(&data);
+    u64 generation = data.generation;
+    expect_should_be(4, data.changed_item_count);
+
+    // Без изменений список пуст.
+    systems_update();
+    scene_system_get_mesh_packet_data(&data);
+    expect_should_be(generation + 1, data.generation);
+    expect_should_be(0, data.changed_item_count);
+
+    // Перемещение публикует объекты сетки один раз, матрица сетки обновляется.
+    mesh* mb = scene_system_mesh_get(b);
+    transform_system_translate(mb->transform, vec3_create(0.0f, 3.0f, 0.0f));
+    transform_system_translate(mb->transform, vec3_create(0.0f, 3.0f, 0.0f));
+    scene_system_mesh_set_dirty(b);
+    systems_update();
+    scene_system_get_mesh_packet_data(&data);
+    expect_should_be(2, data.changed_item_count);
+    u32 moved_item = data.changed_items[0];
+    expect_pointer_should_be(mb, &data.meshes[data.items[moved_item].mesh_index]);
+    expect_float_to_be(6.0f, data.mesh_models[data.items[moved_item].mesh_index].data[13]);
+
+    // Удаление: объекты публикуются с пустой геометрией, индексы перенесенной сетки обновляются.
+    expect_to_be_true(scene_system_mesh_remove(a));
+    systems_update();
+    scene_system_get_mesh_packet_data(&data);
+    expect_should_be(2, data.changed_item_count);
+    for(u32 i = 0; i < data.changed_item_count; ++i)
+    {
+        expect_pointer_should_be(null, data.items[data.changed_items[i]].geometry);
+    }
+    expect_should_be(0, data.items[moved_item].mesh_index);
+    expect_to_be_false(item_changed(&data, moved_item));
+
+    // Смена владельца объекта за одно обновление публикуется один раз.
+    expect_to_be_true(scene_system_mesh_remove(b));
+    scene_system_mesh_add(2, model, transform_system_create(vec3_zero(), quat_identity(), vec3_one(), KHANDLE_INVALID));
+    systems_update();
+    scene_system_get_mesh_packet_data(&data);
+    expect_should_be(2, data.changed_item_count);
+    expect_to_be_true(item_changed(&data, moved_item));
+    expect_pointer_should_not_be(null, data.items[moved_item].geometry);
+
+    // Конец зоны тестов!
+    systems_stop();
+    return true;
+}
+
+#if KBENCHMARK_FLAG
+
+u8 scene_system_test3()
+{
+    const u32 count = BENCHMARK_INSTANCES;
+    expect_to_be_true(systems_start(count, count * 2));
+
+    geometry geometries[2];
+    geometry_setup(&geometries[0], vec3_zero(), 1.0f);
+    geometry_setup(&geometries[1], vec3_create(0.0f, 2.0f, 0.0f), 0.5f);
+    geometry* model[2] = { &geometries[0], &geometries[1] };
+
+    khandle* handles = kallocate_tc(khandle, count, MEMORY_TAG_ARRAY);
+    u32* visible = kallocate_tc(u32, count * 2, MEMORY_TAG_ARRAY);
+    u32 seed = 5;
+    clock timer;
+
+    // Появление экземпляров.
+    clock_start(&timer);
+    for(u32 i = 0; i < count; ++i)
+    {
+        vec3 position = vec3_create(random_unit(&seed) * 1000.0f, random_unit(&seed) * 20.0f, random_unit(&seed) * 1000.0f);
+        khandle t = transform_system_create(position, quat_identity(), vec3_one(), KHANDLE_INVALID);
+        handles[i] = scene_system_mesh_add(2, model, t);
+    }
+    systems_update();
+    clock_update(&timer);
+    f64 spawn_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+    expect_should_be(count, scene_system_mesh_count());
+
+    // Кадры с перемещением 10% экземпляров и отсечением.
+    mat4 view_projection = mat4_mul(
+        mat4_look_at(vec3_create(0.0f, 50.0f, 0.0f), vec3_create(300.0f, 0.0f, 300.0f), vec3_up()),
+        mat4_perspective(deg_to_rad(60.0f), 16.0f / 9.0f, 0.1f, 500.0f)
+    );
+    frustum f = frustum_from_view_projection(view_projection);
+    mesh_packet_data data;
+    u32 visible_count = 0;
+
+    clock_start(&timer);
+    for(u32 frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+    {
+        for(u32 i = frame % 10; i < count; i += 10)
+        {
+            mesh* m = scene_system_mesh_get(handles[i]);
+            transform_system_translate(m->transform, vec3_create(random_unit(&seed), 0.0f, random_unit(&seed)));
+        }
+        systems_update();
+
+        scene_system_get_mesh_packet_data(&data);
+        visible_count = bvh_query_frustum(data.culling_tree, &f, visible, count * 2);
+    }
+    clock_update(&timer);
+    f64 frames_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    // Удаление половины экземпляров и повторное появление.
+    clock_start(&timer);
+    for(u32 i = 0; i < count; i += 2)
+    {
+        scene_system_mesh_remove(handles[i]);
+    }
+    for(u32 i = 0; i < count; i += 2)
+    {
+        vec3 position = vec3_create(random_unit(&seed) * 1000.0f, random_unit(&seed) * 20.0f, random_unit(&seed) * 1000.0f);
+        khandle t = transform_system_create(position, quat_identity(), vec3_one(), KHANDLE_INVALID);
+        handles[i] = scene_system_mesh_add(2, model, t);
+    }
+    systems_update();
+    clock_update(&timer);
+    f64 respawn_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+    expect_should_be(count, scene_system_mesh_count());
+
+    kinfor(
+        "Scene (%u instances): spawn %8.3f ms, frame (10%% moved + cull, %u visible) %8.3f ms, respawn half %8.3f ms",
+        count, spawn_ms, visible_count, frames_ms / BENCHMARK_FRAMES, respawn_ms
+    );
+
+    kfree_tc(handles, khandle, count, MEMORY_TAG_ARRAY);
+    kfree_tc(visible, u32, count * 2, MEMORY_TAG_ARRAY);
+    systems_stop();
+    return true;
+}
+
+#endif
+
+void scene_system_register_tests()
+{
+    test_managet_register_test(scene_system_test1, "Scene system should keep culling items consistent across add, remove and move.");
+    test_managet_register_test(scene_system_test2, "Scene system should publish changed items once per update.");
+#if KBENCHMARK_FLAG
+    test_managet_register_test(scene_system_test3, "Scene system spawn and update micro-benchmark.");
+#endif
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void scene_system_register_tests();
@@ -0,0 +1,252 @@
+#include "systems/transform_system_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+#include "test_utils.h"
+
+#include <systems/transform_system.h>
+#include <math/transform.h>
+#include <math/kmath.h>
+#include <memory/memory.h>
+#include <clock.h>
+#include <logger.h>
+
+#define NODE_COUNT       64
+#define BENCHMARK_ROOTS  512
+#define BENCHMARK_DEPTH  8
+#define BENCHMARK_FRAMES 200
+
+static void* system_memory = null;
+static u64 system_memory_requirement = 0;
+
+static bool system_start(u32 max_transform_count)
+{
+    transform_system_config config = { max_transform_count };
+    transform_system_initialize(&system_memory_requirement, null, &config);
+    system_memory = kallocate(system_memory_requirement, MEMORY_TAG_ARRAY);
+    return transform_system_initialize(&system_memory_requirement, system_memory, &config);
+}
+
+static void system_stop()
+{
+    transform_system_shutdown();
+    kfree(system_memory, system_memory_requirement, MEMORY_TAG_ARRAY);
+    system_memory = null;
+}
+
+static bool mat4_equal(mat4 expected, mat4 actual)
+{
+    for(u32 i = 0; i < 16; ++i)
+    {
+        if(expected.data[i] != actual.data[i]) return false;
+    }
+    return true;
+}
+
+u8 transform_system_test1()
+{
+    expect_to_be_true(system_start(NODE_COUNT + 1));
+    // Начало зоны тестов!
+
+    // Случайная иерархия, продублированная в transform (рекурсивный расчет мировой матрицы).
+    transform legacy[NODE_COUNT + 1];
+    khandle handles[NODE_COUNT + 1];
+    bool alive[NODE_COUNT + 1];
+
+    u32 seed = 17;
+    for(u32 i = 0; i < NODE_COUNT; ++i)
+    {
+        vec3 position = vec3_create(random_unit(&seed) * 10.0f, random_unit(&seed) * 10.0f, random_unit(&seed) * 10.0f);
+        quat rotation = random_quat(&seed);
+        vec3 scale = vec3_create(1.0f + random_unit(&seed) * 0.5f, 1.0f + random_unit(&seed) * 0.5f, 1.0f + random_unit(&seed) * 0.5f);
+        u32 parent = (i % 7 == 0) ? INVALID_ID : (seed >> 8) % i;
+
+        legacy[i] = transform_from_position_rotation_scale(position, rotation, scale);
+        legacy[i].parent = parent == INVALID_ID ? null : &legacy[parent];
+        handles[i] = transform_system_create(position, rotation, scale, parent == INVALID_ID ? KHANDLE_INVALID : handles[parent]);
+        expect_to_be_true(transform_system_valid(handles[i]));
+        alive[i] = true;
+    }
+
+    // Создание корня после остальных и перенос под него поддерева (родитель оказывается после потомков).
+    u32 last = NODE_COUNT;
+    legacy[last] = transform_from_position(vec3_create(5.0f, -3.0f, 2.0f));
+    handles[last] = transform_system_create(vec3_create(5.0f, -3.0f, 2.0f), quat_identity(), vec3_one(), KHANDLE_INVALID);
+    alive[last] = true;
+
+    expect_to_be_true(transform_system_set_parent(handles[1], handles[last]));
+    legacy[1].parent = &legacy[last];
+    expect_should_be(last, transform_system_get_parent(handles[1]).index);
+
+    // Уничтожение узла с потомками: потомки становятся корневыми.
+    transform_system_destroy(handles[2]);
+    expect_to_be_false(transform_system_valid(handles[2]));
+    alive[2] = false;
+    for(u32 i = 0; i <= last; ++i)
+    {
+        if(legacy[i].parent == &legacy[2])
+        {
+            legacy[i].parent = null;
+            legacy[i].is_dirty = true;
+        }
+    }
+
+    for(u32 frame = 0; frame < 3; ++frame)
+    {
+        transform_system_update();
+
+        for(u32 i = 0; i <= last; ++i)
+        {
+            if(!alive[i]) continue;
+            expect_to_be_true(mat4_close(transform_get_world(&legacy[i]), transform_system_get_world(handles[i]), 1e-4f));
+        }
+
+        // Изменение части узлов к следующему кадру.
+        for(u32 i = frame; i <= last; i += 5)
+        {
+            if(!alive[i]) continue;
+            quat rotation = random_quat(&seed);
+            vec3 translation = vec3_create(random_unit(&seed), random_unit(&seed), random_unit(&seed));
+            transform_rotate(&legacy[i], rotation);
+            transform_translate(&legacy[i], translation);
+            transform_system_rotate(handles[i], rotation);
+            transform_system_translate(handles[i], translation);
+        }
+    }
+
+    // Освободившийся слот используется повторно, старый дескриптор остается недействительным.
+    khandle reused = transform_system_create(vec3_zero(), quat_identity(), vec3_one(), KHANDLE_INVALID);
+    expect_to_be_true(transform_system_valid(reused));
+    expect_should_be(handles[2].index, reused.index);
+    expect_to_be_false(transform_system_valid(handles[2]));
+
+    // Конец зоны тестов!
+    system_stop();
+    return true;
+}
+
+u8 transform_system_test2()
+{
+    expect_to_be_true(system_start(8));
+    // Начало зоны тестов!
+
+    khandle a = transform_system_create(vec3_zero(), quat_identity(), vec3_one(), KHANDLE_INVALID);
+    khandle b = transform_system_create(vec3_create(0.0f, 1.0f, 0.0f), quat_identity(), vec3_one(), a);
+    khandle c = transform_system_create(vec3_create(0.0f, 0.0f, 1.0f), quat_identity(), vec3_one(), b);
+    khandle d = transform_system_create(vec3_create(3.0f, 0.0f, 0.0f), quat_identity(), vec3_one(), KHANDLE_INVALID);
+    transform_system_update();
+
+    mat4 d_world = transform_system_get_world(d);
+    expect_float_to_be(1.0f, transform_system_get_world(c).data[13]);
+    expect_float_to_be(1.0f, transform_system_get_world(c).data[14]);
+
+    // Изменение корня обновляет всех потомков и не затрагивает другие поддеревья.
+    transform_system_translate(a, vec3_create(2.0f, 0.0f, 0.0f));
+    transform_system_update();
+    expect_float_to_be(2.0f, transform_system_get_world(b).data[12]);
+    expect_float_to_be(2.0f, transform_system_get_world(c).data[12]);
+    expect_to_be_true(mat4_equal(d_world, transform_system_get_world(d)));
+    expect_to_be_true(transform_system_is_world_changed(c));
+    expect_to_be_false(transform_system_is_world_changed(d));
+
+    // Циклы запрещены.
+    expect_to_be_false(transform_system_set_parent(a, c));
+    expect_to_be_false(transform_system_set_parent(a, a));
+
+    // Перенос в другое поддерево и отсоединение.
+    expect_to_be_true(transform_system_set_parent(b, d));
+    transform_system_update();
+    expect_float_to_be(3.0f, transform_system_get_world(c).data[12]);
+    expect_to_be_true(transform_system_set_parent(b, KHANDLE_INVALID));
+    transform_system_update();
+    expect_float_to_be(0.0f, transform_system_get_world(c).data[12]);
+    expect_should_be(INVALID_ID, transform_system_get_parent(b).index);
+
+    // Конец зоны тестов!
+    system_stop();
+    return true;
+}
+
+#if KBENCHMARK_FLAG
+
+u8 transform_system_test3()
+{
+    const u32 count = BENCHMARK_ROOTS * BENCHMARK_DEPTH;
+    expect_to_be_true(system_start(count));
+
+    transform* legacy = kallocate_tc(transform, count, MEMORY_TAG_ARRAY);
+    khandle* handles = kallocate_tc(khandle, count, MEMORY_TAG_ARRAY);
+    mat4* worlds = kallocate_tc(mat4, count, MEMORY_TAG_ARRAY);
+
+    // Цепочки глубиной BENCHMARK_DEPTH.
+    for(u32 i = 0; i < count; ++i)
+    {
+        bool root = (i % BENCHMARK_DEPTH) == 0;
+        vec3 position = vec3_create(0.0f, 1.0f, 0.0f);
+        legacy[i] = transform_from_position(position);
+        legacy[i].parent = root ? null : &legacy[i - 1];
+        handles[i] = transform_system_create(position, quat_identity(), vec3_one(), root ? KHANDLE_INVALID : handles[i - 1]);
+    }
+
+    quat rotation = quat_from_axis_angle(vec3_up(), 0.01f, false);
+    clock timer;
+
+    // Каждый кадр вращается каждый восьмой корень, мировые матрицы получаются для всех узлов.
+    clock_start(&timer);
+    for(u32 frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+    {
+        for(u32 r = frame & 7; r < BENCHMARK_ROOTS; r += 8)
+        {
+            transform_rotate(&legacy[r * BENCHMARK_DEPTH], rotation);
+        }
+        for(u32 i = 0; i < count; ++i)
+        {
+            worlds[i] = transform_get_world(&legacy[i]);
+        }
+    }
+    clock_update(&timer);
+    f64 legacy_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    clock_start(&timer);
+    for(u32 frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+    {
+        for(u32 r = frame & 7; r < BENCHMARK_ROOTS; r += 8)
+        {
+            transform_system_rotate(handles[r * BENCHMARK_DEPTH], rotation);
+        }
+        transform_system_update();
+        for(u32 i = 0; i < count; ++i)
+        {
+            worlds[i] = transform_system_get_world(handles[i]);
+        }
+    }
+    clock_update(&timer);
+    f64 system_ms = timer.elapsed * K_SEC_TO_MS_MULTIPLIER;
+
+    kinfor(
+        "Transform hierarchy (%u nodes, depth %u, %u frames): recursive %8.3f ms, system %8.3f ms (x%.2f)",
+        count, BENCHMARK_DEPTH, BENCHMARK_FRAMES, legacy_ms, system_ms, legacy_ms / system_ms
+    );
+
+    // Результаты совпадают.
+    for(u32 i = 0; i < count; ++i)
+    {
+        expect_to_be_true(mat4_close(transform_get_world(&legacy[i]), transform_system_get_world(handles[i]), 1e-4f));
+    }
+
+    kfree_tc(legacy, transform, count, MEMORY_TAG_ARRAY);
+    kfree_tc(handles, khandle, count, MEMORY_TAG_ARRAY);
+    kfree_tc(worlds, mat4, count, MEMORY_TAG_ARRAY);
+    system_stop();
+    return true;
+}
+
+#endif
+
+void transform_system_register_tests()
+{
+    test_managet_register_test(transform_system_test1, "Transform system should match recursive world matrices after reparent and destroy.");
+    test_managet_register_test(transform_system_test2, "Transform system should propagate changes only to dirty subtrees.");
+#if KBENCHMARK_FLAG
+    test_managet_register_test(transform_system_test3, "Transform hierarchy update micro-benchmark.");
+#endif
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void transform_system_register_tests();
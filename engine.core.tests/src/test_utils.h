@@ -0,0 +1,102 @@
+#pragma once
+
+#include <defines.h>
+#include <logger.h>
+#include <math/kmath.h>
+
+/*
+    @brief Возвращает псевдослучайное число в [-1, 1] (линейный конгруэнтный генератор).
+    @param seed Указатель на состояние генератора.
+*/
+KINLINE f32 random_unit(u32* seed)
+{
+    *seed = *seed * 1664525U + 1013904223U;
+    return ((*seed >> 8) / 8388607.5f) - 1.0f;
+}
+
+/*
+    @brief Возвращает псевдослучайное число в [0, 1] двойной точности (тот же генератор, что и random_unit).
+    @param seed Указатель на состояние генератора.
+*/
+KINLINE f64 random_fraction(u32* seed)
+{
+    *seed = *seed * 1664525U + 1013904223U;
+    return (*seed >> 8) / 16777215.0;
+}
+
+/*
+    @brief Возвращает псевдослучайный нормализованный кватернион.
+    @param seed Указатель на состояние генератора.
+*/
+KINLINE quat random_quat(u32* seed)
+{
+    return quat_normalize(vec4_create(random_unit(seed), random_unit(seed), random_unit(seed), random_unit(seed) + 1.5f));
+}
+
+/*
+    @brief Сравнивает значения с допуском, относительным к величине ожидаемого значения (не меньше 1).
+    @param expected Ожидаемое значение.
+    @param actual Фактическое значение.
+    @param tolerance Допуск.
+*/
+KINLINE bool float_close(f32 expected, f32 actual, f32 tolerance)
+{
+    return kabs(expected - actual) <= tolerance * KMAX(1.0f, kabs(expected));
+}
+
+/*
+    @brief Сравнивает векторы поэлементно с помощью float_close, первое расхождение пишется в журнал.
+    @param expected Ожидаемый вектор.
+    @param actual Фактический вектор.
+    @param tolerance Допуск.
+*/
+KINLINE bool vec3_close(vec3 expected, vec3 actual, f32 tolerance)
+{
+    for(u32 i = 0; i < 3; ++i)
+    {
+        if(!float_close(expected.elements[i], actual.elements[i], tolerance))
+        {
+            kerror("--> Vector element %u: expected %f, but got: %f.", i, expected.elements[i], actual.elements[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+    @brief Сравнивает векторы поэлементно с помощью float_close, первое расхождение пишется в журнал.
+    @param expected Ожидаемый вектор.
+    @param actual Фактический вектор.
+    @param tolerance Допуск.
+*/
+KINLINE bool vec4_close(vec4 expected, vec4 actual, f32 tolerance)
+{
+    for(u32 i = 0; i < 4; ++i)
+    {
+        if(!float_close(expected.elements[i], actual.elements[i], tolerance))
+        {
+            kerror("--> Vector element %u: expected %f, but got: %f.", i, expected.elements[i], actual.elements[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+    @brief Сравнивает матрицы поэлементно с помощью float_close, первое расхождение пишется в журнал.
+    @param expected Ожидаемая матрица.
+    @param actual Фактическая матрица.
+    @param tolerance Допуск.
+*/
+KINLINE bool mat4_close(mat4 expected, mat4 actual, f32 tolerance)
+{
+    for(u32 i = 0; i < 16; ++i)
+    {
+        if(!float_close(expected.data[i], actual.data[i], tolerance))
+        {
+            kerror("--> Matrix element %u: expected %f, but got: %f.", i, expected.data[i], actual.data[i]);
+            return false;
+        }
+    }
+    return true;
+}
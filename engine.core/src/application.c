@@ -6,9 +6,9 @@
 #include "event.h"
 #include "input.h"
 #include "clock.h"
+#include "frame_pacer.h"
+#include "frame_pipeline.h"
 #include "platform/window.h"
-#include "platform/time.h"
-#include "platform/thread.h"
 #include "memory/memory.h"
 #include "memory/allocators/linear_allocator.h"
 #include "renderer/renderer_frontend.h"
@@ -18,27 +18,50 @@
 #include "systems/resource_system.h"
 #include "systems/shader_system.h"
 #include "systems/camera_system.h"
+#include "systems/transform_system.h"
+#include "systems/scene_system.h"
 #include "systems/render_view_system.h"
 
 // TODO: Временный тестовый код: начало.
 #include "kstring.h"
 #include "math/kmath.h"
-#include "math/transform.h"
 #include "containers/darray.h"
+#include "debug/profiler.h"
 // TODO: Временный тестовый код: конец.
 
+// Количество представлений в пакете отрисовки.
+#define FRAME_VIEW_COUNT 2
+
+// @brief Данные кадра, передаваемые потоку отрисовки.
+typedef struct frame_slot {
+    render_packet packet;
+    render_view_packet views[FRAME_VIEW_COUNT];
+    // NOTE: Списки отрисовки представлений изменяются при построении следующего пакета,
+    //       поэтому кадр хранит их копии, неизменные до завершения его отрисовки.
+    geometry_render_data* geometries[FRAME_VIEW_COUNT];
+    u32 geometry_capacities[FRAME_VIEW_COUNT];
+} frame_slot;
+
 typedef struct application_state {
     game* game_inst;
     bool  is_running;
     bool  is_suspended;
     clock clock;
     f64   last_time;
+    frame_pacer pacer;
+    fixed_timestep timestep;
+    frame_pipeline* pipeline;
+    u64 pipeline_memory_requirement;
+    void* pipeline_memory;
 
     linear_allocator* systems_allocator;
 
     u64 event_system_memory_requirement;
     void* event_system_state;
 
+    u64 profiler_system_memory_requirement;
+    void* profiler_system_state;
+
     u64 input_system_memory_requirement;
     void* input_system_state;
 
@@ -69,12 +92,18 @@ typedef struct application_state {
     u64 camera_system_memory_requirement;
     void* camera_system_state;
 
-    // TODO: Временный тестовый код: начало.
-    u32 world_mesh_count;
-    mesh world_meshes[10];
+    u64 transform_system_memory_requirement;
+    void* transform_system_state;
+
+    u64 scene_system_memory_requirement;
+    void* scene_system_state;
 
-    u32 ui_mesh_count;
-    mesh ui_meshes[10];
+    // TODO: Временный тестовый код: начало.
+    khandle cube_mesh;
+    // Поворот куба на предыдущем и текущем шагах обновления (для интерполяции при отрисовке).
+    quat cube_rotation_previous;
+    quat cube_rotation_current;
+    mesh* ui_meshes; // darray
     // TODO: Временный тестовый код: конец.
 
 } application_state;
@@ -100,10 +129,14 @@ bool event_on_debug_event(event_code code, void* sender, void* listener_inst, ev
     choice++;
     choice %= 3;
 
-    geometry* g = app_state->world_meshes[0].geometries[0];
+    mesh* cube_mesh = scene_system_mesh_get(app_state->cube_mesh);
+    geometry* g = cube_mesh ? cube_mesh->geometries[0] : null;
 
     if(g)
     {
+        // Материал геометрии читается записываемым кадром, смена выполняется между кадрами.
+        renderer_resources_lock();
+
         g->material = material_system_acquire(names[choice]);
 
         if(!g->material)
@@ -113,10 +146,46 @@ bool event_on_debug_event(event_code code, void* sender, void* listener_inst, ev
         }
 
         material_system_release(old_name);
+
+        renderer_resources_unlock();
+
+        // Смена материала может изменить прозрачность, списки отрисовки должны быть исправлены.
+        scene_system_mesh_set_dirty(app_state->cube_mesh);
     }
 
     return true;
 }
+
+khandle test_mesh_load(const char* name, vec3 position)
+{
+    resource mesh_resource = {};
+    if(!resource_system_load(name, RESOURCE_TYPE_MESH, &mesh_resource))
+    {
+        kerror("Failed to load '%s' test mesh.", name);
+        return KHANDLE_INVALID;
+    }
+
+    geometry_config* configs = mesh_resource.data;
+    u16 geometry_count = mesh_resource.data_size; // Передается из mesh_loader.
+    geometry** geometries = kallocate_tc(geometry*, geometry_count, MEMORY_TAG_ARRAY);
+
+    for(u32 i = 0; i < geometry_count; ++i)
+    {
+        geometries[i] = geometry_system_acquire_from_config(&configs[i], true);
+    }
+
+    // NOTE: Очистка конфигурации происходит в загрузчике.
+    resource_system_unload(&mesh_resource);
+
+    khandle transform = transform_system_create(position, quat_identity(), vec3_one(), KHANDLE_INVALID);
+    khandle handle = scene_system_mesh_add(geometry_count, geometries, transform);
+    if(handle.index == INVALID_ID)
+    {
+        transform_system_destroy(transform);
+        kfree_tc(geometries, geometry*, geometry_count, MEMORY_TAG_ARRAY);
+    }
+    return handle;
+}
 // TODO: Временный тестовый код: конец.
 
 
@@ -161,6 +230,21 @@ bool application_create(game* game_inst)
     event_system_initialize(&app_state->event_system_memory_requirement, app_state->event_system_state);
     kinfor("Event system started.");
 
+#if KPROFILER_FLAG
+    // Система профилирования (после системы событий - сохранение трассировки по событию).
+    profiler_system_config profiler_sys_config;
+    profiler_sys_config.max_thread_count = 8;
+    profiler_sys_config.max_zone_count_per_thread = 16384;
+    profiler_system_initialize(&app_state->profiler_system_memory_requirement, null, &profiler_sys_config);
+    app_state->profiler_system_state = linear_allocator_allocate(app_state->systems_allocator, app_state->profiler_system_memory_requirement);
+    if(!profiler_system_initialize(&app_state->profiler_system_memory_requirement, app_state->profiler_system_state, &profiler_sys_config))
+    {
+        kerror("Failed to initialize profiler system. Aborted!");
+        return false;
+    }
+    kinfor("Profiler system started.");
+#endif
+
     // TODO: Отвязать от системы событий! и перенести!
     // Система ввода (должно быть инициализировано до создания окна приложения, но после системы событий - связаны).
     input_system_initialize(&app_state->input_system_memory_requirement, null);
@@ -173,6 +257,7 @@ bool application_create(game* game_inst)
     window_sys_config.title = game_inst->window_title;
     window_sys_config.width = game_inst->window_width;
     window_sys_config.height = game_inst->window_height;
+    window_sys_config.use_event_thread = game_inst->window_event_thread;
     platform_window_create(&app_state->platform_window_memory_requirement, null, null);
     app_state->platform_window_state = linear_allocator_allocate(app_state->systems_allocator, app_state->platform_window_memory_requirement);
     if(!platform_window_create(&app_state->platform_window_memory_requirement, app_state->platform_window_state, &window_sys_config))
@@ -219,9 +304,14 @@ bool application_create(game* game_inst)
     kinfor("Shader system started.");
 
     // Система визуализатора графики.
+    renderer_system_config renderer_sys_config;
+    renderer_sys_config.window_state = app_state->platform_window_state;
+    renderer_sys_config.geometry_compaction = true;
+    renderer_sys_config.geometry_compaction_threshold = 0.5f;
+    renderer_sys_config.geometry_compaction_bytes_per_frame = MEBIBYTES(4);
     renderer_system_initialize(&app_state->renderer_system_memory_requirement, null, null);
     app_state->renderer_system_state = linear_allocator_allocate(app_state->systems_allocator, app_state->renderer_system_memory_requirement);
-    if(!renderer_system_initialize(&app_state->renderer_system_memory_requirement, app_state->renderer_system_state, app_state->platform_window_state))
+    if(!renderer_system_initialize(&app_state->renderer_system_memory_requirement, app_state->renderer_system_state, &renderer_sys_config))
     {
         kerror("Failed to initialize renderer system. Aborted!");
         return false;
@@ -274,6 +364,29 @@ bool application_create(game* game_inst)
     }
     kinfor("Camera system started.");
 
+    transform_system_config transform_sys_config;
+    transform_sys_config.max_transform_count = 65536;
+    transform_system_initialize(&app_state->transform_system_memory_requirement, null, &transform_sys_config);
+    app_state->transform_system_state = linear_allocator_allocate(app_state->systems_allocator, app_state->transform_system_memory_requirement);
+    if(!transform_system_initialize(&app_state->transform_system_memory_requirement, app_state->transform_system_state, &transform_sys_config))
+    {
+        kerror("Failed to initialize transform system. Aborted!");
+        return false;
+    }
+    kinfor("Transform system started.");
+
+    scene_system_config scene_sys_config;
+    scene_sys_config.max_mesh_count = 65536;
+    scene_sys_config.max_geometry_count = 131072;
+    scene_system_initialize(&app_state->scene_system_memory_requirement, null, &scene_sys_config);
+    app_state->scene_system_state = linear_allocator_allocate(app_state->systems_allocator, app_state->scene_system_memory_requirement);
+    if(!scene_system_initialize(&app_state->scene_system_memory_requirement, app_state->scene_system_state, &scene_sys_config))
+    {
+        kerror("Failed to initialize scene system. Aborted!");
+        return false;
+    }
+    kinfor("Scene system started.");
+
     render_view_system_config render_view_sys_config;
     render_view_sys_config.max_view_count = 251;
     render_view_system_initialize(&app_state->render_view_system_memory_requirement, null, &render_view_sys_config);
@@ -318,70 +431,21 @@ bool application_create(game* game_inst)
     }
 
     // TODO: Временный тестовый код: начало.
-    app_state->world_mesh_count = 0;
-    app_state->ui_mesh_count = 0;
+    app_state->ui_meshes = darray_create(mesh);
 
     // Первый куб.
-    mesh* cube_mesh = &app_state->world_meshes[app_state->world_mesh_count];
-    cube_mesh->geometry_count = 1;
-    cube_mesh->geometries = kallocate_tc(geometry*, cube_mesh->geometry_count, MEMORY_TAG_ARRAY);
+    geometry** cube_geometries = kallocate_tc(geometry*, 1, MEMORY_TAG_ARRAY);
     geometry_config g_config = geometry_system_generate_cube_config(10.0f, 10.0f, 10.0f, 1.0f, 1.0f, "test_cube", "test_material");
-    cube_mesh->geometries[0] = geometry_system_acquire_from_config(&g_config, true);
-    cube_mesh->transform = transform_create();
+    cube_geometries[0] = geometry_system_acquire_from_config(&g_config, true);
     geometry_system_config_dispose(&g_config);
-    app_state->world_mesh_count++;
+    khandle cube_transform = transform_system_create(vec3_zero(), quat_identity(), vec3_one(), KHANDLE_INVALID);
+    app_state->cube_mesh = scene_system_mesh_add(1, cube_geometries, cube_transform);
+    app_state->cube_rotation_previous = quat_identity();
+    app_state->cube_rotation_current = quat_identity();
 
-    // Машина.
-    mesh* car_mesh = &app_state->world_meshes[app_state->world_mesh_count];
-    resource car_mesh_resource = {};
-    if(!resource_system_load("falcon", RESOURCE_TYPE_MESH, &car_mesh_resource))
-    {
-        kerror("Failed to load car test mesh.");
-    }
-    else
-    {
-        geometry_config* configs = car_mesh_resource.data;
-        car_mesh->geometry_count = car_mesh_resource.data_size; // Передается из mesh_loader.
-        car_mesh->geometries = kallocate_tc(geometry*, car_mesh->geometry_count, MEMORY_TAG_ARRAY);
-
-        for(u32 i = 0; i < car_mesh->geometry_count; ++i)
-        {
-            geometry_config* cfg = &configs[i];
-            car_mesh->geometries[i] = geometry_system_acquire_from_config(cfg, true);
-        }
-
-        car_mesh->transform = transform_from_position(vec3_create(20.0f, 0.0f, 0.0f));
-
-        // NOTE: Очистка конфигурации происходит в загрузчике.
-        resource_system_unload(&car_mesh_resource);
-        app_state->world_mesh_count++;
-    }
-
-    // Sponza.
-    mesh* sponza_mesh = &app_state->world_meshes[app_state->world_mesh_count];
-    resource sponza_mesh_resource = {};
-    if(!resource_system_load("sponza", RESOURCE_TYPE_MESH, &sponza_mesh_resource))
-    {
-        kerror("Failed to load sponza test mesh.");
-    }
-    else
-    {
-        geometry_config* configs = sponza_mesh_resource.data;
-        sponza_mesh->geometry_count = sponza_mesh_resource.data_size; // Передается из mesh_loader.
-        sponza_mesh->geometries = kallocate_tc(geometry*, sponza_mesh->geometry_count, MEMORY_TAG_ARRAY);
-
-        for(u32 i = 0; i < sponza_mesh->geometry_count; ++i)
-        {
-            geometry_config* cfg = &configs[i];
-            sponza_mesh->geometries[i] = geometry_system_acquire_from_config(cfg, true);
-        }
-
-        sponza_mesh->transform = transform_from_position(vec3_create(0.0f, 0.0f, 0.0f));
-
-        // NOTE: Очистка конфигурации происходит в загрузчике.
-        resource_system_unload(&sponza_mesh_resource);
-        app_state->world_mesh_count++;
-    }
+    // Машина и Sponza.
+    test_mesh_load("falcon", vec3_create(20.0f, 0.0f, 0.0f));
+    test_mesh_load("sponza", vec3_zero());
 
     // UI геометрия.
     geometry_config ui_config;
@@ -420,15 +484,15 @@ bool application_create(game* game_inst)
     u32 uiindices[6] = {2, 1, 0, 3, 0, 1};
     ui_config.indices = uiindices;
 
-    mesh* ui_mesh = &app_state->ui_meshes[app_state->ui_mesh_count];
-    ui_mesh->geometry_count = 1;
-    ui_mesh->geometries = kallocate_tc(geometry*, ui_mesh->geometry_count, MEMORY_TAG_ARRAY);
-    for(u32 i = 0; i < ui_mesh->geometry_count; ++i)
+    mesh ui_mesh;
+    ui_mesh.geometry_count = 1;
+    ui_mesh.geometries = kallocate_tc(geometry*, ui_mesh.geometry_count, MEMORY_TAG_ARRAY);
+    for(u32 i = 0; i < ui_mesh.geometry_count; ++i)
     {
-        ui_mesh->geometries[i] = geometry_system_acquire_from_config(&ui_config, true);
+        ui_mesh.geometries[i] = geometry_system_acquire_from_config(&ui_config, true);
     }
-    ui_mesh->transform = transform_create();
-    app_state->ui_mesh_count++;
+    ui_mesh.transform = transform_system_create(vec3_zero(), quat_identity(), vec3_one(), KHANDLE_INVALID);
+    darray_push(app_state->ui_meshes, ui_mesh);
 
     event_register(EVENT_CODE_DEBUG_0, null, event_on_debug_event);
     // TODO: Временный тестовый код: конец.
@@ -450,6 +514,78 @@ bool application_create(game* game_inst)
     return true;
 }
 
+// Отрисовывает кадр в потоке отрисовки.
+static bool application_frame_render(void* slot, void* user_data)
+{
+    frame_slot* frame = slot;
+    return renderer_draw_frame(&frame->packet);
+}
+
+// Копирует список отрисовки представления в данные кадра.
+static void application_frame_view_copy(frame_slot* frame, u32 index)
+{
+    render_view_packet* view = &frame->views[index];
+
+    if(view->geometry_count > frame->geometry_capacities[index])
+    {
+        if(frame->geometries[index])
+        {
+            kfree_tc(frame->geometries[index], geometry_render_data, frame->geometry_capacities[index], MEMORY_TAG_RENDERER);
+        }
+        frame->geometry_capacities[index] = KMAX(view->geometry_count, frame->geometry_capacities[index] * 2);
+        frame->geometries[index] = kallocate_tc(geometry_render_data, frame->geometry_capacities[index], MEMORY_TAG_RENDERER);
+    }
+
+    if(view->geometry_count)
+    {
+        kcopy_tc(frame->geometries[index], view->geometries, geometry_render_data, view->geometry_count);
+    }
+    view->geometries = frame->geometries[index];
+}
+
+static bool application_pipeline_create()
+{
+    frame_pipeline_config config;
+    config.slot_size = sizeof(frame_slot);
+    config.consume = application_frame_render;
+    config.user_data = null;
+    config.threaded = app_state->game_inst->frame_pipelining;
+
+    frame_pipeline_create(&config, &app_state->pipeline_memory_requirement, null);
+    app_state->pipeline_memory = kallocate(app_state->pipeline_memory_requirement, MEMORY_TAG_APPLICATION);
+    app_state->pipeline = frame_pipeline_create(&config, &app_state->pipeline_memory_requirement, app_state->pipeline_memory);
+    if(!app_state->pipeline)
+    {
+        kfree(app_state->pipeline_memory, app_state->pipeline_memory_requirement, MEMORY_TAG_APPLICATION);
+        app_state->pipeline_memory = null;
+        return false;
+    }
+    return true;
+}
+
+static void application_pipeline_destroy()
+{
+    if(!app_state->pipeline) return;
+
+    frame_pipeline_destroy(app_state->pipeline);
+
+    for(u32 i = 0; i < FRAME_PIPELINE_SLOT_COUNT; ++i)
+    {
+        frame_slot* frame = frame_pipeline_slot_get(app_state->pipeline, i);
+        for(u32 v = 0; v < FRAME_VIEW_COUNT; ++v)
+        {
+            if(frame->geometries[v])
+            {
+                kfree_tc(frame->geometries[v], geometry_render_data, frame->geometry_capacities[v], MEMORY_TAG_RENDERER);
+            }
+        }
+    }
+
+    kfree(app_state->pipeline_memory, app_state->pipeline_memory_requirement, MEMORY_TAG_APPLICATION);
+    app_state->pipeline_memory = null;
+    app_state->pipeline = null;
+}
+
 bool application_run()
 {
     if(!app_state)
@@ -459,21 +595,32 @@ bool application_run()
     }
 
     app_state->is_running = true;
+    bool run_result = true;
 
     clock_start(&app_state->clock);
     clock_update(&app_state->clock);
     app_state->last_time = app_state->clock.elapsed;
 
-    f64 running_time     = 0;
-    u16 frame_count      = 0;
-    f64 frame_limit_time = 1.0f / 60; // TODO: сделать настраиваемым!
+    frame_pacer_create(&app_state->pacer, app_state->game_inst->frame_rate_limit);
+    fixed_timestep_create(&app_state->timestep, app_state->game_inst->update_rate, app_state->game_inst->max_update_steps);
 
-    // TODO: Временный тестовый код: начало.
-    render_view_packet views[2];
-    // TODO: Временный тестовый код: конец.
+    if(!application_pipeline_create())
+    {
+        kerror("Failed to create frame pipeline. Aborted!");
+        return false;
+    }
 
     while(app_state->is_running)
     {
+        KPROFILE_SCOPE("Frame");
+
+        // NOTE: Ожидание начала кадра перед опросом окна, чтобы ввод считывался
+        //       непосредственно перед обновлением игры, а не до ожидания.
+        {
+            KPROFILE_SCOPE("Frame pacer");
+            frame_pacer_wait(&app_state->pacer);
+        }
+
         if(!platform_window_dispatch(app_state->platform_window_state))
         {
             app_state->is_running = false;
@@ -485,17 +632,53 @@ bool application_run()
             clock_update(&app_state->clock);
             f64 current_time = app_state->clock.elapsed;
             f64 delta = current_time - app_state->last_time;
-            f64 frame_start_time = platform_time_absolute();
-            
-            if(!app_state->game_inst->update(app_state->game_inst, (f32)delta))
+
+            // NOTE: Состояние игры обновляется шагами фиксированной длительности независимо от частоты кадров.
+            f64 step = 0;
+            u32 step_count = fixed_timestep_advance(&app_state->timestep, delta, &step);
+
+            KPROFILE_BEGIN(game_update_zone, "Game update");
+            bool game_update_result = true;
+            for(u32 s = 0; s < step_count && game_update_result; ++s)
+            {
+                game_update_result = app_state->game_inst->update(app_state->game_inst, (f32)step);
+
+                // TODO: Временный тестовый код: начало.
+                quat rotation = quat_from_axis_angle(vec3_up(), 0.5f * step, false);
+                app_state->cube_rotation_previous = app_state->cube_rotation_current;
+                app_state->cube_rotation_current = quat_normalize(quat_mul(app_state->cube_rotation_current, rotation));
+                // TODO: Временный тестовый код: конец.
+
+                // NOTE: Нажатия обрабатываются первым шагом кадра, а без шагов сохраняются до следующего кадра.
+                input_system_update(step);
+            }
+            KPROFILE_END(game_update_zone);
+
+            if(!game_update_result)
             {
                 kerror("Game update failed, shutting down!");
                 app_state->is_running = false;
                 break;
             }
 
+            // NOTE: Отрисовывается состояние между двумя последними шагами с долей накопленного остатка времени.
+            f32 alpha = fixed_timestep_alpha(&app_state->timestep);
+
+            // TODO: Временный тестовый код: начало.
+            mesh* cube_mesh = scene_system_mesh_get(app_state->cube_mesh);
+            if(cube_mesh)
+            {
+                quat rotation = quat_slerp(app_state->cube_rotation_previous, app_state->cube_rotation_current, alpha);
+                transform_system_set_rotation(cube_mesh->transform, rotation);
+            }
+            // TODO: Временный тестовый код: конец.
+
             // Пользовательский рендер.
-            if(!app_state->game_inst->render(app_state->game_inst, (f32)delta))
+            KPROFILE_BEGIN(game_render_zone, "Game render");
+            bool game_render_result = app_state->game_inst->render(app_state->game_inst, (f32)delta, alpha);
+            KPROFILE_END(game_render_zone);
+
+            if(!game_render_result)
             {
                 kerror("Game render failed, shutting down!");
                 app_state->is_running = false;
@@ -503,100 +686,96 @@ bool application_run()
             }
 
             // TODO: Временный тестовый код: начало.
-            if(app_state->world_mesh_count > 0)
+            // Обновление мировых матриц, границ и данных камер перед построением пакетов.
+            transform_system_update();
+            scene_system_update();
+            camera_system_update();
+
+            // NOTE: Пакет кадра N+1 строится, пока поток отрисовки отрисовывает кадр N.
+            frame_slot* frame = frame_pipeline_acquire(app_state->pipeline);
+            if(!frame)
             {
-                quat rotation = quat_from_axis_angle(vec3_up(), 0.5f * delta, false);
-                transform_rotate(&app_state->world_meshes[0].transform, rotation);
+                app_state->is_running = false;
+                break;
             }
 
             // TODO: Реарганизовать.
-            render_packet packet = {};
-            packet.delta_time = (f32)delta;
-            packet.view_count = 2;
-            kzero_tc(views, render_view_packet, packet.view_count);
-            packet.views = views;
+            frame->packet.delta_time = (f32)delta;
+            frame->packet.view_count = FRAME_VIEW_COUNT;
+            frame->packet.views = frame->views;
+            kzero_tc(frame->views, render_view_packet, FRAME_VIEW_COUNT);
 
             // World.
-            mesh_packet_data world_mesh_data = {};
-            world_mesh_data.mesh_count = app_state->world_mesh_count;
-            world_mesh_data.meshes = app_state->world_meshes;
-            if(!render_view_system_build_packet(render_view_system_get("world_opaque"), &world_mesh_data, &packet.views[0]))
+            mesh_packet_data world_mesh_data;
+            scene_system_get_mesh_packet_data(&world_mesh_data);
+            bool build_result = render_view_system_build_packet(render_view_system_get("world_opaque"), &world_mesh_data, &frame->views[0]);
+            if(!build_result)
             {
                 kerror("Failed to build packet for view 'world_opaque'.");
-                return false;
             }
 
             // UI.
             mesh_packet_data ui_mesh_data = {};
-            ui_mesh_data.mesh_count = app_state->ui_mesh_count;
+            ui_mesh_data.mesh_count = darray_length(app_state->ui_meshes);
             ui_mesh_data.meshes = app_state->ui_meshes;
-            if(!render_view_system_build_packet(render_view_system_get("ui"), &ui_mesh_data, &packet.views[1]))
+            if(build_result && !render_view_system_build_packet(render_view_system_get("ui"), &ui_mesh_data, &frame->views[1]))
             {
                 kerror("Failed to build packet for view 'ui'.");
-                return false;
+                build_result = false;
             }
             // TODO: Временный тестовый код: конец.
 
-            if(!renderer_draw_frame(&packet))
+            if(!build_result)
             {
-                kerror("Renderer failed draw frame, shutting down!");
+                // NOTE: Незавершенный кадр отбрасывается при остановке конвейера в общем пути завершения.
+                run_result = false;
                 app_state->is_running = false;
                 break;
             }
 
-            // TODO: Временный тестовый код: начало.
-            // TODO: Знаю решение не очень, но пока без идей...
-            darray_destroy(views[0].geometries);
-            darray_destroy(views[1].geometries);
-            views[0].geometries = null;
-            views[1].geometries = null;
-            // TODO: Временный тестовый код: конец.
-
-            // Расчет времени кадра.
-            f64 frame_end_time = platform_time_absolute();
-            f64 frame_elapsed_time = frame_end_time - frame_start_time;
-            running_time += frame_elapsed_time;
-            f64 remaining_secounds = frame_limit_time - frame_elapsed_time;
-
-            if(remaining_secounds > 0)
+            for(u32 i = 0; i < FRAME_VIEW_COUNT; ++i)
             {
-                u64 remaining_ms = remaining_secounds * 1000;
-
-                // Если время еще не вышло, то возвращаем управление операционной системе!
-                // TODO: Вынести лимитер кадров в настройки приложения.
-                bool frame_limit_on = true;
-                if(remaining_ms > 0 && frame_limit_on)
-                {
-                    platform_thread_sleep(remaining_ms - 1);
-                }
-
-                frame_count++;
+                application_frame_view_copy(frame, i);
             }
+            frame_pipeline_submit(app_state->pipeline);
 
-            // NOTE: Устройства ввода последнее что должно обновляться в кадре!
-            input_system_update(delta);
+            if(frame_pipeline_failed(app_state->pipeline))
+            {
+                kerror("Renderer failed draw frame, shutting down!");
+                app_state->is_running = false;
+                break;
+            }
 
             app_state->last_time = current_time;
         }
     }
 
+    // NOTE: Поток отрисовки останавливается до освобождения используемых кадрами ресурсов.
+    application_pipeline_destroy();
+
     kfree(app_state->game_inst->state, app_state->game_inst->state_memory_requirement, MEMORY_TAG_GAME);
     kinfor("Game stopped.");
 
     // TODO: Временный тестовый код: начало.
-    kdebug("World meshes count: %u", app_state->world_mesh_count);
-    for(u32 i = 0; i < app_state->world_mesh_count; ++i)
+    // NOTE: Массивы геометрий тестовых сеток не общие, преобразования уничтожает система сцены.
+    mesh_packet_data world_mesh_data;
+    scene_system_get_mesh_packet_data(&world_mesh_data);
+    kdebug("World meshes count: %u", world_mesh_data.mesh_count);
+    for(u32 i = 0; i < world_mesh_data.mesh_count; ++i)
     {
-        kdebug("Mesh[%u]: get geometries is %u", i, app_state->world_meshes[i].geometry_count);
-        kfree_tc(app_state->world_meshes[i].geometries, geometry*, app_state->world_meshes[i].geometry_count, MEMORY_TAG_ARRAY);
+        kdebug("Mesh[%u]: get geometries is %u", i, world_mesh_data.meshes[i].geometry_count);
+        kfree_tc(world_mesh_data.meshes[i].geometries, geometry*, world_mesh_data.meshes[i].geometry_count, MEMORY_TAG_ARRAY);
     }
 
-    kdebug("UI meshes count: %u", app_state->ui_mesh_count);
-    for(u32 i = 0; i < app_state->ui_mesh_count; ++i)
+    u32 ui_mesh_count = darray_length(app_state->ui_meshes);
+    kdebug("UI meshes count: %u", ui_mesh_count);
+    for(u32 i = 0; i < ui_mesh_count; ++i)
     {
         kdebug("Mesh[%u]: get geometries is %u", i, app_state->ui_meshes[i].geometry_count);
         kfree_tc(app_state->ui_meshes[i].geometries, geometry*, app_state->ui_meshes[i].geometry_count, MEMORY_TAG_ARRAY);
+        transform_system_destroy(app_state->ui_meshes[i].transform);
     }
+    darray_destroy(app_state->ui_meshes);
     // TODO: Временный тестовый код: конецы.
 
     // NOTE: Что бы исключить нежелательные эффекты управление остановить первым!
@@ -606,6 +785,12 @@ bool application_run()
     render_view_system_shutdown();
     kinfor("Render view system stopped.");
 
+    scene_system_shutdown();
+    kinfor("Scene system stopped.");
+
+    transform_system_shutdown();
+    kinfor("Transform system stopped.");
+
     camera_system_shutdown();
     kinfor("Camera system stopped.");
 
@@ -630,6 +815,11 @@ bool application_run()
     platform_window_destroy(app_state->platform_window_state);
     kinfor("Platform window destroyed.");
 
+#if KPROFILER_FLAG
+    profiler_system_shutdown();
+    kinfor("Profiler system stopped.");
+#endif
+
     event_system_shutdown();
     kinfor("Event system stopped.");
 
@@ -644,6 +834,44 @@ bool application_run()
     memory_system_shutdown();
     kinfor("Memory system stopped.");
 
+    return run_result;
+}
+
+void application_render_wait_idle()
+{
+    if(!app_state)
+    {
+        kerror("Function '%s': Application context was not created. Call 'application_create' first.", __FUNCTION__);
+        return;
+    }
+
+    if(app_state->pipeline)
+    {
+        frame_pipeline_wait_idle(app_state->pipeline);
+    }
+}
+
+void application_frame_rate_limit_set(u32 target_fps)
+{
+    if(!app_state)
+    {
+        kerror("Function '%s': Application context was not created. Call 'application_create' first.", __FUNCTION__);
+        return;
+    }
+
+    app_state->game_inst->frame_rate_limit = target_fps;
+    frame_pacer_target_set(&app_state->pacer, target_fps);
+}
+
+bool application_frame_stats_get(frame_pacer_stats* out_stats)
+{
+    if(!app_state || !out_stats)
+    {
+        kerror("Function '%s' requires a created application and a valid pointer to out_stats.", __FUNCTION__);
+        return false;
+    }
+
+    frame_pacer_stats_get(&app_state->pacer, out_stats);
     return true;
 }
 
@@ -677,6 +905,10 @@ void application_on_keyboard_key(u32 keycode, bool pressed)
         const char* meminfo = memory_system_usage_str();
         kinfor(meminfo);
         string_free(meminfo);
+
+        const char* gpu_meminfo = renderer_memory_usage_str();
+        kinfor(gpu_meminfo);
+        string_free(gpu_meminfo);
     }
 
     input_update_keyboard_key(keycode, pressed);
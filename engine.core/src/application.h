@@ -1,6 +1,8 @@
 #pragma once
 
 #include <defines.h>
+#include <frame_pacer.h>
+#include <fixed_timestep.h>
 
 // @brief Конфигурация игры.
 typedef struct game {
@@ -10,12 +12,22 @@ typedef struct game {
     i32   window_width;
     // @brief Высота окна.
     i32   window_height;
+    // @brief Ограничение частоты кадров (0 - без ограничения).
+    u32   frame_rate_limit;
+    // @brief Частота обновления состояния игры в секунду (0 - одно обновление за кадр длительностью кадра).
+    u32   update_rate;
+    // @brief Максимальное количество обновлений за кадр для наверстывания после задержек.
+    u32   max_update_steps;
+    // @brief Отрисовка кадра в отдельном потоке одновременно с обновлением и построением следующего кадра.
+    bool  frame_pipelining;
+    // @brief Чтение событий устройств ввода окна в отдельном потоке.
+    bool  window_event_thread;
     // @brief Указатель на функцию инициализации игры.
     bool (*initialize)(struct game* inst);
-    // @brief Указатель на функцию обновления состояния игры.
+    // @brief Указатель на функцию обновления состояния игры (вызывается с шагом фиксированной длительности).
     bool (*update)(struct game* inst, f32 delta_time);
-    // @brief Указатель на функцию отрисовки игры.
-    bool (*render)(struct game* inst, f32 delta_time);
+    // @brief Указатель на функцию отрисовки игры (alpha - доля шага после последнего обновления для интерполяции).
+    bool (*render)(struct game* inst, f32 delta_time, f32 alpha);
     // @brief Указатель на функцию изменения размера окна игры.
     void (*on_resize)(struct game* inst, i32 width, i32 height);
     // @brief Требования к памяти в байтах (sizeof(game_state)).
@@ -38,3 +50,23 @@ KAPI bool application_create(game* game_inst);
     @return В случае успеха - true, в случае ошибок - false.
 */
 KAPI bool application_run();
+
+/*
+    @brief Ожидает завершения отрисовки всех отправленных кадров.
+    NOTE: Изменения ресурсов визуализатора синхронизируются с отрисовкой сами (см. renderer_resources_lock),
+          ожидание нужно только когда требуется завершение всех уже отправленных кадров.
+*/
+KAPI void application_render_wait_idle();
+
+/*
+    @brief Изменяет ограничение частоты кадров приложения (статистика кадров сбрасывается).
+    @param target_fps Целевая частота кадров, 0 - без ограничения.
+*/
+KAPI void application_frame_rate_limit_set(u32 target_fps);
+
+/*
+    @brief Получает статистику равномерности кадров с момента последнего изменения ограничения частоты кадров.
+    @param out_stats Указатель на структуру для сохранения статистики.
+    @return True в случае успеха, false если приложение не создано.
+*/
+KAPI bool application_frame_stats_get(frame_pacer_stats* out_stats);
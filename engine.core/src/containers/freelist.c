@@ -361,6 +361,23 @@ u64 freelist_block_capacity(freelist* list)
     return list->node_capacity;
 }
 
+u64 freelist_largest_free_block(freelist* list)
+{
+    if(!list || !list->nodes)
+    {
+        kerror("Function '%s' requires a valid pointer to list.", __FUNCTION__);
+        return 0;
+    }
+
+    u64 largest = 0;
+    for(freelist_node* node = list->head; node; node = node->next)
+    {
+        largest = KMAX(largest, node->size);
+    }
+
+    return largest;
+}
+
 static freelist_node* node_get(freelist* list)
 {
     // TODO: Что бы избавиться от флага, обновление можно вынести в отдельную функцию.
@@ -86,3 +86,12 @@ KAPI u64 freelist_block_count(freelist* list);
             или 0 при ошибках.
 */
 KAPI u64 freelist_block_capacity(freelist* list);
+
+/*
+    @brief Возвращает размер наибольшего блока свободной памяти.
+    NOTE: Вместе с freelist_free_space позволяет оценить фрагментацию: чем меньше наибольший блок
+          относительно всей свободной памяти, тем сильнее фрагментирован список.
+    @param list Указатель на экземпляр списка свободной памяти.
+    @return Размер наибольшего блока свободной памяти в байтах или 0 при ошибках.
+*/
+KAPI u64 freelist_largest_free_block(freelist* list);
@@ -0,0 +1,167 @@
+// Собственные подключения.
+#include "containers/handle_pool.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+
+/*
+    NOTE: Поколение слота увеличивается при каждом занятии и освобождении, поэтому у занятого слота
+          оно нечетное, а у свободного четное. Отдельный признак занятости не требуется.
+*/
+#define SLOT_ALIVE(generation) (((generation) & 1) != 0)
+
+struct handle_pool {
+    // Количество слотов.
+    u32 capacity;
+    // Количество свободных слотов (вершина стека).
+    u32 free_count;
+    // Поколения слотов.
+    u32* generations;
+    // Стек индексов свободных слотов.
+    u32* free_indices;
+};
+
+handle_pool* handle_pool_create(u32 capacity, u64* memory_requirement, void* memory)
+{
+    if(!capacity || capacity == INVALID_ID)
+    {
+        kerror("Function '%s' require a capacity greater than zero and less than INVALID_ID.", __FUNCTION__);
+        return null;
+    }
+
+    if(!memory_requirement)
+    {
+        kerror("Function '%s' requires a valid pointer to memory_requiremet to obtain requirements.", __FUNCTION__);
+        return null;
+    }
+
+    u64 array_requirement = sizeof(u32) * capacity;
+    *memory_requirement = sizeof(handle_pool) + array_requirement * 2;
+
+    if(!memory)
+    {
+        return null;
+    }
+
+    kzero(memory, *memory_requirement);
+    handle_pool* pool = memory;
+    pool->capacity = capacity;
+    pool->free_count = capacity;
+    pool->generations = POINTER_GET_OFFSET(pool, sizeof(handle_pool));
+    pool->free_indices = POINTER_GET_OFFSET(pool->generations, array_requirement);
+
+    // Стек заполняется в обратном порядке, чтобы первыми выдавались младшие индексы.
+    for(u32 i = 0; i < capacity; ++i)
+    {
+        pool->free_indices[i] = capacity - 1 - i;
+    }
+
+    return pool;
+}
+
+void handle_pool_destroy(handle_pool* pool)
+{
+    if(!pool)
+    {
+        kerror("Function '%s' requires a valid pointer to pool.", __FUNCTION__);
+        return;
+    }
+
+    kzero_tc(pool, handle_pool, 1);
+}
+
+bool handle_pool_acquire(handle_pool* pool, khandle* out_handle)
+{
+    if(!pool || !out_handle)
+    {
+        kerror("Function '%s' requires valid pointers to pool and out_handle.", __FUNCTION__);
+        return false;
+    }
+
+    if(!pool->free_count)
+    {
+        *out_handle = KHANDLE_INVALID;
+        return false;
+    }
+
+    u32 index = pool->free_indices[--pool->free_count];
+    u32 generation = pool->generations[index] + 1;
+
+    // Значение INVALID_ID нечетное и может появиться при переполнении, оно пропускается.
+    if(generation == INVALID_ID)
+    {
+        generation += 2;
+    }
+
+    pool->generations[index] = generation;
+    out_handle->index = index;
+    out_handle->generation = generation;
+    return true;
+}
+
+bool handle_pool_release(handle_pool* pool, khandle handle)
+{
+    if(!handle_pool_valid(pool, handle))
+    {
+        kwarng("Function '%s': Tried to release stale or invalid handle (index %u).", __FUNCTION__, handle.index);
+        return false;
+    }
+
+    pool->generations[handle.index]++;
+    pool->free_indices[pool->free_count++] = handle.index;
+    return true;
+}
+
+bool handle_pool_valid(handle_pool* pool, khandle handle)
+{
+    if(!pool)
+    {
+        kerror("Function '%s' requires a valid pointer to pool.", __FUNCTION__);
+        return false;
+    }
+
+    return handle.index < pool->capacity && SLOT_ALIVE(handle.generation)
+        && pool->generations[handle.index] == handle.generation;
+}
+
+bool handle_pool_handle_get(handle_pool* pool, u32 index, khandle* out_handle)
+{
+    if(!pool || !out_handle)
+    {
+        kerror("Function '%s' requires valid pointers to pool and out_handle.", __FUNCTION__);
+        return false;
+    }
+
+    if(index >= pool->capacity || !SLOT_ALIVE(pool->generations[index]))
+    {
+        *out_handle = KHANDLE_INVALID;
+        return false;
+    }
+
+    out_handle->index = index;
+    out_handle->generation = pool->generations[index];
+    return true;
+}
+
+u32 handle_pool_count(handle_pool* pool)
+{
+    if(!pool)
+    {
+        kerror("Function '%s' requires a valid pointer to pool.", __FUNCTION__);
+        return 0;
+    }
+
+    return pool->capacity - pool->free_count;
+}
+
+u32 handle_pool_capacity(handle_pool* pool)
+{
+    if(!pool)
+    {
+        kerror("Function '%s' requires a valid pointer to pool.", __FUNCTION__);
+        return 0;
+    }
+
+    return pool->capacity;
+}
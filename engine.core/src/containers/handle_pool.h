@@ -0,0 +1,87 @@
+#pragma once
+
+#include <defines.h>
+
+/*
+    @brief Дескриптор элемента пула: индекс слота и поколение слота на момент получения.
+    NOTE: После освобождения слота его поколение изменяется, поэтому устаревший дескриптор
+          (освобожденный или указывающий на повторно занятый слот) определяется сравнением поколений.
+*/
+typedef struct khandle {
+    // @brief Индекс слота в массиве элементов.
+    u32 index;
+    // @brief Поколение слота.
+    u32 generation;
+} khandle;
+
+// @brief Недействительный дескриптор.
+#define KHANDLE_INVALID ((khandle){ INVALID_ID, INVALID_ID })
+
+// @brief Контекст пула дескрипторов.
+typedef struct handle_pool handle_pool;
+
+/*
+    @brief Создает пул дескрипторов или получает требования к пулу.
+    NOTE: Вызывается дважды, первый для получения требований и второй для создания пула.
+          Свободные слоты хранятся в стеке, поэтому получение и освобождение выполняются за O(1).
+    @param capacity Количество слотов пула.
+    @param memory_requirement Указатель для хранения требований к памяти.
+    @param memory Указатель выделенную память, или null для получения требований.
+    @return Указатель на экземпляр пула или null при получении требований или ошибках.
+*/
+KAPI handle_pool* handle_pool_create(u32 capacity, u64* memory_requirement, void* memory);
+
+/*
+    @brief Уничтожает пул дескрипторов.
+    NOTE: После использования в этой функции, указатель на пул нужно обнулить самостоятельно.
+    @param pool Указатель на экземпляр пула.
+*/
+KAPI void handle_pool_destroy(handle_pool* pool);
+
+/*
+    @brief Занимает свободный слот пула.
+    NOTE: Первыми выдаются слоты с меньшими индексами, освобожденные слоты используются повторно первыми.
+    @param pool Указатель на экземпляр пула.
+    @param out_handle Указатель для сохранения дескриптора занятого слота.
+    @return True если слот занят, false если свободных слотов нет или при ошибках.
+*/
+KAPI bool handle_pool_acquire(handle_pool* pool, khandle* out_handle);
+
+/*
+    @brief Освобождает слот пула, все дескрипторы этого слота становятся недействительными.
+    @param pool Указатель на экземпляр пула.
+    @param handle Дескриптор занятого слота.
+    @return True если слот освобожден, false если дескриптор недействителен.
+*/
+KAPI bool handle_pool_release(handle_pool* pool, khandle handle);
+
+/*
+    @brief Проверяет, что дескриптор указывает на занятый слот того же поколения.
+    @param pool Указатель на экземпляр пула.
+    @param handle Проверяемый дескриптор.
+    @return True если дескриптор действителен, false если устарел или при ошибках.
+*/
+KAPI bool handle_pool_valid(handle_pool* pool, khandle handle);
+
+/*
+    @brief Получает действительный дескриптор занятого слота по индексу.
+    @param pool Указатель на экземпляр пула.
+    @param index Индекс слота.
+    @param out_handle Указатель для сохранения дескриптора.
+    @return True если слот занят, false если свободен или индекс вне пула.
+*/
+KAPI bool handle_pool_handle_get(handle_pool* pool, u32 index, khandle* out_handle);
+
+/*
+    @brief Возвращает количество занятых слотов пула.
+    @param pool Указатель на экземпляр пула.
+    @return Количество занятых слотов или 0 при ошибках.
+*/
+KAPI u32 handle_pool_count(handle_pool* pool);
+
+/*
+    @brief Возвращает количество слотов пула.
+    @param pool Указатель на экземпляр пула.
+    @return Количество слотов или 0 при ошибках.
+*/
+KAPI u32 handle_pool_capacity(handle_pool* pool);
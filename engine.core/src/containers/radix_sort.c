@@ -0,0 +1,86 @@
+// Собственные подключения.
+#include "containers/radix_sort.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+
+#define RADIX_BITS    8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_MASK    (RADIX_BUCKETS - 1)
+#define RADIX_PASSES  (32 / RADIX_BITS)
+
+void radix_sort(u32 count, u32* keys, u32* indices, u32* scratch)
+{
+    if(count < 2)
+    {
+        return;
+    }
+
+    if(!keys || !indices || !scratch)
+    {
+        kerror("Function '%s' requires valid pointers to keys, indices and scratch buffer.", __FUNCTION__);
+        return;
+    }
+
+    // Гистограммы всех разрядов собираются за один проход.
+    u32 histograms[RADIX_PASSES][RADIX_BUCKETS];
+    kzero(histograms, sizeof(histograms));
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        u32 key = keys[i];
+        for(u32 pass = 0; pass < RADIX_PASSES; ++pass)
+        {
+            histograms[pass][(key >> (pass * RADIX_BITS)) & RADIX_MASK]++;
+        }
+    }
+
+    u32* src_keys = keys;
+    u32* src_indices = indices;
+    u32* dst_keys = scratch;
+    u32* dst_indices = scratch + count;
+
+    for(u32 pass = 0; pass < RADIX_PASSES; ++pass)
+    {
+        u32 shift = pass * RADIX_BITS;
+        u32* histogram = histograms[pass];
+
+        // Разряд одинаков у всех ключей: проход не меняет порядок.
+        if(histogram[(src_keys[0] >> shift) & RADIX_MASK] == count)
+        {
+            continue;
+        }
+
+        // Начальные позиции корзин.
+        u32 offset = 0;
+        for(u32 b = 0; b < RADIX_BUCKETS; ++b)
+        {
+            u32 bucket_count = histogram[b];
+            histogram[b] = offset;
+            offset += bucket_count;
+        }
+
+        for(u32 i = 0; i < count; ++i)
+        {
+            u32 key = src_keys[i];
+            u32 position = histogram[(key >> shift) & RADIX_MASK]++;
+            dst_keys[position] = key;
+            dst_indices[position] = src_indices[i];
+        }
+
+        u32* temp_keys = src_keys;
+        u32* temp_indices = src_indices;
+        src_keys = dst_keys;
+        src_indices = dst_indices;
+        dst_keys = temp_keys;
+        dst_indices = temp_indices;
+    }
+
+    // После нечетного количества проходов результат находится во временном буфере.
+    if(src_keys != keys)
+    {
+        kcopy_tc(keys, src_keys, u32, count);
+        kcopy_tc(indices, src_indices, u32, count);
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <defines.h>
+
+/*
+    @brief Преобразует число с плавающей точкой в ключ сортировки, сохраняющий порядок чисел.
+    NOTE: Для сортировки по убыванию используется инвертированный ключ (~ключ).
+    @param value Число с плавающей точкой (кроме NaN).
+    @return Беззнаковый ключ сортировки.
+*/
+KINLINE u32 radix_sort_key_f32(f32 value)
+{
+    union { f32 f; u32 u; } bits = { .f = value };
+    // Отрицательные числа инвертируются полностью, у положительных устанавливается знаковый бит.
+    return bits.u & 0x80000000 ? ~bits.u : bits.u | 0x80000000;
+}
+
+/*
+    @brief Устойчиво сортирует ключи по возрастанию поразрядной сортировкой, переставляя индексы вместе с ключами.
+    NOTE: Выполняется не более 4 проходов по 8 бит без сравнений и рекурсии, проходы по одинаковым у всех
+          ключей разрядам пропускаются. Сортируются только ключи и индексы, поэтому сами элементы
+          не перемещаются и после сортировки читаются через индексы.
+    @param count Количество ключей.
+    @param keys Массив ключей для сортировки.
+    @param indices Массив индексов элементов, переставляется вместе с ключами.
+    @param scratch Временный буфер размером не менее count * 2 элементов.
+*/
+KAPI void radix_sort(u32 count, u32* keys, u32* indices, u32* scratch);
@@ -0,0 +1,337 @@
+// Собственные подключения.
+#include "debug/profiler.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "event.h"
+#include "kstring.h"
+#include "memory/memory.h"
+#include "platform/file.h"
+
+// @brief Записанная зона профилирования.
+typedef struct profiler_zone_record {
+    const char* name;
+    u64 start_ns;
+    u64 end_ns;
+} profiler_zone_record;
+
+// @brief Кольцевой буфер зон одного потока.
+typedef struct profiler_thread_buffer {
+    // Указывает, что буфер закреплен за потоком (атомарно, освобождается при завершении потока).
+    bool is_active;
+    // Общее количество записанных зон, запись идет по модулю емкости (атомарно, пишет только поток-владелец).
+    u64 head;
+    // Количество зон, запись которых начата (атомарно, опережает head на время записи зоны).
+    u64 reserved;
+    // Кольцевой буфер зон.
+    profiler_zone_record* records;
+} profiler_thread_buffer;
+
+typedef struct profiler_system_state {
+    // Конфигурация системы.
+    profiler_system_config config;
+    // Время инициализации системы (начало трассировки).
+    u64 start_ns;
+    // Количество буферов, которые хотя бы раз были закреплены за потоками (атомарно).
+    u32 thread_count;
+    // Указывает, что о достижении ограничения количества потоков уже сообщено (атомарно).
+    bool thread_limit_reported;
+    // Массив буферов потоков.
+    profiler_thread_buffer* threads;
+} profiler_system_state;
+
+static profiler_system_state* state_ptr = null;
+
+// NOTE: Поколение системы защищает от использования буферов, закрепленных при предыдущей инициализации.
+static u32 system_generation = 0;
+static _Thread_local profiler_thread_buffer* thread_buffer = null;
+static _Thread_local u32 thread_buffer_generation = 0;
+
+static bool system_status_valid(const char* func_name)
+{
+    if(!state_ptr)
+    {
+        if(func_name)
+        {
+            kerror(
+                "Function '%s' requires the profiler system to be initialized. Call 'profiler_system_initialize' first.",
+                func_name
+            );
+        }
+        return false;
+    }
+    return true;
+}
+
+static bool profiler_on_event(event_code code, void* sender, void* listener_inst, event_context* context)
+{
+    if(code == EVENT_CODE_PROFILER_DUMP)
+    {
+        profiler_dump(PROFILER_DEFAULT_TRACE_PATH);
+        return true;
+    }
+    return false;
+}
+
+bool profiler_system_initialize(u64* memory_requirement, void* memory, profiler_system_config* config)
+{
+    if(state_ptr)
+    {
+        kwarng("Function '%s' was called more than once!", __FUNCTION__);
+        return false;
+    }
+
+    if(!memory_requirement || !config)
+    {
+        kerror("Function '%s' requires a valid pointers to memory_requirement and config.", __FUNCTION__);
+        return false;
+    }
+
+    if(!config->max_thread_count || !config->max_zone_count_per_thread)
+    {
+        kerror(
+            "Function '%s': config.max_thread_count and config.max_zone_count_per_thread must be greater then zero.",
+            __FUNCTION__
+        );
+        return false;
+    }
+
+    u64 state_requirement = sizeof(profiler_system_state);
+    u64 threads_requirement = sizeof(profiler_thread_buffer) * config->max_thread_count;
+    u64 records_requirement = sizeof(profiler_zone_record) * config->max_zone_count_per_thread;
+    *memory_requirement = state_requirement + threads_requirement + records_requirement * config->max_thread_count;
+
+    if(!memory)
+    {
+        return true;
+    }
+
+    kzero(memory, *memory_requirement);
+    state_ptr = memory;
+    state_ptr->config = *config;
+    state_ptr->threads = POINTER_GET_OFFSET(state_ptr, state_requirement);
+
+    void* records_block = POINTER_GET_OFFSET(state_ptr->threads, threads_requirement);
+    for(u32 i = 0; i < config->max_thread_count; ++i)
+    {
+        state_ptr->threads[i].records = POINTER_GET_OFFSET(records_block, records_requirement * i);
+    }
+
+    system_generation++;
+    state_ptr->start_ns = platform_time_absolute_ns();
+
+    event_register(EVENT_CODE_PROFILER_DUMP, null, profiler_on_event);
+    return true;
+}
+
+void profiler_system_shutdown()
+{
+    if(!system_status_valid(__FUNCTION__)) return;
+
+    event_unregister(EVENT_CODE_PROFILER_DUMP, null, profiler_on_event);
+    state_ptr = null;
+}
+
+static profiler_thread_buffer* thread_buffer_get()
+{
+    if(thread_buffer_generation == system_generation)
+    {
+        return thread_buffer;
+    }
+
+    // Первая зона потока: закрепление свободного буфера.
+    thread_buffer_generation = system_generation;
+    thread_buffer = null;
+
+    for(u32 i = 0; i < state_ptr->config.max_thread_count; ++i)
+    {
+        profiler_thread_buffer* buffer = &state_ptr->threads[i];
+        bool expected = false;
+        if(!__atomic_compare_exchange_n(&buffer->is_active, &expected, true, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            continue;
+        }
+
+        // NOTE: Освобожденный буфер продолжает кольцо предыдущего потока, его зоны сохраняются до перезаписи.
+        u32 used = __atomic_load_n(&state_ptr->thread_count, __ATOMIC_RELAXED);
+        while(used < i + 1 && !__atomic_compare_exchange_n(
+            &state_ptr->thread_count, &used, i + 1, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED
+        ));
+
+        thread_buffer = buffer;
+        return thread_buffer;
+    }
+
+    if(!__atomic_exchange_n(&state_ptr->thread_limit_reported, true, __ATOMIC_RELAXED))
+    {
+        kwarng(
+            "Function '%s': Profiler thread limit %u reached. Zones of threads without a free buffer are ignored.",
+            __FUNCTION__, state_ptr->config.max_thread_count
+        );
+    }
+    return null;
+}
+
+void profiler_thread_release()
+{
+    if(!state_ptr || thread_buffer_generation != system_generation)
+    {
+        return;
+    }
+
+    if(thread_buffer)
+    {
+        __atomic_store_n(&thread_buffer->is_active, false, __ATOMIC_RELEASE);
+    }
+
+    // Следующая зона потока закрепит буфер заново.
+    thread_buffer = null;
+    thread_buffer_generation = 0;
+}
+
+void profiler_zone_end(profiler_zone* zone)
+{
+    u64 end_ns = platform_time_absolute_ns();
+
+    if(!state_ptr || !zone) return;
+
+    profiler_thread_buffer* buffer = thread_buffer_get();
+    if(!buffer) return;
+
+    u64 head = buffer->head;
+
+    // Начало записи публикуется до изменения ячейки, чтобы сохранение могло отбросить перезаписанную копию.
+    __atomic_store_n(&buffer->reserved, head + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    profiler_zone_record* record = &buffer->records[head % state_ptr->config.max_zone_count_per_thread];
+    record->name = zone->name;
+    record->start_ns = zone->start_ns;
+    record->end_ns = end_ns;
+
+    // Публикация записи для потока, сохраняющего трассировку.
+    __atomic_store_n(&buffer->head, head + 1, __ATOMIC_RELEASE);
+}
+
+// @brief Буфер записи трассировки в файл частями.
+typedef struct trace_writer {
+    file* f;
+    char* data;
+    u64 size;
+    u64 capacity;
+    bool failed;
+} trace_writer;
+
+static void trace_writer_flush(trace_writer* writer)
+{
+    if(writer->size > 0 && !writer->failed)
+    {
+        writer->failed = !platform_file_write(writer->f, writer->size, writer->data);
+    }
+    writer->size = 0;
+}
+
+static void trace_writer_append(trace_writer* writer, const char* str, i32 length)
+{
+    if(length <= 0) return;
+
+    if(writer->size + length > writer->capacity)
+    {
+        trace_writer_flush(writer);
+    }
+
+    kcopy(writer->data + writer->size, str, length);
+    writer->size += length;
+}
+
+bool profiler_dump(const char* path)
+{
+    if(!system_status_valid(__FUNCTION__)) return false;
+
+    if(!path)
+    {
+        kerror("Function '%s' requires a valid pointer to path.", __FUNCTION__);
+        return false;
+    }
+
+    trace_writer writer = {};
+    if(!platform_file_open(path, FILE_MODE_WRITE, &writer.f))
+    {
+        kerror("Function '%s': Unable to open file '%s' for writing.", __FUNCTION__, path);
+        return false;
+    }
+
+    writer.capacity = KIBIBYTES(64);
+    writer.data = kallocate(writer.capacity, MEMORY_TAG_STRING);
+
+    char line[512];
+    i32 length = string_format(line, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    trace_writer_append(&writer, line, length);
+
+    u32 thread_count = KMIN(__atomic_load_n(&state_ptr->thread_count, __ATOMIC_ACQUIRE), state_ptr->config.max_thread_count);
+    u32 capacity = state_ptr->config.max_zone_count_per_thread;
+    u64 zone_count = 0;
+    bool first = true;
+
+    for(u32 t = 0; t < thread_count; ++t)
+    {
+        profiler_thread_buffer* buffer = &state_ptr->threads[t];
+
+        length = string_format(
+            line, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+            first ? "" : ",\n", t, t == 0 ? "Main" : "Thread", t
+        );
+        trace_writer_append(&writer, line, length);
+        first = false;
+
+        // NOTE: Зоны других потоков могут дописываться во время сохранения, сохраняются только опубликованные.
+        //       Запись копируется, после чего проверяется счетчик начатых записей: если поток-владелец
+        //       начал перезапись ее ячейки, копия отбрасывается.
+        u64 head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+        u64 count = KMIN(head, (u64)capacity);
+
+        for(u64 i = head - count; i < head; ++i)
+        {
+            profiler_zone_record record = buffer->records[i % capacity];
+
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            u64 reserved = __atomic_load_n(&buffer->reserved, __ATOMIC_RELAXED);
+            if(i + capacity < reserved)
+            {
+                continue;
+            }
+
+            if(!record.name || record.start_ns < state_ptr->start_ns)
+            {
+                continue;
+            }
+
+            // Время в микросекундах с дробной частью (требование формата).
+            u64 ts_ns = record.start_ns - state_ptr->start_ns;
+            u64 dur_ns = record.end_ns - record.start_ns;
+            length = string_format(
+                line, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03llu,\"dur\":%llu.%03llu}",
+                record.name, t, ts_ns / 1000, ts_ns % 1000, dur_ns / 1000, dur_ns % 1000
+            );
+            trace_writer_append(&writer, line, length);
+            zone_count++;
+        }
+    }
+
+    length = string_format(line, "\n]}\n");
+    trace_writer_append(&writer, line, length);
+    trace_writer_flush(&writer);
+
+    bool result = !writer.failed;
+    kfree(writer.data, writer.capacity, MEMORY_TAG_STRING);
+    platform_file_close(writer.f);
+
+    if(!result)
+    {
+        kerror("Function '%s': Failed to write trace to file '%s'.", __FUNCTION__, path);
+        return false;
+    }
+
+    kinfor("Profiler trace saved to '%s' (%llu zones, %u threads).", path, zone_count, thread_count);
+    return true;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <defines.h>
+#include <platform/time.h>
+
+// @brief Имя файла трассировки по умолчанию (при сохранении по событию).
+#define PROFILER_DEFAULT_TRACE_PATH "profile_trace.json"
+
+// @brief Конфигурация системы профилирования.
+typedef struct profiler_system_config {
+    // @brief Максимальное количество одновременно записывающих потоков (буферы освобождаются при
+    //        завершении потоков, созданных platform_thread_create; о превышении сообщается один раз).
+    u32 max_thread_count;
+    // @brief Размер кольцевого буфера зон одного потока (старые зоны перезаписываются).
+    u32 max_zone_count_per_thread;
+} profiler_system_config;
+
+// @brief Открытая зона профилирования.
+typedef struct profiler_zone {
+    // @brief Имя зоны (должно существовать все время работы системы, обычно строковый литерал).
+    const char* name;
+    // @brief Время начала зоны в наносекундах.
+    u64 start_ns;
+} profiler_zone;
+
+/*
+    @brief Инициализирует систему профилирования используя предоставленную конфигурацию.
+    NOTE: Вызывать дважды, первый раз для получения требований к памяти, второй для инициализации.
+    @param memory_requirement Указатель на переменную для сохранения требований системы к памяти в байтах.
+    @param memory Указатель на выделенный блок памяти, или null для получения требований.
+    @param config Конфигурация используемая для инициализации системы и получения требований к памяти.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool profiler_system_initialize(u64* memory_requirement, void* memory, profiler_system_config* config);
+
+/*
+    @brief Завершает работу системы профилирования.
+*/
+KAPI void profiler_system_shutdown();
+
+/*
+    @brief Открывает зону профилирования.
+    @param name Имя зоны (должно существовать все время работы системы, обычно строковый литерал).
+    @return Открытая зона профилирования.
+*/
+KINLINE profiler_zone profiler_zone_begin(const char* name)
+{
+    return (profiler_zone){ name, platform_time_absolute_ns() };
+}
+
+/*
+    @brief Закрывает зону профилирования и записывает ее в кольцевой буфер текущего потока.
+    NOTE: До инициализации системы вызов игнорируется.
+    @param zone Указатель на открытую зону профилирования.
+*/
+KAPI void profiler_zone_end(profiler_zone* zone);
+
+/*
+    @brief Освобождает буфер зон текущего потока для других потоков, записанные зоны сохраняются до перезаписи.
+    NOTE: Вызывается при завершении потоков, созданных platform_thread_create. Следующая зона потока
+          закрепит буфер заново.
+*/
+KAPI void profiler_thread_release();
+
+/*
+    @brief Сохраняет записанные зоны всех потоков в файл формата Chrome trace (JSON),
+           который открывается в chrome://tracing и Perfetto.
+    @param path Путь к файлу для сохранения.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool profiler_dump(const char* path);
+
+#if KPROFILER_FLAG
+
+    #define KPROFILER_CONCAT_INNER(a, b) a##b
+    #define KPROFILER_CONCAT(a, b) KPROFILER_CONCAT_INNER(a, b)
+
+    /*
+        @brief Открывает зону профилирования, которая закрывается автоматически при выходе из области видимости.
+        @param name Имя зоны (строковый литерал).
+    */
+    #define KPROFILE_SCOPE(name)                                                                            \
+        profiler_zone KPROFILER_CONCAT(__profiler_zone_, __LINE__) __attribute__((cleanup(profiler_zone_end))) \
+            = profiler_zone_begin(name)
+
+    /*
+        @brief Открывает зону профилирования с именем текущей функции до выхода из нее.
+    */
+    #define KPROFILE_FUNCTION() KPROFILE_SCOPE(__FUNCTION__)
+
+    /*
+        @brief Открывает именованную зону профилирования, которую необходимо закрыть с помощью KPROFILE_END.
+        @param zone Имя переменной зоны.
+        @param name Имя зоны (строковый литерал).
+    */
+    #define KPROFILE_BEGIN(zone, name) profiler_zone zone = profiler_zone_begin(name)
+
+    /*
+        @brief Закрывает зону профилирования открытую с помощью KPROFILE_BEGIN.
+        @param zone Имя переменной зоны.
+    */
+    #define KPROFILE_END(zone) profiler_zone_end(&zone)
+
+#else
+
+    #define KPROFILE_SCOPE(name)
+    #define KPROFILE_FUNCTION()
+    #define KPROFILE_BEGIN(zone, name)
+    #define KPROFILE_END(zone)
+
+#endif
@@ -211,6 +211,7 @@ const char* event_code_str(event_code code)
         [EVENT_CODE_MOUSE_MOVED]           = "EVENT_CODE_MOUSE_MOVED",
         [EVENT_CODE_MOUSE_WHEEL]           = "EVENT_CODE_MOUSE_WHEEL",
         [EVENT_CODE_SET_RENDER_MODE]       = "EVENT_CODE_SET_RENDER_MODE",
+        [EVENT_CODE_PROFILER_DUMP]         = "EVENT_CODE_PROFILER_DUMP",
         [EVENT_CODE_DEBUG_0]               = "EVENT_CODE_DEBUG_0",
         [EVENT_CODE_DEBUG_1]               = "EVENT_CODE_DEBUG_1",
         [EVENT_CODE_DEBUG_2]               = "EVENT_CODE_DEBUG_2",
@@ -18,12 +18,12 @@ typedef bool (*PFN_event_handler)(event_code code, void* sender, void* listener,
     @param memory_requirement Указатель на переменную для получения требований к памяти.
     @param memory Указатель на выделенную память, для получения требований к памяти передать null.
 */
-void event_system_initialize(u64* memory_requirement, void* memory);
+KAPI void event_system_initialize(u64* memory_requirement, void* memory);
 
 /*
     @brief Останавливает систему событий.
 */
-void event_system_shutdown();
+KAPI void event_system_shutdown();
 
 /*
     @brief Регистрирует функцию-обработчик на заданное событие.
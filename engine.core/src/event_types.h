@@ -73,6 +73,12 @@ typedef enum event_code {
     */
     EVENT_CODE_SET_RENDER_MODE,
 
+    /*
+        @brief Сохранение записанных зон профилирования в файл трассировки.
+        Получение контекста: не используется.
+    */
+    EVENT_CODE_PROFILER_DUMP,
+
     /*
         @brief Отладка.
     */
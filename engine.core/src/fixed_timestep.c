@@ -0,0 +1,53 @@
+// Cобственные подключения.
+#include "fixed_timestep.h"
+
+// Внутренние подключения.
+#include "memory/memory.h"
+
+void fixed_timestep_create(fixed_timestep* ts, u32 update_rate, u32 max_steps)
+{
+    kzero_tc(ts, fixed_timestep, 1);
+    ts->step = update_rate ? 1.0 / update_rate : 0.0;
+    ts->max_steps = max_steps ? max_steps : 1;
+}
+
+u32 fixed_timestep_advance(fixed_timestep* ts, f64 frame_delta, f64* out_step)
+{
+    if(frame_delta < 0.0)
+    {
+        frame_delta = 0.0;
+    }
+
+    if(ts->step <= 0.0)
+    {
+        ts->step_count++;
+        *out_step = frame_delta;
+        return 1;
+    }
+
+    *out_step = ts->step;
+    ts->accumulator += frame_delta;
+
+    // NOTE: Количество шагов вычисляется делением, а не вычитанием в цикле, поэтому не зависит от длительности задержки.
+    f64 available = ts->accumulator / ts->step;
+    u64 whole = (u64)available;
+    u32 steps = whole > ts->max_steps ? ts->max_steps : (u32)whole;
+
+    // Остаток меньше шага сохраняется для интерполяции, лишние целые шаги отбрасываются.
+    ts->dropped_time += (whole - steps) * ts->step;
+    ts->accumulator = (available - whole) * ts->step;
+
+    ts->step_count += steps;
+    return steps;
+}
+
+f32 fixed_timestep_alpha(const fixed_timestep* ts)
+{
+    if(ts->step <= 0.0)
+    {
+        return 1.0f;
+    }
+
+    f32 alpha = (f32)(ts->accumulator / ts->step);
+    return alpha < 1.0f ? alpha : 0.999999f;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <defines.h>
+
+// @brief Данные шага фиксированной длительности для обновления состояния игры.
+typedef struct fixed_timestep {
+    // @brief Длительность шага в секундах (0 - один шаг за кадр длительностью кадра).
+    f64 step;
+    // @brief Максимальное количество шагов за кадр (догоняющие шаги после задержек).
+    u32 max_steps;
+    // @brief Накопленное и еще не обработанное шагами время в секундах.
+    f64 accumulator;
+    // @brief Количество выполненных шагов.
+    u64 step_count;
+    // @brief Время в секундах, отброшенное из-за ограничения количества шагов за кадр.
+    f64 dropped_time;
+} fixed_timestep;
+
+/*
+    @brief Инициализирует шаг фиксированной длительности.
+    @param ts Указатель на данные шага.
+    @param update_rate Количество шагов в секунду, 0 - один шаг за кадр длительностью кадра.
+    @param max_steps Максимальное количество шагов за кадр (0 заменяется на 1).
+*/
+KAPI void fixed_timestep_create(fixed_timestep* ts, u32 update_rate, u32 max_steps);
+
+/*
+    @brief Добавляет время кадра и определяет количество шагов, которые необходимо выполнить в этом кадре.
+    NOTE: Время, превышающее max_steps шагов, отбрасывается, чтобы после длительной задержки обновления
+          не занимали все последующие кадры (симуляция замедляется вместо лавинообразного отставания).
+    @param ts Указатель на данные шага.
+    @param frame_delta Время кадра в секундах.
+    @param out_step Указатель для сохранения длительности одного шага в секундах.
+    @return Количество шагов для выполнения (может быть 0).
+*/
+KAPI u32 fixed_timestep_advance(fixed_timestep* ts, f64 frame_delta, f64* out_step);
+
+/*
+    @brief Получает коэффициент интерполяции между двумя последними шагами для отрисовки.
+    @param ts Указатель на данные шага.
+    @return Доля шага в [0, 1), прошедшая после последнего выполненного шага (1 без фиксированного шага).
+*/
+KAPI f32 fixed_timestep_alpha(const fixed_timestep* ts);
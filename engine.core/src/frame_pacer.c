@@ -0,0 +1,167 @@
+// Cобственные подключения.
+#include "frame_pacer.h"
+
+// Внутренние подключения.
+#include "memory/memory.h"
+#include "math/kmath.h"
+#include "platform/time.h"
+#include "platform/thread.h"
+
+// Запас времени активного ожидания перед началом кадра (поверх оценки пересыпания).
+#define FRAME_PACER_SPIN_MARGIN_NS   200000ULL
+// Ограничение оценки пересыпания (защита от единичных длительных задержек планировщика).
+#define FRAME_PACER_MAX_OVERSLEEP_NS 4000000ULL
+// Скорость уменьшения оценки пересыпания (1/N от разницы за кадр).
+#define FRAME_PACER_OVERSLEEP_DECAY  16
+
+static u64 platform_clock_now_ns(void* user_data)
+{
+    return platform_time_absolute_ns();
+}
+
+static void platform_clock_sleep_until_ns(u64 deadline_ns, void* user_data)
+{
+    platform_thread_sleep_until_ns(deadline_ns);
+}
+
+static KINLINE u64 frame_pacer_now(const frame_pacer* pacer)
+{
+    return pacer->clock.now_ns(pacer->clock.user_data);
+}
+
+static void frame_pacer_record(frame_pacer* pacer, u64 now_ns)
+{
+    if(pacer->last_frame_ns)
+    {
+        u64 interval = now_ns - pacer->last_frame_ns;
+        pacer->last_interval_ns = interval;
+        pacer->frame_count++;
+
+        // Среднее и дисперсия по алгоритму Уэлфорда.
+        f64 delta = (f64)interval - pacer->interval_mean_ns;
+        pacer->interval_mean_ns += delta / pacer->frame_count;
+        pacer->interval_m2_ns += delta * ((f64)interval - pacer->interval_mean_ns);
+
+        u64 reference = pacer->period_ns ? pacer->period_ns : (u64)pacer->interval_mean_ns;
+        u64 deviation = interval > reference ? interval - reference : reference - interval;
+        pacer->max_deviation_ns = KMAX(pacer->max_deviation_ns, deviation);
+    }
+
+    pacer->last_frame_ns = now_ns;
+}
+
+void frame_pacer_create(frame_pacer* pacer, u32 target_fps)
+{
+    kzero_tc(pacer, frame_pacer, 1);
+    frame_pacer_clock_set(pacer, null);
+    frame_pacer_target_set(pacer, target_fps);
+}
+
+void frame_pacer_clock_set(frame_pacer* pacer, const frame_pacer_clock* clock)
+{
+    if(clock)
+    {
+        pacer->clock = *clock;
+    }
+    else
+    {
+        pacer->clock.now_ns = platform_clock_now_ns;
+        pacer->clock.sleep_until_ns = platform_clock_sleep_until_ns;
+        pacer->clock.user_data = null;
+    }
+
+    pacer->next_deadline_ns = 0;
+    pacer->oversleep_ns = 0;
+    frame_pacer_stats_reset(pacer);
+}
+
+void frame_pacer_target_set(frame_pacer* pacer, u32 target_fps)
+{
+    pacer->period_ns = target_fps ? 1000000000ULL / target_fps : 0;
+    pacer->next_deadline_ns = 0;
+    frame_pacer_stats_reset(pacer);
+}
+
+void frame_pacer_wait(frame_pacer* pacer)
+{
+    u64 now = frame_pacer_now(pacer);
+
+    if(!pacer->period_ns)
+    {
+        frame_pacer_record(pacer, now);
+        return;
+    }
+
+    if(!pacer->next_deadline_ns)
+    {
+        pacer->next_deadline_ns = now;
+    }
+
+    u64 deadline = pacer->next_deadline_ns;
+
+    if(now < deadline)
+    {
+        // Засыпание с запасом на пересыпание планировщиком.
+        u64 sleep_margin = pacer->oversleep_ns + FRAME_PACER_SPIN_MARGIN_NS;
+        if(deadline - now > sleep_margin)
+        {
+            u64 wake_target = deadline - sleep_margin;
+            pacer->clock.sleep_until_ns(wake_target, pacer->clock.user_data);
+            now = frame_pacer_now(pacer);
+
+            // Оценка быстро растет и медленно уменьшается, чтобы пропуски кадра были редкими.
+            u64 oversleep = now > wake_target ? now - wake_target : 0;
+            oversleep = KMIN(oversleep, FRAME_PACER_MAX_OVERSLEEP_NS);
+            if(oversleep > pacer->oversleep_ns)
+            {
+                pacer->oversleep_ns = oversleep;
+            }
+            else
+            {
+                pacer->oversleep_ns -= (pacer->oversleep_ns - oversleep) / FRAME_PACER_OVERSLEEP_DECAY;
+            }
+        }
+
+        // Точное ожидание оставшегося времени.
+        while(now < deadline)
+        {
+            now = frame_pacer_now(pacer);
+        }
+    }
+
+    // NOTE: При отставании больше чем на кадр расписание переносится, чтобы не догонять его серией коротких кадров.
+    if(now - deadline >= pacer->period_ns)
+    {
+        pacer->missed_deadlines++;
+        pacer->next_deadline_ns = now + pacer->period_ns;
+    }
+    else
+    {
+        pacer->next_deadline_ns = deadline + pacer->period_ns;
+    }
+
+    frame_pacer_record(pacer, now);
+}
+
+void frame_pacer_stats_get(const frame_pacer* pacer, frame_pacer_stats* out_stats)
+{
+    out_stats->frame_count = pacer->frame_count;
+    out_stats->target_ms = pacer->period_ns * 0.000001;
+    out_stats->last_frame_ms = pacer->last_interval_ns * 0.000001;
+    out_stats->average_frame_ms = pacer->interval_mean_ns * 0.000001;
+    out_stats->jitter_ms = pacer->frame_count > 1 ? ksqrt_f64(pacer->interval_m2_ns / (pacer->frame_count - 1)) * 0.000001 : 0;
+    out_stats->max_deviation_ms = pacer->max_deviation_ns * 0.000001;
+    out_stats->oversleep_ms = pacer->oversleep_ns * 0.000001;
+    out_stats->missed_deadlines = pacer->missed_deadlines;
+}
+
+void frame_pacer_stats_reset(frame_pacer* pacer)
+{
+    pacer->frame_count = 0;
+    pacer->last_frame_ns = 0;
+    pacer->last_interval_ns = 0;
+    pacer->interval_mean_ns = 0;
+    pacer->interval_m2_ns = 0;
+    pacer->max_deviation_ns = 0;
+    pacer->missed_deadlines = 0;
+}
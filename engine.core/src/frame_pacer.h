@@ -0,0 +1,98 @@
+#pragma once
+
+#include <defines.h>
+
+// @brief Статистика равномерности кадров с момента последнего сброса.
+typedef struct frame_pacer_stats {
+    // @brief Количество измеренных кадров.
+    u64 frame_count;
+    // @brief Целевое время кадра в миллисекундах (0 - без ограничения).
+    f64 target_ms;
+    // @brief Время последнего кадра в миллисекундах.
+    f64 last_frame_ms;
+    // @brief Среднее время кадра в миллисекундах.
+    f64 average_frame_ms;
+    // @brief Неравномерность кадров: стандартное отклонение времени кадра в миллисекундах.
+    f64 jitter_ms;
+    // @brief Максимальное отклонение времени кадра от целевого (или среднего без ограничения) в миллисекундах.
+    f64 max_deviation_ms;
+    // @brief Текущая оценка пересыпания планировщиком в миллисекундах.
+    f64 oversleep_ms;
+    // @brief Количество кадров, не уложившихся в целевое время.
+    u64 missed_deadlines;
+} frame_pacer_stats;
+
+// @brief Источник времени ограничителя частоты кадров.
+typedef struct frame_pacer_clock {
+    // @brief Возвращает текущее время в наносекундах.
+    u64 (*now_ns)(void* user_data);
+    // @brief Засыпает до указанного момента времени в наносекундах.
+    void (*sleep_until_ns)(u64 deadline_ns, void* user_data);
+    // @brief Данные, передаваемые функциям источника.
+    void* user_data;
+} frame_pacer_clock;
+
+// @brief Данные ограничителя частоты кадров.
+typedef struct frame_pacer {
+    // @brief Источник времени (по умолчанию таймер платформы).
+    frame_pacer_clock clock;
+    // @brief Целевое время кадра в наносекундах (0 - без ограничения).
+    u64 period_ns;
+    // @brief Момент начала следующего кадра в наносекундах.
+    u64 next_deadline_ns;
+    // @brief Момент начала предыдущего кадра в наносекундах.
+    u64 last_frame_ns;
+    // @brief Оценка пересыпания планировщиком в наносекундах (компенсируется при засыпании).
+    u64 oversleep_ns;
+
+    // Накопление статистики.
+    u64 frame_count;
+    u64 last_interval_ns;
+    f64 interval_mean_ns;
+    f64 interval_m2_ns;
+    u64 max_deviation_ns;
+    u64 missed_deadlines;
+} frame_pacer;
+
+/*
+    @brief Инициализирует ограничитель частоты кадров.
+    @param pacer Указатель на ограничитель.
+    @param target_fps Целевая частота кадров, 0 - без ограничения.
+*/
+KAPI void frame_pacer_create(frame_pacer* pacer, u32 target_fps);
+
+/*
+    @brief Заменяет источник времени ограничителя (например, для тестов) и сбрасывает расписание и статистику.
+    @param pacer Указатель на ограничитель.
+    @param clock Указатель на источник времени, null - таймер платформы.
+*/
+KAPI void frame_pacer_clock_set(frame_pacer* pacer, const frame_pacer_clock* clock);
+
+/*
+    @brief Изменяет целевую частоту кадров и сбрасывает статистику.
+    @param pacer Указатель на ограничитель.
+    @param target_fps Целевая частота кадров, 0 - без ограничения.
+*/
+KAPI void frame_pacer_target_set(frame_pacer* pacer, u32 target_fps);
+
+/*
+    @brief Ожидает начала следующего кадра: засыпает до момента незадолго до начала (с учетом оценки
+           пересыпания), после чего дожидается точного момента активным ожиданием.
+    NOTE: Вызывать в начале кадра, непосредственно перед опросом устройств ввода,
+          чтобы ввод считывался как можно позже и задержка ввода была минимальной.
+    @param pacer Указатель на ограничитель.
+*/
+KAPI void frame_pacer_wait(frame_pacer* pacer);
+
+/*
+    @brief Получает статистику равномерности кадров.
+    @param pacer Указатель на ограничитель.
+    @param out_stats Указатель на структуру для сохранения статистики.
+*/
+KAPI void frame_pacer_stats_get(const frame_pacer* pacer, frame_pacer_stats* out_stats);
+
+/*
+    @brief Сбрасывает статистику равномерности кадров.
+    @param pacer Указатель на ограничитель.
+*/
+KAPI void frame_pacer_stats_reset(frame_pacer* pacer);
@@ -0,0 +1,251 @@
+// Cобственные подключения.
+#include "frame_pipeline.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+#include "debug/profiler.h"
+#include "platform/time.h"
+#include "platform/thread.h"
+
+struct frame_pipeline {
+    // Конфигурация конвейера.
+    frame_pipeline_config config;
+    // Данные слотов.
+    void* slots[FRAME_PIPELINE_SLOT_COUNT];
+    // Количество свободных слотов.
+    platform_semaphore free_slots;
+    // Количество заполненных слотов.
+    platform_semaphore filled_slots;
+    // Индекс следующего слота производителя.
+    u32 produce_index;
+    // Индекс следующего слота обработчика.
+    u32 consume_index;
+    // Слот получен производителем и еще не отправлен.
+    bool acquired;
+    // Поток обработки.
+    platform_thread thread;
+    bool thread_started;
+    bool stop;
+    bool failed;
+
+    // Статистика (время в наносекундах).
+    // NOTE: Значения обработчика изменяются в потоке обработки и читаются атомарно.
+    u64 frame_count;
+    u64 producer_wait_ns;
+    u64 consume_ns;
+    u64 consumer_idle_ns;
+};
+
+static bool pipeline_consume(frame_pipeline* pipeline)
+{
+    void* slot = pipeline->slots[pipeline->consume_index];
+    pipeline->consume_index = (pipeline->consume_index + 1) % FRAME_PIPELINE_SLOT_COUNT;
+
+    u64 start = platform_time_absolute_ns();
+    bool result = pipeline->config.consume(slot, pipeline->config.user_data);
+    __atomic_fetch_add(&pipeline->consume_ns, platform_time_absolute_ns() - start, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&pipeline->frame_count, 1, __ATOMIC_RELAXED);
+
+    if(!result)
+    {
+        __atomic_store_n(&pipeline->failed, true, __ATOMIC_RELEASE);
+    }
+    return result;
+}
+
+static void pipeline_thread_run(void* params)
+{
+    frame_pipeline* pipeline = params;
+
+    while(true)
+    {
+        u64 start = platform_time_absolute_ns();
+        platform_semaphore_wait(&pipeline->filled_slots);
+        __atomic_fetch_add(&pipeline->consumer_idle_ns, platform_time_absolute_ns() - start, __ATOMIC_RELAXED);
+
+        if(__atomic_load_n(&pipeline->stop, __ATOMIC_ACQUIRE))
+        {
+            break;
+        }
+
+        KPROFILE_SCOPE("Frame pipeline consume");
+        pipeline_consume(pipeline);
+
+        // NOTE: Семафоры упорядочивают память, поэтому данные слота видны производителю после освобождения.
+        platform_semaphore_signal(&pipeline->free_slots);
+    }
+}
+
+frame_pipeline* frame_pipeline_create(const frame_pipeline_config* config, u64* memory_requirement, void* memory)
+{
+    if(!config || !memory_requirement)
+    {
+        kerror("Function '%s' requires valid pointers to config and memory_requirement.", __FUNCTION__);
+        return null;
+    }
+
+    if(!config->slot_size || !config->consume)
+    {
+        kerror("Function '%s' requires a slot size greater than zero and a consume function.", __FUNCTION__);
+        return null;
+    }
+
+    u64 slot_requirement = get_aligned(config->slot_size, 16);
+    *memory_requirement = get_aligned(sizeof(frame_pipeline), 16) + slot_requirement * FRAME_PIPELINE_SLOT_COUNT;
+
+    if(!memory)
+    {
+        return null;
+    }
+
+    kzero(memory, *memory_requirement);
+    frame_pipeline* pipeline = memory;
+    pipeline->config = *config;
+
+    void* slot_block = POINTER_GET_OFFSET(pipeline, get_aligned(sizeof(frame_pipeline), 16));
+    for(u32 i = 0; i < FRAME_PIPELINE_SLOT_COUNT; ++i)
+    {
+        pipeline->slots[i] = POINTER_GET_OFFSET(slot_block, slot_requirement * i);
+    }
+
+    if(!platform_semaphore_create(FRAME_PIPELINE_SLOT_COUNT, &pipeline->free_slots))
+    {
+        kerror("Function '%s': Failed to create semaphore.", __FUNCTION__);
+        return null;
+    }
+
+    if(!platform_semaphore_create(0, &pipeline->filled_slots))
+    {
+        kerror("Function '%s': Failed to create semaphore.", __FUNCTION__);
+        platform_semaphore_destroy(&pipeline->free_slots);
+        return null;
+    }
+
+    if(config->threaded)
+    {
+        pipeline->thread_started = platform_thread_create(pipeline_thread_run, pipeline, &pipeline->thread);
+        if(!pipeline->thread_started)
+        {
+            kwarng("Function '%s': Failed to start consume thread. Slots will be consumed sequentially.", __FUNCTION__);
+        }
+    }
+
+    return pipeline;
+}
+
+void frame_pipeline_destroy(frame_pipeline* pipeline)
+{
+    if(!pipeline)
+    {
+        kerror("Function '%s' requires a valid pointer to frame pipeline.", __FUNCTION__);
+        return;
+    }
+
+    if(pipeline->acquired)
+    {
+        kwarng("Function '%s': Acquired slot was not submitted and will be dropped.", __FUNCTION__);
+        platform_semaphore_signal(&pipeline->free_slots);
+        pipeline->acquired = false;
+    }
+
+    frame_pipeline_wait_idle(pipeline);
+
+    if(pipeline->thread_started)
+    {
+        __atomic_store_n(&pipeline->stop, true, __ATOMIC_RELEASE);
+        platform_semaphore_signal(&pipeline->filled_slots);
+        platform_thread_join(&pipeline->thread);
+        pipeline->thread_started = false;
+    }
+
+    platform_semaphore_destroy(&pipeline->free_slots);
+    platform_semaphore_destroy(&pipeline->filled_slots);
+}
+
+void* frame_pipeline_slot_get(frame_pipeline* pipeline, u32 index)
+{
+    if(!pipeline || index >= FRAME_PIPELINE_SLOT_COUNT)
+    {
+        kerror("Function '%s' requires a valid pointer to frame pipeline and an index less than %u.", __FUNCTION__, FRAME_PIPELINE_SLOT_COUNT);
+        return null;
+    }
+    return pipeline->slots[index];
+}
+
+void* frame_pipeline_acquire(frame_pipeline* pipeline)
+{
+    if(!pipeline || pipeline->acquired)
+    {
+        kerror("Function '%s' requires a valid pointer to frame pipeline without an acquired slot.", __FUNCTION__);
+        return null;
+    }
+
+    u64 start = platform_time_absolute_ns();
+    platform_semaphore_wait(&pipeline->free_slots);
+    pipeline->producer_wait_ns += platform_time_absolute_ns() - start;
+
+    pipeline->acquired = true;
+    return pipeline->slots[pipeline->produce_index];
+}
+
+void frame_pipeline_submit(frame_pipeline* pipeline)
+{
+    if(!pipeline || !pipeline->acquired)
+    {
+        kerror("Function '%s' requires a valid pointer to frame pipeline with an acquired slot.", __FUNCTION__);
+        return;
+    }
+
+    pipeline->acquired = false;
+    pipeline->produce_index = (pipeline->produce_index + 1) % FRAME_PIPELINE_SLOT_COUNT;
+
+    if(pipeline->thread_started)
+    {
+        platform_semaphore_signal(&pipeline->filled_slots);
+    }
+    else
+    {
+        pipeline_consume(pipeline);
+        platform_semaphore_signal(&pipeline->free_slots);
+    }
+}
+
+void frame_pipeline_wait_idle(frame_pipeline* pipeline)
+{
+    if(!pipeline || pipeline->acquired)
+    {
+        kerror("Function '%s' requires a valid pointer to frame pipeline without an acquired slot.", __FUNCTION__);
+        return;
+    }
+
+    // NOTE: Все слоты свободны только после обработки всех отправленных слотов.
+    for(u32 i = 0; i < FRAME_PIPELINE_SLOT_COUNT; ++i)
+    {
+        platform_semaphore_wait(&pipeline->free_slots);
+    }
+    for(u32 i = 0; i < FRAME_PIPELINE_SLOT_COUNT; ++i)
+    {
+        platform_semaphore_signal(&pipeline->free_slots);
+    }
+}
+
+bool frame_pipeline_failed(frame_pipeline* pipeline)
+{
+    if(!pipeline) return true;
+    return __atomic_load_n(&pipeline->failed, __ATOMIC_ACQUIRE);
+}
+
+void frame_pipeline_stats_get(frame_pipeline* pipeline, frame_pipeline_stats* out_stats)
+{
+    if(!pipeline || !out_stats)
+    {
+        kerror("Function '%s' requires valid pointers to frame pipeline and out_stats.", __FUNCTION__);
+        return;
+    }
+
+    out_stats->frame_count = __atomic_load_n(&pipeline->frame_count, __ATOMIC_RELAXED);
+    out_stats->producer_wait_ms = pipeline->producer_wait_ns * 0.000001;
+    out_stats->consume_ms = __atomic_load_n(&pipeline->consume_ns, __ATOMIC_RELAXED) * 0.000001;
+    out_stats->consumer_idle_ms = __atomic_load_n(&pipeline->consumer_idle_ns, __ATOMIC_RELAXED) * 0.000001;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <defines.h>
+
+// @brief Количество слотов кадров: один заполняется, пока другой обрабатывается.
+#define FRAME_PIPELINE_SLOT_COUNT 2
+
+/*
+    @brief Функция обработки заполненного слота кадра (например, запись и отправка команд отрисовки).
+    @param slot Указатель на данные слота.
+    @param user_data Пользовательские данные из конфигурации.
+    @return True в случае успеха, false если есть ошибки.
+*/
+typedef bool (*frame_pipeline_consume)(void* slot, void* user_data);
+
+// @brief Конфигурация конвейера кадров.
+typedef struct frame_pipeline_config {
+    // @brief Размер данных одного слота в байтах.
+    u64 slot_size;
+    // @brief Функция обработки заполненного слота.
+    frame_pipeline_consume consume;
+    // @brief Пользовательские данные функции обработки.
+    void* user_data;
+    // @brief True - обработка в отдельном потоке, false - последовательно при отправке слота.
+    bool threaded;
+} frame_pipeline_config;
+
+// @brief Статистика конвейера кадров.
+typedef struct frame_pipeline_stats {
+    // @brief Количество обработанных кадров.
+    u64 frame_count;
+    // @brief Суммарное время ожидания свободного слота производителем в миллисекундах.
+    f64 producer_wait_ms;
+    // @brief Суммарное время обработки слотов в миллисекундах.
+    f64 consume_ms;
+    // @brief Суммарное время ожидания заполненного слота обработчиком в миллисекундах.
+    f64 consumer_idle_ms;
+} frame_pipeline_stats;
+
+// @brief Контекст конвейера кадров.
+typedef struct frame_pipeline frame_pipeline;
+
+/*
+    @brief Создает двухступенчатый конвейер кадров или получает требования к нему.
+    NOTE: Производитель (игровой поток) заполняет слот кадра N+1, пока обработчик (поток отрисовки)
+          обрабатывает кадр N. Слот принадлежит производителю от получения до отправки, а после отправки
+          обработчику до завершения обработки, поэтому данные слота не требуют блокировок.
+          Вызывается дважды, первый для получения требований и второй для создания конвейера.
+    @param config Конфигурация конвейера.
+    @param memory_requirement Указатель для сохранения требований к памяти в байтах.
+    @param memory Указатель на выделенную память, или null для получения требований.
+    @return Указатель на конвейер или null при получении требований или ошибках.
+*/
+KAPI frame_pipeline* frame_pipeline_create(const frame_pipeline_config* config, u64* memory_requirement, void* memory);
+
+/*
+    @brief Дожидается обработки отправленных слотов, останавливает поток обработки и уничтожает конвейер.
+    @param pipeline Указатель на конвейер.
+*/
+KAPI void frame_pipeline_destroy(frame_pipeline* pipeline);
+
+/*
+    @brief Получает данные слота по индексу (для инициализации и освобождения данных слотов).
+    NOTE: Безопасно только при простое конвейера, см. frame_pipeline_wait_idle.
+    @param pipeline Указатель на конвейер.
+    @param index Индекс слота меньше FRAME_PIPELINE_SLOT_COUNT.
+    @return Указатель на данные слота или null при ошибках.
+*/
+KAPI void* frame_pipeline_slot_get(frame_pipeline* pipeline, u32 index);
+
+/*
+    @brief Получает свободный слот для заполнения следующего кадра, ожидая его освобождения обработчиком.
+    @param pipeline Указатель на конвейер.
+    @return Указатель на данные слота или null при ошибках.
+*/
+KAPI void* frame_pipeline_acquire(frame_pipeline* pipeline);
+
+/*
+    @brief Передает заполненный слот обработчику, после чего производитель не должен обращаться к нему.
+    @param pipeline Указатель на конвейер.
+*/
+KAPI void frame_pipeline_submit(frame_pipeline* pipeline);
+
+/*
+    @brief Ожидает обработки всех отправленных слотов.
+    NOTE: Вызывается производителем перед изменением данных, используемых обработчиком (например, ресурсов
+          визуализатора), и не должен вызываться между получением и отправкой слота.
+    @param pipeline Указатель на конвейер.
+*/
+KAPI void frame_pipeline_wait_idle(frame_pipeline* pipeline);
+
+/*
+    @brief Проверяет, завершилась ли ошибкой обработка какого-либо слота.
+    @param pipeline Указатель на конвейер.
+    @return True если обработка завершилась ошибкой, false если нет.
+*/
+KAPI bool frame_pipeline_failed(frame_pipeline* pipeline);
+
+/*
+    @brief Получает статистику конвейера.
+    NOTE: Значения обработчика читаются атомарно во время работы, но согласованы между собой
+          (например, количество кадров и время обработки) только при простое конвейера.
+    @param pipeline Указатель на конвейер.
+    @param out_stats Указатель на структуру для сохранения статистики.
+*/
+KAPI void frame_pipeline_stats_get(frame_pipeline* pipeline, frame_pipeline_stats* out_stats);
@@ -20,10 +20,9 @@ void log_output_default_hook(log_level level, const char* message);
 
 /*
     Буфер сообщений.
-    NOTE: Только для однопоточной работы.
-    TODO: Заменить на многопоточный вариант.
+    NOTE: Свой у каждого потока (игрового и отрисовки), поэтому сообщения разных потоков не смешиваются.
 */
-static char buffer[LOG_BUFFER_SIZE];
+static _Thread_local char buffer[LOG_BUFFER_SIZE];
 
 // Указатель на функцию в которую будет передаваться сообщение.
 static PFN_console_write log_output_hook = log_output_default_hook;
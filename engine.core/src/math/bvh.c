@@ -0,0 +1,893 @@
+// Собственные подключения.
+#include "math/bvh.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+#include "math/kmath.h"
+
+// Количество корзин при поиске разбиения по эвристике площади поверхности.
+#define BVH_SAH_BINS 12
+// Максимальное количество объектов листа, который выгоднее не разбивать.
+#define BVH_LEAF_MAX_ITEMS 8
+// Глубина, после которой узлы делятся пополам без эвристики (ограничивает глубину дерева).
+#define BVH_SAH_MAX_DEPTH 32
+// Размер стека обхода (глубина дерева не превышает BVH_SAH_MAX_DEPTH + 32).
+#define BVH_STACK_SIZE 64
+// Ухудшение стоимости дерева после обновления границ, при котором дерево перестраивается.
+#define BVH_REBUILD_COST_RATIO 1.5f
+// Минимальное количество объектов вне дерева, при котором дерево перестраивается.
+#define BVH_PENDING_MIN 32
+
+typedef struct bvh_node {
+    // Границы узла.
+    extents_3d bounds;
+    // Внутренний узел: индекс левого потомка (правый следует за ним); лист: индекс первого объекта в item_slots.
+    u32 first;
+    // Количество объектов листа или 0 для внутреннего узла.
+    u32 count;
+    // Индекс родителя или INVALID_ID для корня.
+    u32 parent;
+} bvh_node;
+
+typedef struct bvh_item {
+    // Мировые границы объекта.
+    extents_3d bounds;
+    // Пользовательские данные объекта.
+    u32 user_data;
+    // Лист, содержащий объект, или INVALID_ID если объект вне дерева.
+    u32 leaf;
+    // Индекс в массиве объектов вне дерева или INVALID_ID.
+    u32 pending;
+} bvh_item;
+
+struct bvh {
+    // Максимальное количество объектов.
+    u32 capacity;
+    // Пул дескрипторов объектов.
+    handle_pool* proxies;
+    // Объекты (индексируется слотом дескриптора).
+    bvh_item* items;
+    // Слоты объектов, упорядоченные по листьям.
+    u32* item_slots;
+    // Слоты объектов, добавленных после построения дерева.
+    u32* pending_slots;
+    // Количество объектов вне дерева.
+    u32 pending_count;
+    // Количество удаленных объектов, слоты которых еще остались в листьях.
+    u32 removed_count;
+    // Узлы дерева.
+    bvh_node* nodes;
+    // Признаки узлов, границы которых нужно обновить.
+    u8* node_dirty;
+    // Количество узлов дерева.
+    u32 node_count;
+    // Количество объектов в дереве при построении.
+    u32 built_item_count;
+    // Стоимость дерева по эвристике площади поверхности после построения.
+    f32 built_cost;
+    // Есть узлы, границы которых нужно обновить.
+    bool bounds_dirty;
+};
+
+static KINLINE f32 extents_area(const extents_3d* e)
+{
+    f32 dx = e->max.x - e->min.x;
+    f32 dy = e->max.y - e->min.y;
+    f32 dz = e->max.z - e->min.z;
+    return dx * dy + dy * dz + dz * dx;
+}
+
+static KINLINE extents_3d extents_empty()
+{
+    return (extents_3d){
+        { { K_FLOAT_MAX, K_FLOAT_MAX, K_FLOAT_MAX } },
+        { { -K_FLOAT_MAX, -K_FLOAT_MAX, -K_FLOAT_MAX } }
+    };
+}
+
+static KINLINE void extents_grow(extents_3d* e, const extents_3d* other)
+{
+    e->min.x = KMIN(e->min.x, other->min.x);
+    e->min.y = KMIN(e->min.y, other->min.y);
+    e->min.z = KMIN(e->min.z, other->min.z);
+    e->max.x = KMAX(e->max.x, other->max.x);
+    e->max.y = KMAX(e->max.y, other->max.y);
+    e->max.z = KMAX(e->max.z, other->max.z);
+}
+
+static KINLINE bool extents_overlap(const extents_3d* a, const extents_3d* b)
+{
+    return a->min.x <= b->max.x && a->max.x >= b->min.x
+        && a->min.y <= b->max.y && a->max.y >= b->min.y
+        && a->min.z <= b->max.z && a->max.z >= b->min.z;
+}
+
+static KINLINE bool extents_intersects_sphere(const extents_3d* e, vec3 center, f32 radius_squared)
+{
+    f32 dx = KMAX(e->min.x - center.x, 0.0f) + KMAX(center.x - e->max.x, 0.0f);
+    f32 dy = KMAX(e->min.y - center.y, 0.0f) + KMAX(center.y - e->max.y, 0.0f);
+    f32 dz = KMAX(e->min.z - center.z, 0.0f) + KMAX(center.z - e->max.z, 0.0f);
+    return dx * dx + dy * dy + dz * dz <= radius_squared;
+}
+
+// Возвращает расстояние входа луча в прямоугольник или K_INFINITY если луч его не пересекает.
+static KINLINE f32 extents_ray_distance(const extents_3d* e, vec3 origin, vec3 inv_direction, f32 max_distance)
+{
+    f32 t1 = (e->min.x - origin.x) * inv_direction.x;
+    f32 t2 = (e->max.x - origin.x) * inv_direction.x;
+    f32 tmin = KMIN(t1, t2);
+    f32 tmax = KMAX(t1, t2);
+
+    t1 = (e->min.y - origin.y) * inv_direction.y;
+    t2 = (e->max.y - origin.y) * inv_direction.y;
+    tmin = KMAX(tmin, KMIN(t1, t2));
+    tmax = KMIN(tmax, KMAX(t1, t2));
+
+    t1 = (e->min.z - origin.z) * inv_direction.z;
+    t2 = (e->max.z - origin.z) * inv_direction.z;
+    tmin = KMAX(tmin, KMIN(t1, t2));
+    tmax = KMIN(tmax, KMAX(t1, t2));
+
+    tmin = KMAX(tmin, 0.0f);
+    return (tmin <= tmax && tmin < max_distance) ? tmin : K_INFINITY;
+}
+
+// Объект листа действителен, если он не удален и не перемещен в другой лист после повторного использования слота.
+static KINLINE bool item_in_leaf(const bvh* tree, u32 slot, u32 leaf)
+{
+    return tree->items[slot].leaf == leaf;
+}
+
+static KINLINE u32 result_push(u32* out_items, u32 max_items, u32 count, u32 user_data)
+{
+    if(count < max_items)
+    {
+        out_items[count] = user_data;
+    }
+    return count + 1;
+}
+
+bvh* bvh_create(u32 max_item_count, u64* memory_requirement, void* memory)
+{
+    if(!max_item_count || max_item_count >= INVALID_ID / 2)
+    {
+        kerror("Function '%s' require a max_item_count greater than zero and less than INVALID_ID / 2.", __FUNCTION__);
+        return null;
+    }
+
+    if(!memory_requirement)
+    {
+        kerror("Function '%s' requires a valid pointer to memory_requiremet to obtain requirements.", __FUNCTION__);
+        return null;
+    }
+
+    u32 max_node_count = max_item_count * 2;
+    u64 pool_requirement = 0;
+    handle_pool_create(max_item_count, &pool_requirement, null);
+    u64 nodes_requirement = sizeof(bvh_node) * max_node_count;
+    u64 items_requirement = sizeof(bvh_item) * max_item_count;
+    u64 slots_requirement = sizeof(u32) * max_item_count;
+    u64 dirty_requirement = sizeof(u8) * max_node_count;
+    *memory_requirement = sizeof(bvh) + pool_requirement + nodes_requirement + items_requirement + slots_requirement * 2
+                        + dirty_requirement;
+
+    if(!memory)
+    {
+        return null;
+    }
+
+    kzero(memory, sizeof(bvh));
+    bvh* tree = memory;
+    tree->capacity = max_item_count;
+    tree->proxies = handle_pool_create(max_item_count, &pool_requirement, POINTER_GET_OFFSET(tree, sizeof(bvh)));
+    tree->nodes = POINTER_GET_OFFSET(tree->proxies, pool_requirement);
+    tree->items = POINTER_GET_OFFSET(tree->nodes, nodes_requirement);
+    tree->item_slots = POINTER_GET_OFFSET(tree->items, items_requirement);
+    tree->pending_slots = POINTER_GET_OFFSET(tree->item_slots, slots_requirement);
+    tree->node_dirty = POINTER_GET_OFFSET(tree->pending_slots, slots_requirement);
+    kzero(tree->node_dirty, dirty_requirement);
+
+    return tree;
+}
+
+void bvh_destroy(bvh* tree)
+{
+    if(!tree)
+    {
+        kerror("Function '%s' requires a valid pointer to bvh.", __FUNCTION__);
+        return;
+    }
+
+    handle_pool_destroy(tree->proxies);
+    kzero(tree, sizeof(bvh));
+}
+
+bool bvh_insert(bvh* tree, extents_3d bounds, u32 user_data, khandle* out_proxy)
+{
+    if(!tree || !out_proxy)
+    {
+        kerror("Function '%s' requires a valid pointers to bvh and out_proxy.", __FUNCTION__);
+        return false;
+    }
+
+    if(!handle_pool_acquire(tree->proxies, out_proxy))
+    {
+        kerror("Function '%s': No free slots. Increase max_item_count of bvh.", __FUNCTION__);
+        return false;
+    }
+
+    bvh_item* item = &tree->items[out_proxy->index];
+    item->bounds = bounds;
+    item->user_data = user_data;
+    item->leaf = INVALID_ID;
+    item->pending = tree->pending_count;
+    tree->pending_slots[tree->pending_count++] = out_proxy->index;
+    return true;
+}
+
+bool bvh_remove(bvh* tree, khandle proxy)
+{
+    if(!tree || !handle_pool_release(tree->proxies, proxy))
+    {
+        kerror("Function '%s' requires a valid pointer to bvh and valid proxy.", __FUNCTION__);
+        return false;
+    }
+
+    bvh_item* item = &tree->items[proxy.index];
+    if(item->pending != INVALID_ID)
+    {
+        // Перенос последнего объекта вне дерева на место удаленного.
+        u32 last_slot = tree->pending_slots[--tree->pending_count];
+        tree->pending_slots[item->pending] = last_slot;
+        tree->items[last_slot].pending = item->pending;
+    }
+    else
+    {
+        // NOTE: Слот остается в листе до перестроения, запросы пропускают его по полю leaf.
+        tree->removed_count++;
+    }
+
+    item->leaf = INVALID_ID;
+    item->pending = INVALID_ID;
+    return true;
+}
+
+bool bvh_move(bvh* tree, khandle proxy, extents_3d bounds)
+{
+    if(!tree || !handle_pool_valid(tree->proxies, proxy))
+    {
+        kerror("Function '%s' requires a valid pointer to bvh and valid proxy.", __FUNCTION__);
+        return false;
+    }
+
+    bvh_item* item = &tree->items[proxy.index];
+    item->bounds = bounds;
+
+    // NOTE: Отмечается только лист, отметки родителей распространяются проходом в bvh_update.
+    if(item->leaf != INVALID_ID)
+    {
+        tree->node_dirty[item->leaf] = true;
+        tree->bounds_dirty = true;
+    }
+
+    return true;
+}
+
+bool bvh_set_user_data(bvh* tree, khandle proxy, u32 user_data)
+{
+    if(!tree || !handle_pool_valid(tree->proxies, proxy))
+    {
+        kerror("Function '%s' requires a valid pointer to bvh and valid proxy.", __FUNCTION__);
+        return false;
+    }
+
+    tree->items[proxy.index].user_data = user_data;
+    return true;
+}
+
+static KINLINE f32 item_centroid(const bvh* tree, u32 slot, u32 axis)
+{
+    const extents_3d* b = &tree->items[slot].bounds;
+    return (b->min.elements[axis] + b->max.elements[axis]) * 0.5f;
+}
+
+/*
+    Ищет разбиение объектов узла по корзинам вдоль каждой оси и разделяет их на месте.
+    Возвращает количество объектов левой части или 0 если узел выгоднее оставить листом.
+*/
+static u32 node_split_sah(bvh* tree, const bvh_node* node, const extents_3d* centroid_bounds)
+{
+    u32* slots = &tree->item_slots[node->first];
+    f32 best_cost = K_FLOAT_MAX;
+    u32 best_axis = 0;
+    u32 best_bin = 0;
+
+    for(u32 axis = 0; axis < 3; ++axis)
+    {
+        f32 cmin = centroid_bounds->min.elements[axis];
+        f32 extent = centroid_bounds->max.elements[axis] - cmin;
+        if(extent <= 0.0f) continue;
+
+        extents_3d bin_bounds[BVH_SAH_BINS];
+        u32 bin_counts[BVH_SAH_BINS];
+        for(u32 b = 0; b < BVH_SAH_BINS; ++b)
+        {
+            bin_bounds[b] = extents_empty();
+            bin_counts[b] = 0;
+        }
+
+        f32 scale = BVH_SAH_BINS / extent;
+        for(u32 i = 0; i < node->count; ++i)
+        {
+            u32 b = KMIN((u32)((item_centroid(tree, slots[i], axis) - cmin) * scale), BVH_SAH_BINS - 1);
+            bin_counts[b]++;
+            extents_grow(&bin_bounds[b], &tree->items[slots[i]].bounds);
+        }
+
+        // Площади и количества справа от каждой границы корзин.
+        f32 right_areas[BVH_SAH_BINS];
+        u32 right_counts[BVH_SAH_BINS];
+        extents_3d accumulated = extents_empty();
+        u32 count = 0;
+        for(u32 b = BVH_SAH_BINS - 1; b > 0; --b)
+        {
+            extents_grow(&accumulated, &bin_bounds[b]);
+            count += bin_counts[b];
+            right_areas[b] = count ? extents_area(&accumulated) : 0.0f;
+            right_counts[b] = count;
+        }
+
+        accumulated = extents_empty();
+        count = 0;
+        for(u32 b = 0; b < BVH_SAH_BINS - 1; ++b)
+        {
+            extents_grow(&accumulated, &bin_bounds[b]);
+            count += bin_counts[b];
+            if(!count || !right_counts[b + 1]) continue;
+
+            f32 cost = extents_area(&accumulated) * count + right_areas[b + 1] * right_counts[b + 1];
+            if(cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_bin = b;
+            }
+        }
+    }
+
+    // Стоимость разбиения относительно листа: обход узла (1) + проверки объектов потомков.
+    f32 node_area = extents_area(&node->bounds);
+    f32 split_cost = node_area > 0.0f ? 1.0f + best_cost / node_area : K_FLOAT_MAX;
+    if(best_cost == K_FLOAT_MAX || (split_cost >= node->count && node->count <= BVH_LEAF_MAX_ITEMS))
+    {
+        return 0;
+    }
+
+    // Разделение на месте: объекты из корзин до best_bin включительно перемещаются влево.
+    f32 cmin = centroid_bounds->min.elements[best_axis];
+    f32 scale = BVH_SAH_BINS / (centroid_bounds->max.elements[best_axis] - cmin);
+    u32 left = 0;
+    u32 right = node->count;
+    while(left < right)
+    {
+        u32 b = KMIN((u32)((item_centroid(tree, slots[left], best_axis) - cmin) * scale), BVH_SAH_BINS - 1);
+        if(b <= best_bin)
+        {
+            left++;
+        }
+        else
+        {
+            u32 t = slots[left];
+            slots[left] = slots[--right];
+            slots[right] = t;
+        }
+    }
+
+    return left;
+}
+
+void bvh_build(bvh* tree)
+{
+    if(!tree)
+    {
+        kerror("Function '%s' requires a valid pointer to bvh.", __FUNCTION__);
+        return;
+    }
+
+    // Сбор действующих объектов.
+    u32 item_count = 0;
+    for(u32 slot = 0; slot < tree->capacity; ++slot)
+    {
+        khandle handle;
+        if(!handle_pool_handle_get(tree->proxies, slot, &handle)) continue;
+        tree->item_slots[item_count++] = slot;
+        tree->items[slot].pending = INVALID_ID;
+    }
+
+    tree->node_count = 0;
+    tree->pending_count = 0;
+    tree->removed_count = 0;
+    tree->built_item_count = item_count;
+    tree->bounds_dirty = false;
+    tree->built_cost = 0.0f;
+
+    if(!item_count)
+    {
+        return;
+    }
+
+    tree->nodes[0].first = 0;
+    tree->nodes[0].count = item_count;
+    tree->nodes[0].parent = INVALID_ID;
+    tree->node_count = 1;
+
+    u32 stack_nodes[BVH_STACK_SIZE];
+    u32 stack_depths[BVH_STACK_SIZE];
+    u32 stack_size = 1;
+    stack_nodes[0] = 0;
+    stack_depths[0] = 0;
+
+    f32 cost = 0.0f;
+
+    while(stack_size)
+    {
+        --stack_size;
+        u32 index = stack_nodes[stack_size];
+        u32 depth = stack_depths[stack_size];
+        bvh_node* node = &tree->nodes[index];
+        tree->node_dirty[index] = false;
+
+        // Границы узла и границы центров объектов.
+        extents_3d centroid_bounds = extents_empty();
+        node->bounds = extents_empty();
+        for(u32 i = 0; i < node->count; ++i)
+        {
+            u32 slot = tree->item_slots[node->first + i];
+            extents_3d* b = &tree->items[slot].bounds;
+            extents_grow(&node->bounds, b);
+            vec3 c = extents_3d_half(*b);
+            extents_3d point = { c, c };
+            extents_grow(&centroid_bounds, &point);
+        }
+
+        u32 left_count = 0;
+        if(node->count > 1)
+        {
+            if(depth < BVH_SAH_MAX_DEPTH)
+            {
+                left_count = node_split_sah(tree, node, &centroid_bounds);
+
+                // Совпадающие центры не делятся по корзинам, такие узлы делятся пополам.
+                if(!left_count && node->count > BVH_LEAF_MAX_ITEMS)
+                {
+                    left_count = node->count / 2;
+                }
+            }
+            else
+            {
+                left_count = node->count / 2;
+            }
+        }
+
+        if(!left_count)
+        {
+            // Лист.
+            for(u32 i = 0; i < node->count; ++i)
+            {
+                tree->items[tree->item_slots[node->first + i]].leaf = index;
+            }
+            cost += extents_area(&node->bounds) * node->count;
+            continue;
+        }
+
+        // Внутренний узел: потомки размещаются парой после всех существующих узлов.
+        u32 left = tree->node_count;
+        tree->node_count += 2;
+        tree->nodes[left].first = node->first;
+        tree->nodes[left].count = left_count;
+        tree->nodes[left].parent = index;
+        tree->nodes[left + 1].first = node->first + left_count;
+        tree->nodes[left + 1].count = node->count - left_count;
+        tree->nodes[left + 1].parent = index;
+        node->first = left;
+        node->count = 0;
+        cost += extents_area(&node->bounds);
+
+        stack_nodes[stack_size] = left + 1;
+        stack_depths[stack_size++] = depth + 1;
+        stack_nodes[stack_size] = left;
+        stack_depths[stack_size++] = depth + 1;
+    }
+
+    f32 root_area = extents_area(&tree->nodes[0].bounds);
+    tree->built_cost = root_area > 0.0f ? cost / root_area : 0.0f;
+}
+
+void bvh_update(bvh* tree)
+{
+    if(!tree)
+    {
+        kerror("Function '%s' requires a valid pointer to bvh.", __FUNCTION__);
+        return;
+    }
+
+    // Перестроение при большом количестве добавленных и удаленных объектов.
+    u32 changes = tree->pending_count + tree->removed_count;
+    if(changes && changes >= KMAX(BVH_PENDING_MIN, tree->built_item_count / 8))
+    {
+        bvh_build(tree);
+        return;
+    }
+
+    if(!tree->bounds_dirty)
+    {
+        return;
+    }
+
+    // NOTE: Потомки находятся после родителя, поэтому обратный проход обновляет узлы снизу вверх,
+    //       а внутренний узел отмечается, если отмечен любой из его потомков.
+    f32 cost = 0.0f;
+    for(u32 i = tree->node_count; i-- > 0;)
+    {
+        bvh_node* node = &tree->nodes[i];
+
+        if(node->count)
+        {
+            if(tree->node_dirty[i])
+            {
+                node->bounds = extents_empty();
+                for(u32 j = 0; j < node->count; ++j)
+                {
+                    u32 slot = tree->item_slots[node->first + j];
+                    if(item_in_leaf(tree, slot, i))
+                    {
+                        extents_grow(&node->bounds, &tree->items[slot].bounds);
+                    }
+                }
+            }
+        }
+        else if(tree->node_dirty[node->first] || tree->node_dirty[node->first + 1])
+        {
+            tree->node_dirty[i] = true;
+            node->bounds = tree->nodes[node->first].bounds;
+            extents_grow(&node->bounds, &tree->nodes[node->first + 1].bounds);
+        }
+
+        cost += extents_area(&node->bounds) * (node->count ? node->count : 1);
+    }
+    kzero_tc(tree->node_dirty, u8, tree->node_count);
+    tree->bounds_dirty = false;
+
+    // Перестроение при заметном ухудшении дерева (объекты разошлись далеко от исходного положения).
+    f32 root_area = extents_area(&tree->nodes[0].bounds);
+    if(root_area > 0.0f && cost / root_area > tree->built_cost * BVH_REBUILD_COST_RATIO)
+    {
+        bvh_build(tree);
+    }
+}
+
+// Добавляет все объекты поддерева без проверок.
+static u32 subtree_collect(const bvh* tree, u32 root, u32* out_items, u32 max_items, u32 count)
+{
+    u32 stack[BVH_STACK_SIZE];
+    u32 stack_size = 0;
+    stack[stack_size++] = root;
+
+    while(stack_size)
+    {
+        u32 index = stack[--stack_size];
+        const bvh_node* node = &tree->nodes[index];
+
+        if(node->count)
+        {
+            for(u32 i = 0; i < node->count; ++i)
+            {
+                u32 slot = tree->item_slots[node->first + i];
+                if(!item_in_leaf(tree, slot, index)) continue;
+                count = result_push(out_items, max_items, count, tree->items[slot].user_data);
+            }
+        }
+        else
+        {
+            stack[stack_size++] = node->first + 1;
+            stack[stack_size++] = node->first;
+        }
+    }
+
+    return count;
+}
+
+// Проверяет прямоугольник по плоскостям из маски, возвращает -1 если он снаружи, иначе новую маску.
+static KINLINE i32 frustum_test_extents(const frustum* f, const extents_3d* e, u32 mask)
+{
+    vec3 center = extents_3d_half(*e);
+    vec3 half = vec3_mul_scalar(vec3_sub(e->max, e->min), 0.5f);
+
+    for(u32 i = 0; i < FRUSTUM_SIDES_MAX; ++i)
+    {
+        if(!(mask & (1u << i))) continue;
+
+        const plane_3d* p = &f->sides[i];
+        f32 r = half.x * kabs(p->normal.x) + half.y * kabs(p->normal.y) + half.z * kabs(p->normal.z);
+        f32 d = vec3_dot(p->normal, center) - p->distance;
+
+        if(d < -r) return -1;
+        // Прямоугольник полностью с внутренней стороны плоскости, потомкам ее проверять не нужно.
+        if(d >= r) mask &= ~(1u << i);
+    }
+
+    return (i32)mask;
+}
+
+u32 bvh_query_frustum(const bvh* tree, const frustum* f, u32* out_items, u32 max_items)
+{
+    if(!tree || !f || (!out_items && max_items))
+    {
+        kerror("Function '%s' requires a valid pointers to bvh, frustum and out_items.", __FUNCTION__);
+        return 0;
+    }
+
+    const u32 all_planes = (1u << FRUSTUM_SIDES_MAX) - 1;
+    u32 count = 0;
+
+    if(tree->node_count)
+    {
+        u32 stack_nodes[BVH_STACK_SIZE];
+        u32 stack_masks[BVH_STACK_SIZE];
+        u32 stack_size = 0;
+        stack_nodes[stack_size] = 0;
+        stack_masks[stack_size++] = all_planes;
+
+        while(stack_size)
+        {
+            --stack_size;
+            u32 index = stack_nodes[stack_size];
+            const bvh_node* node = &tree->nodes[index];
+
+            i32 mask = frustum_test_extents(f, &node->bounds, stack_masks[stack_size]);
+            if(mask < 0) continue;
+
+            if(mask == 0)
+            {
+                count = subtree_collect(tree, index, out_items, max_items, count);
+            }
+            else if(node->count)
+            {
+                for(u32 i = 0; i < node->count; ++i)
+                {
+                    u32 slot = tree->item_slots[node->first + i];
+                    if(!item_in_leaf(tree, slot, index)) continue;
+                    if(node->count > 1 && frustum_test_extents(f, &tree->items[slot].bounds, (u32)mask) < 0) continue;
+                    count = result_push(out_items, max_items, count, tree->items[slot].user_data);
+                }
+            }
+            else
+            {
+                stack_nodes[stack_size] = node->first + 1;
+                stack_masks[stack_size++] = (u32)mask;
+                stack_nodes[stack_size] = node->first;
+                stack_masks[stack_size++] = (u32)mask;
+            }
+        }
+    }
+
+    for(u32 i = 0; i < tree->pending_count; ++i)
+    {
+        const bvh_item* item = &tree->items[tree->pending_slots[i]];
+        if(frustum_test_extents(f, &item->bounds, all_planes) < 0) continue;
+        count = result_push(out_items, max_items, count, item->user_data);
+    }
+
+    return count;
+}
+
+u32 bvh_query_sphere(const bvh* tree, vec3 center, f32 radius, u32* out_items, u32 max_items)
+{
+    if(!tree || (!out_items && max_items))
+    {
+        kerror("Function '%s' requires a valid pointers to bvh and out_items.", __FUNCTION__);
+        return 0;
+    }
+
+    f32 radius_squared = radius * radius;
+    u32 count = 0;
+
+    if(tree->node_count)
+    {
+        u32 stack[BVH_STACK_SIZE];
+        u32 stack_size = 0;
+        stack[stack_size++] = 0;
+
+        while(stack_size)
+        {
+            u32 index = stack[--stack_size];
+            const bvh_node* node = &tree->nodes[index];
+            if(!extents_intersects_sphere(&node->bounds, center, radius_squared)) continue;
+
+            if(node->count)
+            {
+                for(u32 i = 0; i < node->count; ++i)
+                {
+                    u32 slot = tree->item_slots[node->first + i];
+                    if(!item_in_leaf(tree, slot, index)) continue;
+                    if(!extents_intersects_sphere(&tree->items[slot].bounds, center, radius_squared)) continue;
+                    count = result_push(out_items, max_items, count, tree->items[slot].user_data);
+                }
+            }
+            else
+            {
+                stack[stack_size++] = node->first + 1;
+                stack[stack_size++] = node->first;
+            }
+        }
+    }
+
+    for(u32 i = 0; i < tree->pending_count; ++i)
+    {
+        const bvh_item* item = &tree->items[tree->pending_slots[i]];
+        if(!extents_intersects_sphere(&item->bounds, center, radius_squared)) continue;
+        count = result_push(out_items, max_items, count, item->user_data);
+    }
+
+    return count;
+}
+
+u32 bvh_query_aabb(const bvh* tree, extents_3d bounds, u32* out_items, u32 max_items)
+{
+    if(!tree || (!out_items && max_items))
+    {
+        kerror("Function '%s' requires a valid pointers to bvh and out_items.", __FUNCTION__);
+        return 0;
+    }
+
+    u32 count = 0;
+
+    if(tree->node_count)
+    {
+        u32 stack[BVH_STACK_SIZE];
+        u32 stack_size = 0;
+        stack[stack_size++] = 0;
+
+        while(stack_size)
+        {
+            u32 index = stack[--stack_size];
+            const bvh_node* node = &tree->nodes[index];
+            if(!extents_overlap(&node->bounds, &bounds)) continue;
+
+            if(node->count)
+            {
+                for(u32 i = 0; i < node->count; ++i)
+                {
+                    u32 slot = tree->item_slots[node->first + i];
+                    if(!item_in_leaf(tree, slot, index)) continue;
+                    if(!extents_overlap(&tree->items[slot].bounds, &bounds)) continue;
+                    count = result_push(out_items, max_items, count, tree->items[slot].user_data);
+                }
+            }
+            else
+            {
+                stack[stack_size++] = node->first + 1;
+                stack[stack_size++] = node->first;
+            }
+        }
+    }
+
+    for(u32 i = 0; i < tree->pending_count; ++i)
+    {
+        const bvh_item* item = &tree->items[tree->pending_slots[i]];
+        if(!extents_overlap(&item->bounds, &bounds)) continue;
+        count = result_push(out_items, max_items, count, item->user_data);
+    }
+
+    return count;
+}
+
+// Проверяет объект лучом и обновляет ближайшее пересечение, возвращает true если оно обновлено.
+static KINLINE bool ray_test_item(
+    const bvh_item* item, vec3 origin, vec3 direction, vec3 inv_direction, PFN_bvh_ray_test test, void* context,
+    bvh_ray_hit* hit
+)
+{
+    f32 distance = extents_ray_distance(&item->bounds, origin, inv_direction, hit->distance);
+    if(distance == K_INFINITY) return false;
+
+    if(test && !test(item->user_data, origin, direction, hit->distance, &distance, context)) return false;
+    if(distance >= hit->distance) return false;
+
+    hit->distance = distance;
+    hit->user_data = item->user_data;
+    return true;
+}
+
+bool bvh_raycast(
+    const bvh* tree, vec3 origin, vec3 direction, f32 max_distance, PFN_bvh_ray_test test, void* context, bvh_ray_hit* out_hit
+)
+{
+    if(!tree || !out_hit)
+    {
+        kerror("Function '%s' requires a valid pointers to bvh and out_hit.", __FUNCTION__);
+        return false;
+    }
+
+    // NOTE: Деление на ноль дает бесконечность, что корректно обрабатывается проверкой пересечения.
+    vec3 inv_direction = vec3_create(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    bvh_ray_hit hit = { INVALID_ID, max_distance };
+    bool found = false;
+
+    if(tree->node_count && extents_ray_distance(&tree->nodes[0].bounds, origin, inv_direction, hit.distance) != K_INFINITY)
+    {
+        u32 stack_nodes[BVH_STACK_SIZE];
+        f32 stack_distances[BVH_STACK_SIZE];
+        u32 stack_size = 0;
+        stack_nodes[stack_size] = 0;
+        stack_distances[stack_size++] = 0.0f;
+
+        while(stack_size)
+        {
+            --stack_size;
+            if(stack_distances[stack_size] >= hit.distance) continue;
+
+            u32 index = stack_nodes[stack_size];
+            const bvh_node* node = &tree->nodes[index];
+
+            if(node->count)
+            {
+                for(u32 i = 0; i < node->count; ++i)
+                {
+                    u32 slot = tree->item_slots[node->first + i];
+                    if(!item_in_leaf(tree, slot, index)) continue;
+                    found |= ray_test_item(&tree->items[slot], origin, direction, inv_direction, test, context, &hit);
+                }
+                continue;
+            }
+
+            // Ближний потомок обходится первым (кладется в стек последним).
+            u32 near = node->first;
+            u32 far = node->first + 1;
+            f32 near_distance = extents_ray_distance(&tree->nodes[near].bounds, origin, inv_direction, hit.distance);
+            f32 far_distance = extents_ray_distance(&tree->nodes[far].bounds, origin, inv_direction, hit.distance);
+            if(far_distance < near_distance)
+            {
+                u32 t = near; near = far; far = t;
+                f32 d = near_distance; near_distance = far_distance; far_distance = d;
+            }
+
+            if(far_distance != K_INFINITY)
+            {
+                stack_nodes[stack_size] = far;
+                stack_distances[stack_size++] = far_distance;
+            }
+            if(near_distance != K_INFINITY)
+            {
+                stack_nodes[stack_size] = near;
+                stack_distances[stack_size++] = near_distance;
+            }
+        }
+    }
+
+    for(u32 i = 0; i < tree->pending_count; ++i)
+    {
+        found |= ray_test_item(&tree->items[tree->pending_slots[i]], origin, direction, inv_direction, test, context, &hit);
+    }
+
+    if(!found)
+    {
+        return false;
+    }
+
+    *out_hit = hit;
+    return true;
+}
+
+u32 bvh_count(const bvh* tree)
+{
+    if(!tree) return 0;
+    return handle_pool_count(tree->proxies);
+}
+
+u32 bvh_node_count(const bvh* tree)
+{
+    if(!tree) return 0;
+    return tree->node_count;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+#include <containers/handle_pool.h>
+
+/*
+    @brief Контекст иерархии ограничивающих объемов (BVH) по мировым границам объектов.
+    NOTE: Дерево строится по эвристике площади поверхности (SAH) и хранится плоским массивом узлов,
+          в котором потомки всегда находятся после родителя. Перемещение объектов обрабатывается
+          обновлением границ только измененных ветвей, перестроение выполняется при добавлении
+          и удалении большого числа объектов или при заметном ухудшении качества дерева.
+*/
+typedef struct bvh bvh;
+
+// @brief Результат пересечения луча с объектом иерархии.
+typedef struct bvh_ray_hit {
+    // @brief Пользовательские данные объекта.
+    u32 user_data;
+    // @brief Расстояние от начала луча до пересечения (в длинах вектора направления).
+    f32 distance;
+} bvh_ray_hit;
+
+/*
+    @brief Функция точной проверки пересечения луча с объектом, границы которого пересекает луч.
+    @param user_data Пользовательские данные объекта.
+    @param origin Начало луча.
+    @param direction Направление луча.
+    @param max_distance Расстояние до ближайшего найденного пересечения.
+    @param out_distance Указатель для сохранения расстояния до пересечения.
+    @param context Пользовательский контекст запроса.
+    @return True если луч пересекает объект ближе max_distance, false если нет.
+*/
+typedef bool (*PFN_bvh_ray_test)(u32 user_data, vec3 origin, vec3 direction, f32 max_distance, f32* out_distance, void* context);
+
+/*
+    @brief Создает иерархию или получает требования к памяти.
+    NOTE: Вызывается дважды, первый для получения требований и второй для создания иерархии.
+    @param max_item_count Максимальное количество объектов.
+    @param memory_requirement Указатель для хранения требований к памяти.
+    @param memory Указатель выделенную память, или null для получения требований.
+    @return Указатель на экземпляр иерархии или null при получении требований или ошибках.
+*/
+KAPI bvh* bvh_create(u32 max_item_count, u64* memory_requirement, void* memory);
+
+/*
+    @brief Уничтожает иерархию.
+    NOTE: После использования в этой функции, указатель на иерархию нужно обнулить самостоятельно.
+    @param tree Указатель на экземпляр иерархии.
+*/
+KAPI void bvh_destroy(bvh* tree);
+
+/*
+    @brief Добавляет объект в иерархию.
+    NOTE: До следующего вызова bvh_update объект проверяется запросами отдельно от дерева (линейно).
+    @param tree Указатель на экземпляр иерархии.
+    @param bounds Мировые границы объекта.
+    @param user_data Пользовательские данные, возвращаемые запросами.
+    @param out_proxy Указатель для сохранения дескриптора объекта.
+    @return True в случае успеха, false если иерархия заполнена или при ошибках.
+*/
+KAPI bool bvh_insert(bvh* tree, extents_3d bounds, u32 user_data, khandle* out_proxy);
+
+/*
+    @brief Удаляет объект из иерархии, дескриптор становится недействительным.
+    @param tree Указатель на экземпляр иерархии.
+    @param proxy Дескриптор объекта.
+    @return True в случае успеха, false если дескриптор недействителен.
+*/
+KAPI bool bvh_remove(bvh* tree, khandle proxy);
+
+/*
+    @brief Изменяет границы объекта (например, после перемещения).
+    NOTE: Границы узлов обновляются при следующем вызове bvh_update.
+    @param tree Указатель на экземпляр иерархии.
+    @param proxy Дескриптор объекта.
+    @param bounds Новые мировые границы объекта.
+    @return True в случае успеха, false если дескриптор недействителен.
+*/
+KAPI bool bvh_move(bvh* tree, khandle proxy, extents_3d bounds);
+
+/*
+    @brief Изменяет пользовательские данные объекта (например, после перемещения объекта в массиве владельца).
+    @param tree Указатель на экземпляр иерархии.
+    @param proxy Дескриптор объекта.
+    @param user_data Новые пользовательские данные.
+    @return True в случае успеха, false если дескриптор недействителен.
+*/
+KAPI bool bvh_set_user_data(bvh* tree, khandle proxy, u32 user_data);
+
+/*
+    @brief Полностью перестраивает дерево по эвристике площади поверхности.
+    @param tree Указатель на экземпляр иерархии.
+*/
+KAPI void bvh_build(bvh* tree);
+
+/*
+    @brief Применяет изменения к дереву: обновляет границы измененных ветвей или перестраивает дерево.
+    NOTE: Вызывается один раз за кадр после изменения объектов и до запросов.
+    @param tree Указатель на экземпляр иерархии.
+*/
+KAPI void bvh_update(bvh* tree);
+
+/*
+    @brief Находит объекты, границы которых пересекают усеченную пирамиду или содержатся в ней.
+    @param tree Указатель на экземпляр иерархии.
+    @param f Указатель на усеченную пирамиду (нормали направлены внутрь).
+    @param out_items Массив для сохранения пользовательских данных найденных объектов.
+    @param max_items Размер массива out_items.
+    @return Количество найденных объектов (в массив записывается не более max_items).
+*/
+KAPI u32 bvh_query_frustum(const bvh* tree, const frustum* f, u32* out_items, u32 max_items);
+
+/*
+    @brief Находит объекты, границы которых пересекают сферу.
+    @param tree Указатель на экземпляр иерархии.
+    @param center Центр сферы.
+    @param radius Радиус сферы.
+    @param out_items Массив для сохранения пользовательских данных найденных объектов.
+    @param max_items Размер массива out_items.
+    @return Количество найденных объектов (в массив записывается не более max_items).
+*/
+KAPI u32 bvh_query_sphere(const bvh* tree, vec3 center, f32 radius, u32* out_items, u32 max_items);
+
+/*
+    @brief Находит объекты, границы которых пересекают выровненный по осям прямоугольник.
+    @param tree Указатель на экземпляр иерархии.
+    @param bounds Границы прямоугольника.
+    @param out_items Массив для сохранения пользовательских данных найденных объектов.
+    @param max_items Размер массива out_items.
+    @return Количество найденных объектов (в массив записывается не более max_items).
+*/
+KAPI u32 bvh_query_aabb(const bvh* tree, extents_3d bounds, u32* out_items, u32 max_items);
+
+/*
+    @brief Находит ближайший объект, пересекаемый лучом.
+    NOTE: Узлы обходятся от ближнего к дальнему, ветви дальше найденного пересечения пропускаются.
+    @param tree Указатель на экземпляр иерархии.
+    @param origin Начало луча.
+    @param direction Направление луча (нормализация не требуется).
+    @param max_distance Максимальное расстояние в длинах вектора направления.
+    @param test Функция точной проверки объекта или null для проверки только по границам.
+    @param context Пользовательский контекст для функции проверки.
+    @param out_hit Указатель для сохранения ближайшего пересечения.
+    @return True если луч пересекает объект, false если нет или при ошибках.
+*/
+KAPI bool bvh_raycast(
+    const bvh* tree, vec3 origin, vec3 direction, f32 max_distance, PFN_bvh_ray_test test, void* context, bvh_ray_hit* out_hit
+);
+
+/*
+    @brief Возвращает количество объектов иерархии.
+    @param tree Указатель на экземпляр иерархии.
+    @return Количество объектов или 0 при ошибках.
+*/
+KAPI u32 bvh_count(const bvh* tree);
+
+/*
+    @brief Возвращает количество узлов дерева.
+    @param tree Указатель на экземпляр иерархии.
+    @return Количество узлов или 0 при ошибках.
+*/
+KAPI u32 bvh_node_count(const bvh* tree);
@@ -0,0 +1,948 @@
+// Cобственные подключения.
+#include "math/geometry_optimizer.h"
+
+// Внутренние подключения.
+#include "math/kmath.h"
+#include "memory/memory.h"
+
+// Смотри: https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+//         https://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/tipsy.pdf
+
+// Размер кэша, моделируемого при упорядочивании (LRU).
+#define FORSYTH_CACHE_SIZE        32
+// Максимальная валентность вершины с табличной оценкой (остальные получают оценку последней).
+#define FORSYTH_MAX_VALENCE       32
+#define FORSYTH_LAST_TRI_SCORE    0.75f
+#define FORSYTH_VALENCE_BOOST     2.0f
+
+// @brief Таблицы оценок вершин по позиции в кэше и количеству оставшихся треугольников.
+typedef struct forsyth_tables {
+    f32 cache[FORSYTH_CACHE_SIZE];
+    f32 valence[FORSYTH_MAX_VALENCE + 1];
+} forsyth_tables;
+
+static void forsyth_tables_init(forsyth_tables* tables)
+{
+    for(u32 i = 0; i < FORSYTH_CACHE_SIZE; ++i)
+    {
+        if(i < 3)
+        {
+            // Вершины последнего треугольника получают фиксированную оценку, чтобы не выбирать его снова.
+            tables->cache[i] = FORSYTH_LAST_TRI_SCORE;
+        }
+        else
+        {
+            f32 score = 1.0f - (f32)(i - 3) / (FORSYTH_CACHE_SIZE - 3);
+            tables->cache[i] = score * ksqrt(score);
+        }
+    }
+
+    tables->valence[0] = 0.0f;
+    for(u32 i = 1; i <= FORSYTH_MAX_VALENCE; ++i)
+    {
+        tables->valence[i] = FORSYTH_VALENCE_BOOST / ksqrt((f32)i);
+    }
+}
+
+KINLINE f32 forsyth_vertex_score(const forsyth_tables* tables, i32 cache_position, u32 remaining)
+{
+    if(!remaining)
+    {
+        return -1.0f;
+    }
+
+    f32 score = cache_position >= 0 ? tables->cache[cache_position] : 0.0f;
+    return score + tables->valence[KMIN(remaining, FORSYTH_MAX_VALENCE)];
+}
+
+void geometry_analyze_vertex_cache(
+    u32 index_count, const u32* indices, u32 vertex_count, u32 cache_size, geometry_vertex_cache_stats* out_stats
+)
+{
+    kzero_tc(out_stats, geometry_vertex_cache_stats, 1);
+    if(!index_count || !vertex_count)
+    {
+        return;
+    }
+
+    // FIFO кэш: вершина в кэше, если с момента ее загрузки было меньше cache_size промахов.
+    u32* cache_time = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    kzero_tc(cache_time, u32, vertex_count);
+
+    u32 timestamp = cache_size + 1;
+    u32 used_vertices = 0;
+
+    for(u32 i = 0; i < index_count; ++i)
+    {
+        u32 v = indices[i];
+
+        if(!cache_time[v])
+        {
+            used_vertices++;
+        }
+
+        if(timestamp - cache_time[v] > cache_size)
+        {
+            cache_time[v] = timestamp++;
+            out_stats->misses++;
+        }
+    }
+
+    out_stats->acmr = (f32)out_stats->misses / (index_count / 3);
+    out_stats->atvr = used_vertices ? (f32)out_stats->misses / used_vertices : 0.0f;
+
+    kfree_tc(cache_time, u32, vertex_count, MEMORY_TAG_ARRAY);
+}
+
+void geometry_optimize_vertex_cache(u32 index_count, u32* indices, u32 vertex_count)
+{
+    u32 triangle_count = index_count / 3;
+    if(!triangle_count || !vertex_count)
+    {
+        return;
+    }
+
+    forsyth_tables tables;
+    forsyth_tables_init(&tables);
+
+    // Списки смежных треугольников вершин: живые треугольники хранятся в начале списка вершины.
+    u32* adjacency_offsets = kallocate_tc(u32, vertex_count + 1, MEMORY_TAG_ARRAY);
+    u32* remaining = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    u32* adjacency = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    kzero_tc(remaining, u32, vertex_count);
+
+    for(u32 i = 0; i < index_count; ++i)
+    {
+        remaining[indices[i]]++;
+    }
+
+    adjacency_offsets[0] = 0;
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        adjacency_offsets[v + 1] = adjacency_offsets[v] + remaining[v];
+        remaining[v] = 0;
+    }
+
+    for(u32 i = 0; i < index_count; ++i)
+    {
+        u32 v = indices[i];
+        adjacency[adjacency_offsets[v] + remaining[v]++] = i / 3;
+    }
+
+    // Оценки вершин и треугольников.
+    i32* cache_position = kallocate_tc(i32, vertex_count, MEMORY_TAG_ARRAY);
+    f32* vertex_score = kallocate_tc(f32, vertex_count, MEMORY_TAG_ARRAY);
+    f32* triangle_score = kallocate_tc(f32, triangle_count, MEMORY_TAG_ARRAY);
+    bool* emitted = kallocate_tc(bool, triangle_count, MEMORY_TAG_ARRAY);
+    u32* source = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    kzero_tc(emitted, bool, triangle_count);
+    kcopy_tc(source, indices, u32, index_count);
+
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        cache_position[v] = -1;
+        vertex_score[v] = forsyth_vertex_score(&tables, -1, remaining[v]);
+    }
+
+    u32 best_triangle = 0;
+    f32 best_score = -1.0f;
+    for(u32 t = 0; t < triangle_count; ++t)
+    {
+        triangle_score[t] = vertex_score[source[t * 3]] + vertex_score[source[t * 3 + 1]] + vertex_score[source[t * 3 + 2]];
+        if(triangle_score[t] > best_score)
+        {
+            best_score = triangle_score[t];
+            best_triangle = t;
+        }
+    }
+
+    u32 cache[FORSYTH_CACHE_SIZE + 3];
+    u32 cache_count = 0;
+    u32 next_unemitted = 0;
+
+    for(u32 output = 0; output < triangle_count; ++output)
+    {
+        // Если в кэше нет подходящих треугольников - следующий по порядку.
+        if(best_triangle == INVALID_ID)
+        {
+            while(emitted[next_unemitted]) next_unemitted++;
+            best_triangle = next_unemitted;
+        }
+
+        const u32* triangle = &source[best_triangle * 3];
+        indices[output * 3 + 0] = triangle[0];
+        indices[output * 3 + 1] = triangle[1];
+        indices[output * 3 + 2] = triangle[2];
+        emitted[best_triangle] = true;
+
+        // Удаление треугольника из списков смежности его вершин.
+        for(u32 k = 0; k < 3; ++k)
+        {
+            u32 v = triangle[k];
+            u32* list = &adjacency[adjacency_offsets[v]];
+            for(u32 j = 0; j < remaining[v]; ++j)
+            {
+                if(list[j] == best_triangle)
+                {
+                    list[j] = list[remaining[v] - 1];
+                    remaining[v]--;
+                    break;
+                }
+            }
+        }
+
+        // Обновление LRU кэша: вершины треугольника в начало, остальные сдвигаются.
+        u32 new_cache[FORSYTH_CACHE_SIZE + 3];
+        u32 new_count = 0;
+        // NOTE: Вырожденные треугольники могут повторять вершину.
+        new_cache[new_count++] = triangle[0];
+        if(triangle[1] != triangle[0])
+        {
+            new_cache[new_count++] = triangle[1];
+        }
+        if(triangle[2] != triangle[0] && triangle[2] != triangle[1])
+        {
+            new_cache[new_count++] = triangle[2];
+        }
+
+        for(u32 j = 0; j < cache_count; ++j)
+        {
+            u32 v = cache[j];
+            if(v != triangle[0] && v != triangle[1] && v != triangle[2])
+            {
+                new_cache[new_count++] = v;
+            }
+        }
+
+        // Пересчет оценок затронутых вершин и их треугольников (включая вытесненные вершины).
+        for(u32 j = 0; j < new_count; ++j)
+        {
+            u32 v = new_cache[j];
+            cache_position[v] = j < FORSYTH_CACHE_SIZE ? (i32)j : -1;
+
+            f32 score = forsyth_vertex_score(&tables, cache_position[v], remaining[v]);
+            f32 delta = score - vertex_score[v];
+            vertex_score[v] = score;
+
+            const u32* list = &adjacency[adjacency_offsets[v]];
+            for(u32 a = 0; a < remaining[v]; ++a)
+            {
+                triangle_score[list[a]] += delta;
+            }
+        }
+
+        cache_count = KMIN(new_count, FORSYTH_CACHE_SIZE);
+        kcopy_tc(cache, new_cache, u32, cache_count);
+
+        // Выбор лучшего треугольника среди смежных с вершинами в кэше.
+        best_triangle = INVALID_ID;
+        best_score = -1.0f;
+        for(u32 j = 0; j < cache_count; ++j)
+        {
+            u32 v = cache[j];
+            const u32* list = &adjacency[adjacency_offsets[v]];
+            for(u32 a = 0; a < remaining[v]; ++a)
+            {
+                if(triangle_score[list[a]] > best_score)
+                {
+                    best_score = triangle_score[list[a]];
+                    best_triangle = list[a];
+                }
+            }
+        }
+    }
+
+    kfree_tc(adjacency_offsets, u32, vertex_count + 1, MEMORY_TAG_ARRAY);
+    kfree_tc(remaining, u32, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(adjacency, u32, index_count, MEMORY_TAG_ARRAY);
+    kfree_tc(cache_position, i32, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(vertex_score, f32, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(triangle_score, f32, triangle_count, MEMORY_TAG_ARRAY);
+    kfree_tc(emitted, bool, triangle_count, MEMORY_TAG_ARRAY);
+    kfree_tc(source, u32, index_count, MEMORY_TAG_ARRAY);
+}
+
+// @brief Ключ сортировки кластера.
+typedef struct overdraw_cluster {
+    f32 sort_key;
+    u32 index;
+} overdraw_cluster;
+
+// @brief Моделирует загрузку вершин треугольника в FIFO кэш и возвращает количество промахов.
+KINLINE u32 overdraw_triangle_misses(const u32* triangle, u32* cache_time, u32* timestamp)
+{
+    u32 misses = 0;
+    for(u32 k = 0; k < 3; ++k)
+    {
+        u32 v = triangle[k];
+        if(*timestamp - cache_time[v] > GEOMETRY_VERTEX_CACHE_SIZE)
+        {
+            cache_time[v] = (*timestamp)++;
+            misses++;
+        }
+    }
+    return misses;
+}
+
+// @brief Устойчивая сортировка кластеров по убыванию ключа (слиянием снизу вверх).
+static void overdraw_clusters_sort(overdraw_cluster* clusters, overdraw_cluster* temp, u32 count)
+{
+    overdraw_cluster* src = clusters;
+    overdraw_cluster* dst = temp;
+
+    for(u32 width = 1; width < count; width *= 2)
+    {
+        for(u32 left = 0; left < count; left += width * 2)
+        {
+            u32 middle = KMIN(left + width, count);
+            u32 right = KMIN(left + width * 2, count);
+            u32 i = left, j = middle, k = left;
+
+            while(i < middle && j < right)
+            {
+                dst[k++] = src[i].sort_key >= src[j].sort_key ? src[i++] : src[j++];
+            }
+            while(i < middle) dst[k++] = src[i++];
+            while(j < right) dst[k++] = src[j++];
+        }
+
+        overdraw_cluster* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if(src != clusters)
+    {
+        kcopy_tc(clusters, src, overdraw_cluster, count);
+    }
+}
+
+void geometry_optimize_overdraw(u32 index_count, u32* indices, u32 vertex_count, const vertex_3d* vertices, f32 threshold)
+{
+    u32 triangle_count = index_count / 3;
+    if(triangle_count < 2 || !vertex_count)
+    {
+        return;
+    }
+
+    u32* cache_time = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    u32* cluster_starts = kallocate_tc(u32, triangle_count + 1, MEMORY_TAG_ARRAY);
+    kzero_tc(cache_time, u32, vertex_count);
+    u32 timestamp = GEOMETRY_VERTEX_CACHE_SIZE + 1;
+
+    // Жесткие границы: треугольники, все вершины которых отсутствуют в кэше.
+    u32* hard_starts = kallocate_tc(u32, triangle_count + 1, MEMORY_TAG_ARRAY);
+    u32 hard_count = 0;
+    for(u32 t = 0; t < triangle_count; ++t)
+    {
+        u32 misses = overdraw_triangle_misses(&indices[t * 3], cache_time, &timestamp);
+        if(t == 0 || misses == 3)
+        {
+            hard_starts[hard_count++] = t;
+        }
+    }
+    hard_starts[hard_count] = triangle_count;
+
+    // Мягкие границы: дополнительное разбиение, пока ACMR части не хуже ACMR жесткого кластера с учетом порога.
+    u32 cluster_count = 0;
+    for(u32 h = 0; h < hard_count; ++h)
+    {
+        u32 start = hard_starts[h];
+        u32 end = hard_starts[h + 1];
+
+        // ACMR кластера при пустом кэше в начале.
+        timestamp += GEOMETRY_VERTEX_CACHE_SIZE + 1;
+        u32 cluster_misses = 0;
+        for(u32 t = start; t < end; ++t)
+        {
+            cluster_misses += overdraw_triangle_misses(&indices[t * 3], cache_time, &timestamp);
+        }
+        f32 cluster_threshold = threshold * cluster_misses / (end - start);
+
+        timestamp += GEOMETRY_VERTEX_CACHE_SIZE + 1;
+        cluster_starts[cluster_count++] = start;
+        u32 soft_start = start;
+        u32 soft_misses = 0;
+        for(u32 t = start; t < end; ++t)
+        {
+            soft_misses += overdraw_triangle_misses(&indices[t * 3], cache_time, &timestamp);
+
+            if(t + 1 < end && (f32)soft_misses / (t + 1 - soft_start) <= cluster_threshold)
+            {
+                // Новый кластер начинается с пустым кэшем.
+                cluster_starts[cluster_count++] = t + 1;
+                soft_start = t + 1;
+                soft_misses = 0;
+                timestamp += GEOMETRY_VERTEX_CACHE_SIZE + 1;
+            }
+        }
+    }
+    cluster_starts[cluster_count] = triangle_count;
+
+    // Центр сетки (по площади треугольников).
+    vec3 mesh_center = vec3_zero();
+    f32 mesh_area = 0.0f;
+    for(u32 t = 0; t < triangle_count; ++t)
+    {
+        vec3 p0 = vertices[indices[t * 3 + 0]].position;
+        vec3 p1 = vertices[indices[t * 3 + 1]].position;
+        vec3 p2 = vertices[indices[t * 3 + 2]].position;
+        f32 area = vec3_length(vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0)));
+        vec3 center = vec3_mul_scalar(vec3_add(vec3_add(p0, p1), p2), area / 3.0f);
+        mesh_center = vec3_add(mesh_center, center);
+        mesh_area += area;
+    }
+    mesh_center = mesh_area > 0.0f ? vec3_mul_scalar(mesh_center, 1.0f / mesh_area) : vec3_zero();
+
+    // Ключ кластера: удаленность центра кластера от центра сетки вдоль средней нормали кластера.
+    overdraw_cluster* clusters = kallocate_tc(overdraw_cluster, cluster_count * 2, MEMORY_TAG_ARRAY);
+    for(u32 c = 0; c < cluster_count; ++c)
+    {
+        vec3 center = vec3_zero();
+        vec3 normal = vec3_zero();
+        f32 area = 0.0f;
+
+        for(u32 t = cluster_starts[c]; t < cluster_starts[c + 1]; ++t)
+        {
+            vec3 p0 = vertices[indices[t * 3 + 0]].position;
+            vec3 p1 = vertices[indices[t * 3 + 1]].position;
+            vec3 p2 = vertices[indices[t * 3 + 2]].position;
+            vec3 cross = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+            f32 triangle_area = vec3_length(cross);
+
+            center = vec3_add(center, vec3_mul_scalar(vec3_add(vec3_add(p0, p1), p2), triangle_area / 3.0f));
+            normal = vec3_add(normal, cross);
+            area += triangle_area;
+        }
+
+        f32 normal_length = vec3_length(normal);
+        center = area > 0.0f ? vec3_mul_scalar(center, 1.0f / area) : center;
+        normal = normal_length > 0.0f ? vec3_mul_scalar(normal, 1.0f / normal_length) : normal;
+
+        clusters[c].sort_key = vec3_dot(vec3_sub(center, mesh_center), normal);
+        clusters[c].index = c;
+    }
+
+    overdraw_clusters_sort(clusters, clusters + cluster_count, cluster_count);
+
+    // Запись треугольников в порядке кластеров.
+    u32* source = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    kcopy_tc(source, indices, u32, index_count);
+
+    u32 offset = 0;
+    for(u32 c = 0; c < cluster_count; ++c)
+    {
+        u32 cluster = clusters[c].index;
+        u32 start = cluster_starts[cluster];
+        u32 count = cluster_starts[cluster + 1] - start;
+        kcopy_tc(&indices[offset], &source[start * 3], u32, count * 3);
+        offset += count * 3;
+    }
+
+    kfree_tc(source, u32, index_count, MEMORY_TAG_ARRAY);
+    kfree_tc(clusters, overdraw_cluster, cluster_count * 2, MEMORY_TAG_ARRAY);
+    kfree_tc(hard_starts, u32, triangle_count + 1, MEMORY_TAG_ARRAY);
+    kfree_tc(cluster_starts, u32, triangle_count + 1, MEMORY_TAG_ARRAY);
+    kfree_tc(cache_time, u32, vertex_count, MEMORY_TAG_ARRAY);
+}
+
+u32 geometry_optimize_vertex_fetch(u32 index_count, u32* indices, u32 vertex_count, u32 vertex_size, void* vertices)
+{
+    if(!vertex_count)
+    {
+        return 0;
+    }
+
+    u32* remap = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    kset_tc(remap, u32, vertex_count, 0xFF);
+
+    // Новые номера вершин в порядке первого использования.
+    u32 used_count = 0;
+    for(u32 i = 0; i < index_count; ++i)
+    {
+        u32 v = indices[i];
+        if(remap[v] == INVALID_ID)
+        {
+            remap[v] = used_count++;
+        }
+        indices[i] = remap[v];
+    }
+
+    // Неиспользуемые вершины в конец.
+    u32 next = used_count;
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        if(remap[v] == INVALID_ID)
+        {
+            remap[v] = next++;
+        }
+    }
+
+    u64 buffer_size = (u64)vertex_count * vertex_size;
+    u8* buffer = kallocate(buffer_size, MEMORY_TAG_ARRAY);
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        kcopy(buffer + (u64)remap[v] * vertex_size, (u8*)vertices + (u64)v * vertex_size, vertex_size);
+    }
+    kcopy(vertices, buffer, buffer_size);
+
+    kfree(buffer, buffer_size, MEMORY_TAG_ARRAY);
+    kfree_tc(remap, u32, vertex_count, MEMORY_TAG_ARRAY);
+    return used_count;
+}
+
+// Смотри: https://www.cs.cmu.edu/~garland/Papers/quadrics.pdf
+
+// @brief Квадрика ошибки Q(p) = p^T A p + 2 b^T p + c, накопленная с весами площадей треугольников.
+typedef struct simplify_quadric {
+    f32 a00, a11, a22;
+    f32 a01, a02, a12;
+    f32 b0, b1, b2;
+    f32 c;
+    f32 weight;
+} simplify_quadric;
+
+static void simplify_quadric_from_triangle(vec3 p0, vec3 p1, vec3 p2, simplify_quadric* out_quadric)
+{
+    vec3 normal = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+    f32 area = vec3_length(normal);
+    if(area > 0.0f)
+    {
+        normal = vec3_mul_scalar(normal, 1.0f / area);
+    }
+
+    f32 d = -vec3_dot(normal, p0);
+    f32 w = area * 0.5f;
+
+    out_quadric->a00 = w * normal.x * normal.x;
+    out_quadric->a11 = w * normal.y * normal.y;
+    out_quadric->a22 = w * normal.z * normal.z;
+    out_quadric->a01 = w * normal.x * normal.y;
+    out_quadric->a02 = w * normal.x * normal.z;
+    out_quadric->a12 = w * normal.y * normal.z;
+    out_quadric->b0 = w * normal.x * d;
+    out_quadric->b1 = w * normal.y * d;
+    out_quadric->b2 = w * normal.z * d;
+    out_quadric->c = w * d * d;
+    out_quadric->weight = w;
+}
+
+KINLINE void simplify_quadric_add(simplify_quadric* quadric, const simplify_quadric* other)
+{
+    quadric->a00 += other->a00;
+    quadric->a11 += other->a11;
+    quadric->a22 += other->a22;
+    quadric->a01 += other->a01;
+    quadric->a02 += other->a02;
+    quadric->a12 += other->a12;
+    quadric->b0 += other->b0;
+    quadric->b1 += other->b1;
+    quadric->b2 += other->b2;
+    quadric->c += other->c;
+    quadric->weight += other->weight;
+}
+
+// @brief Возвращает средний квадрат расстояния от точки до плоскостей квадрики.
+KINLINE f32 simplify_quadric_error(const simplify_quadric* q, vec3 p)
+{
+    f32 rx = q->a00 * p.x + q->a01 * p.y + q->a02 * p.z;
+    f32 ry = q->a01 * p.x + q->a11 * p.y + q->a12 * p.z;
+    f32 rz = q->a02 * p.x + q->a12 * p.y + q->a22 * p.z;
+
+    f32 r = rx * p.x + ry * p.y + rz * p.z + 2.0f * (q->b0 * p.x + q->b1 * p.y + q->b2 * p.z) + q->c;
+    return q->weight > 0.0f ? kabs(r) / q->weight : 0.0f;
+}
+
+KINLINE u32 simplify_hash(u32 h)
+{
+    // Финализатор MurmurHash3.
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+KINLINE u32 simplify_position_hash(vec3 p)
+{
+    union { f32 f; u32 u; } x = { p.x }, y = { p.y }, z = { p.z };
+    return simplify_hash(x.u * 73856093U ^ y.u * 19349663U ^ z.u * 83492791U);
+}
+
+KINLINE u32 simplify_table_capacity(u32 count)
+{
+    u32 capacity = 16;
+    while(capacity < count * 2)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// @brief Находит для каждой вершины первую вершину с таким же положением.
+static void simplify_build_position_remap(u32 vertex_count, const vertex_3d* vertices, u32* out_remap)
+{
+    u32 capacity = simplify_table_capacity(vertex_count);
+    u32* table = kallocate_tc(u32, capacity, MEMORY_TAG_ARRAY);
+    kset_tc(table, u32, capacity, 0xFF);
+
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        vec3 p = vertices[v].position;
+        u32 slot = simplify_position_hash(p) & (capacity - 1);
+
+        while(table[slot] != INVALID_ID)
+        {
+            vec3 other = vertices[table[slot]].position;
+            if(other.x == p.x && other.y == p.y && other.z == p.z)
+            {
+                break;
+            }
+            slot = (slot + 1) & (capacity - 1);
+        }
+
+        if(table[slot] == INVALID_ID)
+        {
+            table[slot] = v;
+        }
+
+        out_remap[v] = table[slot];
+    }
+
+    kfree_tc(table, u32, capacity, MEMORY_TAG_ARRAY);
+}
+
+// @brief Отмечает вершины, которые нельзя перемещать: швы атрибутов и открытые границы.
+static void simplify_build_locks(
+    u32 index_count, const u32* indices, u32 vertex_count, const u32* remap, u8* out_locked
+)
+{
+    // Швы: несколько вершин с одним положением.
+    u32* wedge_count = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    kzero_tc(wedge_count, u32, vertex_count);
+    kzero_tc(out_locked, u8, vertex_count);
+
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        wedge_count[remap[v]]++;
+    }
+
+    // Открытые границы: ребро (по положениям) без ребра обратного направления.
+    u32 capacity = simplify_table_capacity(index_count);
+    u64* edges = kallocate_tc(u64, capacity, MEMORY_TAG_ARRAY);
+    kset_tc(edges, u64, capacity, 0xFF);
+
+    for(u32 pass = 0; pass < 2; ++pass)
+    {
+        for(u32 i = 0; i < index_count; ++i)
+        {
+            u32 a = remap[indices[i]];
+            u32 b = remap[indices[i - i % 3 + (i + 1) % 3]];
+
+            // Первый проход заполняет таблицу ребер, второй ищет обратные ребра.
+            u64 key = pass == 0 ? ((u64)a << 32 | b) : ((u64)b << 32 | a);
+            u32 slot = simplify_hash((u32)key ^ (u32)(key >> 32) * 0x9e3779b9U) & (capacity - 1);
+
+            while(edges[slot] != U64_MAX && edges[slot] != key)
+            {
+                slot = (slot + 1) & (capacity - 1);
+            }
+
+            if(pass == 0)
+            {
+                edges[slot] = key;
+            }
+            else if(edges[slot] == U64_MAX)
+            {
+                out_locked[a] = true;
+                out_locked[b] = true;
+            }
+        }
+    }
+
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        out_locked[v] = out_locked[remap[v]] || wedge_count[remap[v]] > 1;
+    }
+
+    kfree_tc(edges, u64, capacity, MEMORY_TAG_ARRAY);
+    kfree_tc(wedge_count, u32, vertex_count, MEMORY_TAG_ARRAY);
+}
+
+/*
+    @brief Проверяет, разворачивает ли перенос вершины source в target один из ее треугольников.
+*/
+static bool simplify_collapse_flips(
+    u32 source, u32 target, const u32* indices, const u32* adjacency_offsets, const u32* adjacency,
+    const u32* collapse_remap, const vec3* positions
+)
+{
+    for(u32 j = adjacency_offsets[source]; j < adjacency_offsets[source + 1]; ++j)
+    {
+        const u32* triangle = &indices[adjacency[j] * 3];
+        u32 t0 = collapse_remap[triangle[0]];
+        u32 t1 = collapse_remap[triangle[1]];
+        u32 t2 = collapse_remap[triangle[2]];
+
+        // Треугольники с ребром (source, target) исчезают.
+        if(t0 == target || t1 == target || t2 == target)
+        {
+            continue;
+        }
+
+        vec3 p0 = positions[t0];
+        vec3 p1 = positions[t1];
+        vec3 p2 = positions[t2];
+        vec3 before = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+
+        if(t0 == source) p0 = positions[target];
+        if(t1 == source) p1 = positions[target];
+        if(t2 == source) p2 = positions[target];
+        vec3 after = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+
+        // Разворот или вырождение треугольника.
+        if(vec3_dot(before, after) <= 1e-2f * vec3_length(before) * vec3_length(after) || vec3_length_squared(after) == 0.0f)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// @brief Кандидат на схлопывание ребра: перенос вершины source в target.
+typedef struct simplify_collapse {
+    u32 source;
+    u32 target;
+    f32 cost;
+} simplify_collapse;
+
+// Количество корзин сортировки кандидатов по старшим битам стоимости.
+#define SIMPLIFY_SORT_BUCKETS 4096
+
+u32 geometry_simplify(
+    u32 index_count, const u32* indices, u32 vertex_count, const vertex_3d* vertices, u32 target_index_count,
+    f32 target_error, u32* out_indices, f32* out_error
+)
+{
+    index_count -= index_count % 3;
+    kcopy_tc(out_indices, indices, u32, index_count);
+    const u32 source_index_count = index_count;
+
+    if(out_error)
+    {
+        *out_error = 0.0f;
+    }
+
+    if(target_index_count >= index_count || !vertex_count)
+    {
+        return index_count;
+    }
+
+    // Нормализация положений в единичный куб для устойчивости вычислений в f32.
+    extents_3d bounds = { vertices[0].position, vertices[0].position };
+    for(u32 v = 1; v < vertex_count; ++v)
+    {
+        bounds.min = vec3_min(bounds.min, vertices[v].position);
+        bounds.max = vec3_max(bounds.max, vertices[v].position);
+    }
+
+    vec3 size = vec3_sub(bounds.max, bounds.min);
+    f32 extent = KMAX(KMAX(size.x, size.y), size.z);
+    f32 scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+
+    vec3* positions = kallocate_tc(vec3, vertex_count, MEMORY_TAG_ARRAY);
+    for(u32 v = 0; v < vertex_count; ++v)
+    {
+        positions[v] = vec3_mul_scalar(vec3_sub(vertices[v].position, bounds.min), scale);
+    }
+
+    u32* remap = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    u8* locked = kallocate_tc(u8, vertex_count, MEMORY_TAG_ARRAY);
+    simplify_build_position_remap(vertex_count, vertices, remap);
+    simplify_build_locks(index_count, indices, vertex_count, remap, locked);
+
+    // Квадрики вершин.
+    simplify_quadric* quadrics = kallocate_tc(simplify_quadric, vertex_count, MEMORY_TAG_ARRAY);
+    kzero_tc(quadrics, simplify_quadric, vertex_count);
+
+    for(u32 i = 0; i < index_count; i += 3)
+    {
+        simplify_quadric q;
+        simplify_quadric_from_triangle(positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]], &q);
+
+        simplify_quadric_add(&quadrics[indices[i + 0]], &q);
+        simplify_quadric_add(&quadrics[indices[i + 1]], &q);
+        simplify_quadric_add(&quadrics[indices[i + 2]], &q);
+    }
+
+    u32* adjacency_offsets = kallocate_tc(u32, vertex_count + 1, MEMORY_TAG_ARRAY);
+    u32* adjacency = kallocate_tc(u32, source_index_count, MEMORY_TAG_ARRAY);
+    simplify_collapse* candidates = kallocate_tc(simplify_collapse, source_index_count, MEMORY_TAG_ARRAY);
+    u32* sorted = kallocate_tc(u32, source_index_count, MEMORY_TAG_ARRAY);
+    u32* collapse_remap = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    u8* collapse_locked = kallocate_tc(u8, vertex_count, MEMORY_TAG_ARRAY);
+    u32* buckets = kallocate_tc(u32, SIMPLIFY_SORT_BUCKETS, MEMORY_TAG_ARRAY);
+
+    f32 error_limit = target_error * scale;
+    f32 error_limit_squared = error_limit * error_limit;
+    f32 result_error_squared = 0.0f;
+
+    // Каждый проход схлопывает независимые ребра в порядке возрастания стоимости.
+    while(index_count > target_index_count)
+    {
+        // Списки смежных треугольников вершин.
+        kzero_tc(adjacency_offsets, u32, vertex_count + 1);
+        for(u32 i = 0; i < index_count; ++i)
+        {
+            adjacency_offsets[out_indices[i] + 1]++;
+        }
+
+        for(u32 v = 0; v < vertex_count; ++v)
+        {
+            adjacency_offsets[v + 1] += adjacency_offsets[v];
+        }
+
+        for(u32 i = 0; i < index_count; ++i)
+        {
+            // NOTE: Смещения временно сдвигаются к концу списков и восстанавливаются ниже.
+            adjacency[adjacency_offsets[out_indices[i]]++] = i / 3;
+        }
+
+        for(u32 v = vertex_count; v > 0; --v)
+        {
+            adjacency_offsets[v] = adjacency_offsets[v - 1];
+        }
+        adjacency_offsets[0] = 0;
+
+        // Кандидаты: каждое ребро (внутреннее ребро встречается с a < b ровно в одном из двух треугольников)
+        // в более дешевом из допустимых направлений.
+        u32 candidate_count = 0;
+        for(u32 i = 0; i < index_count; ++i)
+        {
+            u32 a = out_indices[i];
+            u32 b = out_indices[i - i % 3 + (i + 1) % 3];
+
+            if(a > b || (locked[a] && locked[b]))
+            {
+                continue;
+            }
+
+            f32 cost_ab = locked[a] ? K_FLOAT_MAX : simplify_quadric_error(&quadrics[a], positions[b]);
+            f32 cost_ba = locked[b] ? K_FLOAT_MAX : simplify_quadric_error(&quadrics[b], positions[a]);
+
+            simplify_collapse* c = &candidates[candidate_count++];
+            c->source = cost_ab <= cost_ba ? a : b;
+            c->target = cost_ab <= cost_ba ? b : a;
+            c->cost = KMIN(cost_ab, cost_ba);
+        }
+
+        // Сортировка кандидатов подсчетом по старшим битам стоимости (неотрицательные f32 упорядочены как u32).
+        kzero_tc(buckets, u32, SIMPLIFY_SORT_BUCKETS);
+        for(u32 c = 0; c < candidate_count; ++c)
+        {
+            union { f32 f; u32 u; } key = { candidates[c].cost };
+            buckets[key.u >> 20]++;
+        }
+
+        u32 sum = 0;
+        for(u32 b = 0; b < SIMPLIFY_SORT_BUCKETS; ++b)
+        {
+            u32 count = buckets[b];
+            buckets[b] = sum;
+            sum += count;
+        }
+
+        for(u32 c = 0; c < candidate_count; ++c)
+        {
+            union { f32 f; u32 u; } key = { candidates[c].cost };
+            sorted[buckets[key.u >> 20]++] = c;
+        }
+
+        // Схлопывание независимых ребер: вершины одного схлопывания не участвуют в других за проход.
+        for(u32 v = 0; v < vertex_count; ++v)
+        {
+            collapse_remap[v] = v;
+        }
+        kzero_tc(collapse_locked, u8, vertex_count);
+
+        u32 triangle_goal = (index_count - target_index_count) / 3;
+        u32 triangles_removed = 0;
+        u32 collapse_count = 0;
+
+        for(u32 c = 0; c < candidate_count && triangles_removed < triangle_goal; ++c)
+        {
+            const simplify_collapse* collapse = &candidates[sorted[c]];
+            u32 source = collapse->source;
+            u32 target = collapse->target;
+
+            if(collapse->cost > error_limit_squared)
+            {
+                break;
+            }
+
+            if(collapse_locked[source] || collapse_locked[target])
+            {
+                continue;
+            }
+
+            if(simplify_collapse_flips(source, target, out_indices, adjacency_offsets, adjacency, collapse_remap, positions))
+            {
+                continue;
+            }
+
+            collapse_remap[source] = target;
+            simplify_quadric_add(&quadrics[target], &quadrics[source]);
+            collapse_locked[source] = true;
+            collapse_locked[target] = true;
+
+            // Схлопывание внутреннего ребра удаляет два треугольника.
+            triangles_removed += 2;
+            collapse_count++;
+            result_error_squared = KMAX(result_error_squared, collapse->cost);
+        }
+
+        if(!collapse_count)
+        {
+            break;
+        }
+
+        // Применение схлопываний и удаление вырожденных треугольников.
+        u32 write = 0;
+        for(u32 i = 0; i < index_count; i += 3)
+        {
+            u32 t0 = collapse_remap[out_indices[i + 0]];
+            u32 t1 = collapse_remap[out_indices[i + 1]];
+            u32 t2 = collapse_remap[out_indices[i + 2]];
+
+            if(t0 != t1 && t0 != t2 && t1 != t2)
+            {
+                out_indices[write++] = t0;
+                out_indices[write++] = t1;
+                out_indices[write++] = t2;
+            }
+        }
+
+        index_count = write;
+    }
+
+    if(out_error)
+    {
+        *out_error = ksqrt(result_error_squared) / scale;
+    }
+
+    kfree_tc(buckets, u32, SIMPLIFY_SORT_BUCKETS, MEMORY_TAG_ARRAY);
+    kfree_tc(collapse_locked, u8, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(collapse_remap, u32, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(sorted, u32, source_index_count, MEMORY_TAG_ARRAY);
+    kfree_tc(candidates, simplify_collapse, source_index_count, MEMORY_TAG_ARRAY);
+    kfree_tc(adjacency, u32, source_index_count, MEMORY_TAG_ARRAY);
+    kfree_tc(adjacency_offsets, u32, vertex_count + 1, MEMORY_TAG_ARRAY);
+    kfree_tc(quadrics, simplify_quadric, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(locked, u8, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(remap, u32, vertex_count, MEMORY_TAG_ARRAY);
+    kfree_tc(positions, vec3, vertex_count, MEMORY_TAG_ARRAY);
+
+    return index_count;
+}
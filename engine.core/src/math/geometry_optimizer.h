@@ -0,0 +1,82 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+
+// @brief Размер моделируемого кэша вершин после преобразования (для статистики и кластеризации).
+#define GEOMETRY_VERTEX_CACHE_SIZE 16
+
+// @brief Статистика эффективности кэша вершин после преобразования.
+typedef struct geometry_vertex_cache_stats {
+    // @brief Количество промахов кэша (преобразованных вершин).
+    u32 misses;
+    // @brief Среднее количество промахов на треугольник (ACMR, от 0.5 у идеальной сетки до 3).
+    f32 acmr;
+    // @brief Отношение промахов к количеству используемых вершин (ATVR, идеально 1).
+    f32 atvr;
+} geometry_vertex_cache_stats;
+
+/*
+    @brief Моделирует FIFO кэш вершин после преобразования и вычисляет статистику ACMR/ATVR.
+    @param index_count Количество индексов.
+    @param indices Массив индексов.
+    @param vertex_count Количество вершин.
+    @param cache_size Размер моделируемого кэша.
+    @param out_stats Указатель на структуру для сохранения статистики.
+*/
+KAPI void geometry_analyze_vertex_cache(
+    u32 index_count, const u32* indices, u32 vertex_count, u32 cache_size, geometry_vertex_cache_stats* out_stats
+);
+
+/*
+    @brief Переупорядочивает треугольники для повторного использования вершин кэшем после преобразования
+           (алгоритм Тома Форсайта, линейная сложность).
+    @param index_count Количество индексов.
+    @param indices Массив индексов (изменяется).
+    @param vertex_count Количество вершин.
+*/
+KAPI void geometry_optimize_vertex_cache(u32 index_count, u32* indices, u32 vertex_count);
+
+/*
+    @brief Переупорядочивает кластеры треугольников так, чтобы внешние поверхности рисовались первыми
+           (меньше перерисовки). Порядок внутри кластеров сохраняется.
+    NOTE: Вызывать после geometry_optimize_vertex_cache. Ухудшение ACMR ограничивается порогом.
+    @param index_count Количество индексов.
+    @param indices Массив индексов (изменяется).
+    @param vertex_count Количество вершин.
+    @param vertices Массив вершин.
+    @param threshold Допустимое ухудшение ACMR (например, 1.05 - не более 5%).
+*/
+KAPI void geometry_optimize_overdraw(u32 index_count, u32* indices, u32 vertex_count, const vertex_3d* vertices, f32 threshold);
+
+/*
+    @brief Переупорядочивает вершины в порядке первого использования индексами (меньше промахов кэша выборки).
+    NOTE: Неиспользуемые вершины перемещаются в конец, количество вершин не изменяется.
+    @param index_count Количество индексов.
+    @param indices Массив индексов (изменяется).
+    @param vertex_count Количество вершин.
+    @param vertex_size Размер вершины в байтах.
+    @param vertices Массив вершин (изменяется).
+    @return Количество используемых вершин.
+*/
+KAPI u32 geometry_optimize_vertex_fetch(u32 index_count, u32* indices, u32 vertex_count, u32 vertex_size, void* vertices);
+
+/*
+    @brief Упрощает геометрию схлопыванием ребер с оценкой ошибки квадриками (Garland-Heckbert).
+    NOTE: Вершины не изменяются: ребро схлопывается в одну из своих вершин, поэтому упрощенные индексы
+          используют исходный массив вершин. Вершины швов (совпадающие положения с разными атрибутами)
+          и открытых границ не перемещаются.
+    @param index_count Количество индексов.
+    @param indices Массив индексов.
+    @param vertex_count Количество вершин.
+    @param vertices Массив вершин.
+    @param target_index_count Желаемое количество индексов.
+    @param target_error Максимально допустимая геометрическая ошибка (в локальных единицах).
+    @param out_indices Массив для сохранения индексов результата (не менее index_count элементов).
+    @param out_error Указатель для сохранения достигнутой ошибки (в локальных единицах), может быть null.
+    @return Количество индексов результата.
+*/
+KAPI u32 geometry_simplify(
+    u32 index_count, const u32* indices, u32 vertex_count, const vertex_3d* vertices, u32 target_index_count,
+    f32 target_error, u32* out_indices, f32* out_error
+);
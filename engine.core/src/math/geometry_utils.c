@@ -3,67 +3,632 @@
 
 // Внутренние подключения.
 #include "math/kmath.h"
+#include "memory/memory.h"
+#include "platform/thread.h"
 
-void geometry_generate_normals(u32 vertex_count, vertex_3d* vertices, u32 index_count, u32* indices)
+/*
+    NOTE: Нормали и касательные вычисляются для каждого треугольника, вершина получает значение последнего
+          ссылающегося на нее треугольника (как при последовательной записи). Значения треугольников
+          вычисляются пакетами SIMD в массивы SoA. В одном потоке блоки треугольников сразу записываются
+          в вершины по порядку. В нескольких потоках обработка идет в три этапа без конфликтов записи:
+          1) значения всех треугольников вычисляются параллельно;
+          2) для каждой вершины определяется последний ссылающийся на нее треугольник;
+          3) значения записываются в вершины параллельно по диапазонам вершин.
+          Используются те же операции в том же порядке, что и в скалярном коде, поэтому результат совпадает.
+*/
+
+// Максимальное количество потоков генерации.
+#define GEOMETRY_GENERATE_MAX_THREADS 16
+// Минимальное количество элементов на поток (меньшие объемы обрабатываются в текущем потоке).
+#define GEOMETRY_GENERATE_MIN_BATCH 16384
+// Количество треугольников в блоке при обработке в одном потоке (значения блока остаются в кэше L1).
+#define GEOMETRY_GENERATE_BLOCK 512
+
+// Смещения полей вершины в элементах f32.
+#define VERTEX_STRIDE   (sizeof(vertex_3d) / sizeof(f32))
+#define VERTEX_POSITION (__builtin_offsetof(vertex_3d, position) / sizeof(f32))
+#define VERTEX_TEXCOORD (__builtin_offsetof(vertex_3d, texcoord) / sizeof(f32))
+
+// @brief Данные этапов генерации.
+typedef struct geometry_generate_context {
+    const f32* vertices;
+    const u32* indices;
+    vertex_3d* out_vertices;
+    // Последний треугольник каждой вершины (INVALID_ID - вершина не используется).
+    const u32* owners;
+    // Значения треугольников (SoA) начиная с треугольника base, w только для касательных.
+    u32 base;
+    f32* x;
+    f32* y;
+    f32* z;
+    f32* w;
+} geometry_generate_context;
+
+// @brief Функция обработки диапазона элементов [begin, end).
+typedef void (*geometry_generate_range_fn)(geometry_generate_context* context, u32 begin, u32 end);
+
+typedef struct geometry_generate_job {
+    geometry_generate_context* context;
+    geometry_generate_range_fn fn;
+    u32 begin;
+    u32 end;
+} geometry_generate_job;
+
+static void geometry_generate_job_run(void* params)
+{
+    geometry_generate_job* job = params;
+    job->fn(job->context, job->begin, job->end);
+}
+
+// @brief Возвращает количество частей для параллельной обработки указанного количества элементов.
+static u32 geometry_generate_job_count(u32 count)
+{
+    u32 job_count = KMIN(platform_thread_processor_count(), GEOMETRY_GENERATE_MAX_THREADS);
+    return KMIN(job_count, count / GEOMETRY_GENERATE_MIN_BATCH);
+}
+
+// @brief Выполняет обработку диапазона [0, count): первая часть в текущем потоке, остальные в дополнительных.
+static void geometry_generate_parallel(geometry_generate_context* context, geometry_generate_range_fn fn, u32 count)
 {
-    for(u32 i = 0; i < index_count; i += 3)
+    u32 job_count = geometry_generate_job_count(count);
+
+    if(job_count < 2)
+    {
+        fn(context, 0, count);
+        return;
+    }
+
+    geometry_generate_job jobs[GEOMETRY_GENERATE_MAX_THREADS];
+    platform_thread threads[GEOMETRY_GENERATE_MAX_THREADS];
+    bool started[GEOMETRY_GENERATE_MAX_THREADS] = {};
+
+    // Границы выровнены по 8 элементов, чтобы пакеты SIMD не пересекали границы частей.
+    u32 step = get_aligned(count / job_count + 1, 8);
+    for(u32 i = 0; i < job_count; ++i)
     {
-        u32 i0 = indices[i + 0];
-        u32 i1 = indices[i + 1];
-        u32 i2 = indices[i + 2];
+        jobs[i].context = context;
+        jobs[i].fn = fn;
+        jobs[i].begin = KMIN(step * i, count);
+        jobs[i].end = KMIN(step * (i + 1), count);
+    }
+    jobs[job_count - 1].end = count;
 
-        vec3 edge1 = vec3_sub(vertices[i1].position, vertices[i0].position);
-        vec3 edge2 = vec3_sub(vertices[i2].position, vertices[i0].position);
+    for(u32 i = 1; i < job_count; ++i)
+    {
+        started[i] = platform_thread_create(geometry_generate_job_run, &jobs[i], &threads[i]);
+    }
 
-        vec3 normal = vec3_normalized(vec3_cross(edge1, edge2));
+    geometry_generate_job_run(&jobs[0]);
 
-        // NOTE: Генерирует нормаль поверхности. Сглаживание выполнить отдельно, если это необходимо.
-        vertices[i0].normal = normal;
-        vertices[i1].normal = normal;
-        vertices[i2].normal = normal;
+    for(u32 i = 1; i < job_count; ++i)
+    {
+        if(started[i])
+        {
+            platform_thread_join(&threads[i]);
+        }
+        else
+        {
+            // Поток не был создан: обработка в текущем потоке.
+            geometry_generate_job_run(&jobs[i]);
+        }
     }
 }
 
+// @brief Вычисляет нормаль треугольника (скалярная версия, эталон для SIMD версий).
+static void triangle_normal_scalar(geometry_generate_context* context, u32 t)
+{
+    const vertex_3d* vertices = (const vertex_3d*)context->vertices;
+    const u32* indices = &context->indices[t * 3];
+
+    vec3 edge1 = vec3_sub(vertices[indices[1]].position, vertices[indices[0]].position);
+    vec3 edge2 = vec3_sub(vertices[indices[2]].position, vertices[indices[0]].position);
+    vec3 normal = vec3_normalized(vec3_cross(edge1, edge2));
+
+    context->x[t - context->base] = normal.x;
+    context->y[t - context->base] = normal.y;
+    context->z[t - context->base] = normal.z;
+}
+
 // Смотри: https://terathon.com/blog/tangent-space.html
 //         https://triplepointfive.github.io/ogltutor/tutorials/tutorial26.html
+// @brief Вычисляет касательную треугольника (скалярная версия, эталон для SIMD версий).
+static void triangle_tangent_scalar(geometry_generate_context* context, u32 t)
+{
+    const vertex_3d* vertices = (const vertex_3d*)context->vertices;
+    const u32* indices = &context->indices[t * 3];
+    u32 i0 = indices[0];
+    u32 i1 = indices[1];
+    u32 i2 = indices[2];
+
+    vec3 edge1 = vec3_sub(vertices[i1].position, vertices[i0].position);
+    vec3 edge2 = vec3_sub(vertices[i2].position, vertices[i0].position);
+
+    f32 deltaU1 = vertices[i1].texcoord.x - vertices[i0].texcoord.x;
+    f32 deltaV1 = vertices[i1].texcoord.y - vertices[i0].texcoord.y;
+
+    f32 deltaU2 = vertices[i2].texcoord.x - vertices[i0].texcoord.x;
+    f32 deltaV2 = vertices[i2].texcoord.y - vertices[i0].texcoord.y;
+
+    f32 dividend = (deltaU1 * deltaV2 - deltaU2 * deltaV1);
+    f32 fc = 1.0f / dividend;
+
+    vec3 tangent = (vec3){{
+        (fc * (deltaV2 * edge1.x - deltaV1 * edge2.x)),
+        (fc * (deltaV2 * edge1.y - deltaV1 * edge2.y)),
+        (fc * (deltaV2 * edge1.z - deltaV1 * edge2.z))
+    }};
+
+    tangent = vec3_normalized(tangent);
+
+    f32 sx = deltaU1, sy = deltaU2;
+    f32 tx = deltaV1, ty = deltaV2;
+
+    context->x[t - context->base] = tangent.x;
+    context->y[t - context->base] = tangent.y;
+    context->z[t - context->base] = tangent.z;
+    context->w[t - context->base] = ((tx * sy - ty * sx) < 0.0f) ? -1.0f : 1.0f;
+}
+
+#if !defined(__x86_64__) && !defined(_M_X64)
+
+static void triangle_normals_range_scalar(geometry_generate_context* context, u32 begin, u32 end)
+{
+    for(u32 t = begin; t < end; ++t)
+    {
+        triangle_normal_scalar(context, t);
+    }
+}
+
+static void triangle_tangents_range_scalar(geometry_generate_context* context, u32 begin, u32 end)
+{
+    for(u32 t = begin; t < end; ++t)
+    {
+        triangle_tangent_scalar(context, t);
+    }
+}
+
+#else
+
+/*
+    NOTE: SSE2 входит в базовый набор x86-64 и не требует проверки процессора. Версия AVX с 8 треугольниками
+          на пакет (загрузки и инструкции сбора) не дала выигрыша: обработка ограничена чтением вершин
+          vertex_3d из памяти, а не вычислениями.
+*/
+#include <emmintrin.h>
+
+// @brief Загружает поле вершин четырех треугольников (угол corner) в регистр SSE.
+#define SSE_GATHER(vertices, idx, corner, field) \
+    _mm_setr_ps(                                 \
+        vertices[idx[0 + corner] * VERTEX_STRIDE + field], vertices[idx[3 + corner] * VERTEX_STRIDE + field], \
+        vertices[idx[6 + corner] * VERTEX_STRIDE + field], vertices[idx[9 + corner] * VERTEX_STRIDE + field]  \
+    )
+
+static void triangle_normals_sse(geometry_generate_context* context, u32 begin, u32 end)
+{
+    const f32* v = context->vertices;
+    u32 t = begin;
+
+    for(; t + 4 <= end; t += 4)
+    {
+        const u32* idx = &context->indices[t * 3];
+
+        __m128 x0 = SSE_GATHER(v, idx, 0, VERTEX_POSITION + 0);
+        __m128 y0 = SSE_GATHER(v, idx, 0, VERTEX_POSITION + 1);
+        __m128 z0 = SSE_GATHER(v, idx, 0, VERTEX_POSITION + 2);
+
+        __m128 e1x = _mm_sub_ps(SSE_GATHER(v, idx, 1, VERTEX_POSITION + 0), x0);
+        __m128 e1y = _mm_sub_ps(SSE_GATHER(v, idx, 1, VERTEX_POSITION + 1), y0);
+        __m128 e1z = _mm_sub_ps(SSE_GATHER(v, idx, 1, VERTEX_POSITION + 2), z0);
+        __m128 e2x = _mm_sub_ps(SSE_GATHER(v, idx, 2, VERTEX_POSITION + 0), x0);
+        __m128 e2y = _mm_sub_ps(SSE_GATHER(v, idx, 2, VERTEX_POSITION + 1), y0);
+        __m128 e2z = _mm_sub_ps(SSE_GATHER(v, idx, 2, VERTEX_POSITION + 2), z0);
+
+        __m128 nx = _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e1z, e2y));
+        __m128 ny = _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e1x, e2z));
+        __m128 nz = _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e1y, e2x));
+
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz)));
+
+        _mm_storeu_ps(&context->x[t - context->base], _mm_div_ps(nx, length));
+        _mm_storeu_ps(&context->y[t - context->base], _mm_div_ps(ny, length));
+        _mm_storeu_ps(&context->z[t - context->base], _mm_div_ps(nz, length));
+    }
+
+    for(; t < end; ++t)
+    {
+        triangle_normal_scalar(context, t);
+    }
+}
+
+static void triangle_tangents_sse(geometry_generate_context* context, u32 begin, u32 end)
+{
+    const f32* v = context->vertices;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    u32 t = begin;
+
+    for(; t + 4 <= end; t += 4)
+    {
+        const u32* idx = &context->indices[t * 3];
+
+        __m128 x0 = SSE_GATHER(v, idx, 0, VERTEX_POSITION + 0);
+        __m128 y0 = SSE_GATHER(v, idx, 0, VERTEX_POSITION + 1);
+        __m128 z0 = SSE_GATHER(v, idx, 0, VERTEX_POSITION + 2);
+        __m128 u0 = SSE_GATHER(v, idx, 0, VERTEX_TEXCOORD + 0);
+        __m128 v0 = SSE_GATHER(v, idx, 0, VERTEX_TEXCOORD + 1);
+
+        __m128 e1x = _mm_sub_ps(SSE_GATHER(v, idx, 1, VERTEX_POSITION + 0), x0);
+        __m128 e1y = _mm_sub_ps(SSE_GATHER(v, idx, 1, VERTEX_POSITION + 1), y0);
+        __m128 e1z = _mm_sub_ps(SSE_GATHER(v, idx, 1, VERTEX_POSITION + 2), z0);
+        __m128 e2x = _mm_sub_ps(SSE_GATHER(v, idx, 2, VERTEX_POSITION + 0), x0);
+        __m128 e2y = _mm_sub_ps(SSE_GATHER(v, idx, 2, VERTEX_POSITION + 1), y0);
+        __m128 e2z = _mm_sub_ps(SSE_GATHER(v, idx, 2, VERTEX_POSITION + 2), z0);
+
+        __m128 du1 = _mm_sub_ps(SSE_GATHER(v, idx, 1, VERTEX_TEXCOORD + 0), u0);
+        __m128 dv1 = _mm_sub_ps(SSE_GATHER(v, idx, 1, VERTEX_TEXCOORD + 1), v0);
+        __m128 du2 = _mm_sub_ps(SSE_GATHER(v, idx, 2, VERTEX_TEXCOORD + 0), u0);
+        __m128 dv2 = _mm_sub_ps(SSE_GATHER(v, idx, 2, VERTEX_TEXCOORD + 1), v0);
+
+        __m128 fc = _mm_div_ps(one, _mm_sub_ps(_mm_mul_ps(du1, dv2), _mm_mul_ps(du2, dv1)));
+
+        __m128 tx = _mm_mul_ps(fc, _mm_sub_ps(_mm_mul_ps(dv2, e1x), _mm_mul_ps(dv1, e2x)));
+        __m128 ty = _mm_mul_ps(fc, _mm_sub_ps(_mm_mul_ps(dv2, e1y), _mm_mul_ps(dv1, e2y)));
+        __m128 tz = _mm_mul_ps(fc, _mm_sub_ps(_mm_mul_ps(dv2, e1z), _mm_mul_ps(dv1, e2z)));
+
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz)));
+
+        __m128 negative = _mm_cmplt_ps(_mm_sub_ps(_mm_mul_ps(dv1, du2), _mm_mul_ps(dv2, du1)), zero);
+        __m128 handedness = _mm_or_ps(_mm_and_ps(negative, minus_one), _mm_andnot_ps(negative, one));
+
+        _mm_storeu_ps(&context->x[t - context->base], _mm_div_ps(tx, length));
+        _mm_storeu_ps(&context->y[t - context->base], _mm_div_ps(ty, length));
+        _mm_storeu_ps(&context->z[t - context->base], _mm_div_ps(tz, length));
+        _mm_storeu_ps(&context->w[t - context->base], handedness);
+    }
+
+    for(; t < end; ++t)
+    {
+        triangle_tangent_scalar(context, t);
+    }
+}
+
+#endif
+
+// @brief Выбирает обработчик треугольников для платформы.
+static geometry_generate_range_fn triangle_fn_select(bool tangents)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return tangents ? triangle_tangents_sse : triangle_normals_sse;
+#else
+    return tangents ? triangle_tangents_range_scalar : triangle_normals_range_scalar;
+#endif
+}
+
+static void vertex_normals_write(geometry_generate_context* context, u32 begin, u32 end)
+{
+    for(u32 i = begin; i < end; ++i)
+    {
+        u32 t = context->owners[i];
+        if(t != INVALID_ID)
+        {
+            context->out_vertices[i].normal = (vec3){{ context->x[t], context->y[t], context->z[t] }};
+        }
+    }
+}
+
+static void vertex_tangents_write(geometry_generate_context* context, u32 begin, u32 end)
+{
+    for(u32 i = begin; i < end; ++i)
+    {
+        u32 t = context->owners[i];
+        if(t != INVALID_ID)
+        {
+            context->out_vertices[i].tangent = (vec4){{ context->x[t], context->y[t], context->z[t], context->w[t] }};
+        }
+    }
+}
+
+// @brief Выполняет все этапы генерации нормалей (tangents = false) или касательных.
+static void geometry_generate(u32 vertex_count, vertex_3d* vertices, u32 index_count, u32* indices, bool tangents)
+{
+    u32 triangle_count = index_count / 3;
+    if(!triangle_count || !vertex_count)
+    {
+        return;
+    }
+
+    geometry_generate_context context = {};
+    context.vertices = (const f32*)vertices;
+    context.indices = indices;
+    context.out_vertices = vertices;
+    geometry_generate_range_fn triangle_fn = triangle_fn_select(tangents);
+
+    if(geometry_generate_job_count(triangle_count) < 2)
+    {
+        f32 values[4][GEOMETRY_GENERATE_BLOCK];
+        context.x = values[0];
+        context.y = values[1];
+        context.z = values[2];
+        context.w = values[3];
+
+        for(u32 begin = 0; begin < triangle_count; begin += GEOMETRY_GENERATE_BLOCK)
+        {
+            u32 end = KMIN(begin + GEOMETRY_GENERATE_BLOCK, triangle_count);
+            context.base = begin;
+            triangle_fn(&context, begin, end);
+
+            // Запись в порядке треугольников.
+            for(u32 t = begin; t < end; ++t)
+            {
+                u32 j = t - begin;
+                const u32* idx = &indices[t * 3];
+
+                if(tangents)
+                {
+                    vec4 tangent = (vec4){{ values[0][j], values[1][j], values[2][j], values[3][j] }};
+                    vertices[idx[0]].tangent = tangent;
+                    vertices[idx[1]].tangent = tangent;
+                    vertices[idx[2]].tangent = tangent;
+                }
+                else
+                {
+                    vec3 normal = (vec3){{ values[0][j], values[1][j], values[2][j] }};
+                    vertices[idx[0]].normal = normal;
+                    vertices[idx[1]].normal = normal;
+                    vertices[idx[2]].normal = normal;
+                }
+            }
+        }
+        return;
+    }
+
+    // Значения треугольников (SoA) и последний треугольник каждой вершины в одном блоке.
+    u32 component_count = tangents ? 4 : 3;
+    u64 block_size = sizeof(f32) * triangle_count * component_count + sizeof(u32) * vertex_count;
+    f32* block = kallocate(block_size, MEMORY_TAG_ARRAY);
+
+    context.base = 0;
+    context.x = block;
+    context.y = context.x + triangle_count;
+    context.z = context.y + triangle_count;
+    context.w = tangents ? context.z + triangle_count : null;
+
+    u32* owners = (u32*)(context.x + (u64)triangle_count * component_count);
+    context.owners = owners;
+
+    geometry_generate_parallel(&context, triangle_fn, triangle_count);
+
+    // NOTE: Последовательный проход: порядок треугольников определяет значение общих вершин.
+    kset_tc(owners, u32, vertex_count, 0xFF);
+    for(u32 t = 0; t < triangle_count; ++t)
+    {
+        owners[indices[t * 3 + 0]] = t;
+        owners[indices[t * 3 + 1]] = t;
+        owners[indices[t * 3 + 2]] = t;
+    }
+
+    geometry_generate_parallel(&context, tangents ? vertex_tangents_write : vertex_normals_write, vertex_count);
+
+    kfree(block, block_size, MEMORY_TAG_ARRAY);
+}
+
+void geometry_generate_normals(u32 vertex_count, vertex_3d* vertices, u32 index_count, u32* indices)
+{
+    // NOTE: Генерирует нормаль поверхности. Сглаживание выполнить отдельно, если это необходимо.
+    geometry_generate(vertex_count, vertices, index_count, indices, false);
+}
+
 void geometry_generate_tangent(u32 vertex_count, vertex_3d* vertices, u32 index_count, u32* indices)
 {
-    for(u32 i = 0; i < index_count; i += 3)
+    geometry_generate(vertex_count, vertices, index_count, indices, true);
+}
+
+// Преобразование f32 -> f16 с округлением до ближайшего четного.
+static u16 float_to_half(f32 value)
+{
+    union { f32 f; u32 u; } v = { .f = value };
+    u32 sign = (v.u >> 16) & 0x8000;
+    u32 abs = v.u & 0x7fffffff;
+
+    // Бесконечность и NaN.
+    if(abs >= 0x7f800000)
+    {
+        return sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0);
+    }
+
+    // Переполнение (65520 и более округляется до бесконечности).
+    if(abs >= 0x477ff000)
+    {
+        return sign | 0x7c00;
+    }
+
+    // Денормализованные числа half (меньше 2^-14).
+    if(abs < 0x38800000)
+    {
+        // Меньше половины минимального денормализованного числа.
+        if(abs < 0x33000000)
+        {
+            return sign;
+        }
+
+        u32 mantissa = (abs & 0x7fffff) | 0x800000;
+        u32 shift = 126 - (abs >> 23);
+        u32 h = mantissa >> shift;
+        u32 remainder = mantissa & ((1u << shift) - 1);
+        u32 halfway = 1u << (shift - 1);
+
+        if(remainder > halfway || (remainder == halfway && (h & 1)))
+        {
+            h++;
+        }
+
+        return sign | h;
+    }
+
+    // Нормализованные числа: смена смещения экспоненты 127 -> 15, перенос при округлении корректен.
+    u32 h = (abs - 0x38000000) >> 13;
+    u32 remainder = abs & 0x1fff;
+
+    if(remainder > 0x1000 || (remainder == 0x1000 && (h & 1)))
+    {
+        h++;
+    }
+
+    return sign | h;
+}
+
+// Преобразование f16 -> f32.
+static f32 half_to_float(u16 value)
+{
+    u32 sign = (u32)(value & 0x8000) << 16;
+    u32 exponent = (value >> 10) & 0x1f;
+    u32 mantissa = value & 0x3ff;
+
+    if(exponent == 0)
+    {
+        // Ноль и денормализованные числа: mantissa * 2^-24.
+        f32 f = (f32)mantissa * 5.9604644775390625e-8f;
+        return sign ? -f : f;
+    }
+
+    union { u32 u; f32 f; } v;
+
+    if(exponent == 31)
+    {
+        v.u = sign | 0x7f800000 | (mantissa << 13);
+    }
+    else
+    {
+        v.u = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    return v.f;
+}
+
+// Преобразование [-1, 1] -> snorm16.
+static i16 float_to_snorm16(f32 value)
+{
+    value = KCLAMP(value, -1.0f, 1.0f);
+    return (i16)(value * 32767.0f + (value >= 0.0f ? 0.5f : -0.5f));
+}
+
+// Октаэдрическое кодирование единичного вектора (нулевой вектор кодируется как (0, 0, 1)).
+// Смотри: https://jcgt.org/published/0003/02/01/
+static void octahedral_encode(vec3 v, i16* out_encoded)
+{
+    f32 length = kabs(v.x) + kabs(v.y) + kabs(v.z);
+    if(length < K_FLOAT_EPSILON)
+    {
+        out_encoded[0] = 0;
+        out_encoded[1] = 0;
+        return;
+    }
+
+    f32 x = v.x / length;
+    f32 y = v.y / length;
+
+    // Нижняя полусфера отражается на углы квадрата.
+    if(v.z < 0.0f)
+    {
+        f32 ox = x;
+        x = (1.0f - kabs(y)) * (ox >= 0.0f ? 1.0f : -1.0f);
+        y = (1.0f - kabs(ox)) * (y >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    out_encoded[0] = float_to_snorm16(x);
+    out_encoded[1] = float_to_snorm16(y);
+}
+
+// Октаэдрическое декодирование (должно соответствовать Builtin.MaterialShader.vert.glsl).
+static vec3 octahedral_decode(const i16* encoded)
+{
+    f32 x = KMAX(encoded[0] / 32767.0f, -1.0f);
+    f32 y = KMAX(encoded[1] / 32767.0f, -1.0f);
+    vec3 v = vec3_create(x, y, 1.0f - kabs(x) - kabs(y));
+
+    f32 t = KMAX(-v.z, 0.0f);
+    v.x += v.x >= 0.0f ? -t : t;
+    v.y += v.y >= 0.0f ? -t : t;
+
+    return vec3_normalized(v);
+}
+
+void geometry_pack_vertices(u32 vertex_count, const vertex_3d* vertices, vertex_3d_packed* out_vertices, extents_3d* out_range)
+{
+    extents_3d range = { .min = vec3_zero(), .max = vec3_zero() };
+
+    if(vertex_count > 0)
+    {
+        range.min = vertices[0].position;
+        range.max = vertices[0].position;
+    }
+
+    for(u32 i = 1; i < vertex_count; ++i)
+    {
+        range.min = vec3_min(range.min, vertices[i].position);
+        range.max = vec3_max(range.max, vertices[i].position);
+    }
+
+    // Множители квантования (для вырожденной оси все значения равны минимуму).
+    vec3 size = vec3_sub(range.max, range.min);
+    f32 scale[3];
+    for(u32 a = 0; a < 3; ++a)
+    {
+        scale[a] = size.elements[a] > 0.0f ? 65535.0f / size.elements[a] : 0.0f;
+    }
+
+    for(u32 i = 0; i < vertex_count; ++i)
     {
-        // Получение индексов вершин треуголиников.
-        u32 i0 = indices[i + 0];
-        u32 i1 = indices[i + 1];
-        u32 i2 = indices[i + 2];
+        const vertex_3d* v = &vertices[i];
+        vertex_3d_packed* p = &out_vertices[i];
+
+        for(u32 a = 0; a < 3; ++a)
+        {
+            f32 q = (v->position.elements[a] - range.min.elements[a]) * scale[a] + 0.5f;
+            p->position[a] = (u16)KCLAMP(q, 0.0f, 65535.0f);
+        }
+        p->position[3] = v->tangent.w < 0.0f ? 0 : 65535;
 
-        // 
-        vec3 edge1 = vec3_sub(vertices[i1].position, vertices[i0].position);
-        vec3 edge2 = vec3_sub(vertices[i2].position, vertices[i0].position);
+        octahedral_encode(v->normal, &p->normal_tangent[0]);
+        octahedral_encode(vec3_from_vec4(v->tangent), &p->normal_tangent[2]);
 
-        //
-        f32 deltaU1 = vertices[i1].texcoord.x - vertices[i0].texcoord.x;
-        f32 deltaV1 = vertices[i1].texcoord.y - vertices[i0].texcoord.y;
+        p->texcoord[0] = float_to_half(v->texcoord.x);
+        p->texcoord[1] = float_to_half(v->texcoord.y);
 
-        f32 deltaU2 = vertices[i2].texcoord.x - vertices[i0].texcoord.x;
-        f32 deltaV2 = vertices[i2].texcoord.y - vertices[i0].texcoord.y;
+        for(u32 c = 0; c < 4; ++c)
+        {
+            f32 q = KCLAMP(v->color.elements[c], 0.0f, 1.0f) * 255.0f + 0.5f;
+            p->color[c] = (u8)q;
+        }
+    }
+
+    *out_range = range;
+}
 
-        f32 dividend = (deltaU1 * deltaV2 - deltaU2 * deltaV1);
-        f32 fc = 1.0f / dividend;
+void geometry_unpack_vertices(u32 vertex_count, const vertex_3d_packed* vertices, const extents_3d* range, vertex_3d* out_vertices)
+{
+    vec3 size = vec3_sub(range->max, range->min);
+
+    for(u32 i = 0; i < vertex_count; ++i)
+    {
+        const vertex_3d_packed* p = &vertices[i];
+        vertex_3d* v = &out_vertices[i];
 
-        vec3 tangent = (vec3){{
-            (fc * (deltaV2 * edge1.x - deltaV1 * edge2.x)),
-            (fc * (deltaV2 * edge1.y - deltaV1 * edge2.y)),
-            (fc * (deltaV2 * edge1.z - deltaV1 * edge2.z))
-        }};
+        for(u32 a = 0; a < 3; ++a)
+        {
+            v->position.elements[a] = range->min.elements[a] + size.elements[a] * (p->position[a] / 65535.0f);
+        }
 
-        tangent = vec3_normalized(tangent);
+        v->normal = octahedral_decode(&p->normal_tangent[0]);
+        v->tangent = vec4_from_vec3(octahedral_decode(&p->normal_tangent[2]), p->position[3] ? 1.0f : -1.0f);
 
-        f32 sx = deltaU1, sy = deltaU2;
-        f32 tx = deltaV1, ty = deltaV2;
-        f32 handedness = ((tx * sy - ty * sx) < 0.0f) ? -1.0f : 1.0f;
-        vec4 t4 = vec4_from_vec3(tangent, handedness);
+        v->texcoord.x = half_to_float(p->texcoord[0]);
+        v->texcoord.y = half_to_float(p->texcoord[1]);
 
-        vertices[i0].tangent = t4;
-        vertices[i1].tangent = t4;
-        vertices[i2].tangent = t4;
+        for(u32 c = 0; c < 4; ++c)
+        {
+            v->color.elements[c] = p->color[c] / 255.0f;
+        }
     }
 }
@@ -20,3 +20,23 @@ void geometry_generate_normals(u32 vertex_count, vertex_3d* vertices, u32 index_
     @param indices Массив индексов.
 */
 void geometry_generate_tangent(u32 vertex_count, vertex_3d* vertices, u32 index_count, u32* indices);
+
+/*
+    @brief Упаковывает вершины в компактный формат vertex_3d_packed.
+    NOTE: Положения квантуются относительно крайних точек вершин, которые возвращаются в out_range
+          и должны передаваться шейдеру для восстановления положений.
+    @param vertex_count Количество вершин.
+    @param vertices Массив исходных вершин.
+    @param out_vertices Массив для сохранения упакованных вершин (не менее vertex_count элементов).
+    @param out_range Указатель для сохранения диапазона квантования положений.
+*/
+KAPI void geometry_pack_vertices(u32 vertex_count, const vertex_3d* vertices, vertex_3d_packed* out_vertices, extents_3d* out_range);
+
+/*
+    @brief Распаковывает вершины из компактного формата vertex_3d_packed (обратное geometry_pack_vertices).
+    @param vertex_count Количество вершин.
+    @param vertices Массив упакованных вершин.
+    @param range Указатель на диапазон квантования положений.
+    @param out_vertices Массив для сохранения распакованных вершин (не менее vertex_count элементов).
+*/
+KAPI void geometry_unpack_vertices(u32 vertex_count, const vertex_3d_packed* vertices, const extents_3d* range, vertex_3d* out_vertices);
@@ -12,38 +12,112 @@
 // {
 // }
 
-// plane_3d plane_3d_create(vec3 p1, vec3 norm)
-// {
-// }
+plane_3d plane_3d_create(vec3 p1, vec3 norm)
+{
+    plane_3d p;
+    p.normal = vec3_normalized(norm);
+    p.distance = vec3_dot(p.normal, p1);
+    return p;
+}
 
-// frustum frustum_create(const vec3 *position, const vec3 *forward, const vec3 *right, const vec3 *up, f32 aspect, f32 fov, f32 near, f32 far)
-// {
-// }
+frustum frustum_create(const vec3 *position, const vec3 *forward, const vec3 *right, const vec3 *up, f32 aspect, f32 fov, f32 near, f32 far)
+{
+    frustum f;
+    f32 half_v = far * ktan(fov * 0.5f);
+    f32 half_h = half_v * aspect;
+    vec3 forward_far = vec3_mul_scalar(*forward, far);
+    vec3 right_half = vec3_mul_scalar(*right, half_h);
+    vec3 up_half = vec3_mul_scalar(*up, half_v);
 
-// frustum frustum_from_view_projection(mat4 view_projection)
-// {
-// }
+    // NOTE: Нормали плоскостей направлены внутрь усеченной пирамиды.
+    f.sides[FRUSTUM_SIDE_2BEAR]  = plane_3d_create(vec3_add(*position, vec3_mul_scalar(*forward, near)), *forward);
+    f.sides[FRUSTUM_SIDE_FAR]    = plane_3d_create(vec3_add(*position, forward_far), vec3_mul_scalar(*forward, -1.0f));
+    f.sides[FRUSTUM_SIDE_RIGHT]  = plane_3d_create(*position, vec3_cross(*up, vec3_add(forward_far, right_half)));
+    f.sides[FRUSTUM_SIDE_LEFT]   = plane_3d_create(*position, vec3_cross(vec3_sub(forward_far, right_half), *up));
+    f.sides[FRUSTUM_SIDE_TOP]    = plane_3d_create(*position, vec3_cross(vec3_add(forward_far, up_half), *right));
+    f.sides[FRUSTUM_SIDE_BOTTOM] = plane_3d_create(*position, vec3_cross(*right, vec3_sub(forward_far, up_half)));
+    return f;
+}
 
-// void frustum_corner_points_world_space(mat4 projection_view, vec4 *corners)
-// {
-// }
+// Плоскость a * x + b * y + c * z + d >= 0 (внутренняя сторона) из строки матрицы отсечения.
+static plane_3d plane_3d_from_clip_row(f32 a, f32 b, f32 c, f32 d)
+{
+    plane_3d p;
+    f32 inv_length = 1.0f / ksqrt(a * a + b * b + c * c);
+    p.normal = vec3_create(a * inv_length, b * inv_length, c * inv_length);
+    p.distance = -d * inv_length;
+    return p;
+}
 
-// f32 plane_signed_distance(const plane_3d *p, const vec3 *position)
-// {
-// }
+frustum frustum_from_view_projection(mat4 view_projection)
+{
+    // NOTE: Векторы-строки: clip = p * view_projection, поэтому координата отсечения j это столбец j матрицы.
+    const f32* m = view_projection.data;
+    frustum f;
+    f.sides[FRUSTUM_SIDE_LEFT]   = plane_3d_from_clip_row(m[3] + m[0], m[7] + m[4], m[11] + m[8],  m[15] + m[12]);
+    f.sides[FRUSTUM_SIDE_RIGHT]  = plane_3d_from_clip_row(m[3] - m[0], m[7] - m[4], m[11] - m[8],  m[15] - m[12]);
+    f.sides[FRUSTUM_SIDE_BOTTOM] = plane_3d_from_clip_row(m[3] + m[1], m[7] + m[5], m[11] + m[9],  m[15] + m[13]);
+    f.sides[FRUSTUM_SIDE_TOP]    = plane_3d_from_clip_row(m[3] - m[1], m[7] - m[5], m[11] - m[9],  m[15] - m[13]);
+    f.sides[FRUSTUM_SIDE_2BEAR]  = plane_3d_from_clip_row(m[3] + m[2], m[7] + m[6], m[11] + m[10], m[15] + m[14]);
+    f.sides[FRUSTUM_SIDE_FAR]    = plane_3d_from_clip_row(m[3] - m[2], m[7] - m[6], m[11] - m[10], m[15] - m[14]);
+    return f;
+}
 
-// bool plane_intersects_sphere(const plane_3d *p, const vec3 *center, f32 radius)
-// {
-// }
+void frustum_corner_points_world_space(mat4 projection_view, vec4 *corners)
+{
+    mat4 inverse_view_projection = mat4_inverse(projection_view);
 
-// bool frustum_intersects_sphere(const frustum *f, const vec3 *center, f32 radius)
-// {
-// }
+    u32 index = 0;
+    for(u32 z = 0; z < 2; ++z)
+    {
+        for(u32 y = 0; y < 2; ++y)
+        {
+            for(u32 x = 0; x < 2; ++x)
+            {
+                vec4 ndc = vec4_create(x * 2.0f - 1.0f, y * 2.0f - 1.0f, z * 2.0f - 1.0f, 1.0f);
+                vec4 point = vec4_mul_mat4(ndc, inverse_view_projection);
+                corners[index++] = vec4_div_scalar(point, point.w);
+            }
+        }
+    }
+}
 
-// bool plane_intersects_aabb(const plane_3d *p, const vec3 *center, const vec3 *extents)
-// {
-// }
+f32 plane_signed_distance(const plane_3d *p, const vec3 *position)
+{
+    return vec3_dot(p->normal, *position) - p->distance;
+}
 
-// bool frustum_intersects_aabb(const frustum *f, const vec3 *center, const vec3 *extents)
-// {
-// }
+bool plane_intersects_sphere(const plane_3d *p, const vec3 *center, f32 radius)
+{
+    return plane_signed_distance(p, center) > -radius;
+}
+
+bool frustum_intersects_sphere(const frustum *f, const vec3 *center, f32 radius)
+{
+    for(u32 i = 0; i < FRUSTUM_SIDES_MAX; ++i)
+    {
+        if(!plane_intersects_sphere(&f->sides[i], center, radius))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool plane_intersects_aabb(const plane_3d *p, const vec3 *center, const vec3 *extents)
+{
+    f32 r = extents->x * kabs(p->normal.x) + extents->y * kabs(p->normal.y) + extents->z * kabs(p->normal.z);
+    return -r <= plane_signed_distance(p, center);
+}
+
+bool frustum_intersects_aabb(const frustum *f, const vec3 *center, const vec3 *extents)
+{
+    for(u32 i = 0; i < FRUSTUM_SIDES_MAX; ++i)
+    {
+        if(!plane_intersects_aabb(&f->sides[i], center, extents))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -2,6 +2,7 @@
 
 #include <defines.h>
 #include <math/math_types.h>
+#include <math/ksimd.h>
 #include <platform/math.h>
 
 // Приблизительное представление числа ПИ.
@@ -113,31 +114,181 @@ KINLINE f32 kstep(f32 edge, f32 x)
 
 /*
     @brief Вычисляет квадратный корень числа.
+    NOTE: Встраивается в место вызова, результат совпадает с platform_math_sqrt (корень округляется точно).
     @param x Число.
     @return Результирующее значение.
 */
-#define ksqrt(x) platform_math_sqrt(x)
+KINLINE f32 ksqrt(f32 x)
+{
+#if KSIMD_BACKEND_SSE
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(x)));
+#elif KSIMD_BACKEND_NEON
+    return vget_lane_f32(vsqrt_f32(vdup_n_f32(x)), 0);
+#else
+    return platform_math_sqrt(x);
+#endif
+}
+
+/*
+    @brief Вычисляет квадратный корень числа двойной точности.
+    @param x Число.
+    @return Результирующее значение.
+*/
+#define ksqrt_f64(x) platform_math_sqrt_f64(x)
 
 /*
     @brief Вычисляет абсолютное значение числа.
     @param x Число.
     @return Результирующее значение.
 */
-#define kabs(x) platform_math_abs(x)
+KINLINE f32 kabs(f32 x)
+{
+    return __builtin_fabsf(x);
+}
 
 /*
     @brief Возвращает наибольшее целое значение, меньшее или равное числу.
+    NOTE: Числа с модулем от 2^23 уже целые и, как NaN и бесконечность, возвращаются без изменений.
     @param x Число.
     @return Результирующее значение.
 */
-#define kfloor(x) platform_math_floor(x)
+KINLINE f32 kfloor(f32 x)
+{
+    if(!(kabs(x) < 8388608.0f))
+    {
+        return x;
+    }
+
+    f32 t = (f32)(i32)x;
+    return __builtin_copysignf(t > x ? t - 1.0f : t, x);
+}
 
 /*
     @brief Возвращает наименьшее целое значение, большее или равное числу.
+    NOTE: Числа с модулем от 2^23 уже целые и, как NaN и бесконечность, возвращаются без изменений.
     @param x Число.
     @return Результирующее значение.
 */
-#define kceil(x) platform_math_ceil(x)
+KINLINE f32 kceil(f32 x)
+{
+    if(!(kabs(x) < 8388608.0f))
+    {
+        return x;
+    }
+
+    f32 t = (f32)(i32)x;
+    return __builtin_copysignf(t < x ? t + 1.0f : t, x);
+}
+
+/*
+    @brief Вычисляет обратный квадратный корень числа (1 / sqrt(x)).
+    @param x Число.
+    @return Результирующее значение.
+*/
+KINLINE f32 krsqrt(f32 x)
+{
+    return 1.0f / ksqrt(x);
+}
+
+/*
+    @brief Быстро вычисляет приближение обратного квадратного корня числа (1 / sqrt(x)).
+    NOTE: Начальное приближение по битам числа и два шага Ньютона, относительная ошибка до 4.8e-6.
+          Аппаратная оценка (rsqrtss) не используется: скалярная инструкция мешает векторизации циклов.
+          Для x <= 0, бесконечности и NaN результат не определен.
+    @param x Положительное число.
+    @return Результирующее значение.
+*/
+KINLINE f32 krsqrt_fast(f32 x)
+{
+    union { f32 f; u32 i; } bits = { .f = x };
+    bits.i = 0x5f375a86 - (bits.i >> 1);
+    f32 r = bits.f;
+    r = r * (1.5f - 0.5f * x * r * r);
+    r = r * (1.5f - 0.5f * x * r * r);
+    return r;
+}
+
+/*
+    @brief Вычисляет приближение синуса угла в диапазоне [-PI/2, PI/2] и меняет знак для нечетного полуоборота.
+    NOTE: Минимаксный многочлен 9-й степени (ошибка многочлена 3.4e-9). Вычисляется без ветвлений, поэтому
+          циклы с ksin_fast/kcos_fast векторизуются компилятором.
+    @param r Угол в радианах в диапазоне [-PI/2, PI/2].
+    @param half_turns Количество полуоборотов, вычтенных из исходного угла.
+    @return Результирующее значение.
+*/
+KINLINE f32 ksin_fast_reduced(f32 r, i32 half_turns)
+{
+    f32 r2 = r * r;
+    union { f32 f; u32 i; } result = {
+        .f = r * (9.999999766e-01f + r2 * (-1.666664763e-01f + r2 * (8.332899823e-03f
+           + r2 * (-1.980089776e-04f + r2 * 2.590488501e-06f))))
+    };
+
+    // sin(r + k * PI) = (-1)^k * sin(r).
+    result.i ^= (u32)half_turns << 31;
+    return result.f;
+}
+
+/*
+    @brief Быстро вычисляет приближение синуса числа.
+    NOTE: Угол приводится к [-PI/2, PI/2] вычитанием k * PI, где PI представлено суммой двух чисел (первое
+          с 8 значащими битами, поэтому его произведение на k точное). Абсолютная ошибка до 1.8e-7 при
+          |x| <= 1e4 и до 1.2e-6 при |x| <= 1e5 (растет из-за приведения). Результат определен при |x| < 1e5.
+    @param x Угол в радианах.
+    @return Результирующее значение.
+*/
+KINLINE f32 ksin_fast(f32 x)
+{
+    f32 k = x * K_ONE_OVER_PI;
+    i32 half_turns = (i32)(k + __builtin_copysignf(0.5f, k));
+    k = (f32)half_turns;
+    return ksin_fast_reduced((x - k * 3.140625f) - k * 9.676535897932384e-4f, half_turns);
+}
+
+/*
+    @brief Быстро вычисляет приближение косинуса числа.
+    NOTE: cos(x) = sin(x + PI/2), сдвиг учитывается при приведении (вычитается (k + 1/2) * PI),
+          поэтому ошибка как у ksin_fast.
+    @param x Угол в радианах.
+    @return Результирующее значение.
+*/
+KINLINE f32 kcos_fast(f32 x)
+{
+    f32 k = x * K_ONE_OVER_PI - 0.5f;
+    i32 half_turns = (i32)(k + __builtin_copysignf(0.5f, k));
+    k = (f32)half_turns + 0.5f;
+    return ksin_fast_reduced((x - k * 3.140625f) - k * 9.676535897932384e-4f, half_turns + 1);
+}
+
+/*
+    @brief Быстро вычисляет приближение тангенса числа как отношение ksin_fast и kcos_fast.
+    NOTE: Относительная ошибка до 4e-7 вдали от PI/2 + k * PI, где тангенс не определен.
+    @param x Угол в радианах.
+    @return Результирующее значение.
+*/
+KINLINE f32 ktan_fast(f32 x)
+{
+    return ksin_fast(x) / kcos_fast(x);
+}
+
+/*
+    @brief Быстро вычисляет приближение арктангенса числа.
+    NOTE: Аргумент приводится к [0, 1] по формуле atan(x) = PI/2 - atan(1/x), далее минимаксный многочлен
+          11-й степени. Абсолютная ошибка до 1.7e-6 радиан на всей числовой оси.
+    @param x Число.
+    @return Угол в радианах в диапазоне [-PI/2, PI/2].
+*/
+KINLINE f32 katan_fast(f32 x)
+{
+    // Без ветвлений: при |x| > 1 многочлен вычисляется от 1/|x| (он меньше |x|), результат PI/2 - r.
+    f32 a = kabs(x);
+    f32 t = KMIN(a, 1.0f / a);
+    f32 invert = (f32)(a > 1.0f);
+    f32 t2 = t * t;
+    f32 r = t * (9.999772191e-01f + t2 * (-3.326228279e-01f + t2 * (1.935403761e-01f
+          + t2 * (-1.164264820e-01f + t2 * (5.264735147e-02f + t2 * -1.171913573e-02f)))));
+    return __builtin_copysignf(invert * K_HALF_PI + (1.0f - 2.0f * invert) * r, x);
+}
 
 /*
     @brief Вычисляет логарифм числа по основанию 2 (т.е. сколько раз x можно разделить на 2).
@@ -748,6 +899,17 @@ KINLINE vec3 vec3_normalized(vec3 vector)
     return vector;
 }
 
+/*
+    @brief Возвращает копию нормализованного вектора, вычисленную через приближение krsqrt_fast.
+    NOTE: Относительная ошибка длины как у krsqrt_fast, для нулевого вектора результат не определен.
+    @param vector Вектор.
+    @return Копия нормализованого вектора.
+*/
+KINLINE vec3 vec3_normalized_fast(vec3 vector)
+{
+    return vec3_mul_scalar(vector, krsqrt_fast(vec3_length_squared(vector)));
+}
+
 /*
     @brief Вычисляет скалярное произведение двух векторов.
     NOTE: Обычно используется для вычисления разницы в направлении.
@@ -842,13 +1004,13 @@ KINLINE f32 vec3_distance_squared(vec3 vector_0, vec3 vector_1)
 }
 
 /*
-    @brief Преобразовывает вектор с помощью матрицы.
+    @brief Преобразовывает вектор с помощью матрицы (скалярная реализация).
     @param v Вектор.
     @param w Передать 1.0f для точки или 0.0f для направления.
     @param m Матрица.
     @return Преобразованная копия вектора.
 */
-KINLINE vec3 vec3_transform(vec3 v, f32 w, mat4 m)
+KINLINE vec3 vec3_transform_scalar(vec3 v, f32 w, mat4 m)
 {
     vec3 out;
     out.x = v.x * m.data[0 + 0] + v.y * m.data[4 + 0] + v.z * m.data[8 + 0] + w * m.data[12 + 0];
@@ -857,6 +1019,29 @@ KINLINE vec3 vec3_transform(vec3 v, f32 w, mat4 m)
     return out;
 }
 
+/*
+    @brief Преобразовывает вектор с помощью матрицы.
+    @param v Вектор.
+    @param w Передать 1.0f для точки или 0.0f для направления.
+    @param m Матрица.
+    @return Преобразованная копия вектора.
+*/
+KINLINE vec3 vec3_transform(vec3 v, f32 w, mat4 m)
+{
+#if KSIMD_ENABLED
+    f32x4 r = f32x4_mul(f32x4_splat(v.x), f32x4_load(&m.data[0]));
+    r = f32x4_mul_add(f32x4_splat(v.y), f32x4_load(&m.data[4]), r);
+    r = f32x4_mul_add(f32x4_splat(v.z), f32x4_load(&m.data[8]), r);
+    r = f32x4_mul_add(f32x4_splat(w), f32x4_load(&m.data[12]), r);
+
+    vec4 out;
+    f32x4_store(out.elements, r);
+    return (vec3){{out.x, out.y, out.z}};
+#else
+    return vec3_transform_scalar(v, w, m);
+#endif
+}
+
 /*
     @brief Поворачивает вектор с помощю кватерниона.
     @param v Вектор.
@@ -1144,14 +1329,14 @@ KINLINE mat4 mat4_identity()
 }
 
 /*
-    @brefi Перемножает две матрицы 4x4.
+    @brief Перемножает две матрицы 4x4 (скалярная реализация).
     @param matrix_0 Первая матрица.
     @param matrix_1 Вторая матрица.
     @return Результирующая матрица.
 */
-KINLINE mat4 mat4_mul(mat4 matrix_0, mat4 matrix_1)
+KINLINE mat4 mat4_mul_scalar(mat4 matrix_0, mat4 matrix_1)
 {
-    mat4 out_matrix = mat4_identity();
+    mat4 out_matrix;
 
     const f32* m1 = matrix_0.data;
     const f32* m2 = matrix_1.data;
@@ -1172,6 +1357,65 @@ KINLINE mat4 mat4_mul(mat4 matrix_0, mat4 matrix_1)
     return out_matrix;
 }
 
+/*
+    @brief Перемножает две матрицы 4x4.
+    NOTE: Строка результата - сумма строк второй матрицы, умноженных на элементы строки первой матрицы.
+    @param matrix_0 Первая матрица.
+    @param matrix_1 Вторая матрица.
+    @return Результирующая матрица.
+*/
+KINLINE mat4 mat4_mul(mat4 matrix_0, mat4 matrix_1)
+{
+#if KSIMD_BACKEND_AVX2
+    // Две строки за раз: строки второй матрицы продублированы в обеих половинах регистра.
+    const f32* m1 = matrix_0.data;
+    const f32* m2 = matrix_1.data;
+    __m256 r0 = _mm256_broadcast_ps((const __m128*)&m2[0]);
+    __m256 r1 = _mm256_broadcast_ps((const __m128*)&m2[4]);
+    __m256 r2 = _mm256_broadcast_ps((const __m128*)&m2[8]);
+    __m256 r3 = _mm256_broadcast_ps((const __m128*)&m2[12]);
+
+    mat4 out_matrix;
+    for(u32 i = 0; i < 16; i += 8)
+    {
+        __m256 a = _mm256_loadu_ps(&m1[i]);
+        __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x00), r0);
+    #if KSIMD_FMA
+        r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0x55), r1, r);
+        r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0xaa), r2, r);
+        r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0xff), r3, r);
+    #else
+        r = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x55), r1), r);
+        r = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a, a, 0xaa), r2), r);
+        r = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a, a, 0xff), r3), r);
+    #endif
+        _mm256_storeu_ps(&out_matrix.data[i], r);
+    }
+    return out_matrix;
+#elif KSIMD_ENABLED
+    const f32* m1 = matrix_0.data;
+    const f32* m2 = matrix_1.data;
+    f32x4 r0 = f32x4_load(&m2[0]);
+    f32x4 r1 = f32x4_load(&m2[4]);
+    f32x4 r2 = f32x4_load(&m2[8]);
+    f32x4 r3 = f32x4_load(&m2[12]);
+
+    mat4 out_matrix;
+    for(u32 i = 0; i < 16; i += 4)
+    {
+        f32x4 a = f32x4_load(&m1[i]);
+        f32x4 r = f32x4_mul(f32x4_splat_lane(a, 0), r0);
+        r = f32x4_mul_add(f32x4_splat_lane(a, 1), r1, r);
+        r = f32x4_mul_add(f32x4_splat_lane(a, 2), r2, r);
+        r = f32x4_mul_add(f32x4_splat_lane(a, 3), r3, r);
+        f32x4_store(&out_matrix.data[i], r);
+    }
+    return out_matrix;
+#else
+    return mat4_mul_scalar(matrix_0, matrix_1);
+#endif
+}
+
 /*
     @brief Создает матрицу ортогональной проекции.
     NOTE: Обычно используется для визуализации плоских или 2D-сцен.
@@ -1220,6 +1464,27 @@ KINLINE mat4 mat4_perspective(f32 fov_radians, f32 aspect_ratio, f32 near_clip,
     return out_matrix;
 }
 
+/*
+    @brief Создает матрицу перспективной проекции, тангенс вычисляется через ktan_fast.
+    NOTE: Ошибка приближения много меньше точности буфера глубины.
+    @param fov_radians Поле зрения в радианах.
+    @param aspects_ratio Соотношение сторон.
+    @param near_clip Расстояние до ближней плоскости отсечения.
+    @param far_clip Расстояние до дальней плоскости отсечения.
+    @return Новая матрица перспективы.
+*/
+KINLINE mat4 mat4_perspective_fast(f32 fov_radians, f32 aspect_ratio, f32 near_clip, f32 far_clip)
+{
+    f32 half_tan_fov = ktan_fast(fov_radians * 0.5f);
+    mat4 out_matrix = {0};
+    out_matrix.data[0]  = 1.0f / (aspect_ratio * half_tan_fov);
+    out_matrix.data[5]  = 1.0f / half_tan_fov;
+    out_matrix.data[10] = -((far_clip + near_clip) / (far_clip - near_clip));
+    out_matrix.data[11] = -1.0f;
+    out_matrix.data[14] = -((2.0f * far_clip * near_clip) / (far_clip - near_clip));
+    return out_matrix;
+}
+
 /*
     @brief Создает матрицу с направлением в сторону точки.
     @param position Матрица позиции.
@@ -1339,11 +1604,11 @@ KINLINE f32 mat4_determinant(mat4 matrix)
 }
 
 /*
-    @brief Создает обратную матрицу предоставленной матрицы.
+    @brief Создает обратную матрицу предоставленной матрицы (скалярная реализация).
     @param matrix Матрица.
     @return Копия обратной матрицы.
 */
-KINLINE mat4 mat4_inverse(mat4 matrix)
+KINLINE mat4 mat4_inverse_scalar(mat4 matrix)
 {
     const f32 *m = matrix.data;
     f32 t0  = m[10] * m[15];
@@ -1399,6 +1664,100 @@ KINLINE mat4 mat4_inverse(mat4 matrix)
     return out_matrix;
 }
 
+#if KSIMD_ENABLED
+
+// @brief Произведение матриц 2x2, упакованных в вектор (m00, m01, m10, m11): a * b.
+KINLINE f32x4 mat2_mul_simd(f32x4 a, f32x4 b)
+{
+    return f32x4_add(
+        f32x4_mul(a, f32x4_shuffle(b, b, 0, 3, 0, 3)),
+        f32x4_mul(f32x4_shuffle(a, a, 1, 0, 3, 2), f32x4_shuffle(b, b, 2, 1, 2, 1))
+    );
+}
+
+// @brief Произведение присоединенной матрицы 2x2 на матрицу: adj(a) * b.
+KINLINE f32x4 mat2_adj_mul_simd(f32x4 a, f32x4 b)
+{
+    return f32x4_sub(
+        f32x4_mul(f32x4_shuffle(a, a, 3, 3, 0, 0), b),
+        f32x4_mul(f32x4_shuffle(a, a, 1, 1, 2, 2), f32x4_shuffle(b, b, 2, 3, 0, 1))
+    );
+}
+
+// @brief Произведение матрицы 2x2 на присоединенную матрицу: a * adj(b).
+KINLINE f32x4 mat2_mul_adj_simd(f32x4 a, f32x4 b)
+{
+    return f32x4_sub(
+        f32x4_mul(a, f32x4_shuffle(b, b, 3, 0, 3, 0)),
+        f32x4_mul(f32x4_shuffle(a, a, 1, 0, 3, 2), f32x4_shuffle(b, b, 2, 1, 2, 1))
+    );
+}
+
+#endif
+
+/*
+    @brief Создает обратную матрицу предоставленной матрицы.
+    NOTE: Векторная реализация обращает матрицу по блокам 2x2 (формула Фробениуса через присоединенные
+          матрицы), поэтому результат может отличаться от скалярной реализации в последних разрядах.
+    @param matrix Матрица.
+    @return Копия обратной матрицы.
+*/
+KINLINE mat4 mat4_inverse(mat4 matrix)
+{
+#if KSIMD_ENABLED
+    f32x4 row0 = f32x4_load(&matrix.data[0]);
+    f32x4 row1 = f32x4_load(&matrix.data[4]);
+    f32x4 row2 = f32x4_load(&matrix.data[8]);
+    f32x4 row3 = f32x4_load(&matrix.data[12]);
+
+    // Блоки матрицы: | A B |
+    //                | C D |
+    f32x4 a = f32x4_shuffle(row0, row1, 0, 1, 0, 1);
+    f32x4 b = f32x4_shuffle(row0, row1, 2, 3, 2, 3);
+    f32x4 c = f32x4_shuffle(row2, row3, 0, 1, 0, 1);
+    f32x4 d = f32x4_shuffle(row2, row3, 2, 3, 2, 3);
+
+    // Определители блоков (|A|, |B|, |C|, |D|).
+    f32x4 det_sub = f32x4_sub(
+        f32x4_mul(f32x4_shuffle(row0, row2, 0, 2, 0, 2), f32x4_shuffle(row1, row3, 1, 3, 1, 3)),
+        f32x4_mul(f32x4_shuffle(row0, row2, 1, 3, 1, 3), f32x4_shuffle(row1, row3, 0, 2, 0, 2))
+    );
+    f32x4 det_a = f32x4_splat_lane(det_sub, 0);
+    f32x4 det_b = f32x4_splat_lane(det_sub, 1);
+    f32x4 det_c = f32x4_splat_lane(det_sub, 2);
+    f32x4 det_d = f32x4_splat_lane(det_sub, 3);
+
+    f32x4 d_c = mat2_adj_mul_simd(d, c);
+    f32x4 a_b = mat2_adj_mul_simd(a, b);
+    f32x4 x = f32x4_sub(f32x4_mul(det_d, a), mat2_mul_simd(b, d_c));
+    f32x4 w = f32x4_sub(f32x4_mul(det_a, d), mat2_mul_simd(c, a_b));
+    f32x4 y = f32x4_sub(f32x4_mul(det_b, c), mat2_mul_adj_simd(d, a_b));
+    f32x4 z = f32x4_sub(f32x4_mul(det_c, b), mat2_mul_adj_simd(a, d_c));
+
+    // Определитель матрицы: |A||D| + |B||C| - tr(adj(A)B * adj(D)C).
+    f32x4 det = f32x4_add(f32x4_mul(det_a, det_d), f32x4_mul(det_b, det_c));
+    f32x4 trace = f32x4_mul(a_b, f32x4_shuffle(d_c, d_c, 0, 2, 1, 3));
+    trace = f32x4_add(trace, f32x4_shuffle(trace, trace, 2, 3, 0, 1));
+    trace = f32x4_add(trace, f32x4_shuffle(trace, trace, 1, 0, 3, 2));
+    det = f32x4_sub(det, trace);
+
+    f32x4 det_inv = f32x4_div(f32x4_set(1.0f, -1.0f, -1.0f, 1.0f), det);
+    x = f32x4_mul(x, det_inv);
+    y = f32x4_mul(y, det_inv);
+    z = f32x4_mul(z, det_inv);
+    w = f32x4_mul(w, det_inv);
+
+    mat4 out_matrix;
+    f32x4_store(&out_matrix.data[0],  f32x4_shuffle(x, y, 3, 1, 3, 1));
+    f32x4_store(&out_matrix.data[4],  f32x4_shuffle(x, y, 2, 0, 2, 0));
+    f32x4_store(&out_matrix.data[8],  f32x4_shuffle(z, w, 3, 1, 3, 1));
+    f32x4_store(&out_matrix.data[12], f32x4_shuffle(z, w, 2, 0, 2, 0));
+    return out_matrix;
+#else
+    return mat4_inverse_scalar(matrix);
+#endif
+}
+
 /*
     @brief Создает матрицу перемещения в заданную позицию.
     @param position Позиция.
@@ -1473,6 +1832,24 @@ KINLINE mat4 mat4_euler_x(f32 angle_radians)
     return out_matrix;
 }
 
+/*
+    @brief Создает матрицу вращения по оси x через ksin_fast/kcos_fast.
+    NOTE: Угол должен быть меньше 1e5 по модулю.
+    @param angle_radians Угол x в радианах.
+    @return Матрица поворота.
+*/
+KINLINE mat4 mat4_euler_x_fast(f32 angle_radians)
+{
+    mat4 out_matrix = mat4_identity();
+    f32 c = kcos_fast(angle_radians);
+    f32 s = ksin_fast(angle_radians);
+    out_matrix.data[5]  =  c;
+    out_matrix.data[6]  =  s;
+    out_matrix.data[9]  = -s;
+    out_matrix.data[10] =  c;
+    return out_matrix;
+}
+
 /*
     @brief Создает матрицу вращения по оси y.
     @param angle_radians Угол y в радианах.
@@ -1490,6 +1867,24 @@ KINLINE mat4 mat4_euler_y(f32 angle_radians)
     return out_matrix;
 }
 
+/*
+    @brief Создает матрицу вращения по оси y через ksin_fast/kcos_fast.
+    NOTE: Угол должен быть меньше 1e5 по модулю.
+    @param angle_radians Угол y в радианах.
+    @return Матрица поворота.
+*/
+KINLINE mat4 mat4_euler_y_fast(f32 angle_radians)
+{
+    mat4 out_matrix = mat4_identity();
+    f32 c = kcos_fast(angle_radians);
+    f32 s = ksin_fast(angle_radians);
+    out_matrix.data[0]  =  c;
+    out_matrix.data[2]  = -s;
+    out_matrix.data[8]  =  s;
+    out_matrix.data[10] =  c;
+    return out_matrix;
+}
+
 /*
     @brief Создает матрицу вращения по оси z.
     @param angle_radians Угол z в радианах.
@@ -1507,6 +1902,24 @@ KINLINE mat4 mat4_euler_z(f32 angle_radians)
     return out_matrix;
 }
 
+/*
+    @brief Создает матрицу вращения по оси z через ksin_fast/kcos_fast.
+    NOTE: Угол должен быть меньше 1e5 по модулю.
+    @param angle_radians Угол z в радианах.
+    @return Матрица поворота.
+*/
+KINLINE mat4 mat4_euler_z_fast(f32 angle_radians)
+{
+    mat4 out_matrix = mat4_identity();
+    f32 c = kcos_fast(angle_radians);
+    f32 s = ksin_fast(angle_radians);
+    out_matrix.data[0] =  c;
+    out_matrix.data[1] =  s;
+    out_matrix.data[4] = -s;
+    out_matrix.data[5] =  c;
+    return out_matrix;
+}
+
 /*
     @brief Создает матрицу вращения по осям x, y и z.
     @param x_radians Угол x в радианах.
@@ -1525,6 +1938,25 @@ KINLINE mat4 mat4_euler_xyz(f32 x_radians, f32 y_radians, f32 z_radians)
     return out_matrix;
 }
 
+/*
+    @brief Создает матрицу вращения по осям x, y и z через ksin_fast/kcos_fast.
+    NOTE: Углы должны быть меньше 1e5 по модулю.
+    @param x_radians Угол x в радианах.
+    @param y_radians Угол y в радианах.
+    @param z_radians Угол z в радианах.
+    @return Матрица вращения.
+*/
+KINLINE mat4 mat4_euler_xyz_fast(f32 x_radians, f32 y_radians, f32 z_radians)
+{
+    mat4 rx = mat4_euler_x_fast(x_radians);
+    mat4 ry = mat4_euler_y_fast(y_radians);
+    mat4 rz = mat4_euler_z_fast(z_radians);
+    mat4 out_matrix = mat4_mul(rx, ry);
+    out_matrix = mat4_mul(out_matrix, rz);
+
+    return out_matrix;
+}
+
 /*
     @brief Возвращает вектор направленный прямо относительно предоставленной матрицы.
     @param matrix Матрица, на которой базируется вектор.
@@ -1540,6 +1972,21 @@ KINLINE vec3 mat4_forward(mat4 matrix)
     return forward;
 }
 
+/*
+    @brief Возвращает вектор направленный прямо относительно предоставленной матрицы.
+    NOTE: Нормализуется через vec3_normalized_fast.
+    @param matrix Матрица, на которой базируется вектор.
+    @return Направленный вектор.
+*/
+KINLINE vec3 mat4_forward_fast(mat4 matrix)
+{
+    vec3 forward;
+    forward.x = -matrix.data[2];
+    forward.y = -matrix.data[6];
+    forward.z = -matrix.data[10];
+    return vec3_normalized_fast(forward);
+}
+
 /*
     @brief Возвращает вектор направленный назад относительно предоставленной матрицы.
     @param matrix Матрица, на которой базируется вектор.
@@ -1555,6 +2002,21 @@ KINLINE vec3 mat4_backward(mat4 matrix)
     return backward;
 }
 
+/*
+    @brief Возвращает вектор направленный назад относительно предоставленной матрицы.
+    NOTE: Нормализуется через vec3_normalized_fast.
+    @param matrix Матрица, на которой базируется вектор.
+    @return Направленный вектор.
+*/
+KINLINE vec3 mat4_backward_fast(mat4 matrix)
+{
+    vec3 backward;
+    backward.x = matrix.data[2];
+    backward.y = matrix.data[6];
+    backward.z = matrix.data[10];
+    return vec3_normalized_fast(backward);
+}
+
 /*
     @brief Возвращает вектор направленный вверх относительно предоставленной матрицы.
     @param matrix Матрица, на которой базируется вектор.
@@ -1570,6 +2032,21 @@ KINLINE vec3 mat4_up(mat4 matrix)
     return up;
 }
 
+/*
+    @brief Возвращает вектор направленный вверх относительно предоставленной матрицы.
+    NOTE: Нормализуется через vec3_normalized_fast.
+    @param matrix Матрица, на которой базируется вектор.
+    @return Направленный вектор.
+*/
+KINLINE vec3 mat4_up_fast(mat4 matrix)
+{
+    vec3 up;
+    up.x = matrix.data[1];
+    up.y = matrix.data[5];
+    up.z = matrix.data[9];
+    return vec3_normalized_fast(up);
+}
+
 /*
     @brief Возвращает вектор направленный вниз относительно предоставленной матрицы.
     @param matrix Матрица, на которой базируется вектор.
@@ -1585,6 +2062,21 @@ KINLINE vec3 mat4_down(mat4 matrix)
     return down;
 }
 
+/*
+    @brief Возвращает вектор направленный вниз относительно предоставленной матрицы.
+    NOTE: Нормализуется через vec3_normalized_fast.
+    @param matrix Матрица, на которой базируется вектор.
+    @return Направленный вектор.
+*/
+KINLINE vec3 mat4_down_fast(mat4 matrix)
+{
+    vec3 down;
+    down.x = -matrix.data[1];
+    down.y = -matrix.data[5];
+    down.z = -matrix.data[9];
+    return vec3_normalized_fast(down);
+}
+
 /*
     @brief Возвращает вектор направленный влево относительно предоставленной матрицы.
     @param matrix Матрица, на которой базируется вектор.
@@ -1600,6 +2092,21 @@ KINLINE vec3 mat4_left(mat4 matrix)
     return left;
 }
 
+/*
+    @brief Возвращает вектор направленный влево относительно предоставленной матрицы.
+    NOTE: Нормализуется через vec3_normalized_fast.
+    @param matrix Матрица, на которой базируется вектор.
+    @return Направленный вектор.
+*/
+KINLINE vec3 mat4_left_fast(mat4 matrix)
+{
+    vec3 left;
+    left.x = -matrix.data[0];
+    left.y = -matrix.data[4];
+    left.z = -matrix.data[8];
+    return vec3_normalized_fast(left);
+}
+
 /*
     @brief Возвращает вектор направленный вправо относительно предоставленной матрицы.
     @param matrix Матрица, на которой базируется вектор.
@@ -1615,6 +2122,21 @@ KINLINE vec3 mat4_right(mat4 matrix)
     return right;
 }
 
+/*
+    @brief Возвращает вектор направленный вправо относительно предоставленной матрицы.
+    NOTE: Нормализуется через vec3_normalized_fast.
+    @param matrix Матрица, на которой базируется вектор.
+    @return Направленный вектор.
+*/
+KINLINE vec3 mat4_right_fast(mat4 matrix)
+{
+    vec3 right;
+    right.x = matrix.data[0];
+    right.y = matrix.data[4];
+    right.z = matrix.data[8];
+    return vec3_normalized_fast(right);
+}
+
 /*
     @brief Возвращает позицию относительно предоставленной матрицы.
     @param matrix Матрица, на основе которой строится вектор.
@@ -1717,10 +2239,8 @@ KINLINE f32 quat_normal(quat q)
 */
 KINLINE quat quat_normalize(quat q)
 {
-    f32 normal = quat_normal(q);
-    return (quat){{
-        q.x / normal, q.y / normal, q.z / normal, q.w / normal
-    }};
+    // NOTE: Одно деление вместо четырех, ошибка увеличивается не более чем на 1 ulp.
+    return vec4_mul_scalar(q, 1.0f / quat_normal(q));
 }
 
 /*
@@ -1747,12 +2267,12 @@ KINLINE quat quat_inverse(quat q)
 }
 
 /*
-    @brief Умножает предоставленные кватернионы.
+    @brief Умножает предоставленные кватернионы (скалярная реализация).
     @param q_0 Первый кватернион.
     @param q_1 Второй кватернион.
     @return Результирующий кватернион.
 */
-KINLINE quat quat_mul(quat q_0, quat q_1)
+KINLINE quat quat_mul_scalar(quat q_0, quat q_1)
 {
     quat out_quaternion;
     out_quaternion.x =  q_0.x * q_1.w + q_0.y * q_1.z 
@@ -1766,6 +2286,35 @@ KINLINE quat quat_mul(quat q_0, quat q_1)
     return out_quaternion;
 }
 
+/*
+    @brief Умножает предоставленные кватернионы.
+    @param q_0 Первый кватернион.
+    @param q_1 Второй кватернион.
+    @return Результирующий кватернион.
+*/
+KINLINE quat quat_mul(quat q_0, quat q_1)
+{
+#if KSIMD_ENABLED
+    // Слагаемые в том же порядке, что и в скалярной реализации (без FMA результат совпадает).
+    f32x4 a = f32x4_load(q_0.elements);
+    f32x4 b = f32x4_load(q_1.elements);
+    f32x4 bx = f32x4_mul(f32x4_shuffle(b, b, 3, 2, 1, 0), f32x4_set( 1.0f, -1.0f,  1.0f, -1.0f));
+    f32x4 by = f32x4_mul(f32x4_shuffle(b, b, 2, 3, 0, 1), f32x4_set( 1.0f,  1.0f, -1.0f, -1.0f));
+    f32x4 bz = f32x4_mul(f32x4_shuffle(b, b, 1, 0, 3, 2), f32x4_set(-1.0f,  1.0f,  1.0f, -1.0f));
+
+    f32x4 r = f32x4_mul(f32x4_splat_lane(a, 0), bx);
+    r = f32x4_mul_add(f32x4_splat_lane(a, 1), by, r);
+    r = f32x4_mul_add(f32x4_splat_lane(a, 2), bz, r);
+    r = f32x4_mul_add(f32x4_splat_lane(a, 3), b, r);
+
+    quat out_quaternion;
+    f32x4_store(out_quaternion.elements, r);
+    return out_quaternion;
+#else
+    return quat_mul_scalar(q_0, q_1);
+#endif
+}
+
 /*
     @brief Вычисляет скалярное произведение предоставленных кватернионов.
     @param q_0 Первый кватернион.
@@ -1778,11 +2327,11 @@ KINLINE f32 quat_dot(quat q_0, quat q_1)
 }
 
 /*
-    @brief Создает матрицу вращения из заданного кватерниона.
+    @brief Создает матрицу вращения из заданного кватерниона (скалярная реализация).
     @param q Кватернион.
     @return Матрица вращения.
 */
-KINLINE mat4 quat_to_mat4(quat q)
+KINLINE mat4 quat_to_mat4_scalar(quat q)
 {
     mat4 out_matrix = mat4_identity();
     quat n = quat_normalize(q);
@@ -1800,6 +2349,47 @@ KINLINE mat4 quat_to_mat4(quat q)
     return out_matrix;
 }
 
+/*
+    @brief Создает матрицу вращения из заданного кватерниона.
+    @param q Кватернион.
+    @return Матрица вращения.
+*/
+KINLINE mat4 quat_to_mat4(quat q)
+{
+#if KSIMD_ENABLED
+    // Нормализация (порядок суммирования как в quat_normal).
+    f32x4 v = f32x4_load(q.elements);
+    f32x4 sq = f32x4_mul(v, v);
+    f32x4 len = f32x4_add(f32x4_splat_lane(sq, 0), f32x4_splat_lane(sq, 1));
+    len = f32x4_add(len, f32x4_splat_lane(sq, 2));
+    len = f32x4_add(len, f32x4_splat_lane(sq, 3));
+    f32x4 n = f32x4_div(v, f32x4_sqrt(len));
+    f32x4 n2 = f32x4_add(n, n);
+
+    // Строка вычисляется как (k - p1) - p2, знаки слагаемых перенесены в p1 и p2, четвертый столбец нулевой.
+    f32x4 p1 = f32x4_mul(f32x4_mul(f32x4_shuffle(n2, n2, 1, 0, 0, 0), f32x4_shuffle(n, n, 1, 1, 2, 2)), f32x4_set(1.0f, -1.0f, -1.0f, 0.0f));
+    f32x4 p2 = f32x4_mul(f32x4_mul(f32x4_shuffle(n2, n2, 2, 2, 1, 1), f32x4_shuffle(n, n, 2, 3, 3, 3)), f32x4_set(1.0f,  1.0f, -1.0f, 0.0f));
+    f32x4 row0 = f32x4_sub(f32x4_sub(f32x4_set(1.0f, 0.0f, 0.0f, 0.0f), p1), p2);
+
+    p1 = f32x4_mul(f32x4_mul(f32x4_shuffle(n2, n2, 0, 0, 1, 1), f32x4_shuffle(n, n, 1, 0, 2, 2)), f32x4_set(-1.0f, 1.0f, -1.0f, 0.0f));
+    p2 = f32x4_mul(f32x4_mul(f32x4_shuffle(n2, n2, 2, 2, 0, 0), f32x4_shuffle(n, n, 3, 2, 3, 3)), f32x4_set(-1.0f, 1.0f,  1.0f, 0.0f));
+    f32x4 row1 = f32x4_sub(f32x4_sub(f32x4_set(0.0f, 1.0f, 0.0f, 0.0f), p1), p2);
+
+    p1 = f32x4_mul(f32x4_mul(f32x4_shuffle(n2, n2, 0, 1, 0, 0), f32x4_shuffle(n, n, 2, 2, 0, 0)), f32x4_set(-1.0f, -1.0f, 1.0f, 0.0f));
+    p2 = f32x4_mul(f32x4_mul(f32x4_shuffle(n2, n2, 1, 0, 1, 1), f32x4_shuffle(n, n, 3, 3, 1, 1)), f32x4_set( 1.0f, -1.0f, 1.0f, 0.0f));
+    f32x4 row2 = f32x4_sub(f32x4_sub(f32x4_set(0.0f, 0.0f, 1.0f, 0.0f), p1), p2);
+
+    mat4 out_matrix;
+    f32x4_store(&out_matrix.data[0], row0);
+    f32x4_store(&out_matrix.data[4], row1);
+    f32x4_store(&out_matrix.data[8], row2);
+    f32x4_store(&out_matrix.data[12], f32x4_set(0.0f, 0.0f, 0.0f, 1.0f));
+    return out_matrix;
+#else
+    return quat_to_mat4_scalar(q);
+#endif
+}
+
 /*
     @brief Вычисляет матрицу вращения на основе кватерниона и переданной центральной точки.
     @param q Кватернион.
@@ -1858,6 +2448,33 @@ KINLINE quat quat_from_axis_angle(vec3 axis, f32 angle, bool normalize)
     return q;
 }
 
+/*
+    @brief Создает кватернион из заданной оси и угла, синус и косинус вычисляются через ksin_fast/kcos_fast.
+    NOTE: Угол должен быть меньше 2e5 по модулю. Нормализация точная: поворот накапливается умножением
+          кватернионов, и ошибка krsqrt_fast меняла бы их длину.
+    @param axis Ось вращения.
+    @param angle Угол вращения.
+    @param normalize Указывает, следует ли нормализовать кватернион.
+    @return Новый кватернион.
+*/
+KINLINE quat quat_from_axis_angle_fast(vec3 axis, f32 angle, bool normalize)
+{
+    const f32 half_angle = 0.5f * angle;
+    f32 s = ksin_fast(half_angle);
+    f32 c = kcos_fast(half_angle);
+
+    quat q = (quat){{
+        s * axis.x, s * axis.y, s * axis.z, c
+    }};
+
+    if (normalize)
+    {
+        return quat_normalize(q);
+    }
+
+    return q;
+}
+
 /*
     @brief Вычисляет сферическую линейную интерполяцию заданного процента между двумя кватернионами.
     @param q_0 Первый кватернион.
@@ -2008,6 +2625,10 @@ KINLINE void vec3_to_rgb(vec3 v, u32 *out_r, u32 *out_g, u32 *out_b)
 }
 
 /*
+    @brief Создает плоскость, проходящую через точку, с заданной нормалью.
+    @param p1 Точка на плоскости.
+    @param norm Нормаль плоскости (нормализуется).
+    @return Плоскость.
 */
 KAPI plane_3d plane_3d_create(vec3 p1, vec3 norm);
 
@@ -2030,6 +2651,11 @@ KAPI frustum frustum_create(
     f32 near, f32 far
 );
 
+/*
+    @brief Извлекает плоскости усеченной пирамиды из матрицы вида-проекции (нормали направлены внутрь).
+    @param view_projection Матрица вида-проекции (view * projection).
+    @return Усеченная пирамида в мировом пространстве.
+*/
 KAPI frustum frustum_from_view_projection(mat4 view_projection);
 
 /*
@@ -2113,6 +2739,27 @@ KINLINE vec3 extents_3d_half(extents_3d extents)
     }};
 }
 
+/*
+    @brief Вычисляет выровненный по осям ограничивающий прямоугольник преобразованного прямоугольника.
+    NOTE: Центр преобразуется матрицей, половинные размеры модулем ее верхней части 3x3.
+    @param extents Ограничивающий прямоугольник (локальные).
+    @param m Матрица преобразования (векторы-строки, как у vec3_transform).
+    @return Ограничивающий прямоугольник в пространстве матрицы.
+*/
+KINLINE extents_3d extents_3d_transform(extents_3d extents, mat4 m)
+{
+    vec3 center = vec3_transform(extents_3d_half(extents), 1.0f, m);
+    vec3 half = vec3_mul_scalar(vec3_sub(extents.max, extents.min), 0.5f);
+
+    vec3 world_half;
+    for(u32 j = 0; j < 3; ++j)
+    {
+        world_half.elements[j] = half.x * kabs(m.data[j]) + half.y * kabs(m.data[4 + j]) + half.z * kabs(m.data[8 + j]);
+    }
+
+    return (extents_3d){ vec3_sub(center, world_half), vec3_add(center, world_half) };
+}
+
 /*
     @brief Поэлементно сравнивает две вершины.
     @param lvert Первая вершина для сравнения.
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <defines.h>
+
+/*
+    NOTE: Набор инструкций выбирается во время компиляции:
+          - KSIMD_SCALAR_FLAG принудительно включает скалярную реализацию (для сравнения и отладки);
+          - на x86-64 используется SSE2 (входит в базовый набор), при сборке с -mavx2 дополнительно AVX2,
+            при сборке с -mfma умножение со сложением выполняется одной инструкцией;
+          - на ARM используется NEON.
+          Загрузка и сохранение выполняются без требований к выравниванию, так как распределитель памяти
+          гарантирует выравнивание только по 8 байт.
+*/
+#if defined(KSIMD_SCALAR_FLAG)
+    #define KSIMD_BACKEND_SCALAR 1
+#elif defined(__SSE2__) || defined(_M_X64)
+    #define KSIMD_BACKEND_SSE 1
+    #define KSIMD_ENABLED 1
+    #include <emmintrin.h>
+
+    #if defined(__AVX2__)
+        #define KSIMD_BACKEND_AVX2 1
+        #include <immintrin.h>
+    #endif
+
+    #if defined(__FMA__)
+        #define KSIMD_FMA 1
+        #include <immintrin.h>
+    #endif
+#elif defined(__ARM_NEON)
+    #define KSIMD_BACKEND_NEON 1
+    #define KSIMD_ENABLED 1
+    #include <arm_neon.h>
+#else
+    #define KSIMD_BACKEND_SCALAR 1
+#endif
+
+// @brief Доступна ли векторная реализация (1 или 0).
+#ifndef KSIMD_ENABLED
+    #define KSIMD_ENABLED 0
+#endif
+
+#if KSIMD_BACKEND_SSE
+
+    // @brief Вектор из 4х элементов с плавающей точкой в регистре процессора.
+    typedef __m128 f32x4;
+
+    // @brief Загружает 4 элемента из памяти (без требований к выравниванию).
+    #define f32x4_load(ptr) _mm_loadu_ps(ptr)
+
+    // @brief Сохраняет 4 элемента в память (без требований к выравниванию).
+    #define f32x4_store(ptr, a) _mm_storeu_ps(ptr, a)
+
+    // @brief Создает вектор из элементов.
+    #define f32x4_set(x, y, z, w) _mm_setr_ps(x, y, z, w)
+
+    // @brief Создает вектор, все элементы которого равны value.
+    #define f32x4_splat(value) _mm_set1_ps(value)
+
+    // @brief Выполняет сложение векторов.
+    #define f32x4_add(a, b) _mm_add_ps(a, b)
+
+    // @brief Выполняет вычитание векторов.
+    #define f32x4_sub(a, b) _mm_sub_ps(a, b)
+
+    // @brief Выполняет умножение векторов.
+    #define f32x4_mul(a, b) _mm_mul_ps(a, b)
+
+    // @brief Выполняет деление векторов.
+    #define f32x4_div(a, b) _mm_div_ps(a, b)
+
+    // @brief Вычисляет квадратный корень элементов вектора.
+    #define f32x4_sqrt(a) _mm_sqrt_ps(a)
+
+    // @brief Возвращает первый элемент вектора.
+    #define f32x4_first(a) _mm_cvtss_f32(a)
+
+    /*
+        @brief Создает вектор (a[x], a[y], b[z], b[w]).
+        NOTE: Индексы должны быть константами времени компиляции.
+    */
+    #define f32x4_shuffle(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+
+    // @brief Создает вектор, все элементы которого равны элементу lane.
+    #define f32x4_splat_lane(a, lane) _mm_shuffle_ps(a, a, _MM_SHUFFLE(lane, lane, lane, lane))
+
+    // @brief Вычисляет a * b + c.
+    #if KSIMD_FMA
+        #define f32x4_mul_add(a, b, c) _mm_fmadd_ps(a, b, c)
+    #else
+        #define f32x4_mul_add(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c)
+    #endif
+
+#elif KSIMD_BACKEND_NEON
+
+    typedef float32x4_t f32x4;
+
+    #define f32x4_load(ptr) vld1q_f32(ptr)
+    #define f32x4_store(ptr, a) vst1q_f32(ptr, a)
+    #define f32x4_set(x, y, z, w) ((f32x4){ x, y, z, w })
+    #define f32x4_splat(value) vdupq_n_f32(value)
+    #define f32x4_add(a, b) vaddq_f32(a, b)
+    #define f32x4_sub(a, b) vsubq_f32(a, b)
+    #define f32x4_mul(a, b) vmulq_f32(a, b)
+    #define f32x4_div(a, b) vdivq_f32(a, b)
+    #define f32x4_sqrt(a) vsqrtq_f32(a)
+    #define f32x4_first(a) vgetq_lane_f32(a, 0)
+    #define f32x4_shuffle(a, b, x, y, z, w) __builtin_shufflevector(a, b, x, y, (z) + 4, (w) + 4)
+    #define f32x4_splat_lane(a, lane) vdupq_laneq_f32(a, lane)
+
+    // NOTE: Без слияния умножения и сложения, чтобы результат совпадал со скалярной реализацией.
+    #define f32x4_mul_add(a, b, c) vaddq_f32(vmulq_f32(a, b), c)
+
+#endif
@@ -142,6 +142,21 @@ typedef struct vertex_3d {
     vec4 tangent;
 } vertex_3d;
 
+/*
+    @brief Представляет упакованную вершину в трехмерном пространстве (24 байта вместо 64 у vertex_3d).
+    NOTE: Положение квантуется относительно диапазона геометрии, нормаль и касательная кодируются октаэдрически.
+*/
+typedef struct vertex_3d_packed {
+    // @brief Положение вершины в диапазоне геометрии (unorm16), w - направление битангенса (0 = -1, 65535 = +1).
+    u16 position[4];
+    // @brief Октаэдрические нормаль (xy) и касательная (zw) вершины (snorm16).
+    i16 normal_tangent[4];
+    // @brief Текстурная координата вершины (half float).
+    u16 texcoord[2];
+    // @brief Цвет вершины (unorm8).
+    u8 color[4];
+} vertex_3d_packed;
+
 // @brief Представляет отдельную вершину в трехмерном пространстве только с данными о положении и цвете.
 typedef struct color_vertex_3d {
     // @brief Положение вершины (w игнорируется).
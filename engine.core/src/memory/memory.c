@@ -6,8 +6,9 @@
 #include "logger.h"
 #include "kstring.h"
 #include "platform/memory.h"
+#include "platform/thread.h"
 
-// TODO: Сделать отдельную подсистему для профилировки памяти, таймкода, стека вызовов и др. И вынести это туда!
+// TODO: Перенести статистику памяти в систему профилирования (debug/profiler.h).
 typedef struct memory_stats {
     u64 total_allocated;
     u64 tagged_allocated[MEMORY_TAGS_MAX];
@@ -24,6 +25,9 @@ typedef struct memory_system_state {
     u64 allocation_count;
     // Указатель на динамический распределитель памяти.
     dynamic_allocator* allocator;
+    // NOTE: Память выделяется из игрового потока и потока отрисовки, поэтому распределитель и статистика
+    //       защищены блокировкой.
+    platform_mutex lock;
 } memory_system_state;
 
 static memory_system_state* state_ptr = null;
@@ -86,6 +90,12 @@ bool memory_system_initialize(memory_system_config* config)
         return false;
     }
 
+    if(!platform_mutex_create(&state_ptr->lock))
+    {
+        kfatal("Function '%s': Unable to create allocator lock.", __FUNCTION__);
+        return false;
+    }
+
     ktrace("Function '%s': Memory system has %lu B of memory to use.", __FUNCTION__, memory_requirement);
     return true;
 }
@@ -109,6 +119,7 @@ void memory_system_shutdown()
 
     // Уничтожение динамического распределителя памяти.
     dynamic_allocator_destroy(state_ptr->allocator);
+    platform_mutex_destroy(&state_ptr->lock);
 
     // Уничтожение памяти выделенной платформой.
     platform_memory_free(state_ptr);
@@ -141,6 +152,7 @@ void* memory_allocate(u64 size, memory_tag tag)
     // Выбирается способ выделения памяти в соответствии с состоянием системы памяти.
     if(state_ptr)
     {
+        platform_mutex_lock(&state_ptr->lock);
         block = dynamic_allocator_allocate(state_ptr->allocator, size);
 
         if(block)
@@ -149,6 +161,7 @@ void* memory_allocate(u64 size, memory_tag tag)
             state_ptr->stats.total_allocated += size;
             state_ptr->allocation_count++;
         }
+        platform_mutex_unlock(&state_ptr->lock);
     }
     else
     {
@@ -188,12 +201,20 @@ void memory_free(void* block, u64 size, memory_tag tag)
     //       динамическим распределителем памяти, то вероятно она была
     //       выделена до инициализации системы памяти. Тогда условие
     //       станет ложным и память будет освобождена платформой.
-    if(state_ptr && dynamic_allocator_free(state_ptr->allocator, block))
+    bool freed = false;
+    if(state_ptr)
     {
-        state_ptr->stats.tagged_allocated[tag] -= size;
-        state_ptr->stats.total_allocated -= size;
+        platform_mutex_lock(&state_ptr->lock);
+        freed = dynamic_allocator_free(state_ptr->allocator, block);
+        if(freed)
+        {
+            state_ptr->stats.tagged_allocated[tag] -= size;
+            state_ptr->stats.total_allocated -= size;
+        }
+        platform_mutex_unlock(&state_ptr->lock);
     }
-    else
+
+    if(!freed)
     {
         platform_memory_free(block);
     }
@@ -236,6 +257,11 @@ const char* memory_system_usage_str()
     const u64 mib = 1024 * 1024;
     const u64 kib = 1024;
 
+    // Копия статистики, чтобы не удерживать блокировку при форматировании.
+    platform_mutex_lock(&state_ptr->lock);
+    memory_stats stats = state_ptr->stats;
+    platform_mutex_unlock(&state_ptr->lock);
+
     char buffer[8000] = "System memory use (tagged):\n";
     // TODO: Использовать обертку над функцией.
     u64 offset = string_length(buffer);
@@ -248,11 +274,11 @@ const char* memory_system_usage_str()
 
         if(i < MEMORY_TAGS_MAX)
         {
-            size = state_ptr->stats.tagged_allocated[i];
+            size = stats.tagged_allocated[i];
         }
         else
         {
-            size = state_ptr->stats.total_allocated;
+            size = stats.total_allocated;
         }
 
         if(size >= gib)
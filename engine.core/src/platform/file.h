@@ -5,6 +5,9 @@
 // @brief Контекст файла.
 typedef struct file file;
 
+// @brief Контекст отображения файла в память (только для чтения).
+typedef struct file_mapping file_mapping;
+
 // @brief Режим открытия файла, комбинируемый.
 typedef enum file_mode {
     FILE_MODE_READ   = 0x01,
@@ -101,3 +104,34 @@ KINLINE bool platform_file_read_all_text(file* file, char* buffer, u64* out_size
 {
     return platform_file_read_all_bytes(file, buffer, out_size);
 }
+
+/*
+    @brief Отображает файл целиком в память только для чтения.
+    NOTE: Данные загружаются с диска страницами при первом обращении, без промежуточного копирования.
+    @param path Указатель на строку пути к файлу.
+    @param out_mapping Указатель на память куда будет сохранен указатель на экземпляр отображения.
+    @return True файл отображен успешно, false не удалось отобразить.
+*/
+KAPI bool platform_file_map(const char* path, file_mapping** out_mapping);
+
+/*
+    @brief Освобождает отображение файла.
+    NOTE: Указатели на данные отображения становятся недействительными, указатель необходимо обнулить самостоятельно!
+    @param mapping Указатель на экземпляр отображения.
+*/
+KAPI void platform_file_unmap(file_mapping* mapping);
+
+/*
+    @brief Получает указатель на данные отображенного файла.
+    NOTE: Указатель выровнен по размеру страницы памяти.
+    @param mapping Указатель на экземпляр отображения.
+    @return Указатель на данные файла.
+*/
+KAPI const void* platform_file_mapping_data(file_mapping* mapping);
+
+/*
+    @brief Получает размер отображенного файла в байтах.
+    @param mapping Указатель на экземпляр отображения.
+    @return Размер файла в байтах.
+*/
+KAPI u64 platform_file_mapping_size(file_mapping* mapping);
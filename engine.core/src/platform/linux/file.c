@@ -10,7 +10,10 @@
     // Внешние подключения.
     #include <stdio.h>
     #include <string.h>
+    #include <fcntl.h>
+    #include <unistd.h>
     #include <sys/stat.h>
+    #include <sys/mman.h>
 
     struct file {
         FILE* handle;
@@ -188,4 +191,74 @@
         return *out_size == file->size;
     }
 
+    struct file_mapping {
+        void* data;
+        u64 size;
+    };
+
+    bool platform_file_map(const char* path, file_mapping** out_mapping)
+    {
+        if(!path || !out_mapping)
+        {
+            kerror("Function '%s' requires a valid pointer to path and out_mapping.", __FUNCTION__);
+            return false;
+        }
+
+        int fd = open(path, O_RDONLY);
+        if(fd < 0)
+        {
+            kerror("Function '%s': Error opening file '%s'.", __FUNCTION__, path);
+            return false;
+        }
+
+        struct stat info;
+        if(fstat(fd, &info) != 0 || info.st_size <= 0)
+        {
+            kerror("Function '%s': Failed to get file size of file '%s'.", __FUNCTION__, path);
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(null, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // NOTE: Отображение остается действительным после закрытия дескриптора.
+        close(fd);
+
+        if(data == MAP_FAILED)
+        {
+            kerror("Function '%s': Failed to map file '%s'.", __FUNCTION__, path);
+            return false;
+        }
+
+        // Подсказка ядру начать упреждающее чтение всего файла.
+        madvise(data, info.st_size, MADV_WILLNEED);
+
+        *out_mapping = kallocate_tc(struct file_mapping, 1, MEMORY_TAG_FILE);
+        (*out_mapping)->data = data;
+        (*out_mapping)->size = info.st_size;
+        return true;
+    }
+
+    void platform_file_unmap(file_mapping* mapping)
+    {
+        if(!mapping)
+        {
+            kerror("Function '%s' requires a valid pointer to mapping.", __FUNCTION__);
+            return;
+        }
+
+        munmap(mapping->data, mapping->size);
+        kfree_tc(mapping, struct file_mapping, 1, MEMORY_TAG_FILE);
+    }
+
+    const void* platform_file_mapping_data(file_mapping* mapping)
+    {
+        return mapping ? mapping->data : null;
+    }
+
+    u64 platform_file_mapping_size(file_mapping* mapping)
+    {
+        return mapping ? mapping->size : 0;
+    }
+
 #endif
@@ -41,6 +41,11 @@
         return sqrtf(x);
     }
 
+    f64 platform_math_sqrt_f64(f64 x)
+    {
+        return sqrt(x);
+    }
+
     f32 platform_math_abs(f32 x)
     {
         return fabsf(x);
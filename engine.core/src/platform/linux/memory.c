@@ -37,4 +37,9 @@
         memmove(dest, src, size);
     }
 
+    const void* platform_memory_find(const void* block, u64 size, u8 value)
+    {
+        return memchr(block, value, size);
+    }
+
 #endif
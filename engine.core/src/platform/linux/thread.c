@@ -3,8 +3,54 @@
 
 #if KPLATFORM_LINUX_FLAG
 
+    // Внутренние подключения.
+    #include "debug/profiler.h"
+
     // Внешние подключения.
     #include <time.h>
+    #include <errno.h>
+    #include <pthread.h>
+    #include <semaphore.h>
+    #include <unistd.h>
+
+    static void* platform_thread_run(void* params)
+    {
+        platform_thread* thread = params;
+        thread->start(thread->params);
+
+        // Буфер зон профилирования потока становится доступным для следующих потоков.
+        profiler_thread_release();
+        return null;
+    }
+
+    bool platform_thread_create(platform_thread_start start, void* params, platform_thread* out_thread)
+    {
+        STATIC_ASSERT(sizeof(pthread_t) <= sizeof(u64), "Assertion 'sizeof(pthread_t) <= sizeof(u64)' failed.");
+
+        out_thread->start = start;
+        out_thread->params = params;
+
+        pthread_t handle;
+        if(pthread_create(&handle, null, platform_thread_run, out_thread) != 0)
+        {
+            return false;
+        }
+
+        out_thread->handle = (u64)handle;
+        return true;
+    }
+
+    void platform_thread_join(platform_thread* thread)
+    {
+        pthread_join((pthread_t)thread->handle, null);
+        thread->handle = 0;
+    }
+
+    u32 platform_thread_processor_count()
+    {
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+        return count > 0 ? (u32)count : 1;
+    }
 
     void platform_thread_sleep(u64 time_ms)
     {
@@ -14,4 +60,71 @@
         nanosleep(&ts, null);
     }
 
+    void platform_thread_sleep_until_ns(u64 deadline_ns)
+    {
+        struct timespec ts;
+        ts.tv_sec  = deadline_ns / 1000000000ULL;
+        ts.tv_nsec = deadline_ns % 1000000000ULL;
+
+        // NOTE: Абсолютное время не накапливает ошибку при повторе после прерывания сигналом.
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, null) == EINTR);
+    }
+
+    bool platform_mutex_create(platform_mutex* out_mutex)
+    {
+        STATIC_ASSERT(sizeof(pthread_mutex_t) <= sizeof(platform_mutex), "Assertion 'sizeof(pthread_mutex_t) <= sizeof(platform_mutex)' failed.");
+        return pthread_mutex_init((pthread_mutex_t*)out_mutex->data, null) == 0;
+    }
+
+    bool platform_mutex_create_recursive(platform_mutex* out_mutex)
+    {
+        pthread_mutexattr_t attr;
+        if(pthread_mutexattr_init(&attr) != 0)
+        {
+            return false;
+        }
+
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        bool result = pthread_mutex_init((pthread_mutex_t*)out_mutex->data, &attr) == 0;
+        pthread_mutexattr_destroy(&attr);
+        return result;
+    }
+
+    void platform_mutex_destroy(platform_mutex* mutex)
+    {
+        pthread_mutex_destroy((pthread_mutex_t*)mutex->data);
+    }
+
+    void platform_mutex_lock(platform_mutex* mutex)
+    {
+        pthread_mutex_lock((pthread_mutex_t*)mutex->data);
+    }
+
+    void platform_mutex_unlock(platform_mutex* mutex)
+    {
+        pthread_mutex_unlock((pthread_mutex_t*)mutex->data);
+    }
+
+    bool platform_semaphore_create(u32 initial_count, platform_semaphore* out_semaphore)
+    {
+        STATIC_ASSERT(sizeof(sem_t) <= sizeof(platform_semaphore), "Assertion 'sizeof(sem_t) <= sizeof(platform_semaphore)' failed.");
+        return sem_init((sem_t*)out_semaphore->data, 0, initial_count) == 0;
+    }
+
+    void platform_semaphore_destroy(platform_semaphore* semaphore)
+    {
+        sem_destroy((sem_t*)semaphore->data);
+    }
+
+    void platform_semaphore_signal(platform_semaphore* semaphore)
+    {
+        sem_post((sem_t*)semaphore->data);
+    }
+
+    void platform_semaphore_wait(platform_semaphore* semaphore)
+    {
+        // NOTE: Ожидание повторяется после прерывания сигналом.
+        while(sem_wait((sem_t*)semaphore->data) == -1 && errno == EINTR);
+    }
+
 #endif
@@ -13,4 +13,11 @@
         return now.tv_sec + now.tv_nsec * 0.000000001;
     }
 
+    u64 platform_time_absolute_ns()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (u64)now.tv_sec * 1000000000ULL + (u64)now.tv_nsec;
+    }
+
 #endif
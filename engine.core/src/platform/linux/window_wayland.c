@@ -14,9 +14,32 @@
 
     // Внешние подключения.
     #include <wayland-client.h>
+    #include <pthread.h>
+    #include <poll.h>
+    #include <errno.h>
     #include <vulkan/vulkan.h>
     #include <vulkan/vulkan_wayland.h>
 
+    // Размер очереди событий ввода, накопленных потоком событий между кадрами.
+    #define WINDOW_INPUT_EVENT_QUEUE_SIZE 256
+    // Время ожидания событий потоком событий в миллисекундах (проверка флага остановки).
+    #define WINDOW_EVENT_THREAD_POLL_TIMEOUT 50
+
+    typedef enum window_input_event_type {
+        WINDOW_INPUT_EVENT_KEYBOARD_KEY,
+        WINDOW_INPUT_EVENT_MOUSE_MOVE,
+        WINDOW_INPUT_EVENT_MOUSE_BUTTON,
+        WINDOW_INPUT_EVENT_MOUSE_WHEEL,
+        WINDOW_INPUT_EVENT_FOCUS
+    } window_input_event_type;
+
+    // @brief Событие ввода, передаваемое потоком событий в главный поток.
+    typedef struct window_input_event {
+        window_input_event_type type;
+        i32 value0;
+        i32 value1;
+    } window_input_event;
+
     typedef struct platform_window_state {
         // Для работы с окном приложения.
         struct wl_display*    wdisplay;
@@ -40,6 +63,19 @@
         PFN_window_handler_focus        on_focus;
         // Флаги состояний.
         bool  do_resize;
+        // Поток событий ввода (опционально).
+        bool                   use_event_thread;
+        bool                   event_thread_stop;
+        pthread_t              event_thread;
+        struct wl_event_queue* input_queue;
+        // Очередь событий ввода от потока событий (защищена мьютексом).
+        pthread_mutex_t        input_mutex;
+        pthread_cond_t         input_space;
+        u32                    input_event_count;
+        window_input_event     input_events[WINDOW_INPUT_EVENT_QUEUE_SIZE];
+        // Количество ожиданий потока событий при заполненной очереди и потерянных при остановке событий.
+        u64                    input_overflow_count;
+        u64                    input_dropped_count;
     } platform_window_state;
 
     // Объявления функций (обработчичи событий).
@@ -85,6 +121,233 @@
 
     static const char* message_missing_instance = "Function '%s' requires an instance of window.";
 
+    static i32 wdisplay_prepare_read(struct wl_display* wdisplay, struct wl_event_queue* queue)
+    {
+        return queue ? wl_display_prepare_read_queue(wdisplay, queue) : wl_display_prepare_read(wdisplay);
+    }
+
+    static i32 wdisplay_dispatch_pending(struct wl_display* wdisplay, struct wl_event_queue* queue)
+    {
+        return queue ? wl_display_dispatch_queue_pending(wdisplay, queue) : wl_display_dispatch_pending(wdisplay);
+    }
+
+    /*
+        @brief Читает и обрабатывает доступные события очереди, ожидая их не дольше указанного времени.
+        @param wdisplay Указатель на соединение с сервером.
+        @param queue Указатель на очередь событий, null для очереди по умолчанию.
+        @param timeout_ms Время ожидания событий в миллисекундах (0 - без ожидания).
+        @return True в случае успеха, false при потере соединения.
+    */
+    static bool wdisplay_dispatch_queue(struct wl_display* wdisplay, struct wl_event_queue* queue, i32 timeout_ms)
+    {
+        // NOTE: Перед чтением необходимо обработать уже прочитанные события очереди.
+        while(wdisplay_prepare_read(wdisplay, queue) != 0)
+        {
+            if(wdisplay_dispatch_pending(wdisplay, queue) == -1)
+            {
+                return false;
+            }
+        }
+
+        // Отправка накопленных запросов (если сокет заполнен, запросы будут отправлены в следующий раз).
+        if(wl_display_flush(wdisplay) == -1 && errno != EAGAIN)
+        {
+            wl_display_cancel_read(wdisplay);
+            return false;
+        }
+
+        struct pollfd pfd = { wl_display_get_fd(wdisplay), POLLIN, 0 };
+        i32 result = poll(&pfd, 1, timeout_ms);
+
+        if(result > 0 && (pfd.revents & POLLIN))
+        {
+            if(wl_display_read_events(wdisplay) == -1)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            wl_display_cancel_read(wdisplay);
+
+            if(result < 0 && errno != EINTR)
+            {
+                return false;
+            }
+        }
+
+        return wdisplay_dispatch_pending(wdisplay, queue) != -1;
+    }
+
+    // @brief Вызывает обработчик события ввода (только в главном потоке).
+    static void input_event_forward(platform_window_state* state, window_input_event_type type, i32 value0, i32 value1)
+    {
+        switch(type)
+        {
+            case WINDOW_INPUT_EVENT_KEYBOARD_KEY:
+                if(state->on_keyboard_key) state->on_keyboard_key(value0, value1);
+                break;
+            case WINDOW_INPUT_EVENT_MOUSE_MOVE:
+                if(state->on_mouse_move) state->on_mouse_move(value0, value1);
+                break;
+            case WINDOW_INPUT_EVENT_MOUSE_BUTTON:
+                if(state->on_mouse_button) state->on_mouse_button(value0, value1);
+                break;
+            case WINDOW_INPUT_EVENT_MOUSE_WHEEL:
+                if(state->on_mouse_wheel) state->on_mouse_wheel(value0);
+                break;
+            case WINDOW_INPUT_EVENT_FOCUS:
+                if(state->on_focus) state->on_focus(value0);
+                break;
+        }
+    }
+
+    // @brief Передает событие ввода обработчикам: напрямую или через очередь, если используется поток событий.
+    static void input_event_emit(platform_window_state* state, window_input_event_type type, i32 value0, i32 value1)
+    {
+        if(!state->use_event_thread)
+        {
+            input_event_forward(state, type, value0, value1);
+            return;
+        }
+
+        pthread_mutex_lock(&state->input_mutex);
+
+        // NOTE: Последовательные перемещения мышки объединяются, важна только последняя позиция.
+        window_input_event* last = state->input_event_count ? &state->input_events[state->input_event_count - 1] : null;
+        if(type == WINDOW_INPUT_EVENT_MOUSE_MOVE && last && last->type == WINDOW_INPUT_EVENT_MOUSE_MOVE)
+        {
+            last->value0 = value0;
+            last->value1 = value1;
+        }
+        else
+        {
+            // NOTE: При заполненной очереди поток событий ждет главный поток, а не теряет события: пропуск
+            //       отпускания клавиши оставил бы ее нажатой. Сервер тем временем копит события в сокете.
+            if(state->input_event_count == WINDOW_INPUT_EVENT_QUEUE_SIZE)
+            {
+                state->input_overflow_count++;
+                kwarng(
+                    "Wayland event thread: Input queue is full (%u events), waiting for main thread (overflow %llu).",
+                    WINDOW_INPUT_EVENT_QUEUE_SIZE, state->input_overflow_count
+                );
+            }
+
+            while(state->input_event_count == WINDOW_INPUT_EVENT_QUEUE_SIZE
+               && !__atomic_load_n(&state->event_thread_stop, __ATOMIC_ACQUIRE))
+            {
+                pthread_cond_wait(&state->input_space, &state->input_mutex);
+            }
+
+            if(state->input_event_count < WINDOW_INPUT_EVENT_QUEUE_SIZE)
+            {
+                window_input_event* event = &state->input_events[state->input_event_count++];
+                event->type = type;
+                event->value0 = value0;
+                event->value1 = value1;
+            }
+            else
+            {
+                state->input_dropped_count++;
+            }
+        }
+
+        pthread_mutex_unlock(&state->input_mutex);
+    }
+
+    // @brief Передает накопленные потоком событий события ввода обработчикам (вызывается в главном потоке).
+    static void input_events_flush(platform_window_state* state)
+    {
+        window_input_event events[WINDOW_INPUT_EVENT_QUEUE_SIZE];
+
+        pthread_mutex_lock(&state->input_mutex);
+        u32 count = state->input_event_count;
+        kcopy_tc(events, state->input_events, window_input_event, count);
+        state->input_event_count = 0;
+        pthread_cond_signal(&state->input_space);
+        pthread_mutex_unlock(&state->input_mutex);
+
+        // NOTE: Обработка вне блокировки, чтобы поток событий не ждал систему ввода.
+        for(u32 i = 0; i < count; ++i)
+        {
+            input_event_forward(state, events[i].type, events[i].value0, events[i].value1);
+        }
+    }
+
+    static void* event_thread_run(void* data)
+    {
+        platform_window_state* state = data;
+
+        while(!__atomic_load_n(&state->event_thread_stop, __ATOMIC_ACQUIRE))
+        {
+            if(!wdisplay_dispatch_queue(state->wdisplay, state->input_queue, WINDOW_EVENT_THREAD_POLL_TIMEOUT))
+            {
+                kerror("Wayland event thread: Failed to dispatch input events. Thread stopped.");
+                break;
+            }
+        }
+
+        return null;
+    }
+
+    static bool event_thread_start(platform_window_state* state)
+    {
+        state->input_queue = wl_display_create_queue(state->wdisplay);
+        if(!state->input_queue)
+        {
+            return false;
+        }
+
+        // Перенос устройств ввода в очередь потока событий.
+        if(state->wkeyboard) wl_proxy_set_queue((struct wl_proxy*)state->wkeyboard, state->input_queue);
+        if(state->wpointer) wl_proxy_set_queue((struct wl_proxy*)state->wpointer, state->input_queue);
+
+        pthread_mutex_init(&state->input_mutex, null);
+        pthread_cond_init(&state->input_space, null);
+        state->input_event_count = 0;
+        state->input_overflow_count = 0;
+        state->input_dropped_count = 0;
+        state->event_thread_stop = false;
+        state->use_event_thread = true;
+
+        if(pthread_create(&state->event_thread, null, event_thread_run, state) != 0)
+        {
+            state->use_event_thread = false;
+            if(state->wkeyboard) wl_proxy_set_queue((struct wl_proxy*)state->wkeyboard, null);
+            if(state->wpointer) wl_proxy_set_queue((struct wl_proxy*)state->wpointer, null);
+            pthread_cond_destroy(&state->input_space);
+            pthread_mutex_destroy(&state->input_mutex);
+            wl_event_queue_destroy(state->input_queue);
+            state->input_queue = null;
+            return false;
+        }
+
+        return true;
+    }
+
+    static void event_thread_stop(platform_window_state* state)
+    {
+        // NOTE: Флаг выставляется под мьютексом, чтобы ожидающий места в очереди поток не пропустил сигнал.
+        pthread_mutex_lock(&state->input_mutex);
+        __atomic_store_n(&state->event_thread_stop, true, __ATOMIC_RELEASE);
+        pthread_cond_signal(&state->input_space);
+        pthread_mutex_unlock(&state->input_mutex);
+
+        pthread_join(state->event_thread, null);
+
+        if(state->input_overflow_count || state->input_dropped_count)
+        {
+            kwarng(
+                "Wayland event thread: Input queue overflowed %llu times, %llu events dropped on stop.",
+                state->input_overflow_count, state->input_dropped_count
+            );
+        }
+
+        pthread_cond_destroy(&state->input_space);
+        pthread_mutex_destroy(&state->input_mutex);
+        state->use_event_thread = false;
+    }
+
     bool platform_window_create(u64* memory_requirement, window* instance, window_config* config)
     {
         // TODO: Защита от повтороного вызова для данного экземпляра!
@@ -154,6 +417,18 @@
         wl_surface_commit(state->wsurface);
         wl_display_roundtrip(state->wdisplay);
 
+        if(config->use_event_thread)
+        {
+            if(event_thread_start(state))
+            {
+                kdebug("Wayland input events are read by a dedicated thread.");
+            }
+            else
+            {
+                kwarng("Function '%s': Failed to start event thread, input events are read by the main thread.", __FUNCTION__);
+            }
+        }
+
         return true;
     }
 
@@ -166,6 +441,12 @@
         }
 
         platform_window_state* state = (void*)((u8*)instance + sizeof(struct window));
+
+        if(state->use_event_thread)
+        {
+            event_thread_stop(state);
+        }
+
         wl_pointer_destroy(state->wpointer);
         wl_keyboard_destroy(state->wkeyboard);
         wl_seat_destroy(state->wseat);
@@ -175,6 +456,13 @@
         wl_surface_destroy(state->wsurface);
         wl_compositor_destroy(state->wcompositor);
         wl_registry_destroy(state->wregistry);
+
+        if(state->input_queue)
+        {
+            wl_event_queue_destroy(state->input_queue);
+            state->input_queue = null;
+        }
+
         wl_display_disconnect(state->wdisplay);
     }
 
@@ -187,7 +475,19 @@
         }
 
         platform_window_state* state = (void*)((u8*)instance + sizeof(struct window));
-        return wl_display_roundtrip(state->wdisplay) != INVALID_ID;
+
+        // NOTE: Без ожидания ответа сервера: обрабатываются только уже пришедшие события.
+        if(!wdisplay_dispatch_queue(state->wdisplay, null, 0))
+        {
+            return false;
+        }
+
+        if(state->use_event_thread)
+        {
+            input_events_flush(state);
+        }
+
+        return true;
     }
 
     void platform_window_set_on_close_handler(window* instance, PFN_window_handler_close handler)
@@ -370,6 +670,11 @@
             {
                 state->wkeyboard = wl_seat_get_keyboard(wseat);
                 wl_keyboard_add_listener(state->wkeyboard, &keyboard_listeners, data);
+
+                if(state->input_queue)
+                {
+                    wl_proxy_set_queue((struct wl_proxy*)state->wkeyboard, state->input_queue);
+                }
                 ktrace("Wayland seat: the keyboard is found.");
             }
         }
@@ -386,6 +691,11 @@
             {
                 state->wpointer = wl_seat_get_pointer(wseat);
                 wl_pointer_add_listener(state->wpointer, &pointer_listeners, data);
+
+                if(state->input_queue)
+                {
+                    wl_proxy_set_queue((struct wl_proxy*)state->wpointer, state->input_queue);
+                }
                 ktrace("Wayland seat: the pointer is found.");
             }
         }
@@ -460,11 +770,8 @@
     {
         platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
 
-        if(wstate->on_keyboard_key)
-        {
-            bool pressed = state == WL_KEYBOARD_KEY_STATE_PRESSED ? true : false;
-            wstate->on_keyboard_key(kb_translate_keycode(key), pressed);
-        }
+        bool pressed = state == WL_KEYBOARD_KEY_STATE_PRESSED ? true : false;
+        input_event_emit(wstate, WINDOW_INPUT_EVENT_KEYBOARD_KEY, kb_translate_keycode(key), pressed);
     }
 
     void kb_mods(void* data, struct wl_keyboard* wkeyboard, u32 serial, u32 depressed, u32 latched, u32 locked, u32 group)
@@ -497,11 +804,7 @@
     void pt_enter(void* data, struct wl_pointer* wpointer, u32 serial, struct wl_surface* wsurface, wl_fixed_t x, wl_fixed_t y)
     {
         platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
-
-        if(wstate->on_focus)
-        {
-            wstate->on_focus(true);
-        }
+        input_event_emit(wstate, WINDOW_INPUT_EVENT_FOCUS, true, 0);
 
         // TODO: Сокрытие курсора!
         // wl_pointer_set_cursor(context->wpointer, serial, null, 0, 0);
@@ -510,11 +813,7 @@
     void pt_leave(void* data, struct wl_pointer* wpointer, u32 serial, struct wl_surface* wsurface)
     {
         platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
-
-        if(wstate->on_focus)
-        {
-            wstate->on_focus(false);
-        }
+        input_event_emit(wstate, WINDOW_INPUT_EVENT_FOCUS, false, 0);
     }
 
     void pt_motion(void* data, struct wl_pointer* wpointer, u32 time, wl_fixed_t x, wl_fixed_t y)
@@ -525,21 +824,15 @@
         x = wl_fixed_to_int(x);
         y = wl_fixed_to_int(y);
 
-        if(wstate->on_mouse_move)
-        {
-            wstate->on_mouse_move(x, y);
-        }
+        input_event_emit(wstate, WINDOW_INPUT_EVENT_MOUSE_MOVE, x, y);
     }
 
     void pt_button(void* data, struct wl_pointer* wpointer, u32 serial, u32 time, u32 button, u32 state)
     {
         platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
 
-        if(wstate->on_mouse_button)
-        {
-            bool pressed = state == WL_POINTER_BUTTON_STATE_PRESSED ? true : false;
-            wstate->on_mouse_button(pt_translate_btncode(button), pressed);
-        }
+        bool pressed = state == WL_POINTER_BUTTON_STATE_PRESSED ? true : false;
+        input_event_emit(wstate, WINDOW_INPUT_EVENT_MOUSE_BUTTON, pt_translate_btncode(button), pressed);
     }
 
     void pt_axis(void* data, struct wl_pointer* wpointer, u32 time, u32 axis, wl_fixed_t value)
@@ -549,10 +842,7 @@
         // Преобразование значения.
         value = wl_fixed_to_int(value);
 
-        if(wstate->on_mouse_wheel)
-        {
-            wstate->on_mouse_wheel(value);
-        }
+        input_event_emit(wstate, WINDOW_INPUT_EVENT_MOUSE_WHEEL, value, 0);
     }
 
     void pt_frame(void* data, struct wl_pointer* wpointer)
@@ -44,6 +44,13 @@ KAPI f32 platform_math_acos(f32 x);
 */
 KAPI f32 platform_math_sqrt(f32 x);
 
+/*
+    @brief Вычисляет квадратный корень числа двойной точности.
+    @param x Число.
+    @return Результирующее значение.
+*/
+KAPI f64 platform_math_sqrt_f64(f64 x);
+
 /*
     @brief Вычисляет абсолютное значение числа.
     @param x Число.
@@ -48,3 +48,12 @@ KAPI void platform_memory_copy(void* dest, const void* src, u64 size);
     @param size Количествой байт которое необходимо скопировать.
 */
 KAPI void platform_memory_move(void* dest, const void* src, u64 size);
+
+/*
+    @brief Выполняет поиск первого байта с заданным значением в участке памяти.
+    @param block Указатель на участок памяти.
+    @param size Количество байт памяти.
+    @param value Значение искомого байта.
+    @return Указатель на найденный байт, в противном случае null.
+*/
+KAPI const void* platform_memory_find(const void* block, u64 size, u8 value);
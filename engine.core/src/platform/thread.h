@@ -2,9 +2,124 @@
 
 #include <defines.h>
 
+// @brief Функция, выполняемая в отдельном потоке.
+typedef void (*platform_thread_start)(void* params);
+
+// @brief Поток платформы.
+typedef struct platform_thread {
+    // @brief Дескриптор потока платформы.
+    u64 handle;
+    // @brief Функция, выполняемая потоком.
+    platform_thread_start start;
+    // @brief Параметры функции потока.
+    void* params;
+} platform_thread;
+
+// @brief Семафор платформы.
+typedef struct platform_semaphore {
+    // @brief Данные семафора платформы.
+    u64 data[4];
+} platform_semaphore;
+
+// @brief Мьютекс платформы.
+typedef struct platform_mutex {
+    // @brief Данные мьютекса платформы.
+    u64 data[8];
+} platform_mutex;
+
+/*
+    @brief Создает и запускает поток, выполняющий указанную функцию.
+    NOTE: Структура потока должна оставаться доступной до вызова platform_thread_join.
+    @param start Функция, выполняемая потоком.
+    @param params Параметры функции потока.
+    @param out_thread Указатель на структуру для сохранения потока.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool platform_thread_create(platform_thread_start start, void* params, platform_thread* out_thread);
+
+/*
+    @brief Ожидает завершения потока и освобождает его ресурсы.
+    @param thread Указатель на поток.
+*/
+KAPI void platform_thread_join(platform_thread* thread);
+
+/*
+    @brief Получает количество доступных логических процессоров.
+    @return Количество логических процессоров (не меньше 1).
+*/
+KAPI u32 platform_thread_processor_count();
+
 /*
     @brief Останавливает/блокирует работку главного потока приложения на заданное время.
     NOTE: Возвращает управление операционной системе.
     @param time Время в миллисекундах.
 */
 KAPI void platform_thread_sleep(u64 time_ms);
+
+/*
+    @brief Останавливает/блокирует работу текущего потока до наступления заданного момента времени.
+    NOTE: Возвращает управление операционной системе, точность пробуждения зависит от планировщика.
+    @param deadline_ns Момент времени пробуждения в наносекундах (по таймеру platform_time_absolute_ns).
+*/
+KAPI void platform_thread_sleep_until_ns(u64 deadline_ns);
+
+/*
+    @brief Создает мьютекс.
+    @param out_mutex Указатель на структуру для сохранения мьютекса.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool platform_mutex_create(platform_mutex* out_mutex);
+
+/*
+    @brief Создает рекурсивный мьютекс, который может быть повторно захвачен владеющим потоком.
+    NOTE: Освобождается столько же раз, сколько был захвачен.
+    @param out_mutex Указатель на структуру для сохранения мьютекса.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool platform_mutex_create_recursive(platform_mutex* out_mutex);
+
+/*
+    @brief Уничтожает мьютекс.
+    NOTE: Мьютекс не должен быть захвачен.
+    @param mutex Указатель на мьютекс.
+*/
+KAPI void platform_mutex_destroy(platform_mutex* mutex);
+
+/*
+    @brief Захватывает мьютекс, ожидая его освобождения другим потоком.
+    @param mutex Указатель на мьютекс.
+*/
+KAPI void platform_mutex_lock(platform_mutex* mutex);
+
+/*
+    @brief Освобождает захваченный мьютекс.
+    @param mutex Указатель на мьютекс.
+*/
+KAPI void platform_mutex_unlock(platform_mutex* mutex);
+
+/*
+    @brief Создает семафор с указанным начальным значением счетчика.
+    @param initial_count Начальное значение счетчика.
+    @param out_semaphore Указатель на структуру для сохранения семафора.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool platform_semaphore_create(u32 initial_count, platform_semaphore* out_semaphore);
+
+/*
+    @brief Уничтожает семафор.
+    NOTE: Семафор не должен ожидаться другими потоками.
+    @param semaphore Указатель на семафор.
+*/
+KAPI void platform_semaphore_destroy(platform_semaphore* semaphore);
+
+/*
+    @brief Увеличивает счетчик семафора, пробуждая один из ожидающих потоков.
+    @param semaphore Указатель на семафор.
+*/
+KAPI void platform_semaphore_signal(platform_semaphore* semaphore);
+
+/*
+    @brief Ожидает положительного значения счетчика семафора и уменьшает его.
+    @param semaphore Указатель на семафор.
+*/
+KAPI void platform_semaphore_wait(platform_semaphore* semaphore);
@@ -7,3 +7,10 @@
     @return Текущее значение таймера в секундах.
 */
 KAPI f64 platform_time_absolute();
+
+/*
+    @brief Возвращает текущее значение монотонного таймера системы в наносекундах.
+    NOTE: Используется там, где точности f64 в секундах недостаточно (профилирование, ожидание кадра).
+    @return Текущее значение таймера в наносекундах.
+*/
+KAPI u64 platform_time_absolute_ns();
@@ -10,6 +10,9 @@ typedef struct window_config {
     i32 width;
     // @brief Высота окна в пикселях.
     i32 height;
+    // @brief Использовать отдельный поток для чтения событий устройств ввода.
+    // NOTE: События ввода накапливаются потоком и передаются обработчикам в platform_window_dispatch.
+    bool use_event_thread;
 } window_config;
 
 // @brief Контекст окна.
@@ -47,7 +50,7 @@ KAPI bool platform_window_create(u64* memory_requirement, window* instance, wind
 KAPI void platform_window_destroy(window* instance);
 
 /*
-    @brief Обрабатывает события окна.
+    @brief Обрабатывает события окна без ожидания ответа сервера (не блокирует кадр).
     NOTE: Обязательно добавить в обработку кадра!
     @param instance Указатель на выделенную память экземпляра окна.
     @return True в случае успеха, false при возникновении ошибки.
@@ -4,6 +4,13 @@
 // Внутренние подключения.
 #include "logger.h"
 #include "math/kmath.h"
+#include "memory/memory.h"
+
+// TODO: Установка из конфигурации.
+#define CAMERA_DEFAULT_FOV       1.04719755f // 60 градусов (deg_to_rad(60.0f))
+#define CAMERA_DEFAULT_ASPECT    (1280.0f / 720.0f)
+#define CAMERA_DEFAULT_NEAR_CLIP 0.1f
+#define CAMERA_DEFAULT_FAR_CLIP  1000.0f
 
 bool camera_check_status(const camera* c, const char* func)
 {
@@ -21,6 +28,7 @@ bool camera_check_status(const camera* c, const char* func)
 camera camera_create()
 {
     camera c;
+    kzero_tc(&c, camera, 1);
     camera_reset(&c);
     return c;
 }
@@ -30,8 +38,12 @@ void camera_reset(camera* c)
     if(!camera_check_status(c, __FUNCTION__)) return;
     c->euler_rotation = vec3_zero();
     c->position = vec3_zero();
-    c->is_dirty = false;
-    c->view_matrix = mat4_identity();
+    c->fov = CAMERA_DEFAULT_FOV;
+    c->aspect = CAMERA_DEFAULT_ASPECT;
+    c->near_clip = CAMERA_DEFAULT_NEAR_CLIP;
+    c->far_clip = CAMERA_DEFAULT_FAR_CLIP;
+    c->is_dirty = true;
+    c->is_projection_dirty = true;
 }
 
 vec3 camera_position_get(const camera* c)
@@ -60,52 +72,89 @@ void camera_rotation_euler_set(camera* c, vec3 rotation)
     c->is_dirty = true;    
 }
 
-mat4 camera_view_get(camera* c)
+void camera_projection_set(camera* c, f32 fov, f32 aspect, f32 near_clip, f32 far_clip)
 {
-    if(!camera_check_status(c, __FUNCTION__)) return mat4_identity();
+    if(!camera_check_status(c, __FUNCTION__)) return;
+    c->fov = fov;
+    c->aspect = aspect;
+    c->near_clip = near_clip;
+    c->far_clip = far_clip;
+    c->is_projection_dirty = true;
+}
+
+void camera_aspect_set(camera* c, f32 aspect)
+{
+    if(!camera_check_status(c, __FUNCTION__)) return;
+    if(c->aspect == aspect) return;
+    c->aspect = aspect;
+    c->is_projection_dirty = true;
+}
+
+bool camera_update(camera* c)
+{
+    if(!camera_check_status(c, __FUNCTION__)) return false;
+    if(!c->is_dirty && !c->is_projection_dirty) return false;
+
+    camera_block* b = &c->block;
 
     if(c->is_dirty)
     {
-        mat4 rotation = mat4_euler_xyz(c->euler_rotation.x, c->euler_rotation.y, c->euler_rotation.z);
-        mat4 translation = mat4_translation(c->position);
+        mat4 rotation = mat4_euler_xyz_fast(c->euler_rotation.x, c->euler_rotation.y, c->euler_rotation.z);
+        b->inverse_view = mat4_mul(rotation, mat4_translation(c->position));
 
-        c->view_matrix = mat4_mul(rotation, translation);
-        c->view_matrix = mat4_inverse(c->view_matrix);
+        // NOTE: Мировая матрица камеры содержит только поворот и перенос, поэтому обратная матрица
+        //       получается транспонированием поворота без полного обращения.
+        b->view = mat4_identity();
+        for(u32 r = 0; r < 3; ++r)
+        {
+            for(u32 col = 0; col < 3; ++col)
+            {
+                b->view.data[r * 4 + col] = rotation.data[col * 4 + r];
+            }
+            vec3 row = vec3_create(rotation.data[r * 4 + 0], rotation.data[r * 4 + 1], rotation.data[r * 4 + 2]);
+            b->view.data[12 + r] = -vec3_dot(c->position, row);
+        }
 
+        b->position = c->position;
+        b->forward = mat4_forward_fast(b->view);
+        b->right = mat4_right_fast(b->view);
+        b->up = mat4_up_fast(b->view);
         c->is_dirty = false;
     }
 
-    return c->view_matrix;
-}
+    if(c->is_projection_dirty)
+    {
+        b->projection = mat4_perspective_fast(c->fov, c->aspect, c->near_clip, c->far_clip);
+        b->inverse_projection = mat4_inverse(b->projection);
+        c->is_projection_dirty = false;
+    }
 
-vec3 camera_forward(camera* c)
-{
-    mat4 view = camera_view_get(c);
-    return mat4_forward(view);
-}
+    b->view_projection = mat4_mul(b->view, b->projection);
+    b->inverse_view_projection = mat4_mul(b->inverse_projection, b->inverse_view);
+    b->frustum = frustum_from_view_projection(b->view_projection);
+    b->generation++;
 
-vec3 camera_backward(camera* c)
-{
-    mat4 view = camera_view_get(c);
-    return mat4_backward(view);
+    return true;
 }
 
-vec3 camera_left(camera* c)
+const camera_block* camera_block_get(camera* c)
 {
-    mat4 view = camera_view_get(c);
-    return mat4_left(view);
+    if(!camera_check_status(c, __FUNCTION__)) return null;
+    camera_update(c);
+    return &c->block;
 }
 
-vec3 camera_right(camera* c)
+mat4 camera_view_get(camera* c)
 {
-    mat4 view = camera_view_get(c);
-    return mat4_right(view);
+    if(!camera_check_status(c, __FUNCTION__)) return mat4_identity();
+    camera_update(c);
+    return c->block.view;
 }
 
 void camera_move_forward(camera* c, f32 amount)
 {
     if(!camera_check_status(c, __FUNCTION__)) return;
-    vec3 direction = camera_forward(c);
+    vec3 direction = camera_block_get(c)->forward;
     direction = vec3_mul_scalar(direction, amount);
     c->position = vec3_add(c->position, direction);
     c->is_dirty = true;
@@ -114,7 +163,7 @@ void camera_move_forward(camera* c, f32 amount)
 void camera_move_backward(camera* c, f32 amount)
 {
     if(!camera_check_status(c, __FUNCTION__)) return;
-    vec3 direction = camera_backward(c);
+    vec3 direction = vec3_mul_scalar(camera_block_get(c)->forward, -1.0f);
     direction = vec3_mul_scalar(direction, amount);
     c->position = vec3_add(c->position, direction);
     c->is_dirty = true;
@@ -123,7 +172,7 @@ void camera_move_backward(camera* c, f32 amount)
 void camera_move_left(camera* c, f32 amount)
 {
     if(!camera_check_status(c, __FUNCTION__)) return;
-    vec3 direction = camera_left(c);
+    vec3 direction = vec3_mul_scalar(camera_block_get(c)->right, -1.0f);
     direction = vec3_mul_scalar(direction, amount);
     c->position = vec3_add(c->position, direction);
     c->is_dirty = true;
@@ -132,7 +181,7 @@ void camera_move_left(camera* c, f32 amount)
 void camera_move_right(camera* c, f32 amount)
 {
     if(!camera_check_status(c, __FUNCTION__)) return;
-    vec3 direction = camera_right(c);
+    vec3 direction = camera_block_get(c)->right;
     direction = vec3_mul_scalar(direction, amount);
     c->position = vec3_add(c->position, direction);
     c->is_dirty = true;
@@ -3,7 +3,38 @@
 #include <defines.h>
 #include <math/math_types.h>
 
-// TODO: FOV и scissor.
+/*
+    @brief Данные камеры, вычисляемые один раз при ее изменении и общие для представлений, отсечения и игрового кода.
+    NOTE: Указатель на блок действителен все время жизни камеры, а данные до следующего изменения камеры.
+*/
+typedef struct camera_block {
+    // @brief Матрица вида.
+    mat4 view;
+    // @brief Матрица проекции.
+    mat4 projection;
+    // @brief Произведение матриц вида и проекции.
+    mat4 view_projection;
+    // @brief Обратная матрица вида (мировая матрица камеры).
+    mat4 inverse_view;
+    // @brief Обратная матрица проекции.
+    mat4 inverse_projection;
+    // @brief Обратное произведение матриц вида и проекции.
+    mat4 inverse_view_projection;
+    // @brief Плоскости усеченной пирамиды видимости в мировом пространстве.
+    frustum frustum;
+    // @brief Позиция камеры.
+    vec3 position;
+    // @brief Направление вперед.
+    vec3 forward;
+    // @brief Направление вправо.
+    vec3 right;
+    // @brief Направление вверх.
+    vec3 up;
+    // @brief Поколение данных, изменяется при каждом пересчете блока.
+    u64 generation;
+} camera_block;
+
+// TODO: Scissor.
 // TODO: Инкапсулировать данные и закрыть доступ к ним.
 // @brief Представляет собой камеру (Не читать и не писать данные камеры напрямую).
 typedef struct camera {
@@ -11,10 +42,20 @@ typedef struct camera {
     vec3 position;
     // @brief Повороты камеры (используеются углы Эйлера).
     vec3 euler_rotation;
+    // @brief Поле зрения по вертикали в радианах.
+    f32 fov;
+    // @brief Соотношение сторон.
+    f32 aspect;
+    // @brief Расстояние до ближней плоскости отсечения.
+    f32 near_clip;
+    // @brief Расстояние до дальней плоскости отсечения.
+    f32 far_clip;
     // @brief Указывает на необходимость обновить матрицу вида.
     bool is_dirty;
-    // @brief Матрица вида камеры.
-    mat4 view_matrix;
+    // @brief Указывает на необходимость обновить матрицу проекции.
+    bool is_projection_dirty;
+    // @brief Кэшированные данные камеры.
+    camera_block block;
 } camera;
 
 /*
@@ -24,7 +65,7 @@ typedef struct camera {
 KAPI camera camera_create();
 
 /*
-    @brief Сбрасывает позицию и вращение камеры на значения по умолчанию.
+    @brief Сбрасывает позицию, вращение и проекцию камеры на значения по умолчанию.
     @param c Указатель на камеру для сброса настроек.
 */
 KAPI void camera_reset(camera* c);
@@ -57,12 +98,44 @@ KAPI vec3 camera_rotation_euler_get(const camera* c);
 */
 KAPI void camera_rotation_euler_set(camera* c, vec3 rotation);
 
+/*
+    @brief Устанавливает перспективную проекцию камеры.
+    @param c Указатель на камеру для установки проекции.
+    @param fov Поле зрения по вертикали в радианах.
+    @param aspect Соотношение сторон.
+    @param near_clip Расстояние до ближней плоскости отсечения.
+    @param far_clip Расстояние до дальней плоскости отсечения.
+*/
+KAPI void camera_projection_set(camera* c, f32 fov, f32 aspect, f32 near_clip, f32 far_clip);
+
+/*
+    @brief Устанавливает соотношение сторон проекции камеры (например, при изменении размеров окна).
+    @param c Указатель на камеру для установки соотношения сторон.
+    @param aspect Новое соотношение сторон.
+*/
+KAPI void camera_aspect_set(camera* c, f32 aspect);
+
+/*
+    @brief Пересчитывает блок данных камеры, если камера изменилась.
+    NOTE: Вызывается системой камер один раз за кадр, но также выполняется при получении данных камеры.
+    @param c Указатель на камеру для обновления.
+    @return True если блок был пересчитан, false если камера не изменилась или при ошибках.
+*/
+KAPI bool camera_update(camera* c);
+
+/*
+    @brief Получение блока данных камеры (пересчитывается, если камера изменилась).
+    @param c Указатель на камеру для получения данных.
+    @return Указатель на блок данных камеры или null при ошибках.
+*/
+KAPI const camera_block* camera_block_get(camera* c);
+
 /*
     @brief Получение матрицы вида камеры.
     @param c Указатель на камеру для получения матрицы вида.
     @return Матрица вида камеры.
 */
-mat4 camera_view_get(camera* c);
+KAPI mat4 camera_view_get(camera* c);
 
 /*
     @brief Перемешает камеру вперед на заданное значение.
@@ -45,6 +45,12 @@ bool renderer_backend_create(renderer_backend_type type, renderer_backend* out_r
         out_renderer_backend->window_attachment_get              = vulkan_renderer_window_attachment_get;
         out_renderer_backend->depth_attachment_get               = vulkan_renderer_depth_attachment_get;
         out_renderer_backend->window_attachment_index_get        = vulkan_renderer_window_attachment_index_get;
+        out_renderer_backend->is_bindless_supported              = vulkan_renderer_is_bindless_supported;
+        out_renderer_backend->gpu_scope_begin                    = vulkan_renderer_gpu_scope_begin;
+        out_renderer_backend->gpu_scope_end                      = vulkan_renderer_gpu_scope_end;
+        out_renderer_backend->gpu_timings_get                    = vulkan_renderer_gpu_timings_get;
+        out_renderer_backend->memory_usage_str                   = vulkan_renderer_memory_usage_str;
+        out_renderer_backend->geometry_buffer_stats_get          = vulkan_renderer_geometry_buffer_stats_get;
         return true;
     }
     return false;
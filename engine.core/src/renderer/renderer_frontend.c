@@ -6,10 +6,13 @@
 // Внутренние подключения.
 #include "logger.h"
 #include "memory/memory.h"
+#include "kstring.h"
 #include "resources/resource_types.h"
 #include "systems/resource_system.h"
 #include "systems/shader_system.h"
 #include "systems/render_view_system.h"
+#include "debug/profiler.h"
+#include "platform/thread.h"
 
 typedef struct renderer_system_state {
     renderer_backend backend;
@@ -24,6 +27,11 @@ typedef struct renderer_system_state {
     renderpass* ui_renderpass;
     // Указывает что сейчас происходит изменение размера окна.
     bool resizing;
+    // Статистика рисования текущего и последнего завершенного кадра.
+    renderer_draw_stats draw_stats;
+    renderer_draw_stats last_draw_stats;
+    // Защищает ресурсы визуализатора: захватывается на время отрисовки кадра и изменения ресурсов.
+    platform_mutex resource_lock;
 } renderer_system_state;
 
 static renderer_system_state* state_ptr = null;
@@ -80,7 +88,7 @@ bool system_status_valid(const char* func_name)
     return true;
 }
 
-bool renderer_system_initialize(u64* memory_requirement, void* memory, window* window_state)
+bool renderer_system_initialize(u64* memory_requirement, void* memory, renderer_system_config* config)
 {
     if(state_ptr)
     {
@@ -98,6 +106,15 @@ bool renderer_system_initialize(u64* memory_requirement, void* memory, window* w
     kzero(memory, *memory_requirement);
     state_ptr = memory;
 
+    // NOTE: Рекурсивный, т.к. системы захватывают блокировку вокруг цепочек вызовов функций визуализатора.
+    if(!platform_mutex_create_recursive(&state_ptr->resource_lock))
+    {
+        kerror("Function '%s': Failed to create renderer resource lock.", __FUNCTION__);
+        state_ptr = null;
+        return false;
+    }
+    window* window_state = config->window_state;
+
     // TODO: Должны быть единая точка задания размеров кадрового буфера при инициализации!
     state_ptr->framebuffer_width = window_state->width;
     state_ptr->framebuffer_height = window_state->height;
@@ -134,6 +151,9 @@ bool renderer_system_initialize(u64* memory_requirement, void* memory, window* w
     renderer_config.on_rendertarget_refresh_required = regenerate_render_targets;
     renderer_config.renderpass_count = 2;
     renderer_config.pass_configs = pass_config;
+    renderer_config.geometry_compaction = config->geometry_compaction;
+    renderer_config.geometry_compaction_threshold = config->geometry_compaction_threshold;
+    renderer_config.geometry_compaction_bytes_per_frame = config->geometry_compaction_bytes_per_frame;
 
     CRITICAL_INIT(
         state_ptr->backend.initialize(&state_ptr->backend, &renderer_config, &state_ptr->window_render_target_count),
@@ -166,8 +186,16 @@ bool renderer_system_initialize(u64* memory_requirement, void* memory, window* w
     resource config_resource;
     shader_config* sconfig = null;
 
+    // При поддержке используется bindless вариант материального шейдера (с тем же именем шейдера).
+    const char* world_shader_config_name = BUILTIN_SHADER_NAME_WORLD;
+    if(state_ptr->backend.is_bindless_supported())
+    {
+        world_shader_config_name = BUILTIN_SHADER_CONFIG_WORLD_BINDLESS;
+        kinfor("Renderer uses bindless material textures.");
+    }
+
     CRITICAL_INIT(
-        resource_system_load(BUILTIN_SHADER_NAME_WORLD, RESOURCE_TYPE_SHADER, &config_resource),
+        resource_system_load(world_shader_config_name, RESOURCE_TYPE_SHADER, &config_resource),
         "Failed to load builtin material shader."
     );
 
@@ -216,6 +244,7 @@ void renderer_system_shutdown()
     state_ptr->backend.shutdown(&state_ptr->backend);
     renderer_backend_destroy(&state_ptr->backend);
 
+    platform_mutex_destroy(&state_ptr->resource_lock);
     state_ptr = null;
 }
 
@@ -223,15 +252,47 @@ void renderer_on_resize(i32 width, i32 height)
 {
     if(!system_status_valid(__FUNCTION__)) return;
 
+    platform_mutex_lock(&state_ptr->resource_lock);
+
     state_ptr->resizing = true;
     state_ptr->framebuffer_width = width;
     state_ptr->framebuffer_height = height;
+
+    // NOTE: Представления обновляются сразу в вызывающем потоке, где строятся их пакеты, а ресурсы
+    //       визуализатора при отрисовке следующего кадра.
+    render_view_system_on_window_resize(width, height);
+
+    platform_mutex_unlock(&state_ptr->resource_lock);
+}
+
+void renderer_resources_lock()
+{
+    platform_mutex_lock(&state_ptr->resource_lock);
 }
 
+void renderer_resources_unlock()
+{
+    platform_mutex_unlock(&state_ptr->resource_lock);
+}
+
+static bool renderer_frame_record(render_packet* packet);
+
 bool renderer_draw_frame(render_packet* packet)
 {
+    KPROFILE_FUNCTION();
+
     if(!system_status_valid(__FUNCTION__)) return false;
 
+    // NOTE: Кадр записывается целиком под блокировкой, изменения ресурсов из игрового потока ожидают его
+    //       завершения (включая уплотнение буферов геометрий в начале кадра).
+    platform_mutex_lock(&state_ptr->resource_lock);
+    bool result = renderer_frame_record(packet);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return result;
+}
+
+static bool renderer_frame_record(render_packet* packet)
+{
     // Производить генерацию кадров даже, если исход плохой!
     state_ptr->backend.frame_number++;
 
@@ -239,22 +300,27 @@ bool renderer_draw_frame(render_packet* packet)
     {
         f32 width = state_ptr->framebuffer_width;
         f32 height = state_ptr->framebuffer_height;
-        render_view_system_on_window_resize(width, height);
         state_ptr->backend.resized(width, height);
         state_ptr->resizing = false;
     }
 
+    kzero_tc(&state_ptr->draw_stats, renderer_draw_stats, 1);
+
     if(state_ptr->backend.frame_begin(packet->delta_time))
     {
         u8 attachment_index = state_ptr->backend.window_attachment_index_get();
 
         for(u32 i = 0; i < packet->view_count; ++i)
         {
+            state_ptr->backend.gpu_scope_begin(packet->views[i].view->name);
+
             if(!render_view_system_on_render(packet->views[i].view, &packet->views[i], state_ptr->backend.frame_number, attachment_index))
             {
                 kerror("Error rendering view index %i.", i);
                 return false;
             }
+
+            state_ptr->backend.gpu_scope_end();
         }
 
         if(!state_ptr->backend.frame_end(packet->delta_time))
@@ -262,43 +328,60 @@ bool renderer_draw_frame(render_packet* packet)
             kerror("Failed to complete function 'renderer_end_frame'. Shutting down.");
             return false;
         }
+
+        state_ptr->last_draw_stats = state_ptr->draw_stats;
     }
     return true;
 }
 
 void renderer_texture_create(texture* texture, const void* pixels)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.texture_create(texture, pixels);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 void renderer_texture_create_writable(texture* texture)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.texture_create_writable(texture);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 void renderer_texture_resize(texture* texture, u32 new_width, u32 new_height)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.texture_resize(texture, new_width, new_height);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 void renderer_texture_write_data(texture* texture, u32 offset, u32 size, const void* pixels)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.texture_write_data(texture, offset, size, pixels);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 void renderer_texture_destroy(texture* texture)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.texture_destroy(texture);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 bool renderer_texture_map_acquire_resources(texture_map* map)
 {
-    return state_ptr->backend.texture_map_acquire_resources(map);
+    platform_mutex_lock(&state_ptr->resource_lock);
+    bool result = state_ptr->backend.texture_map_acquire_resources(map);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return result;
 }
 
 void renderer_texture_map_release_resources(texture_map* map)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.texture_map_release_resources(map);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 bool renderer_geometry_create(
@@ -306,32 +389,55 @@ bool renderer_geometry_create(
     const void* indices
 )
 {
-    return state_ptr->backend.geometry_create(geometry, vertex_size, vertex_count, vertices, index_size, index_count, indices);
+    platform_mutex_lock(&state_ptr->resource_lock);
+    bool result = state_ptr->backend.geometry_create(geometry, vertex_size, vertex_count, vertices, index_size, index_count, indices);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return result;
 }
 
 void renderer_geometry_destroy(geometry* geometry)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.geometry_destroy(geometry);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 void renderer_geometry_draw(geometry_render_data* data)
 {
+    geometry* g = data->geometry;
+    if(g && data->lod < g->lod_count)
+    {
+        renderer_draw_stats* stats = &state_ptr->draw_stats;
+        stats->draw_count++;
+        stats->triangle_count += g->lods[data->lod].index_count / 3;
+        stats->full_triangle_count += g->lods[0].index_count / 3;
+        stats->lod_draw_counts[data->lod]++;
+    }
+
     state_ptr->backend.geometry_draw(data);
 }
 
 bool renderer_shader_create(shader* s, renderpass* pass, u8 stage_count, const char** stage_filenames, shader_stage* stages)
 {
-    return state_ptr->backend.shader_create(s, pass, stage_count, stage_filenames, stages);
+    platform_mutex_lock(&state_ptr->resource_lock);
+    bool result = state_ptr->backend.shader_create(s, pass, stage_count, stage_filenames, stages);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return result;
 }
 
 void renderer_shader_destroy(shader* s)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.shader_destroy(s);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 bool renderer_shader_initialize(shader* s)
 {
-    return state_ptr->backend.shader_initialize(s);
+    platform_mutex_lock(&state_ptr->resource_lock);
+    bool result = state_ptr->backend.shader_initialize(s);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return result;
 }
 
 bool renderer_shader_use(shader* s)
@@ -361,12 +467,18 @@ bool renderer_shader_apply_instance(shader* s, bool needs_update)
 
 bool renderer_shader_acquire_instance_resources(shader* s, texture_map** maps, u32* out_instance_id)
 {
-    return state_ptr->backend.shader_acquire_instance_resources(s, maps, out_instance_id);
+    platform_mutex_lock(&state_ptr->resource_lock);
+    bool result = state_ptr->backend.shader_acquire_instance_resources(s, maps, out_instance_id);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return result;
 }
 
 bool renderer_shader_release_instance_resources(shader* s, u32 instance_id)
 {
-    return state_ptr->backend.shader_release_instance_resources(s, instance_id);
+    platform_mutex_lock(&state_ptr->resource_lock);
+    bool result = state_ptr->backend.shader_release_instance_resources(s, instance_id);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return result;
 }
 
 bool renderer_shader_set_uniform(shader* s, shader_uniform* uniform, const void* value)
@@ -376,22 +488,30 @@ bool renderer_shader_set_uniform(shader* s, shader_uniform* uniform, const void*
 
 void renderer_render_target_create(u8 attachment_count, texture** attachments, renderpass* pass, u32 width, u32 height, render_target* out_target)
 {
-    state_ptr->backend.render_target_create(attachment_count, attachments, pass, width, height, out_target);    
+    platform_mutex_lock(&state_ptr->resource_lock);
+    state_ptr->backend.render_target_create(attachment_count, attachments, pass, width, height, out_target);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 void renderer_render_target_destroy(render_target* target, bool free_internal_memory)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.render_target_destroy(target, free_internal_memory);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 void renderer_renderpass_create(renderpass* out_renderpass, f32 depth, u32 stencil, bool has_prev_pass, bool has_next_pass)
 {
-    state_ptr->backend.renderpass_create(out_renderpass, depth, stencil, has_prev_pass, has_next_pass);    
+    platform_mutex_lock(&state_ptr->resource_lock);
+    state_ptr->backend.renderpass_create(out_renderpass, depth, stencil, has_prev_pass, has_next_pass);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 void renderer_renderpass_destroy(renderpass* pass)
 {
+    platform_mutex_lock(&state_ptr->resource_lock);
     state_ptr->backend.renderpass_destroy(pass);
+    platform_mutex_unlock(&state_ptr->resource_lock);
 }
 
 bool renderer_renderpass_begin(renderpass* pass, render_target* target)
@@ -408,3 +528,141 @@ renderpass* renderer_renderpass_get(const char* name)
 {
     return state_ptr->backend.renderpass_get(name);
 }
+
+const renderer_gpu_timing* renderer_gpu_timings_get(u32* out_count)
+{
+    if(!out_count)
+    {
+        kerror("Function '%s' requires a valid pointer to out_count.", __FUNCTION__);
+        return null;
+    }
+
+    if(!system_status_valid(__FUNCTION__))
+    {
+        *out_count = 0;
+        return null;
+    }
+
+    platform_mutex_lock(&state_ptr->resource_lock);
+    const renderer_gpu_timing* timings = state_ptr->backend.gpu_timings_get(out_count);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return timings;
+}
+
+void renderer_gpu_timings_log()
+{
+    if(!system_status_valid(__FUNCTION__)) return;
+
+    // NOTE: Замеры перезаписываются потоком отрисовки, поэтому выводятся под блокировкой.
+    platform_mutex_lock(&state_ptr->resource_lock);
+
+    u32 count = 0;
+    const renderer_gpu_timing* timings = state_ptr->backend.gpu_timings_get(&count);
+
+    if(!count)
+    {
+        kinfor("GPU timings are not available.");
+    }
+    else
+    {
+        kinfor("GPU timings (frame %llu):", state_ptr->backend.frame_number);
+        for(u32 i = 0; i < count; ++i)
+        {
+            kinfor("  %*s%-32s %8.3f ms", timings[i].depth * 2, "", timings[i].name, timings[i].milliseconds);
+        }
+    }
+
+    platform_mutex_unlock(&state_ptr->resource_lock);
+}
+
+const char* renderer_memory_usage_str()
+{
+    if(!system_status_valid(__FUNCTION__))
+    {
+        return string_duplicate("");
+    }
+
+    platform_mutex_lock(&state_ptr->resource_lock);
+    const char* str = state_ptr->backend.memory_usage_str();
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return str;
+}
+
+bool renderer_geometry_buffer_stats_get(renderer_geometry_buffer_stats* out_stats)
+{
+    if(!out_stats)
+    {
+        kerror("Function '%s' requires a valid pointer to out_stats.", __FUNCTION__);
+        return false;
+    }
+
+    if(!system_status_valid(__FUNCTION__))
+    {
+        return false;
+    }
+
+    platform_mutex_lock(&state_ptr->resource_lock);
+    state_ptr->backend.geometry_buffer_stats_get(out_stats);
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return true;
+}
+
+void renderer_geometry_buffer_stats_log()
+{
+    renderer_geometry_buffer_stats stats;
+    if(!renderer_geometry_buffer_stats_get(&stats))
+    {
+        return;
+    }
+
+    const f32 mib = 1024.0f * 1024.0f;
+    kinfor(
+        "Vertex buffer: %.2f / %.2f MiB free, largest free block %.2f MiB, fragmentation %.1f%%",
+        stats.vertex.free_size / mib, stats.vertex.total_size / mib, stats.vertex.largest_free_block / mib,
+        stats.vertex.fragmentation * 100.0f
+    );
+    kinfor(
+        "Index buffer : %.2f / %.2f MiB free, largest free block %.2f MiB, fragmentation %.1f%%",
+        stats.index.free_size / mib, stats.index.total_size / mib, stats.index.largest_free_block / mib,
+        stats.index.fragmentation * 100.0f
+    );
+    kinfor(
+        "Compaction   : %llu range(s) moved, %.2f MiB total, %u range(s) pending release",
+        stats.move_count, stats.moved_bytes / mib, stats.pending_release_count
+    );
+}
+
+bool renderer_draw_stats_get(renderer_draw_stats* out_stats)
+{
+    if(!out_stats)
+    {
+        kerror("Function '%s' requires a valid pointer to out_stats.", __FUNCTION__);
+        return false;
+    }
+
+    if(!system_status_valid(__FUNCTION__))
+    {
+        return false;
+    }
+
+    platform_mutex_lock(&state_ptr->resource_lock);
+    *out_stats = state_ptr->last_draw_stats;
+    platform_mutex_unlock(&state_ptr->resource_lock);
+    return true;
+}
+
+void renderer_draw_stats_log()
+{
+    renderer_draw_stats stats;
+    if(!renderer_draw_stats_get(&stats))
+    {
+        return;
+    }
+
+    f32 ratio = stats.full_triangle_count ? (f32)stats.triangle_count / stats.full_triangle_count : 1.0f;
+    kinfor(
+        "Draws: %u, triangles %llu of %llu at full detail (%.1f%%), draws per LOD: %u / %u / %u / %u",
+        stats.draw_count, stats.triangle_count, stats.full_triangle_count, ratio * 100.0f,
+        stats.lod_draw_counts[0], stats.lod_draw_counts[1], stats.lod_draw_counts[2], stats.lod_draw_counts[3]
+    );
+}
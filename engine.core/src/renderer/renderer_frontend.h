@@ -4,15 +4,27 @@
 #include <systems/shader_system.h>
 #include <platform/window.h>
 
+// @brief Конфигурация системы рендеринга.
+typedef struct renderer_system_config {
+    // @brief Указатель на выделенную память экземпляра оконной системы.
+    window* window_state;
+    // @brief Постепенная дефрагментация буферов вершин и индексов геометрий.
+    bool geometry_compaction;
+    // @brief Фрагментация свободной памяти буфера (0..1), начиная с которой переносятся данные.
+    f32 geometry_compaction_threshold;
+    // @brief Максимальный объем данных, переносимых за кадр, в байтах.
+    u64 geometry_compaction_bytes_per_frame;
+} renderer_system_config;
+
 /*
     @brief Инициализирует интерфейс и систему рендеринга.
     NOTE: Вызывать дважды, первый раз для получения требований к памяти, второй для инициализации.
     @param memory_requirement Указатель на переменную для сохранения требований системы к памяти в байтах.
     @param memory Указатель на выделенный блок памяти, или null для получения требований.
-    @param window_state Указатель на выделенную память экземпляра оконной системы.
+    @param config Указатель на конфигурацию системы рендеринга.
     @return True операция завершена успешно, false в случае ошибок.
 */
-bool renderer_system_initialize(u64* memory_requirement, void* memory, window* window_state);
+bool renderer_system_initialize(u64* memory_requirement, void* memory, renderer_system_config* config);
 
 /*
     @brief Завершает работу системы рендеринга и освобождает выделеные ей ресурсы.
@@ -21,11 +33,25 @@ void renderer_system_shutdown();
 
 /*
     @brief Изменяет размер области рендеринга, обычно вызывается на событие изменение размера окна.
+    NOTE: Ожидает завершения записи текущего кадра потоком отрисовки.
     @param width Новая ширина области рендеринга.
     @param height Новая высота области рендеринга.
 */
 void renderer_on_resize(i32 width, i32 height);
 
+/*
+    @brief Захватывает блокировку ресурсов визуализатора (рекурсивную): кадр не записывается, пока она удерживается.
+    NOTE: Функции создания, изменения и уничтожения ресурсов захватывают ее сами. Явно она нужна для изменения
+          данных, которые читает поток отрисовки (например, материала геометрии), и для цепочек таких изменений.
+          Ожидание может длиться до завершения записи текущего кадра.
+*/
+KAPI void renderer_resources_lock();
+
+/*
+    @brief Освобождает блокировку ресурсов визуализатора, захваченную renderer_resources_lock.
+*/
+KAPI void renderer_resources_unlock();
+
 /*
     @brief Рисует следующий кард используя предоставленный пакет рендеринга.
     @param packet Указатель на пакет рендеринга.
@@ -263,3 +289,50 @@ bool renderer_renderpass_end(renderpass* pass);
     @return Указатель на проходчик визуализатора, null если не удалось найти.
 */
 renderpass* renderer_renderpass_get(const char* name);
+
+/*
+    @brief Получает результаты замеров времени графического процессора последнего завершенного кадра:
+           кадр целиком, представления и проходы визуализатора (с учетом вложенности).
+    NOTE: Результаты читаются без ожидания, с задержкой на количество кадров в полете.
+    @param out_count Указатель на переменную для сохранения количества результатов.
+    @return Указатель на массив результатов (действителен до следующего кадра, для чтения при параллельной
+            отрисовке удерживайте renderer_resources_lock).
+*/
+KAPI const renderer_gpu_timing* renderer_gpu_timings_get(u32* out_count);
+
+/*
+    @brief Выводит в журнал результаты замеров времени графического процессора последнего завершенного кадра.
+*/
+KAPI void renderer_gpu_timings_log();
+
+/*
+    @brief Формирует строку с использованием памяти видеокарты по кучам (дополняет memory_system_usage_str).
+    NOTE: Полученную строку необходимо освободить с помощью string_free.
+    @return Строка с использованием памяти видеокарты.
+*/
+KAPI const char* renderer_memory_usage_str();
+
+/*
+    @brief Получает состояние буферов геометрий: фрагментацию свободной памяти (наибольший свободный блок
+           относительно всей свободной памяти) и результаты постепенной дефрагментации.
+    @param out_stats Указатель на структуру для сохранения состояния.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool renderer_geometry_buffer_stats_get(renderer_geometry_buffer_stats* out_stats);
+
+/*
+    @brief Выводит в журнал состояние буферов геометрий.
+*/
+KAPI void renderer_geometry_buffer_stats_log();
+
+/*
+    @brief Получает статистику геометрий, отправленных на рисование в последнем завершенном кадре.
+    @param out_stats Указатель на структуру для сохранения статистики.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool renderer_draw_stats_get(renderer_draw_stats* out_stats);
+
+/*
+    @brief Выводит в журнал статистику геометрий последнего завершенного кадра.
+*/
+KAPI void renderer_draw_stats_log();
@@ -4,9 +4,12 @@
 #include <platform/window.h>
 #include <math/math_types.h>
 #include <resources/resource_types.h>
+#include <math/bvh.h>
 
 #define BUILTIN_SHADER_NAME_WORLD "Builtin.MaterialShader"
 #define BUILTIN_SHADER_NAME_UI    "Builtin.UIShader"
+// @brief Имя конфигурации материального шейдера для режима bindless (создает шейдер BUILTIN_SHADER_NAME_WORLD).
+#define BUILTIN_SHADER_CONFIG_WORLD_BINDLESS "Builtin.MaterialShaderBindless"
 
 // TODO: Подчистить заголовочные файлы данным способом!
 struct shader;
@@ -29,6 +32,8 @@ typedef enum renderer_backend_type {
 typedef struct geometry_render_data {
     mat4 model;
     geometry* geometry;
+    // @brief Индекс выбранного уровня детализации геометрии.
+    u32 lod;
 } geometry_render_data;
 
 // @brief Представляет флаги очистки прохода визуализатора (комбинируемые).
@@ -89,6 +94,54 @@ typedef struct renderpass {
     void* internal_data;
 } renderpass;
 
+// @brief Результат замера времени графического процессора для области кадра.
+typedef struct renderer_gpu_timing {
+    // @brief Имя области (проход визуализатора, представление или кадр).
+    const char* name;
+    // @brief Глубина вложенности области (0 - кадр целиком).
+    u8 depth;
+    // @brief Время выполнения области в миллисекундах.
+    f64 milliseconds;
+} renderer_gpu_timing;
+
+// @brief Состояние свободной памяти буфера визуализатора.
+typedef struct renderer_buffer_stats {
+    // @brief Размер буфера в байтах.
+    u64 total_size;
+    // @brief Объем свободной памяти в байтах.
+    u64 free_size;
+    // @brief Размер наибольшего свободного блока в байтах.
+    u64 largest_free_block;
+    // @brief Фрагментация свободной памяти: 1 - largest_free_block / free_size (0 - без фрагментации).
+    f32 fragmentation;
+} renderer_buffer_stats;
+
+// @brief Состояние буферов геометрий и их дефрагментации.
+typedef struct renderer_geometry_buffer_stats {
+    // @brief Буфер вершин.
+    renderer_buffer_stats vertex;
+    // @brief Буфер индексов.
+    renderer_buffer_stats index;
+    // @brief Общее количество перенесенных дефрагментацией диапазонов.
+    u64 move_count;
+    // @brief Общий объем перенесенных дефрагментацией данных в байтах.
+    u64 moved_bytes;
+    // @brief Количество диапазонов, ожидающих освобождения после завершения кадров в полете.
+    u32 pending_release_count;
+} renderer_geometry_buffer_stats;
+
+// @brief Статистика отправленных на рисование геометрий за кадр.
+typedef struct renderer_draw_stats {
+    // @brief Количество вызовов рисования.
+    u32 draw_count;
+    // @brief Количество нарисованных треугольников с учетом выбранных уровней детализации.
+    u64 triangle_count;
+    // @brief Количество треугольников тех же геометрий при полной детализации.
+    u64 full_triangle_count;
+    // @brief Количество вызовов рисования по уровням детализации.
+    u32 lod_draw_counts[GEOMETRY_LOD_MAX];
+} renderer_draw_stats;
+
 // @brief Представляет конфигурацию визуализатора.
 typedef struct renderer_backend_config {
     // @brief Имя приложения.
@@ -99,6 +152,12 @@ typedef struct renderer_backend_config {
     renderpass_config* pass_configs;
     // @brief Функция обновления/воссоздания целей визуализатора по требованию.
     void (*on_rendertarget_refresh_required)();
+    // @brief Постепенная дефрагментация буферов вершин и индексов геометрий.
+    bool geometry_compaction;
+    // @brief Фрагментация свободной памяти буфера (0..1), начиная с которой переносятся данные.
+    f32 geometry_compaction_threshold;
+    // @brief Максимальный объем данных, переносимых за кадр, в байтах.
+    u64 geometry_compaction_bytes_per_frame;
 } renderer_backend_config;
 
 typedef struct renderer_backend {
@@ -389,6 +448,45 @@ typedef struct renderer_backend {
     */
     u8 (*window_attachment_index_get)();
 
+    /*
+        @brief Проверяет поддержку режима bindless (единый массив текстур и индекс материала вместо наборов экземпляров).
+        @return True если режим поддерживается, false если нет.
+    */
+    bool (*is_bindless_supported)();
+
+    /*
+        @brief Открывает область замера времени графического процессора в текущем кадре.
+        NOTE: Области могут быть вложенными, каждая должна быть закрыта с помощью gpu_scope_end.
+        @param name Имя области (должно существовать не менее количества кадров в полете).
+    */
+    void (*gpu_scope_begin)(const char* name);
+
+    /*
+        @brief Закрывает последнюю открытую область замера времени графического процессора.
+    */
+    void (*gpu_scope_end)();
+
+    /*
+        @brief Получает результаты замеров времени графического процессора последнего завершенного кадра.
+        NOTE: Результаты читаются без ожидания, с задержкой на количество кадров в полете.
+        @param out_count Указатель на переменную для сохранения количества результатов.
+        @return Указатель на массив результатов.
+    */
+    const renderer_gpu_timing* (*gpu_timings_get)(u32* out_count);
+
+    /*
+        @brief Формирует строку с использованием памяти видеокарты по кучам.
+        NOTE: Полученную строку необходимо освободить с помощью string_free.
+        @return Строка с использованием памяти видеокарты.
+    */
+    const char* (*memory_usage_str)();
+
+    /*
+        @brief Получает состояние буферов геометрий и их дефрагментации.
+        @param out_stats Указатель на структуру для сохранения состояния.
+    */
+    void (*geometry_buffer_stats_get)(renderer_geometry_buffer_stats* out_stats);
+
 } renderer_backend;
 
 // @brief Известные типы визуализации.
@@ -456,9 +554,33 @@ typedef struct render_view_packet {
     void* extended_data;
 } render_view_packet;
 
+// @brief Геометрия сетки с постоянным индексом (объект сцены).
+typedef struct mesh_packet_item {
+    // @brief Геометрия объекта или null если объект удален.
+    geometry* geometry;
+    // @brief Индекс сетки объекта в meshes и mesh_models.
+    u32 mesh_index;
+    // @brief Мировые границы геометрии.
+    extents_3d bounds;
+} mesh_packet_item;
+
 typedef struct mesh_packet_data {
     u32 mesh_count;
     mesh* meshes;
+    // @brief Кэшированные мировые матрицы сеток (индексируется как meshes), или null.
+    const mat4* mesh_models;
+    // @brief Иерархия мировых границ объектов (пользовательские данные - индексы в items) для отсечения, или null.
+    const bvh* culling_tree;
+    // @brief Количество элементов массива items.
+    u32 item_capacity;
+    // @brief Объекты с постоянными индексами, или null.
+    const mesh_packet_item* items;
+    // @brief Номер обновления, за которое составлен список изменений.
+    u64 generation;
+    // @brief Количество измененных объектов.
+    u32 changed_item_count;
+    // @brief Индексы объектов, добавленных, удаленных или измененных за обновление generation.
+    const u32* changed_items;
 } mesh_packet_data;
 
 typedef struct render_packet {
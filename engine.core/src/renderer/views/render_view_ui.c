@@ -5,7 +5,7 @@
 #include "logger.h"
 #include "memory/memory.h"
 #include "math/kmath.h"
-#include "math/transform.h"
+#include "systems/transform_system.h"
 #include "containers/darray.h"
 #include "systems/material_system.h"
 #include "systems/shader_system.h"
@@ -18,6 +18,8 @@ typedef struct render_view_ui_internal_data {
     mat4 projection_matrix;
     mat4 view_matrix;
     // u32 render_mode;
+    // Список отрисовки, принадлежащий представлению (darray).
+    geometry_render_data* draw_list;
 } render_view_ui_internal_data;
 
 static bool view_state_valid(render_view* self, const char* func_name)
@@ -48,6 +50,7 @@ bool render_view_ui_on_create(render_view* self)
 
     data->projection_matrix = mat4_orthographic(0.0f, 1280.0f, 720.0f, 0.0f, data->near_clip, data->far_clip);
     data->view_matrix = mat4_inverse(mat4_identity());
+    data->draw_list = darray_create(geometry_render_data);
 
     return true;
 }
@@ -56,6 +59,9 @@ void render_view_ui_on_destroy(render_view* self)
 {
     if(!view_state_valid(self, __FUNCTION__)) return;
 
+    render_view_ui_internal_data* data = self->internal_data;
+    darray_destroy(data->draw_list);
+
     kfree_tc(self->internal_data, render_view_ui_internal_data, 1, MEMORY_TAG_RENDERER);
     self->internal_data = null;
 }
@@ -92,7 +98,7 @@ bool render_view_ui_on_build_packet(render_view* self, void* data, render_view_p
     mesh_packet_data* mesh_data = data;
     render_view_ui_internal_data* internal_data = self->internal_data;
 
-    out_packet->geometries = darray_create(geometry_render_data);
+    darray_clear(internal_data->draw_list);
     out_packet->view = self;
 
     out_packet->projection_matrix = internal_data->projection_matrix;
@@ -106,13 +112,17 @@ bool render_view_ui_on_build_packet(render_view* self, void* data, render_view_p
         {
             geometry_render_data render_data;
             render_data.geometry = m->geometries[j];
-            render_data.model = transform_get_world(&m->transform);
+            render_data.model = transform_system_get_world(m->transform);
+            render_data.lod = 0;
 
-            darray_push(out_packet->geometries, render_data);
-            out_packet->geometry_count++;
+            darray_push(internal_data->draw_list, render_data);
         }
     }
 
+    // NOTE: Список отрисовки принадлежит представлению и действителен до следующего построения пакета.
+    out_packet->geometries = internal_data->draw_list;
+    out_packet->geometry_count = darray_length(internal_data->draw_list);
+
     return true;
 }
 
@@ -171,7 +181,7 @@ bool render_view_ui_on_render(render_view* self, const render_view_packet* packe
             }
 
             // Применение локальной позиции объекта.
-            material_system_apply_local(m, &packet->geometries[i].model);
+            material_system_apply_local(m, &packet->geometries[i].model, null);
 
             // Нарисовать!
             renderer_geometry_draw(&packet->geometries[i]);
@@ -6,28 +6,71 @@
 #include "event.h"
 #include "memory/memory.h"
 #include "math/kmath.h"
-#include "math/transform.h"
+#include "systems/transform_system.h"
 #include "containers/darray.h"
+#include "containers/radix_sort.h"
 #include "systems/material_system.h"
 #include "systems/shader_system.h"
 #include "systems/camera_system.h"
 #include "renderer/renderer_frontend.h"
 
+typedef struct geometry_distance {
+    geometry_render_data g;
+    f32 distance_squared;    // Квадрат дистанции относительно камеры.
+    u32 item;                // Объект сцены или INVALID_ID.
+} geometry_distance;
+
 typedef struct render_view_world_internal_data {
     u32 shader_id;
     f32 fov;
     f32 near_clip;
     f32 far_clip;
-    mat4 projection_matrix;
     camera* world_camera;
     vec4 ambient_color;
     u32 render_mode;
+    // Индексы видимых объектов, найденных в иерархии отсечения.
+    u32* visible_items;
+    u32 visible_capacity;
+
+    // NOTE: Списки отрисовки сохраняются между кадрами: изменения сцены исправляют только измененные объекты,
+    //       а при движении камеры записи видимых объектов обновляются на месте, добавляются только ставшие
+    //       видимыми и удаляются ставшие невидимыми. Полностью списки строятся заново только при пропуске
+    //       обновлений сцены или изменении количества объектов.
+
+    // Геометрии пакета: сначала без прозрачности, затем отсортированные с прозрачностью (darray).
+    geometry_render_data* draw_list;
+    // Объекты геометрий без прозрачности, по порядку draw_list (darray).
+    u32* opaque_items;
+    // Геометрии с прозрачностью (darray).
+    geometry_distance* transparent;
+    // Список геометрий с прозрачностью изменился и должен быть отсортирован.
+    bool transparent_dirty;
+    // Порядок отрисовки геометрий с прозрачностью (индексы transparent от дальних к ближним).
+    u32* transparent_order;
+    // Ключи и временный буфер (двойного размера) поразрядной сортировки.
+    u32* sort_keys;
+    u32* sort_scratch;
+    u32 sort_capacity;
+    // Положение объектов в списках: индекс | DRAW_ENTRY_TRANSPARENT или INVALID_ID (индексируется объектом).
+    u32* item_entries;
+    // Номер отсечения, в котором объект последний раз найден видимым (индексируется объектом).
+    u32* item_stamps;
+    u32 item_capacity;
+    // Номер последнего отсечения.
+    u32 cull_stamp;
+    // Состояние, для которого составлены списки.
+    u64 list_camera_generation;
+    u64 list_generation;
+    // Положение камеры, для которого выбраны уровни детализации и расстояния геометрий с прозрачностью.
+    vec3 list_position;
+    bool list_valid;
 } render_view_world_internal_data;
 
-typedef struct geometry_distance {
-    geometry_render_data g;
-    f32 distance;            // Дистанция относительно камеры.
-} geometry_distance;
+// Допустимая ошибка уровня детализации на экране в пикселях.
+#define WORLD_LOD_PIXEL_ERROR 1.0f
+
+// Признак нахождения объекта в списке геометрий с прозрачностью.
+#define DRAW_ENTRY_TRANSPARENT 0x80000000
 
 static bool view_state_valid(render_view* self, const char* func_name)
 {
@@ -39,58 +82,69 @@ static bool view_state_valid(render_view* self, const char* func_name)
     return true;
 }
 
-static void swap(geometry_distance* a, geometry_distance* b)
-{
-    geometry_distance t  = *a;
-    *a = *b;
-    *b = t;
-}
-
-static i32 partition(geometry_distance* arr, i32 low_index, i32 high_index, bool ascending)
+// Обеспечивает буферы сортировки для указанного количества элементов.
+static void sort_buffers_reserve(render_view_world_internal_data* data, u32 count)
 {
-    geometry_distance pivot = arr[high_index];
-    i32 i = (low_index - 1);
+    if(count <= data->sort_capacity) return;
 
-    for(i32 j = low_index; j <= high_index - 1; ++j)
+    if(data->sort_capacity)
     {
-        if(ascending)
-        {
-            if(arr[j].distance < pivot.distance)
-            {
-                ++i;
-                swap(&arr[i], &arr[j]);
-            }
-        }
-        else
-        {
-            if(arr[j].distance > pivot.distance)
-            {
-                ++i;
-                swap(&arr[i], &arr[j]);
-            }
-        }
+        u32 scratch_capacity = data->sort_capacity * 2;
+        kfree_tc(data->transparent_order, u32, data->sort_capacity, MEMORY_TAG_RENDERER);
+        kfree_tc(data->sort_keys, u32, data->sort_capacity, MEMORY_TAG_RENDERER);
+        kfree_tc(data->sort_scratch, u32, scratch_capacity, MEMORY_TAG_RENDERER);
     }
 
-    swap(&arr[i + 1], &arr[high_index]);
-    return i + 1;
+    data->sort_capacity = KMAX(count, data->sort_capacity * 2);
+    u32 scratch_capacity = data->sort_capacity * 2;
+    data->transparent_order = kallocate_tc(u32, data->sort_capacity, MEMORY_TAG_RENDERER);
+    data->sort_keys = kallocate_tc(u32, data->sort_capacity, MEMORY_TAG_RENDERER);
+    data->sort_scratch = kallocate_tc(u32, scratch_capacity, MEMORY_TAG_RENDERER);
 }
 
 /*
-    @brief Функция сортировки геометрий.
-    @param arr Массив геометрий с дистанцией до камеры для сортировки.
-    @param low_index Начальный индекс с которого нужно выполнять сортировку (обычно с 0).
-    @param high_index Конечноый индекс до которого нужно выполнять сортировку (для всего массива -1).
-    @param ascending True сортировка в порядке возрастания, false в порядке убывания.
+    @brief Выбирает самый грубый уровень детализации геометрии, ошибка которого на экране не превышает
+           WORLD_LOD_PIXEL_ERROR (по расстоянию до ограничивающей сферы и размеру пикселя на этом расстоянии).
+    @param g Указатель на геометрию.
+    @param model Мировая матрица геометрии.
+    @param camera_position Положение камеры.
+    @param pixel_size_per_distance Размер пикселя в мировых единицах на единичном расстоянии от камеры.
+    @return Индекс уровня детализации.
 */
-static void quick_sort(geometry_distance* arr, i32 low_index, i32 high_index, bool ascending)
+static u32 lod_select(const geometry* g, const mat4* model, vec3 camera_position, f32 pixel_size_per_distance)
 {
-    if(low_index < high_index)
+    if(g->lod_count <= 1 || pixel_size_per_distance <= 0.0f)
     {
-        i32 partition_index = partition(arr, low_index, high_index, ascending);
+        return 0;
+    }
 
-        quick_sort(arr, low_index, partition_index - 1, ascending);
-        quick_sort(arr, partition_index + 1, high_index, ascending);
+    // Наибольший масштаб мировой матрицы (строки содержат масштабированные базисные векторы).
+    f32 scale = 0.0f;
+    for(u32 r = 0; r < 3; ++r)
+    {
+        vec3 axis = vec3_create(model->data[r * 4 + 0], model->data[r * 4 + 1], model->data[r * 4 + 2]);
+        scale = KMAX(scale, vec3_length(axis));
     }
+
+    vec3 center = vec3_transform(g->center, 1.0f, *model);
+    f32 radius = vec3_length(vec3_sub(g->extents.max, g->extents.min)) * 0.5f * scale;
+    f32 distance = vec3_distance(center, camera_position) - radius;
+
+    if(distance <= 0.0f)
+    {
+        return 0;
+    }
+
+    f32 allowed_error = WORLD_LOD_PIXEL_ERROR * pixel_size_per_distance * distance;
+    for(u32 lod = g->lod_count - 1; lod > 0; --lod)
+    {
+        if(g->lods[lod].error * scale <= allowed_error)
+        {
+            return lod;
+        }
+    }
+
+    return 0;
 }
 
 bool render_view_world_on_event(event_code code, void* sender, void* listener, event_context* context)
@@ -129,6 +183,7 @@ bool render_view_world_on_create(render_view* self)
 
     self->internal_data = kallocate_tc(render_view_world_internal_data, 1, MEMORY_TAG_RENDERER);
     render_view_world_internal_data* data = self->internal_data;
+    kzero_tc(data, render_view_world_internal_data, 1);
 
     data->shader_id = shader_system_get_id(self->custom_shader_name ? self->custom_shader_name : BUILTIN_SHADER_NAME_WORLD);
     data->render_mode = RENDERER_VIEW_MODE_DEFAULT;
@@ -136,11 +191,15 @@ bool render_view_world_on_create(render_view* self)
     data->fov = deg_to_rad(60.0f);
     data->near_clip = 0.1f;
     data->far_clip = 1000.0f;
-    data->projection_matrix = mat4_perspective(data->fov, 1280.0f / 720.0f, data->near_clip, data->far_clip);
     data->world_camera = camera_system_get_default();
+    camera_projection_set(data->world_camera, data->fov, 1280.0f / 720.0f, data->near_clip, data->far_clip);
     // TODO: Получение из сцены.
     data->ambient_color = (vec4){{0.25f, 0.25f, 0.25f, 1.0f}};
 
+    data->draw_list = darray_create(geometry_render_data);
+    data->opaque_items = darray_create(u32);
+    data->transparent = darray_create(geometry_distance);
+
     event_register(EVENT_CODE_SET_RENDER_MODE, self->internal_data, render_view_world_on_event);
 
     return true;
@@ -150,6 +209,28 @@ void render_view_world_on_destroy(render_view* self)
 {
     if(!view_state_valid(self, __FUNCTION__)) return;
     event_unregister(EVENT_CODE_SET_RENDER_MODE, self->internal_data, render_view_world_on_event);
+
+    render_view_world_internal_data* data = self->internal_data;
+    if(data->visible_items)
+    {
+        kfree_tc(data->visible_items, u32, data->visible_capacity, MEMORY_TAG_RENDERER);
+    }
+    if(data->item_entries)
+    {
+        kfree_tc(data->item_entries, u32, data->item_capacity, MEMORY_TAG_RENDERER);
+        kfree_tc(data->item_stamps, u32, data->item_capacity, MEMORY_TAG_RENDERER);
+    }
+    if(data->sort_capacity)
+    {
+        u32 scratch_capacity = data->sort_capacity * 2;
+        kfree_tc(data->transparent_order, u32, data->sort_capacity, MEMORY_TAG_RENDERER);
+        kfree_tc(data->sort_keys, u32, data->sort_capacity, MEMORY_TAG_RENDERER);
+        kfree_tc(data->sort_scratch, u32, scratch_capacity, MEMORY_TAG_RENDERER);
+    }
+    darray_destroy(data->draw_list);
+    darray_destroy(data->opaque_items);
+    darray_destroy(data->transparent);
+
     kfree_tc(self->internal_data, render_view_world_internal_data, 1, MEMORY_TAG_RENDERER);
     self->internal_data = null;
 }
@@ -164,8 +245,7 @@ void render_view_world_on_resize(render_view* self, u32 width, u32 height)
 
         self->width = width;
         self->height = height;
-        f32 aspect = (f32)width / height;
-        data->projection_matrix = mat4_perspective(data->fov, aspect, data->near_clip, data->far_clip);
+        camera_aspect_set(data->world_camera, (f32)width / height);
 
         for(u32 i = 0; i < self->renderpass_count; ++i)
         {
@@ -176,6 +256,295 @@ void render_view_world_on_resize(render_view* self, u32 width, u32 height)
     }
 }
 
+static KINLINE bool geometry_is_transparent(const geometry* g)
+{
+    return g->material && (g->material->diffuse_map.texture->flags & TEXTURE_FLAG_HAS_TRANSPARENCY) != 0;
+}
+
+/*
+    @brief Добавляет геометрию в список без прозрачности или в список с прозрачностью.
+    NOTE: Список draw_list в этот момент должен содержать только геометрии без прозрачности.
+*/
+static void draw_entry_add(
+    render_view_world_internal_data* data, u32 item, geometry* g, const mat4* model, vec3 view_position,
+    f32 pixel_size_per_distance
+)
+{
+    geometry_render_data render_data;
+    render_data.geometry = g;
+    render_data.model = *model;
+    render_data.lod = lod_select(g, model, view_position, pixel_size_per_distance);
+
+    if(!geometry_is_transparent(g))
+    {
+        if(item != INVALID_ID)
+        {
+            data->item_entries[item] = darray_length(data->opaque_items);
+            darray_push(data->opaque_items, item);
+        }
+        darray_push(data->draw_list, render_data);
+    }
+    else
+    {
+        geometry_distance gdist;
+        gdist.g = render_data;
+        gdist.distance_squared = vec3_distance_squared(vec3_transform(g->center, 1.0f, *model), view_position);
+        gdist.item = item;
+
+        if(item != INVALID_ID)
+        {
+            data->item_entries[item] = darray_length(data->transparent) | DRAW_ENTRY_TRANSPARENT;
+        }
+        darray_push(data->transparent, gdist);
+        data->transparent_dirty = true;
+    }
+}
+
+// Удаляет объект из списков (последний элемент списка переносится на его место).
+static void draw_entry_remove(render_view_world_internal_data* data, u32 item)
+{
+    u32 entry = data->item_entries[item];
+    if(entry == INVALID_ID) return;
+
+    u32 index = entry & ~DRAW_ENTRY_TRANSPARENT;
+    if(entry & DRAW_ENTRY_TRANSPARENT)
+    {
+        u32 last = darray_length(data->transparent) - 1;
+        if(index != last)
+        {
+            data->transparent[index] = data->transparent[last];
+            data->item_entries[data->transparent[index].item] = index | DRAW_ENTRY_TRANSPARENT;
+        }
+        darray_pop(data->transparent, null);
+        data->transparent_dirty = true;
+    }
+    else
+    {
+        u32 last = darray_length(data->opaque_items) - 1;
+        if(index != last)
+        {
+            data->draw_list[index] = data->draw_list[last];
+            data->opaque_items[index] = data->opaque_items[last];
+            data->item_entries[data->opaque_items[index]] = index;
+        }
+        darray_pop(data->draw_list, null);
+        darray_pop(data->opaque_items, null);
+    }
+
+    data->item_entries[item] = INVALID_ID;
+}
+
+static void draw_lists_clear(render_view_world_internal_data* data)
+{
+    if(data->item_entries)
+    {
+        u32 opaque_count = darray_length(data->opaque_items);
+        for(u32 i = 0; i < opaque_count; ++i)
+        {
+            data->item_entries[data->opaque_items[i]] = INVALID_ID;
+        }
+
+        u32 transparent_count = darray_length(data->transparent);
+        for(u32 i = 0; i < transparent_count; ++i)
+        {
+            if(data->transparent[i].item != INVALID_ID)
+            {
+                data->item_entries[data->transparent[i].item] = INVALID_ID;
+            }
+        }
+    }
+
+    darray_clear(data->draw_list);
+    darray_clear(data->opaque_items);
+    darray_clear(data->transparent);
+    data->transparent_dirty = true;
+    data->list_valid = false;
+}
+
+// Находит объекты, пересекающие усеченную пирамиду (через иерархию отсечения), и возвращает их количество.
+static u32 visible_items_query(render_view_world_internal_data* data, const mesh_packet_data* mesh_data, const frustum* f)
+{
+    u32 item_count = bvh_count(mesh_data->culling_tree);
+    if(item_count > data->visible_capacity)
+    {
+        if(data->visible_items)
+        {
+            kfree_tc(data->visible_items, u32, data->visible_capacity, MEMORY_TAG_RENDERER);
+        }
+        data->visible_capacity = item_count;
+        data->visible_items = kallocate_tc(u32, data->visible_capacity, MEMORY_TAG_RENDERER);
+    }
+
+    u32 visible_count = bvh_query_frustum(mesh_data->culling_tree, f, data->visible_items, data->visible_capacity);
+    return KMIN(visible_count, data->visible_capacity);
+}
+
+/*
+    @brief Добавляет первые count объектов из visible_items от ближних к дальним.
+    NOTE: Геометрии без прозрачности рисуются спереди назад, чтобы тест глубины отбрасывал перекрытые
+          фрагменты. Объекты, добавленные позже (исправлениями списков или при движении камеры), попадают
+          в конец списка, поэтому порядок приблизительный до следующего полного построения.
+*/
+static void draw_lists_add_sorted(
+    render_view_world_internal_data* data, const mesh_packet_data* mesh_data, u32 count, vec3 view_position,
+    f32 pixel_size_per_distance
+)
+{
+    sort_buffers_reserve(data, count);
+    for(u32 i = 0; i < count; ++i)
+    {
+        extents_3d bounds = mesh_data->items[data->visible_items[i]].bounds;
+        data->sort_keys[i] = radix_sort_key_f32(vec3_distance_squared(extents_3d_half(bounds), view_position));
+    }
+    radix_sort(count, data->sort_keys, data->visible_items, data->sort_scratch);
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        u32 item = data->visible_items[i];
+        const mesh_packet_item* it = &mesh_data->items[item];
+        draw_entry_add(data, item, it->geometry, &mesh_data->mesh_models[it->mesh_index], view_position, pixel_size_per_distance);
+    }
+}
+
+// Строит списки заново по объектам, пересекающим усеченную пирамиду.
+static void draw_lists_build_visible(
+    render_view_world_internal_data* data, const mesh_packet_data* mesh_data, const frustum* f, vec3 view_position,
+    f32 pixel_size_per_distance
+)
+{
+    u32 visible_count = visible_items_query(data, mesh_data, f);
+    draw_lists_add_sorted(data, mesh_data, visible_count, view_position, pixel_size_per_distance);
+}
+
+/*
+    @brief Обновляет запись видимого объекта на месте: уровень детализации и расстояние (при движении камеры),
+           а также список, если прозрачность геометрии изменилась после смены материала.
+*/
+static void draw_entry_refresh(
+    render_view_world_internal_data* data, u32 item, const mesh_packet_item* it, vec3 view_position,
+    f32 pixel_size_per_distance, bool position_changed
+)
+{
+    u32 entry = data->item_entries[item];
+    u32 index = entry & ~DRAW_ENTRY_TRANSPARENT;
+    bool transparent = (entry & DRAW_ENTRY_TRANSPARENT) != 0;
+    geometry_render_data* render_data = transparent ? &data->transparent[index].g : &data->draw_list[index];
+
+    if(geometry_is_transparent(it->geometry) != transparent)
+    {
+        mat4 model = render_data->model;
+        draw_entry_remove(data, item);
+        draw_entry_add(data, item, it->geometry, &model, view_position, pixel_size_per_distance);
+        return;
+    }
+
+    if(!position_changed) return;
+
+    render_data->lod = lod_select(it->geometry, &render_data->model, view_position, pixel_size_per_distance);
+    if(transparent)
+    {
+        data->transparent[index].distance_squared = vec3_distance_squared(
+            vec3_transform(it->geometry->center, 1.0f, render_data->model), view_position
+        );
+    }
+}
+
+/*
+    @brief Исправляет списки после движения камеры без их очистки.
+    NOTE: Объекты, оставшиеся видимыми, сохраняют свои записи, добавляются только ставшие видимыми
+          объекты и удаляются ставшие невидимыми. Порядок геометрий с прозрачностью сортируется заново,
+          только если после обновления расстояний он нарушен.
+*/
+static void draw_lists_update_visible(
+    render_view_world_internal_data* data, const mesh_packet_data* mesh_data, const frustum* f, vec3 view_position,
+    f32 pixel_size_per_distance, bool position_changed
+)
+{
+    u32 visible_count = visible_items_query(data, mesh_data, f);
+
+    data->cull_stamp++;
+    if(data->cull_stamp == 0)
+    {
+        kzero_tc(data->item_stamps, u32, data->item_capacity);
+        data->cull_stamp = 1;
+    }
+
+    // Обновление оставшихся видимыми, новые объекты переносятся в начало visible_items.
+    u32 added_count = 0;
+    for(u32 i = 0; i < visible_count; ++i)
+    {
+        u32 item = data->visible_items[i];
+        data->item_stamps[item] = data->cull_stamp;
+
+        if(data->item_entries[item] == INVALID_ID)
+        {
+            data->visible_items[added_count++] = item;
+            continue;
+        }
+
+        draw_entry_refresh(data, item, &mesh_data->items[item], view_position, pixel_size_per_distance, position_changed);
+    }
+
+    // Удаление ставших невидимыми (при удалении на место записи переносится уже проверенная последняя).
+    for(u32 i = darray_length(data->opaque_items); i > 0; --i)
+    {
+        u32 item = data->opaque_items[i - 1];
+        if(data->item_stamps[item] != data->cull_stamp)
+        {
+            draw_entry_remove(data, item);
+        }
+    }
+    for(u32 i = darray_length(data->transparent); i > 0; --i)
+    {
+        u32 item = data->transparent[i - 1].item;
+        if(data->item_stamps[item] != data->cull_stamp)
+        {
+            draw_entry_remove(data, item);
+        }
+    }
+
+    // Проверка порядка геометрий с прозрачностью (от дальних к ближним).
+    if(position_changed && !data->transparent_dirty)
+    {
+        u32 transparent_count = darray_length(data->transparent);
+        for(u32 i = 1; i < transparent_count; ++i)
+        {
+            f32 farther = data->transparent[data->transparent_order[i - 1]].distance_squared;
+            f32 nearer = data->transparent[data->transparent_order[i]].distance_squared;
+            if(farther < nearer)
+            {
+                data->transparent_dirty = true;
+                break;
+            }
+        }
+    }
+
+    draw_lists_add_sorted(data, mesh_data, added_count, view_position, pixel_size_per_distance);
+}
+
+// Исправляет списки для объектов, измененных за последнее обновление сцены.
+static void draw_lists_patch(
+    render_view_world_internal_data* data, const mesh_packet_data* mesh_data, const frustum* f, vec3 view_position,
+    f32 pixel_size_per_distance
+)
+{
+    for(u32 i = 0; i < mesh_data->changed_item_count; ++i)
+    {
+        u32 item = mesh_data->changed_items[i];
+        draw_entry_remove(data, item);
+
+        const mesh_packet_item* it = &mesh_data->items[item];
+        if(!it->geometry) continue;
+
+        vec3 center = extents_3d_half(it->bounds);
+        vec3 half = vec3_mul_scalar(vec3_sub(it->bounds.max, it->bounds.min), 0.5f);
+        if(frustum_intersects_aabb(f, &center, &half))
+        {
+            draw_entry_add(data, item, it->geometry, &mesh_data->mesh_models[it->mesh_index], view_position, pixel_size_per_distance);
+        }
+    }
+}
+
 bool render_view_world_on_build_packet(render_view* self, void* data, render_view_packet* out_packet)
 {
     if(!view_state_valid(self, __FUNCTION__) || !data || !out_packet)
@@ -187,59 +556,115 @@ bool render_view_world_on_build_packet(render_view* self, void* data, render_vie
     mesh_packet_data* mesh_data = data;
     render_view_world_internal_data* internal_data = self->internal_data;
 
-    out_packet->geometries = darray_create(geometry_render_data);
-    out_packet->view = self;
+    // NOTE: Блок данных камеры обновляется системой камер один раз за кадр.
+    const camera_block* cam = camera_block_get(internal_data->world_camera);
 
-    out_packet->projection_matrix = internal_data->projection_matrix;
-    out_packet->view_matrix = camera_view_get(internal_data->world_camera);
-    out_packet->view_position = camera_position_get(internal_data->world_camera);
+    out_packet->view = self;
+    out_packet->projection_matrix = cam->projection;
+    out_packet->view_matrix = cam->view;
+    out_packet->view_position = cam->position;
     out_packet->ambient_color = internal_data->ambient_color;
 
-    geometry_distance* geometry_distances = darray_create(geometry_distance);
+    // Размер пикселя на единичном расстоянии от камеры для выбора уровней детализации.
+    f32 pixel_size_per_distance = self->height ? 2.0f * ktan_fast(internal_data->fov * 0.5f) / self->height : 0.0f;
 
-    for(u32 i = 0; i < mesh_data->mesh_count; ++i)
+    // Удаление отсортированных геометрий с прозрачностью предыдущего кадра.
+    u32 opaque_count = darray_length(internal_data->opaque_items);
+    while(darray_length(internal_data->draw_list) > opaque_count)
     {
-        mesh* m = &mesh_data->meshes[i];
-        mat4 model = transform_get_world(&m->transform);
+        darray_pop(internal_data->draw_list, null);
+    }
 
-        for(u32 j = 0; j < m->geometry_count; ++j)
+    if(mesh_data->culling_tree && mesh_data->items && mesh_data->mesh_models)
+    {
+        if(mesh_data->item_capacity != internal_data->item_capacity)
         {
-            geometry_render_data render_data;
-            render_data.geometry = m->geometries[j];
-            render_data.model = model;
+            draw_lists_clear(internal_data);
+            if(internal_data->item_entries)
+            {
+                kfree_tc(internal_data->item_entries, u32, internal_data->item_capacity, MEMORY_TAG_RENDERER);
+                kfree_tc(internal_data->item_stamps, u32, internal_data->item_capacity, MEMORY_TAG_RENDERER);
+            }
+            internal_data->item_capacity = mesh_data->item_capacity;
+            internal_data->item_entries = kallocate_tc(u32, internal_data->item_capacity, MEMORY_TAG_RENDERER);
+            internal_data->item_stamps = kallocate_tc(u32, internal_data->item_capacity, MEMORY_TAG_RENDERER);
+            kset_tc(internal_data->item_entries, u32, internal_data->item_capacity, 0xff);
+            internal_data->cull_stamp = 0;
+        }
+
+        const frustum* f = &cam->frustum;
+
+        bool generation_missed = mesh_data->generation != internal_data->list_generation
+                              && mesh_data->generation != internal_data->list_generation + 1;
 
-            // Добавление сеток без прозрачности.
-            if((m->geometries[j]->material->diffuse_map.texture->flags & TEXTURE_FLAG_HAS_TRANSPARENCY) == 0)
+        if(!internal_data->list_valid || generation_missed)
+        {
+            // Полное построение отсечением через иерархию ограничивающих объемов.
+            draw_lists_clear(internal_data);
+            draw_lists_build_visible(internal_data, mesh_data, f, out_packet->view_position, pixel_size_per_distance);
+        }
+        else
+        {
+            if(mesh_data->generation != internal_data->list_generation)
             {
-                darray_push(out_packet->geometries, render_data);
-                out_packet->geometry_count++;
+                draw_lists_patch(internal_data, mesh_data, f, out_packet->view_position, pixel_size_per_distance);
             }
-            // Добавление сеток с прозрачностью.
-            else
+
+            if(cam->generation != internal_data->list_camera_generation)
             {
-                vec3 center = vec3_transform(render_data.geometry->center, 1.0f, model);
-                f32 distance = vec3_distance(center, internal_data->world_camera->position);
+                // NOTE: При одном только повороте камеры уровни детализации и расстояния не изменяются.
+                bool position_changed = !vec3_compare(out_packet->view_position, internal_data->list_position, 0.0f);
+                draw_lists_update_visible(
+                    internal_data, mesh_data, f, out_packet->view_position, pixel_size_per_distance, position_changed
+                );
+            }
+        }
+
+        internal_data->list_camera_generation = cam->generation;
+        internal_data->list_generation = mesh_data->generation;
+        internal_data->list_position = out_packet->view_position;
+        internal_data->list_valid = true;
+    }
+    else
+    {
+        // Без объектов сцены списки строятся заново каждый кадр.
+        draw_lists_clear(internal_data);
 
-                geometry_distance gdist;
-                gdist.distance = kabs(distance);
-                gdist.g = render_data;
+        for(u32 i = 0; i < mesh_data->mesh_count; ++i)
+        {
+            mesh* m = &mesh_data->meshes[i];
+            mat4 model = transform_system_get_world(m->transform);
 
-                darray_push(geometry_distances, gdist);
+            for(u32 j = 0; j < m->geometry_count; ++j)
+            {
+                if(!m->geometries[j]) continue;
+                draw_entry_add(internal_data, INVALID_ID, m->geometries[j], &model, out_packet->view_position, pixel_size_per_distance);
             }
         }
     }
 
-    // Сортировка дистанций.
-    u32 geometry_count = darray_length(geometry_distances);
-    quick_sort(geometry_distances, 0, geometry_count - 1, false);
+    // Сортировка от дальних к ближним (только при изменении списка).
+    u32 transparent_count = darray_length(internal_data->transparent);
+    if(internal_data->transparent_dirty)
+    {
+        sort_buffers_reserve(internal_data, transparent_count);
+        for(u32 i = 0; i < transparent_count; ++i)
+        {
+            internal_data->sort_keys[i] = ~radix_sort_key_f32(internal_data->transparent[i].distance_squared);
+            internal_data->transparent_order[i] = i;
+        }
+        radix_sort(transparent_count, internal_data->sort_keys, internal_data->transparent_order, internal_data->sort_scratch);
+    }
+    internal_data->transparent_dirty = false;
 
-    for(u32 i = 0; i < geometry_count; ++i)
+    for(u32 i = 0; i < transparent_count; ++i)
     {
-        darray_push(out_packet->geometries, geometry_distances[i].g);
-        out_packet->geometry_count++;
+        darray_push(internal_data->draw_list, internal_data->transparent[internal_data->transparent_order[i]].g);
     }
 
-    darray_destroy(geometry_distances);
+    // NOTE: Список отрисовки принадлежит представлению и действителен до следующего построения пакета.
+    out_packet->geometries = internal_data->draw_list;
+    out_packet->geometry_count = darray_length(internal_data->draw_list);
 
     return true;
 }
@@ -302,7 +727,7 @@ bool render_view_world_on_render(render_view* self, const render_view_packet* pa
             }
 
             // Применение локальной позиции объекта.
-            material_system_apply_local(m, &packet->geometries[i].model);
+            material_system_apply_local(m, &packet->geometries[i].model, &packet->geometries[i].geometry->position_range);
 
             // Нарисовать!
             renderer_geometry_draw(&packet->geometries[i]);
@@ -8,6 +8,7 @@
 #include "renderer/vulkan/vulkan_command_buffer.h"
 #include "renderer/vulkan/vulkan_buffer.h"
 #include "renderer/vulkan/vulkan_image.h"
+#include "renderer/vulkan/vulkan_memory.h"
 #include "renderer/vulkan/vulkan_pipeline.h"
 
 // Внутренние подключения.
@@ -140,6 +141,19 @@ bool swapchain_recreate()
     return true;
 }
 
+void geometry_compaction_mark_dirty(vulkan_buffer* buffer)
+{
+    // NOTE: Раскладка буфера изменилась: следующий кадр заново оценит его фрагментацию.
+    if(buffer == &context->object_vertex_buffer)
+    {
+        context->geometry_compaction.vertex_dirty = true;
+    }
+    else if(buffer == &context->object_index_buffer)
+    {
+        context->geometry_compaction.index_dirty = true;
+    }
+}
+
 bool upload_data_range(VkCommandPool pool, VkFence fence, VkQueue queue, vulkan_buffer* buffer, u64* out_offset, u64 size, const void* data)
 {
     // Выделение памяти в буфере.
@@ -148,7 +162,8 @@ bool upload_data_range(VkCommandPool pool, VkFence fence, VkQueue queue, vulkan_
         kerror("Function '%s': Failed to allocate from the given buffer!", __FUNCTION__);
         return false;
     }
-    
+    geometry_compaction_mark_dirty(buffer);
+
     // Создание host-видимого промежуточный буфер для загрузки на устройство.
     VkBufferUsageFlags flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
     vulkan_buffer staging;
@@ -175,6 +190,287 @@ void free_data_range(vulkan_buffer* buffer, u64 offset, u64 size)
     }
 
     vulkan_buffer_free(buffer, size, offset);
+    geometry_compaction_mark_dirty(buffer);
+}
+
+void buffer_stats_get(vulkan_buffer* buffer, renderer_buffer_stats* out_stats)
+{
+    out_stats->total_size = buffer->total_size;
+    out_stats->free_size = vulkan_buffer_free_space(buffer);
+    out_stats->largest_free_block = vulkan_buffer_largest_free_block(buffer);
+    out_stats->fragmentation = out_stats->free_size
+                             ? 1.0f - (f32)out_stats->largest_free_block / (f32)out_stats->free_size : 0.0f;
+}
+
+void geometry_compaction_release(bool release_all)
+{
+    vulkan_geometry_compaction* compaction = &context->geometry_compaction;
+    u32 i = 0;
+
+    while(i < compaction->retired_count)
+    {
+        vulkan_retired_range* range = &compaction->retired[i];
+
+        // NOTE: Старые смещения могли использовать только кадры, отправленные до переноса, а кадр в полете
+        //       завершается не позже, чем через max_frames_in_flight отправок.
+        if(release_all || compaction->frame - range->frame >= context->swapchain.max_frames_in_flight)
+        {
+            free_data_range(range->buffer, range->offset, range->size);
+            compaction->retired[i] = compaction->retired[--compaction->retired_count];
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+u64 geometry_compaction_buffer(VkCommandBuffer command_buffer, vulkan_buffer* buffer, bool is_index, u64 budget)
+{
+    vulkan_geometry_compaction* compaction = &context->geometry_compaction;
+    bool* dirty = is_index ? &compaction->index_dirty : &compaction->vertex_dirty;
+
+    // NOTE: Без изменений раскладки буфера повторная проверка даст тот же результат.
+    if(!budget || !*dirty)
+    {
+        return 0;
+    }
+
+    renderer_buffer_stats stats;
+    buffer_stats_get(buffer, &stats);
+    if(stats.fragmentation < compaction->fragmentation_threshold)
+    {
+        *dirty = false;
+        return 0;
+    }
+
+    VkBufferCopy regions[VULKAN_GEOMETRY_COMPACTION_MAX_MOVES];
+    u32 region_count = 0;
+    u64 moved = 0;
+    u64 offset_limit = U64_MAX;
+
+    // Диапазоны перебираются от конца буфера к началу и переносятся в наиболее ранний подходящий свободный блок.
+    for(u32 attempt = 0; attempt < VULKAN_GEOMETRY_COMPACTION_MAX_ATTEMPTS; ++attempt)
+    {
+        if(region_count >= VULKAN_GEOMETRY_COMPACTION_MAX_MOVES || compaction->retired_count >= VULKAN_GEOMETRY_COMPACTION_MAX_RETIRED)
+        {
+            break;
+        }
+
+        vulkan_geometry_data* candidate = null;
+        u64 candidate_offset = 0;
+        u64 candidate_size = 0;
+
+        for(u32 i = 0; i < VULKAN_SHADER_MAX_GEOMETRY_COUNT; ++i)
+        {
+            vulkan_geometry_data* data = &context->geometries[i];
+            if(data->id == INVALID_ID)
+            {
+                continue;
+            }
+
+            u64 offset = is_index ? data->index_buffer_offset : data->vertex_buffer_offset;
+            u64 size = is_index ? (u64)data->index_count * data->index_element_size
+                                : (u64)data->vertex_count * data->vertex_element_size;
+
+            if(size && offset < offset_limit && (!candidate || offset > candidate_offset))
+            {
+                candidate = data;
+                candidate_offset = offset;
+                candidate_size = size;
+            }
+        }
+
+        if(!candidate)
+        {
+            break;
+        }
+
+        offset_limit = candidate_offset;
+
+        if(moved + candidate_size > budget || candidate_size > vulkan_buffer_largest_free_block(buffer))
+        {
+            continue;
+        }
+
+        u64 new_offset = 0;
+        if(!vulkan_buffer_allocate(buffer, candidate_size, &new_offset))
+        {
+            continue;
+        }
+
+        // Первый подходящий блок находится после диапазона: перенос не уменьшит фрагментацию.
+        if(new_offset > candidate_offset)
+        {
+            vulkan_buffer_free(buffer, candidate_size, new_offset);
+            continue;
+        }
+
+        regions[region_count].srcOffset = candidate_offset;
+        regions[region_count].dstOffset = new_offset;
+        regions[region_count].size = candidate_size;
+        region_count++;
+
+        // Новое смещение используется командами этого кадра, которые записываются после копирования.
+        if(is_index)
+        {
+            candidate->index_buffer_offset = new_offset;
+        }
+        else
+        {
+            candidate->vertex_buffer_offset = new_offset;
+        }
+
+        vulkan_retired_range* range = &compaction->retired[compaction->retired_count++];
+        range->buffer = buffer;
+        range->offset = candidate_offset;
+        range->size = candidate_size;
+        range->frame = compaction->frame;
+
+        moved += candidate_size;
+    }
+
+    if(region_count)
+    {
+        // Завершение переносов предыдущих кадров перед чтением и записью диапазонов.
+        VkMemoryBarrier barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(
+            command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, null, 0, null
+        );
+
+        vkCmdCopyBuffer(command_buffer, buffer->handle, buffer->handle, region_count, regions);
+        compaction->move_count += region_count;
+        compaction->moved_bytes += moved;
+        ktrace(
+            "Geometry compaction: %u %s range(s) moved (%llu bytes), fragmentation %.1f%%.",
+            region_count, is_index ? "index" : "vertex", moved, stats.fragmentation * 100.0f
+        );
+    }
+    else if(compaction->retired_count < VULKAN_GEOMETRY_COMPACTION_MAX_RETIRED)
+    {
+        // Переносить нечего до следующего изменения раскладки (загрузки, удаления или освобождения диапазона).
+        *dirty = false;
+    }
+
+    return moved;
+}
+
+void geometry_compaction_update(vulkan_command_buffer* command_buffer)
+{
+    vulkan_geometry_compaction* compaction = &context->geometry_compaction;
+
+    geometry_compaction_release(false);
+
+    if(!compaction->enabled)
+    {
+        return;
+    }
+
+    u64 moved = geometry_compaction_buffer(
+        command_buffer->handle, &context->object_vertex_buffer, false, compaction->bytes_per_frame
+    );
+    moved += geometry_compaction_buffer(
+        command_buffer->handle, &context->object_index_buffer, true, compaction->bytes_per_frame - moved
+    );
+
+    if(moved)
+    {
+        // Перенесенные данные должны быть записаны до чтения вершин и индексов.
+        VkMemoryBarrier barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        vkCmdPipelineBarrier(
+            command_buffer->handle, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &barrier,
+            0, null, 0, null
+        );
+    }
+}
+
+bool timestamp_pools_create()
+{
+    // NOTE: Замеры создаются всегда, пулы запросов только при поддержке временных меток.
+    context->timestamp_frame_count = context->swapchain.max_frames_in_flight;
+    context->timestamp_frames = kallocate_tc(vulkan_timestamp_frame, context->timestamp_frame_count, MEMORY_TAG_RENDERER);
+    kzero_tc(context->timestamp_frames, vulkan_timestamp_frame, context->timestamp_frame_count);
+
+    if(!context->device.timestamp_support)
+    {
+        kwarng("Vulkan renderer: Timestamp queries are not supported by graphics queue, GPU timings disabled.");
+        return true;
+    }
+
+    VkQueryPoolCreateInfo poolinfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+    poolinfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolinfo.queryCount = VULKAN_MAX_TIMESTAMP_SCOPES * 2;
+
+    for(u32 i = 0; i < context->timestamp_frame_count; ++i)
+    {
+        VkResult result = vkCreateQueryPool(context->device.logical, &poolinfo, context->allocator, &context->timestamp_frames[i].pool);
+        if(!vulkan_result_is_success(result))
+        {
+            kerror("Function '%s': Failed to create query pool with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void timestamp_pools_destroy()
+{
+    if(!context->timestamp_frames)
+    {
+        return;
+    }
+
+    for(u32 i = 0; i < context->timestamp_frame_count; ++i)
+    {
+        if(context->timestamp_frames[i].pool)
+        {
+            vkDestroyQueryPool(context->device.logical, context->timestamp_frames[i].pool, context->allocator);
+        }
+    }
+
+    kfree_tc(context->timestamp_frames, vulkan_timestamp_frame, context->timestamp_frame_count, MEMORY_TAG_RENDERER);
+    context->timestamp_frames = null;
+    context->timestamp_frame_count = 0;
+    context->gpu_timing_count = 0;
+}
+
+void timestamp_frame_resolve(vulkan_timestamp_frame* frame)
+{
+    if(!frame->pool || !frame->is_pending)
+    {
+        return;
+    }
+
+    frame->is_pending = false;
+
+    // NOTE: Ожидание не требуется, кадр завершен (fence кадра уже дождались).
+    u64 timestamps[VULKAN_MAX_TIMESTAMP_SCOPES * 2];
+    VkResult result = vkGetQueryPoolResults(
+        context->device.logical, frame->pool, 0, frame->scope_count * 2, sizeof(timestamps), timestamps, sizeof(u64),
+        VK_QUERY_RESULT_64_BIT
+    );
+    if(result != VK_SUCCESS)
+    {
+        return;
+    }
+
+    u32 valid_bits = context->device.timestamp_valid_bits;
+    u64 mask = valid_bits >= 64 ? U64_MAX : (1ULL << valid_bits) - 1;
+    f64 period_ms = context->device.properties.limits.timestampPeriod / 1000000.0;
+
+    for(u32 i = 0; i < frame->scope_count; ++i)
+    {
+        u64 ticks = (timestamps[i * 2 + 1] - timestamps[i * 2]) & mask;
+        context->gpu_timings[i].name = frame->names[i];
+        context->gpu_timings[i].depth = frame->depths[i];
+        context->gpu_timings[i].milliseconds = ticks * period_ms;
+    }
+    context->gpu_timing_count = frame->scope_count;
 }
 
 bool shader_status_valid(shader* shader, const char* func_name)
@@ -219,6 +515,98 @@ bool shader_create_module(vulkan_shader* shader, vulkan_shader_stage_config conf
     return true;
 }
 
+bool shader_bindless_initialize(shader* s)
+{
+    vulkan_shader* vk_shader = s->internal_data;
+
+    // Выделение единого блока данных всех экземпляров, доступного шейдеру как буфер хранения.
+    u64 instance_block_size = s->ubo_stride * VULKAN_SHADER_MAX_MATERIAL_COUNT;
+    if(!vulkan_buffer_allocate(&vk_shader->uniform_buffer, instance_block_size, &vk_shader->bindless_instance_offset))
+    {
+        kerror("Function '%s': Failed to allocate space for the instance storage buffer.", __FUNCTION__);
+        return false;
+    }
+
+    // Выделение наборов дескрипторов экземпляров на кадр (общие для всех экземпляров).
+    VkDescriptorSetLayout layouts[5] = { // TODO: image_count == 5!
+        vk_shader->descriptor_set_layouts[DESC_SET_INDEX_INSTANCE],
+        vk_shader->descriptor_set_layouts[DESC_SET_INDEX_INSTANCE],
+        vk_shader->descriptor_set_layouts[DESC_SET_INDEX_INSTANCE],
+        vk_shader->descriptor_set_layouts[DESC_SET_INDEX_INSTANCE],
+        vk_shader->descriptor_set_layouts[DESC_SET_INDEX_INSTANCE]
+    };
+
+    VkDescriptorSetAllocateInfo allocate_info = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocate_info.descriptorPool = vk_shader->descriptor_pool;
+    allocate_info.descriptorSetCount = 5; // TODO: image_count == 5!
+    allocate_info.pSetLayouts = layouts;
+
+    VkResult result = vkAllocateDescriptorSets(context->device.logical, &allocate_info, vk_shader->bindless_descriptor_sets);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror(
+            "Function '%s': Failed to allocate bindless descriptor sets: '%s'",
+            __FUNCTION__, vulkan_result_get_string(result, true)
+        );
+        return false;
+    }
+
+    // Буфер хранения не меняется, поэтому записывается один раз.
+    VkDescriptorBufferInfo buffer_info;
+    buffer_info.buffer = vk_shader->uniform_buffer.handle;
+    buffer_info.offset = vk_shader->bindless_instance_offset;
+    buffer_info.range  = instance_block_size;
+
+    VkWriteDescriptorSet descriptor_writes[5]; // TODO: image_count == 5!
+    for(u32 i = 0; i < 5; ++i)
+    {
+        VkWriteDescriptorSet storage_write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+        storage_write.dstSet = vk_shader->bindless_descriptor_sets[i];
+        storage_write.dstBinding = BINDING_INDEX_UBO;
+        storage_write.dstArrayElement = 0;
+        storage_write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        storage_write.descriptorCount = 1;
+        storage_write.pBufferInfo = &buffer_info;
+        descriptor_writes[i] = storage_write;
+    }
+
+    vkUpdateDescriptorSets(context->device.logical, 5, descriptor_writes, 0, null);
+    return true;
+}
+
+void shader_bindless_update_textures(shader* s, u32 instance_id)
+{
+    if(s->instance_texture_count == 0)
+    {
+        return;
+    }
+
+    vulkan_shader* vk_shader = s->internal_data;
+    vulkan_shader_instance_state* instance_state = &vk_shader->instance_states[instance_id];
+    VkDescriptorImageInfo image_infos[VULKAN_SHADER_MAX_INSTANCE_TEXTURES];
+
+    for(u32 i = 0; i < s->instance_texture_count; ++i)
+    {
+        texture_map* map = instance_state->instance_texture_maps[i];
+        vulkan_image* image = map->texture->internal_data;
+
+        image_infos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        image_infos[i].imageView = image->view;
+        image_infos[i].sampler = map->internal_data;
+    }
+
+    // NOTE: Набор текущего кадра уже может быть привязан, это допустимо благодаря UPDATE_AFTER_BIND.
+    VkWriteDescriptorSet sampler_write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    sampler_write.dstSet = vk_shader->bindless_descriptor_sets[context->image_index];
+    sampler_write.dstBinding = BINDING_INDEX_SAMPLER;
+    sampler_write.dstArrayElement = instance_id * s->instance_texture_count;
+    sampler_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    sampler_write.descriptorCount = s->instance_texture_count;
+    sampler_write.pImageInfo = image_infos;
+
+    vkUpdateDescriptorSets(context->device.logical, 1, &sampler_write, 0, null);
+}
+
 VkSamplerAddressMode convert_repeat_type(const char* axis, texture_repeat repeat)
 {
     switch(repeat)
@@ -479,6 +867,14 @@ bool vulkan_renderer_backend_initialize(renderer_backend* backend, const rendere
     }
     ktrace("Vulkan device created.");
 
+    // Создание распределителя памяти устройства.
+    if(!vulkan_memory_allocator_create(context))
+    {
+        kerror("Failed to create vulkan memory allocator.");
+        return false;
+    }
+    ktrace("Vulkan memory allocator created.");
+
     // Создание цепочки обмена.
     vulkan_swapchain_create(context, context->framebuffer_width, context->framebuffer_height, &context->swapchain);
     ktrace("Vulkan swapchain created.");
@@ -540,6 +936,10 @@ bool vulkan_renderer_backend_initialize(renderer_backend* backend, const rendere
             &context->registered_passes[id], 1.0f, 0, config->pass_configs[i].prev_name != 0, config->pass_configs[i].next_name != 0
         );
 
+        // Имя используется для замеров времени прохода.
+        vulkan_renderpass* vk_renderpass = context->registered_passes[id].internal_data;
+        vk_renderpass->name = string_duplicate(config->pass_configs[i].name);
+
         // Обновление хэш-таблицы.
         hashtable_set(context->renderpass_table, config->pass_configs[i].name, &id, true);
     }
@@ -583,6 +983,13 @@ bool vulkan_renderer_backend_initialize(renderer_backend* backend, const rendere
     kzero_tc(context->images_in_flight, VkFence, context->swapchain.image_count);
     ktrace("Vulkan sync objects created.");
 
+    // Создание пулов запросов временных меток.
+    if(!timestamp_pools_create())
+    {
+        return false;
+    }
+    ktrace("Vulkan timestamp query pools created.");
+
     // Создание буферов данных в локальной памяти устройства (видеокарте).
     VkMemoryPropertyFlagBits memory_property_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
     VkBufferUsageFlagBits vertex_usage_flags = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
@@ -609,6 +1016,31 @@ bool vulkan_renderer_backend_initialize(renderer_backend* backend, const rendere
     {
         context->geometries[i].id = INVALID_ID;
     }
+
+    // Пул слотов геометрий.
+    context->geometry_handles_memory_requirement = 0;
+    handle_pool_create(VULKAN_SHADER_MAX_GEOMETRY_COUNT, &context->geometry_handles_memory_requirement, null);
+    context->geometry_handles_memory = kallocate(context->geometry_handles_memory_requirement, MEMORY_TAG_RENDERER);
+    context->geometry_handles = handle_pool_create(
+        VULKAN_SHADER_MAX_GEOMETRY_COUNT, &context->geometry_handles_memory_requirement, context->geometry_handles_memory
+    );
+    if(!context->geometry_handles)
+    {
+        kerror("Function '%s': Failed to create geometry handle pool.", __FUNCTION__);
+        return false;
+    }
+
+    // Дефрагментация буферов геометрий.
+    context->geometry_compaction.enabled = config->geometry_compaction;
+    context->geometry_compaction.fragmentation_threshold = config->geometry_compaction_threshold;
+    context->geometry_compaction.bytes_per_frame = config->geometry_compaction_bytes_per_frame;
+    if(context->geometry_compaction.enabled)
+    {
+        ktrace(
+            "Vulkan geometry compaction enabled (threshold %.0f%%, %llu bytes per frame).",
+            context->geometry_compaction.fragmentation_threshold * 100.0f, context->geometry_compaction.bytes_per_frame
+        );
+    }
     ktrace("Vulkan buffers created.");
 
     return true;
@@ -621,10 +1053,23 @@ void vulkan_renderer_backend_shutdown(renderer_backend* backend)
     vkDeviceWaitIdle(context->device.logical);
 
     // Уничтожение буферов данных.
+    geometry_compaction_release(true);
     vulkan_buffer_destroy(context, &context->object_vertex_buffer);
     vulkan_buffer_destroy(context, &context->object_index_buffer);
     ktrace("Vulkan buffers destroyed.");
 
+    if(context->geometry_handles)
+    {
+        handle_pool_destroy(context->geometry_handles);
+        kfree(context->geometry_handles_memory, context->geometry_handles_memory_requirement, MEMORY_TAG_RENDERER);
+        context->geometry_handles = null;
+        context->geometry_handles_memory = null;
+    }
+
+    // Уничтожение пулов запросов временных меток.
+    timestamp_pools_destroy();
+    ktrace("Vulkan timestamp query pools destroyed.");
+
     // Уничтожение объектов сингхронизации.
     for(u8 i = 0; i < context->swapchain.max_frames_in_flight; ++i)
     {
@@ -683,6 +1128,10 @@ void vulkan_renderer_backend_shutdown(renderer_backend* backend)
     vulkan_swapchain_destroy(context, &context->swapchain);
     ktrace("Vulkan swapchain destroyed.");
 
+    // Уничтожение распределителя памяти устройства.
+    vulkan_memory_allocator_destroy(context);
+    ktrace("Vulkan memory allocator destroyed.");
+
     // Уничтожение физического и логического устройства.
     vulkan_device_destroy(backend, context);
     ktrace("Vulkan device destroyed.");
@@ -781,6 +1230,10 @@ bool vulkan_renderer_backend_frame_begin(f32 delta_time)
         return false;
     }
 
+    // Кадр завершен, чтение его замеров времени без остановки конвейера.
+    vulkan_timestamp_frame* timestamp_frame = &context->timestamp_frames[context->current_frame];
+    timestamp_frame_resolve(timestamp_frame);
+
     // Получить следующее изображение из цепочки обмена. Передать семафор, который должен сигнализировать о завершении.
     // Этот же семафор позже будет ожидаться отправкой очереди, чтобы гарантировать доступность этого изображения.
     if(!vulkan_swapchain_acquire_next_image_index(
@@ -797,6 +1250,9 @@ bool vulkan_renderer_backend_frame_begin(f32 delta_time)
     vulkan_command_buffer_reset(command_buffer);
     vulkan_command_buffer_begin(command_buffer, false, false, false);
 
+    // Постепенная дефрагментация буферов геометрий (до записи команд отрисовки).
+    geometry_compaction_update(command_buffer);
+
     // Область просмотра.
     VkViewport viewport = {0};
     viewport.x = 0.0f;
@@ -815,6 +1271,17 @@ bool vulkan_renderer_backend_frame_begin(f32 delta_time)
     vkCmdSetViewport(command_buffer->handle, 0, 1, &viewport);
     vkCmdSetScissor(command_buffer->handle, 0, 1, &scissor);
 
+    // Начало замеров времени кадра.
+    if(timestamp_frame->pool)
+    {
+        vkCmdResetQueryPool(command_buffer->handle, timestamp_frame->pool, 0, VULKAN_MAX_TIMESTAMP_SCOPES * 2);
+        timestamp_frame->scope_count = 0;
+        context->timestamp_stack_depth = 0;
+        context->timestamp_skipped_depth = 0;
+        context->timestamp_recording = true;
+        vulkan_renderer_gpu_scope_begin("Frame");
+    }
+
     return true;
 }
 
@@ -823,6 +1290,15 @@ bool vulkan_renderer_backend_frame_end(f32 delta_time)
     VkResult result = VK_ERROR_UNKNOWN;
     vulkan_command_buffer* command_buffer = &context->graphics_command_buffers[context->image_index];
 
+    // Завершение замеров времени кадра (закрытие всех открытых областей).
+    vulkan_timestamp_frame* timestamp_frame = &context->timestamp_frames[context->current_frame];
+    context->timestamp_skipped_depth = 0;
+    while(context->timestamp_stack_depth > 0)
+    {
+        vulkan_renderer_gpu_scope_end();
+    }
+    context->timestamp_recording = false;
+
     // Конец записи команд.
     vulkan_command_buffer_end(command_buffer);
 
@@ -870,6 +1346,8 @@ bool vulkan_renderer_backend_frame_end(f32 delta_time)
     }
 
     vulkan_command_buffer_update_submitted(command_buffer);
+    timestamp_frame->is_pending = timestamp_frame->scope_count > 0;
+    context->geometry_compaction.frame++;
 
     // Возвращаем изображение в цепочку обмена.
     vulkan_swapchain_present(
@@ -883,6 +1361,7 @@ void vulkan_renderer_renderpass_create(renderpass* out_renderpass, f32 depth, u3
 {
     vulkan_renderpass* vk_renderpass = kallocate_tc(vulkan_renderpass, 1, MEMORY_TAG_RENDERER);
     out_renderpass->internal_data = vk_renderpass;
+    vk_renderpass->name = null;
     vk_renderpass->depth = depth;
     vk_renderpass->stencil = stencil;
     vk_renderpass->has_prev_pass = has_prev_pass;
@@ -997,6 +1476,12 @@ void vulkan_renderer_renderpass_destroy(renderpass* pass)
     vkDestroyRenderPass(context->device.logical, vk_renderpass->handle, context->allocator);
     vk_renderpass->handle = null;
 
+    if(vk_renderpass->name)
+    {
+        string_free(vk_renderpass->name);
+        vk_renderpass->name = null;
+    }
+
     kfree_tc(vk_renderpass, vulkan_renderpass, 1, MEMORY_TAG_RENDERER);
     pass->internal_data = null;
 }
@@ -1036,6 +1521,7 @@ bool vulkan_renderer_renderpass_begin(renderpass* pass, render_target* target)
 
     begininfo.pClearValues = begininfo.clearValueCount > 0 ? clear_values : null;
 
+    vulkan_renderer_gpu_scope_begin(vk_renderpass->name ? vk_renderpass->name : "Renderpass");
     vkCmdBeginRenderPass(command_buffer->handle, &begininfo, VK_SUBPASS_CONTENTS_INLINE);
     command_buffer->state = VULKAN_COMMAND_BUFFER_STATE_IN_RENDERPASS;
     return true;
@@ -1046,6 +1532,7 @@ bool vulkan_renderer_renderpass_end(renderpass* pass)
     vulkan_command_buffer* command_buffer = &context->graphics_command_buffers[context->image_index];
     vkCmdEndRenderPass(command_buffer->handle);
     command_buffer->state = VULKAN_COMMAND_BUFFER_STATE_RECORDING;
+    vulkan_renderer_gpu_scope_end();
     return true;
 }
 
@@ -1234,6 +1721,23 @@ void vulkan_renderer_texture_map_release_resources(texture_map* map)
     map->internal_data = null;
 }
 
+// @brief Освобождает слот геометрии в пуле и отмечает геометрию как незагруженную.
+static void geometry_slot_release(geometry* geometry)
+{
+    vulkan_geometry_data* internal_data = &context->geometries[geometry->internal_id];
+    kzero_tc(internal_data, vulkan_geometry_data, 1);
+    internal_data->id = INVALID_ID;
+    internal_data->generation = INVALID_ID;
+
+    khandle handle;
+    if(handle_pool_handle_get(context->geometry_handles, geometry->internal_id, &handle))
+    {
+        handle_pool_release(context->geometry_handles, handle);
+    }
+
+    geometry->internal_id = INVALID_ID;
+}
+
 bool vulkan_renderer_geometry_create(
     geometry* geometry, u32 vertex_size, u32 vertex_count, const void* vertices, u32 index_size, u32 index_count,
     const void* indices
@@ -1261,26 +1765,19 @@ bool vulkan_renderer_geometry_create(
     }
     else
     {
-        for(u32 i = 0; i < VULKAN_SHADER_MAX_GEOMETRY_COUNT; ++i)
+        khandle handle;
+        if(!handle_pool_acquire(context->geometry_handles, &handle))
         {
-            if(context->geometries[i].id == INVALID_ID)
-            {
-                // Поиск свободного индекса.
-                geometry->internal_id = i;
-                context->geometries[i].id = i;
-                internal_data = &context->geometries[i];
-                break;
-            }
+            kerror(
+                "Function '%s': Failed to find a free index for a new geometry upload. Adjust config to allow for more.",
+                __FUNCTION__
+            );
+            return false;
         }
-    }
 
-    if(!internal_data)
-    {
-        kerror(
-            "Function '%s': Failed to find a free index for a new geometry upload. Adjust config to allow for more.",
-            __FUNCTION__
-        );
-        return false;
+        geometry->internal_id = handle.index;
+        context->geometries[handle.index].id = handle.index;
+        internal_data = &context->geometries[handle.index];
     }
 
     VkCommandPool pool = context->device.graphics_queue.command_pool;
@@ -1297,6 +1794,10 @@ bool vulkan_renderer_geometry_create(
     ))
     {
         kerror("Function '%s': Failed to upload to the vertex buffer.", __FUNCTION__);
+        if(!is_reupload)
+        {
+            geometry_slot_release(geometry);
+        }
         return false;
     }
 
@@ -1312,6 +1813,11 @@ bool vulkan_renderer_geometry_create(
         ))
         {
             kerror("Function '%s': Failed to upload to the index buffer.", __FUNCTION__);
+            if(!is_reupload)
+            {
+                free_data_range(&context->object_vertex_buffer, internal_data->vertex_buffer_offset, vertex_count * vertex_size);
+                geometry_slot_release(geometry);
+            }
             return false;
         }
     }
@@ -1364,9 +1870,7 @@ void vulkan_renderer_geometry_destroy(geometry* geometry)
     }
 
     // Освобождение диапазона для нового использования.
-    kzero_tc(internal_data, vulkan_geometry_data, 1);
-    internal_data->id = INVALID_ID;
-    internal_data->generation = INVALID_ID;
+    geometry_slot_release(geometry);
 }
 
 void vulkan_renderer_geometry_draw(geometry_render_data* data)
@@ -1386,6 +1890,15 @@ void vulkan_renderer_geometry_draw(geometry_render_data* data)
 
     if(buffer_data->index_count > 0)
     {
+        // Диапазон индексов выбранного уровня детализации.
+        u32 first_index = 0;
+        u32 index_count = buffer_data->index_count;
+        if(data->lod < data->geometry->lod_count)
+        {
+            first_index = data->geometry->lods[data->lod].index_offset;
+            index_count = data->geometry->lods[data->lod].index_count;
+        }
+
         // Привязка буфера индексов.
         vkCmdBindIndexBuffer(
             command_buffer->handle, context->object_index_buffer.handle, buffer_data->index_buffer_offset,
@@ -1393,7 +1906,7 @@ void vulkan_renderer_geometry_draw(geometry_render_data* data)
         );
         // Рисовать.
         // TODO: VUID-vkCmdDrawIndexed-None-08114
-        vkCmdDrawIndexed(command_buffer->handle, buffer_data->index_count, 1, 0, 0, 0);
+        vkCmdDrawIndexed(command_buffer->handle, index_count, 1, first_index, 0, 0);
     }
     else
     {
@@ -1479,10 +1992,28 @@ bool vulkan_renderer_shader_create(struct shader* s, renderpass* pass, u8 stage_
         vk_shader->config.stage_count++;
     }
 
+    // Режим bindless требует индексирования дескрипторов и использования экземпляров.
+    if(s->use_bindless)
+    {
+        if(!context->device.descriptor_indexing_support)
+        {
+            kerror("Function '%s': Shader '%s' requires bindless mode, but device does not support it.", __FUNCTION__, s->name);
+            return false;
+        }
+
+        if(!s->use_instances)
+        {
+            kerror("Function '%s': Shader '%s' uses bindless mode without instances.", __FUNCTION__, s->name);
+            return false;
+        }
+    }
+
     // HACK: Максимальное число ubo дескрипторных наборов.
     vk_shader->config.pool_sizes[0] = (VkDescriptorPoolSize){VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1024};
     // HACK: Максимальное число image sampler дескрипторных наборов.
     vk_shader->config.pool_sizes[1] = (VkDescriptorPoolSize){VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4096};
+    // Буферы хранения используются только в режиме bindless (по одному на кадр).
+    vk_shader->config.pool_sizes[2] = (VkDescriptorPoolSize){VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5}; // TODO: image_count == 5!
 
     // Глобальный набор дескрипторов (UBO).
     vulkan_descriptor_set_config* global_descriptor_set_config = &vk_shader->config.descriptor_sets[DESC_SET_INDEX_GLOBAL];
@@ -1496,10 +2027,11 @@ bool vulkan_renderer_shader_create(struct shader* s, renderpass* pass, u8 stage_
     // При изпользовании экземпляров, добавляется второй набор дескрипторов (UBO).
     if(s->use_instances)
     {
+        // NOTE: В режиме bindless данные всех экземпляров доступны шейдеру как единый буфер хранения.
         vulkan_descriptor_set_config* instance_descriptor_set_config = &vk_shader->config.descriptor_sets[DESC_SET_INDEX_INSTANCE];
         instance_descriptor_set_config->bindings[BINDING_INDEX_UBO].binding = BINDING_INDEX_UBO;
         instance_descriptor_set_config->bindings[BINDING_INDEX_UBO].descriptorCount = 1;
-        instance_descriptor_set_config->bindings[BINDING_INDEX_UBO].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        instance_descriptor_set_config->bindings[BINDING_INDEX_UBO].descriptorType = s->use_bindless ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
         instance_descriptor_set_config->bindings[BINDING_INDEX_UBO].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
         instance_descriptor_set_config->binding_count++;
         vk_shader->config.descriptor_set_count++;
@@ -1575,7 +2107,7 @@ bool vulkan_renderer_shader_initialize(shader* shader)
     }
 
     // Статическая таблица для трансляции определений движка -> Vulkan.
-    static const VkFormat attribute_types[11] = {
+    static const VkFormat attribute_types[15] = {
         [SHADER_ATTRIB_TYPE_FLOAT32]   = VK_FORMAT_R32_SFLOAT,
         [SHADER_ATTRIB_TYPE_FLOAT32_2] = VK_FORMAT_R32G32_SFLOAT,
         [SHADER_ATTRIB_TYPE_FLOAT32_3] = VK_FORMAT_R32G32B32_SFLOAT,
@@ -1585,7 +2117,11 @@ bool vulkan_renderer_shader_initialize(shader* shader)
         [SHADER_ATTRIB_TYPE_INT16]     = VK_FORMAT_R16_SINT,
         [SHADER_ATTRIB_TYPE_UINT16]    = VK_FORMAT_R16_UINT,
         [SHADER_ATTRIB_TYPE_INT32]     = VK_FORMAT_R32_SINT,
-        [SHADER_ATTRIB_TYPE_UINT32]    = VK_FORMAT_R32_UINT
+        [SHADER_ATTRIB_TYPE_UINT32]    = VK_FORMAT_R32_UINT,
+        [SHADER_ATTRIB_TYPE_FLOAT16_2] = VK_FORMAT_R16G16_SFLOAT,
+        [SHADER_ATTRIB_TYPE_UNORM8_4]  = VK_FORMAT_R8G8B8A8_UNORM,
+        [SHADER_ATTRIB_TYPE_UNORM16_4] = VK_FORMAT_R16G16B16A16_UNORM,
+        [SHADER_ATTRIB_TYPE_SNORM16_4] = VK_FORMAT_R16G16B16A16_SNORM
     };
 
     // Получение атрибутов.
@@ -1628,12 +2164,47 @@ bool vulkan_renderer_shader_initialize(shader* shader)
         }
     }
 
+    // В режиме bindless текстуры всех экземпляров собираются в один большой массив, где текстуры экземпляра
+    // занимают последовательные элементы: instance_id * instance_texture_count + location.
+    if(shader->use_bindless)
+    {
+        vk_shader->bindless_texture_count = shader->instance_texture_count * VULKAN_SHADER_MAX_MATERIAL_COUNT;
+
+        if(vk_shader->bindless_texture_count > 0)
+        {
+            VkPhysicalDeviceVulkan12Properties properties12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES };
+            VkPhysicalDeviceProperties2 properties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+            properties.pNext = &properties12;
+            vkGetPhysicalDeviceProperties2(context->device.physical, &properties);
+            u32 max_textures = properties12.maxPerStageDescriptorUpdateAfterBindSamplers;
+
+            if(vk_shader->bindless_texture_count > max_textures)
+            {
+                kerror(
+                    "Function '%s': Shader '%s' requires %u bindless textures, but device supports only %u.",
+                    __FUNCTION__, shader->name, vk_shader->bindless_texture_count, max_textures
+                );
+                return false;
+            }
+
+            vulkan_descriptor_set_config* set_config = &vk_shader->config.descriptor_sets[DESC_SET_INDEX_INSTANCE];
+            set_config->bindings[BINDING_INDEX_SAMPLER].descriptorCount = vk_shader->bindless_texture_count;
+            set_config->bindings[BINDING_INDEX_SAMPLER].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+            // TODO: image_count == 5!
+            vk_shader->config.pool_sizes[1].descriptorCount += vk_shader->bindless_texture_count * 5;
+        }
+    }
+
     // Пул дескрипторов.
     VkDescriptorPoolCreateInfo pool_info = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
-    pool_info.poolSizeCount = 2;
+    pool_info.poolSizeCount = shader->use_bindless ? 3 : 2;
     pool_info.pPoolSizes = vk_shader->config.pool_sizes;
     pool_info.maxSets = vk_shader->config.max_descriptor_set_count;
     pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    if(shader->use_bindless)
+    {
+        pool_info.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    }
 
     // Создание пула дескрипторов.
     VkResult result = vkCreateDescriptorPool(logical, &pool_info, vk_allocator, &vk_shader->descriptor_pool);
@@ -1649,6 +2220,23 @@ bool vulkan_renderer_shader_initialize(shader* shader)
         VkDescriptorSetLayoutCreateInfo layout_info = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
         layout_info.bindingCount = vk_shader->config.descriptor_sets[i].binding_count;
         layout_info.pBindings = vk_shader->config.descriptor_sets[i].bindings;
+
+        // Массив текстур режима bindless заполняется частично и обновляется после привязки набора.
+        VkDescriptorBindingFlags binding_flags[VULKAN_SHADER_MAX_BINDINGS] = {0};
+        binding_flags[BINDING_INDEX_SAMPLER] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+                                             | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+        VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info = {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO
+        };
+        binding_flags_info.bindingCount = layout_info.bindingCount;
+        binding_flags_info.pBindingFlags = binding_flags;
+
+        if(shader->use_bindless && i == DESC_SET_INDEX_INSTANCE && layout_info.bindingCount > 1)
+        {
+            layout_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+            layout_info.pNext = &binding_flags_info;
+        }
+
         result = vkCreateDescriptorSetLayout(logical, &layout_info, vk_allocator, &vk_shader->descriptor_set_layouts[i]);
         if(!vulkan_result_is_success(result))
         {
@@ -1703,13 +2291,24 @@ bool vulkan_renderer_shader_initialize(shader* shader)
     // Получение требуемых величин выравнивания.
     shader->global_ubo_stride = get_aligned(shader->global_ubo_size, shader->required_ubo_alignment);
     shader->ubo_stride = get_aligned(shader->ubo_size, shader->required_ubo_alignment);
+    VkBufferUsageFlags buffer_usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+
+    if(shader->use_bindless)
+    {
+        // Данные экземпляров читаются шейдером как массив структур std430, шаг которых кратен 16 байтам.
+        // NOTE: Структура экземпляра в шейдере должна быть дополнена до размера кратного 16 байтам!
+        u64 storage_alignment = context->device.properties.limits.minStorageBufferOffsetAlignment;
+        shader->global_ubo_stride = get_aligned(shader->global_ubo_size, KMAX(shader->required_ubo_alignment, storage_alignment));
+        shader->ubo_stride = get_aligned(shader->ubo_size, 16);
+        buffer_usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
 
     // Создание uniform буфера.
     u32 device_local_bit = context->device.memory_local_host_visible_support ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT : 0;
     // TODO: Максимальное количество должно быть настраиваемым или должна быть долгосрочная поддержка изменения размера буфера.
     u64 total_buffer_size = shader->global_ubo_stride + (shader->ubo_stride * VULKAN_SHADER_MAX_MATERIAL_COUNT);
     if(!vulkan_buffer_create(
-        context, total_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 
+        context, total_buffer_size, buffer_usage, 
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | device_local_bit, 
         true, &vk_shader->uniform_buffer
     ))
@@ -1743,6 +2342,12 @@ bool vulkan_renderer_shader_initialize(shader* shader)
     allocate_info.pSetLayouts = global_layouts;
     VK_CHECK(vkAllocateDescriptorSets(logical, &allocate_info, vk_shader->global_descriptor_sets));
 
+    if(shader->use_bindless && !shader_bindless_initialize(shader))
+    {
+        kerror("Function '%s': Failed to initialize bindless resources for shader '%s'.", __FUNCTION__, shader->name);
+        return false;
+    }
+
     return true;
 }
 
@@ -1821,6 +2426,15 @@ bool vulkan_renderer_shader_apply_globals(shader* shader)
         command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_shader->pipeline.layout, 0, 1, &global_descriptor, 0, null
     );
 
+    // В режиме bindless набор экземпляров общий, поэтому привязывается один раз вместе с глобальным.
+    if(shader->use_bindless)
+    {
+        VkDescriptorSet bindless_descriptor = vk_shader->bindless_descriptor_sets[image_index];
+        vkCmdBindDescriptorSets(
+            command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_shader->pipeline.layout, 1, 1, &bindless_descriptor, 0, null
+        );
+    }
+
     return true;
 }
 
@@ -1838,6 +2452,16 @@ bool vulkan_renderer_shader_apply_instance(struct shader* shader, bool needs_upd
     vulkan_shader* vk_shader = shader->internal_data;
     VkCommandBuffer command_buffer = context->graphics_command_buffers[image_index].handle;
 
+    // В режиме bindless достаточно обновить текстуры экземпляра в общем массиве, без привязки наборов.
+    if(shader->use_bindless)
+    {
+        if(needs_update)
+        {
+            shader_bindless_update_textures(shader, shader->bound_instance_id);
+        }
+        return true;
+    }
+
     // Получение данных экземпляра.
     vulkan_shader_instance_state* object_state = &vk_shader->instance_states[shader->bound_instance_id];
     VkDescriptorSet object_descriptor_set = object_state->descriptor_set_state.descriptor_sets[image_index];
@@ -1951,7 +2575,7 @@ bool vulkan_renderer_shader_acquire_instance_resources(shader* s, texture_map**
     }
 
     vulkan_shader_instance_state* instance_state = &vk_shader->instance_states[*out_instance_id];
-    u32 instance_texture_count = vk_shader->config.descriptor_sets[DESC_SET_INDEX_INSTANCE].bindings[BINDING_INDEX_SAMPLER].descriptorCount;
+    u32 instance_texture_count = s->instance_texture_count;
     instance_state->instance_texture_maps = kallocate_tc(texture_map*, s->instance_texture_count, MEMORY_TAG_ARRAY);
     kcopy_tc(instance_state->instance_texture_maps, maps, texture_map*, s->instance_texture_count);
 
@@ -1965,6 +2589,13 @@ bool vulkan_renderer_shader_acquire_instance_resources(shader* s, texture_map**
         }
     }
 
+    // В режиме bindless место экземпляра в блоке данных и в массиве текстур определяется его идентификатором.
+    if(s->use_bindless)
+    {
+        instance_state->offset = vk_shader->bindless_instance_offset + s->ubo_stride * (*out_instance_id);
+        return true;
+    }
+
     // Выделение места в UBO по шагу, а не по размеру.
     u64 size = s->ubo_stride;
     if(!vulkan_buffer_allocate(&vk_shader->uniform_buffer, size, &instance_state->offset))
@@ -2028,6 +2659,20 @@ bool vulkan_renderer_shader_release_instance_resources(shader* shader, u32 insta
     // Ожидание завершения всех операций, использующих набор дескрипторов.
     vkDeviceWaitIdle(context->device.logical);
 
+    // В режиме bindless наборы дескрипторов и блок данных общие, освобождается только слот экземпляра.
+    if(shader->use_bindless)
+    {
+        if(instance_state->instance_texture_maps)
+        {
+            kfree_tc(instance_state->instance_texture_maps, texture_map*, shader->instance_texture_count, MEMORY_TAG_ARRAY);
+            instance_state->instance_texture_maps = null;
+        }
+
+        instance_state->offset = INVALID_ID;
+        instance_state->id = INVALID_ID;
+        return true;
+    }
+
     // Освобождение 5 набора дескрипторов (по одному на кадр).
     VkResult result = vkFreeDescriptorSets(
         context->device.logical, vk_shader->descriptor_pool, 5, instance_state->descriptor_set_state.descriptor_sets
@@ -2162,3 +2807,89 @@ u8 vulkan_renderer_window_attachment_index_get()
 {
     return (u8)context->image_index;
 }
+
+bool vulkan_renderer_is_bindless_supported()
+{
+    return context->device.descriptor_indexing_support;
+}
+
+void vulkan_renderer_gpu_scope_begin(const char* name)
+{
+    if(!context->timestamp_recording)
+    {
+        return;
+    }
+
+    // NOTE: При переполнении стека область пропускается целиком, а ее завершение снимает счетчик
+    //       пропущенных областей вместо записи стека, чтобы не нарушить вложенность.
+    if(context->timestamp_stack_depth >= VULKAN_MAX_TIMESTAMP_SCOPES)
+    {
+        context->timestamp_skipped_depth++;
+        return;
+    }
+
+    // NOTE: При переполнении пула область не записывается, но стек сохраняет парность вызовов.
+    vulkan_timestamp_frame* frame = &context->timestamp_frames[context->current_frame];
+    u32 scope_index = INVALID_ID;
+
+    if(frame->scope_count < VULKAN_MAX_TIMESTAMP_SCOPES)
+    {
+        scope_index = frame->scope_count++;
+        frame->names[scope_index] = name;
+        frame->depths[scope_index] = (u8)context->timestamp_stack_depth;
+
+        vulkan_command_buffer* command_buffer = &context->graphics_command_buffers[context->image_index];
+        vkCmdWriteTimestamp(command_buffer->handle, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame->pool, scope_index * 2);
+    }
+
+    context->timestamp_stack[context->timestamp_stack_depth++] = scope_index;
+}
+
+void vulkan_renderer_gpu_scope_end()
+{
+    if(!context->timestamp_recording)
+    {
+        return;
+    }
+
+    if(context->timestamp_skipped_depth > 0)
+    {
+        context->timestamp_skipped_depth--;
+        return;
+    }
+
+    if(context->timestamp_stack_depth == 0)
+    {
+        return;
+    }
+
+    u32 scope_index = context->timestamp_stack[--context->timestamp_stack_depth];
+    if(scope_index == INVALID_ID)
+    {
+        return;
+    }
+
+    vulkan_timestamp_frame* frame = &context->timestamp_frames[context->current_frame];
+    vulkan_command_buffer* command_buffer = &context->graphics_command_buffers[context->image_index];
+    vkCmdWriteTimestamp(command_buffer->handle, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame->pool, scope_index * 2 + 1);
+}
+
+const renderer_gpu_timing* vulkan_renderer_gpu_timings_get(u32* out_count)
+{
+    *out_count = context->gpu_timing_count;
+    return context->gpu_timings;
+}
+
+const char* vulkan_renderer_memory_usage_str()
+{
+    return vulkan_memory_usage_str(context);
+}
+
+void vulkan_renderer_geometry_buffer_stats_get(renderer_geometry_buffer_stats* out_stats)
+{
+    buffer_stats_get(&context->object_vertex_buffer, &out_stats->vertex);
+    buffer_stats_get(&context->object_index_buffer, &out_stats->index);
+    out_stats->move_count = context->geometry_compaction.move_count;
+    out_stats->moved_bytes = context->geometry_compaction.moved_bytes;
+    out_stats->pending_release_count = context->geometry_compaction.retired_count;
+}
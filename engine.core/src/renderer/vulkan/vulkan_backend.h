@@ -76,3 +76,15 @@ texture* vulkan_renderer_window_attachment_get(u8 index);
 texture* vulkan_renderer_depth_attachment_get();
 
 u8 vulkan_renderer_window_attachment_index_get();
+
+bool vulkan_renderer_is_bindless_supported();
+
+void vulkan_renderer_gpu_scope_begin(const char* name);
+
+void vulkan_renderer_gpu_scope_end();
+
+const renderer_gpu_timing* vulkan_renderer_gpu_timings_get(u32* out_count);
+
+const char* vulkan_renderer_memory_usage_str();
+
+void vulkan_renderer_geometry_buffer_stats_get(renderer_geometry_buffer_stats* out_stats);
@@ -1,6 +1,7 @@
 // Собственные подключения.
 #include "renderer/vulkan/vulkan_buffer.h"
 #include "renderer/vulkan/vulkan_command_buffer.h"
+#include "renderer/vulkan/vulkan_memory.h"
 #include "renderer/vulkan/vulkan_utils.h"
 
 // Внутренние подключения.
@@ -16,6 +17,16 @@ void cleanup_freelist(vulkan_buffer* buffer)
     buffer->freelist_memory = null;
 }
 
+static vulkan_memory_usage buffer_memory_usage(VkBufferUsageFlagBits usage, u32 memory_property_flags)
+{
+    // Промежуточные буферы живут до завершения одной передачи, для них используется линейная стратегия.
+    if(usage == VK_BUFFER_USAGE_TRANSFER_SRC_BIT && (memory_property_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+    {
+        return VULKAN_MEMORY_USAGE_STAGING;
+    }
+    return VULKAN_MEMORY_USAGE_BUFFER;
+}
+
 bool vulkan_buffer_create(
     vulkan_context* context, u64 size, VkBufferUsageFlagBits usage, u32 memory_property_flags,
     bool bind_on_create, vulkan_buffer* out_buffer
@@ -52,28 +63,17 @@ bool vulkan_buffer_create(
     // Получение требований памяти.
     VkMemoryRequirements requirements = {0};
     vkGetBufferMemoryRequirements(context->device.logical, out_buffer->handle, &requirements);
-    out_buffer->memory_index = context->find_memory_index(requirements.memoryTypeBits, out_buffer->memory_property_flags);
-    if(out_buffer->memory_index == INVALID_ID)
-    {
-        kerror("Function '%s': Failed to find required memory type index.", __FUNCTION__);
-
-        // Обязательное уничтожение списка.
-        cleanup_freelist(out_buffer);
-        return false;
-    }
-
-    // Выделение памяти.
-    VkMemoryAllocateInfo allocate_info = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
-    allocate_info.allocationSize = requirements.size;
-    allocate_info.memoryTypeIndex = (u32)out_buffer->memory_index;
 
-    result = vkAllocateMemory(context->device.logical, &allocate_info, context->allocator, &out_buffer->memory);
-    if(!vulkan_result_is_success(result))
+    // Выделение участка памяти.
+    vulkan_memory_usage memory_usage = buffer_memory_usage(usage, memory_property_flags);
+    if(!vulkan_memory_allocate(context, &requirements, memory_property_flags, memory_usage, &out_buffer->allocation))
     {
-        kerror("Function '%s': Failed to allocate memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        kerror("Function '%s': Failed to allocate memory for buffer.", __FUNCTION__);
 
-        // Обязательное уничтожение списка.
+        // Обязательное уничтожение списка и буфера.
         cleanup_freelist(out_buffer);
+        vkDestroyBuffer(context->device.logical, out_buffer->handle, context->allocator);
+        out_buffer->handle = null;
         return false;
     }
 
@@ -92,16 +92,13 @@ void vulkan_buffer_destroy(vulkan_context* context, vulkan_buffer* buffer)
         cleanup_freelist(buffer);
     }
 
-    if(buffer->memory)
-    {
-        vkFreeMemory(context->device.logical, buffer->memory, context->allocator);
-    }
-
     if(buffer->handle)
     {
         vkDestroyBuffer(context->device.logical, buffer->handle, context->allocator);
     }
 
+    vulkan_memory_free(context, &buffer->allocation);
+
     kzero_tc(buffer, struct vulkan_buffer, 1);
 }
 
@@ -138,24 +135,23 @@ bool vulkan_buffer_resize(vulkan_context* context, u64 new_size, vulkan_buffer*
     VkMemoryRequirements requirements = {0};
     vkGetBufferMemoryRequirements(context->device.logical, new_buffer, &requirements);
 
-    // Выделение новой памяти.
-    VkMemoryAllocateInfo allocate_info = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
-    allocate_info.allocationSize = requirements.size;
-    allocate_info.memoryTypeIndex = (u32)buffer->memory_index;
-
-    VkDeviceMemory new_memory = null;
-    result = vkAllocateMemory(context->device.logical, &allocate_info, context->allocator, &new_memory);
-    if(!vulkan_result_is_success(result))
+    // Выделение нового участка памяти.
+    vulkan_memory_allocation new_allocation;
+    vulkan_memory_usage memory_usage = buffer_memory_usage(buffer->usage, buffer->memory_property_flags);
+    if(!vulkan_memory_allocate(context, &requirements, buffer->memory_property_flags, memory_usage, &new_allocation))
     {
-        kerror("Function '%s': Failed to allocate new memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        kerror("Function '%s': Failed to allocate new memory for buffer.", __FUNCTION__);
+        vkDestroyBuffer(context->device.logical, new_buffer, context->allocator);
         return false;
     }
 
     // Привязывание новой памяти.
-    result = vkBindBufferMemory(context->device.logical, new_buffer, new_memory, 0);
+    result = vkBindBufferMemory(context->device.logical, new_buffer, new_allocation.memory, new_allocation.offset);
     if(!vulkan_result_is_success(result))
     {
         kerror("Function '%s': Failed to bind buffer memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        vkDestroyBuffer(context->device.logical, new_buffer, context->allocator);
+        vulkan_memory_free(context, &new_allocation);
         return false;
     }
 
@@ -166,21 +162,17 @@ bool vulkan_buffer_resize(vulkan_context* context, u64 new_size, vulkan_buffer*
     vkDeviceWaitIdle(context->device.logical);
 
     // Уничтожение старого буфера.
-    if(buffer->memory)
-    {
-        vkFreeMemory(context->device.logical, buffer->memory, context->allocator);
-        buffer->memory = null;
-    }
-
     if(buffer->handle)
     {
         vkDestroyBuffer(context->device.logical, buffer->handle, context->allocator);
         buffer->handle = null;
     }
 
+    vulkan_memory_free(context, &buffer->allocation);
+
     // Установка новых значений.
     buffer->total_size = new_size;
-    buffer->memory = new_memory;
+    buffer->allocation = new_allocation;
     buffer->handle = new_buffer;
 
     return true;
@@ -188,7 +180,9 @@ bool vulkan_buffer_resize(vulkan_context* context, u64 new_size, vulkan_buffer*
 
 void vulkan_buffer_bind(vulkan_context* context, vulkan_buffer* buffer, u64 offset)
 {
-    VkResult result = vkBindBufferMemory(context->device.logical, buffer->handle, buffer->memory, offset);
+    VkResult result = vkBindBufferMemory(
+        context->device.logical, buffer->handle, buffer->allocation.memory, buffer->allocation.offset + offset
+    );
     if(!vulkan_result_is_success(result))
     {
         kerror("Function '%s': Failed to bind buffer memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
@@ -197,18 +191,26 @@ void vulkan_buffer_bind(vulkan_context* context, vulkan_buffer* buffer, u64 offs
 
 void* vulkan_buffer_lock_memory(vulkan_context* context, vulkan_buffer* buffer, u64 offset, u64 size, u32 flags)
 {
-    void* data = null;
-    VkResult result = vkMapMemory(context->device.logical, buffer->memory, offset, size, flags, &data);
-    if(!vulkan_result_is_success(result))
+    // NOTE: Блоки памяти видимой хосту отображены постоянно, поэтому блокировка не обращается к драйверу.
+    if(!buffer->allocation.mapped)
     {
-        kerror("Function '%s': Failed to map memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        kerror("Function '%s': Buffer memory is not host visible.", __FUNCTION__);
+        return null;
     }
-    return data;
+
+    buffer->is_locked = true;
+    return POINTER_GET_OFFSET(buffer->allocation.mapped, offset);
 }
 
 void vulkan_buffer_unlock_memory(vulkan_context* context, vulkan_buffer* buffer)
 {
-    vkUnmapMemory(context->device.logical, buffer->memory);    
+    if(!buffer->is_locked)
+    {
+        return;
+    }
+
+    vulkan_memory_flush(context, &buffer->allocation, 0, VK_WHOLE_SIZE);
+    buffer->is_locked = false;
 }
 
 bool vulkan_buffer_allocate(vulkan_buffer* buffer, u64 size, u64* out_offset)
@@ -233,19 +235,28 @@ bool vulkan_buffer_free(vulkan_buffer* buffer, u64 size, u64 offset)
     return freelist_free_block(buffer->buffer_freelist, size, offset);
 }
 
+u64 vulkan_buffer_free_space(vulkan_buffer* buffer)
+{
+    return freelist_free_space(buffer->buffer_freelist);
+}
+
+u64 vulkan_buffer_largest_free_block(vulkan_buffer* buffer)
+{
+    return freelist_largest_free_block(buffer->buffer_freelist);
+}
+
 void vulkan_buffer_load_data(
     vulkan_context* context, vulkan_buffer* buffer, u64 offset, u64 size, u32 flags, const void* data
 )
 {
-    void* data_ptr = null;
-    VkResult result = vkMapMemory(context->device.logical, buffer->memory, offset, size, flags, &data_ptr);
-    if(!vulkan_result_is_success(result))
+    if(!buffer->allocation.mapped)
     {
-        kerror("Function '%s': Failed to map memory with result %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        kerror("Function '%s': Buffer memory is not host visible.", __FUNCTION__);
         return;
     }
-    kcopy(data_ptr, data, size);
-    vkUnmapMemory(context->device.logical, buffer->memory);
+
+    kcopy(POINTER_GET_OFFSET(buffer->allocation.mapped, offset), data, size);
+    vulkan_memory_flush(context, &buffer->allocation, offset, size);
 }
 
 void vulkan_buffer_copy_to(
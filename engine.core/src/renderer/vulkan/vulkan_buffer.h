@@ -40,6 +40,16 @@ bool vulkan_buffer_allocate(vulkan_buffer* buffer, u64 size, u64* out_offset);
 */
 bool vulkan_buffer_free(vulkan_buffer* buffer, u64 size, u64 offset);
 
+/*
+    @brief Возвращает объем свободной памяти в буфере (сумма всех свободных блоков).
+*/
+u64 vulkan_buffer_free_space(vulkan_buffer* buffer);
+
+/*
+    @brief Возвращает размер наибольшего свободного блока в буфере.
+*/
+u64 vulkan_buffer_largest_free_block(vulkan_buffer* buffer);
+
 /*
 */
 void vulkan_buffer_load_data(
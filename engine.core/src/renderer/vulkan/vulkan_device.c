@@ -110,7 +110,36 @@ VkResult vulkan_device_create(renderer_backend* backend, vulkan_context* context
     VkPhysicalDeviceFeatures features = {0};
     features.samplerAnisotropy = requirements.sampler_anisotropy ? VK_TRUE : VK_FALSE;
 
+    // Запрос функций индексирования дескрипторов (Vulkan 1.2), необходимых для режима bindless.
+    VkPhysicalDeviceVulkan12Features features12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+    context->device.descriptor_indexing_support = false;
+
+    if(context->device.properties.apiVersion >= VK_API_VERSION_1_2)
+    {
+        VkPhysicalDeviceVulkan12Features supported12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+        VkPhysicalDeviceFeatures2 supported = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+        supported.pNext = &supported12;
+        vkGetPhysicalDeviceFeatures2(context->device.physical, &supported);
+
+        context->device.descriptor_indexing_support = supported12.descriptorIndexing
+                                                   && supported12.runtimeDescriptorArray
+                                                   && supported12.descriptorBindingPartiallyBound
+                                                   && supported12.descriptorBindingSampledImageUpdateAfterBind
+                                                   && supported12.shaderSampledImageArrayNonUniformIndexing;
+    }
+
+    if(context->device.descriptor_indexing_support)
+    {
+        features12.descriptorIndexing = VK_TRUE;
+        features12.runtimeDescriptorArray = VK_TRUE;
+        features12.descriptorBindingPartiallyBound = VK_TRUE;
+        features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        ktrace("Vulkan device supports descriptor indexing (bindless).");
+    }
+
     VkDeviceCreateInfo deviceinfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+    deviceinfo.pNext = context->device.descriptor_indexing_support ? &features12 : null;
     deviceinfo.queueCreateInfoCount = index;
     deviceinfo.pQueueCreateInfos = queueinfo;
     deviceinfo.pEnabledFeatures = &features;
@@ -361,6 +390,14 @@ VkResult vulkan_create_devices_info(renderer_backend* backend, vulkan_context* c
             }
         }
 
+        // Поддержка временных меток графической очередью (для замеров времени графического процессора).
+        if(graphics_family_index != INVALID_ID)
+        {
+            devices[i].timestamp_valid_bits = queue_families[graphics_family_index].timestampValidBits;
+            devices[i].timestamp_support = devices[i].timestamp_valid_bits > 0
+                                        && devices[i].properties.limits.timestampPeriod > 0.0f;
+        }
+
         // Сохранение индексов.
         devices[i].graphics_queue.index = graphics_family_index;
         devices[i].compute_queue.index  = compute_family_index;
@@ -480,6 +517,11 @@ void vulkan_logging_devices_info(vulkan_context* context, vulkan_device* devices
             kdebug("[%2d] GPU local host visible memory support", i);
         }
 
+        if(devices[i].timestamp_support)
+        {
+            kdebug("[%2d] GPU timestamp queries support (period %.2f ns)", i, devices[i].properties.limits.timestampPeriod);
+        }
+
         if(devices[i].physical == context->device.physical)
         {
             gpu_index = i;
@@ -1,5 +1,6 @@
 // Собственные подключения.
 #include "renderer/vulkan/vulkan_image.h"
+#include "renderer/vulkan/vulkan_memory.h"
 #include "renderer/vulkan/vulkan_utils.h"
 
 // Внутренние подключения.
@@ -40,26 +41,19 @@ void vulkan_image_create(
     VkMemoryRequirements memory_requirements;
     vkGetImageMemoryRequirements(context->device.logical, out_image->handle, &memory_requirements);
 
-    i32 memory_type = context->find_memory_index(memory_requirements.memoryTypeBits, memoryflags);
-    if(memory_type == INVALID_ID)
+    // Выделение участка памяти.
+    // NOTE: Линейные и оптимальные ресурсы размещаются в разных блоках, поэтому bufferImageGranularity
+    //       между соседними участками соблюдается автоматически.
+    vulkan_memory_usage usage = imagetiling == VK_IMAGE_TILING_OPTIMAL ? VULKAN_MEMORY_USAGE_IMAGE : VULKAN_MEMORY_USAGE_BUFFER;
+    if(!vulkan_memory_allocate(context, &memory_requirements, memoryflags, usage, &out_image->allocation))
     {
-        kfatal("Required memory type not found. Image not valid.");
-    }
-
-    // Выделение памяти.
-    VkMemoryAllocateInfo memoryinfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
-    memoryinfo.allocationSize = memory_requirements.size;
-    memoryinfo.memoryTypeIndex = memory_type;
-
-    result = vkAllocateMemory(context->device.logical, &memoryinfo, context->allocator, &out_image->memory);
-    if(!vulkan_result_is_success(result))
-    {
-        kfatal("Failed to allocate memory for vulkan_image with result: %s", vulkan_result_get_string(result, true));
+        kfatal("Failed to allocate memory for vulkan_image.");
     }
 
     // Связывание памяти с изображеинем.
-    // TODO: Сделать поддержку конфигурации сдвига памяти.
-    result = vkBindImageMemory(context->device.logical, out_image->handle, out_image->memory, 0);
+    result = vkBindImageMemory(
+        context->device.logical, out_image->handle, out_image->allocation.memory, out_image->allocation.offset
+    );
     if(!vulkan_result_is_success(result))
     {
         kfatal("Failed to bind memory to image for vulkan_image with result: %s", vulkan_result_get_string(result, true));
@@ -184,15 +178,11 @@ void vulkan_image_destroy(vulkan_context* context, vulkan_image* image)
         image->view = null;
     }
 
-    if(image->memory)
-    {
-        vkFreeMemory(context->device.logical, image->memory, context->allocator);
-        image->memory = null;
-    }
-
     if(image->handle)
     {
         vkDestroyImage(context->device.logical, image->handle, context->allocator);
         image->handle = null;
     }
+
+    vulkan_memory_free(context, &image->allocation);
 }
@@ -0,0 +1,512 @@
+// Собственные подключения.
+#include "renderer/vulkan/vulkan_memory.h"
+#include "renderer/vulkan/vulkan_utils.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "kstring.h"
+#include "memory/memory.h"
+#include "containers/darray.h"
+#include "containers/freelist.h"
+
+// Размер блока памяти для куч от 1 ГиБ.
+#define VULKAN_MEMORY_BLOCK_SIZE         MEBIBYTES(64)
+// Для куч меньше 1 ГиБ размер блока равен доле размера кучи.
+#define VULKAN_MEMORY_SMALL_HEAP_DIVISOR 8
+// Минимальная гранулярность участков: размеры и смещения участков в блоке кратны этому значению.
+#define VULKAN_MEMORY_MIN_ALIGNMENT      256
+
+struct vulkan_memory_block {
+    // Память устройства.
+    VkDeviceMemory memory;
+    // Размер блока.
+    u64 size;
+    // Индекс типа памяти.
+    u32 memory_type_index;
+    // Индекс кучи памяти.
+    u32 heap_index;
+    // Назначение памяти блока.
+    vulkan_memory_usage usage;
+    // Указывает, что блок выделен под один ресурс и освобождается вместе с ним.
+    bool is_dedicated;
+    // Постоянно отображенная память блока (только для памяти видимой хосту).
+    void* mapped;
+    // Количество выделенных участков.
+    u32 allocation_count;
+    // Размер занятой участками памяти.
+    u64 used_size;
+    // Стратегия списка свободной памяти.
+    u64 freelist_memory_requirement;
+    void* freelist_memory;
+    freelist* list;
+    // Линейная стратегия: смещение начала свободной памяти.
+    u64 linear_offset;
+};
+
+// Статистика использования кучи памяти.
+typedef struct vulkan_memory_heap_stats {
+    // Размер выделенных у драйвера блоков.
+    u64 allocated_size;
+    // Размер занятой участками памяти.
+    u64 used_size;
+    // Количество блоков.
+    u32 block_count;
+    // Количество участков.
+    u32 allocation_count;
+} vulkan_memory_heap_stats;
+
+struct vulkan_memory_allocator {
+    // Блоки памяти по типу памяти и назначению (darray указателей, создается при первом блоке).
+    vulkan_memory_block** blocks[VK_MAX_MEMORY_TYPES][VULKAN_MEMORY_USAGE_MAX];
+    // Размер блока для каждой кучи.
+    u64 block_sizes[VK_MAX_MEMORY_HEAPS];
+    // Статистика использования куч.
+    vulkan_memory_heap_stats heaps[VK_MAX_MEMORY_HEAPS];
+    // Общее количество вызовов vkAllocateMemory.
+    u64 device_allocation_total;
+};
+
+static vulkan_memory_block* block_create(
+    vulkan_context* context, u32 memory_type_index, vulkan_memory_usage usage, u64 size, bool is_dedicated
+)
+{
+    vulkan_memory_allocator* allocator = context->memory_allocator;
+    VkMemoryType* type = &context->device.memory.memoryTypes[memory_type_index];
+
+    VkMemoryAllocateInfo allocate_info = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocate_info.allocationSize = size;
+    allocate_info.memoryTypeIndex = memory_type_index;
+
+    VkDeviceMemory memory = null;
+    VkResult result = vkAllocateMemory(context->device.logical, &allocate_info, context->allocator, &memory);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to allocate memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        return null;
+    }
+
+    vulkan_memory_block* block = kallocate_tc(vulkan_memory_block, 1, MEMORY_TAG_RENDERER);
+    kzero_tc(block, vulkan_memory_block, 1);
+    block->memory = memory;
+    block->size = size;
+    block->memory_type_index = memory_type_index;
+    block->heap_index = type->heapIndex;
+    block->usage = usage;
+    block->is_dedicated = is_dedicated;
+
+    // NOTE: Память может быть отображена только один раз, поэтому блок отображается целиком на все время жизни.
+    if(type->propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+    {
+        result = vkMapMemory(context->device.logical, memory, 0, VK_WHOLE_SIZE, 0, &block->mapped);
+        if(!vulkan_result_is_success(result))
+        {
+            kerror("Function '%s': Failed to map memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+            vkFreeMemory(context->device.logical, memory, context->allocator);
+            kfree_tc(block, vulkan_memory_block, 1, MEMORY_TAG_RENDERER);
+            return null;
+        }
+    }
+
+    if(!is_dedicated && usage != VULKAN_MEMORY_USAGE_STAGING)
+    {
+        freelist_create(size, &block->freelist_memory_requirement, null);
+        block->freelist_memory = kallocate(block->freelist_memory_requirement, MEMORY_TAG_RENDERER);
+        block->list = freelist_create(size, &block->freelist_memory_requirement, block->freelist_memory);
+    }
+
+    allocator->device_allocation_total++;
+    allocator->heaps[block->heap_index].allocated_size += size;
+    allocator->heaps[block->heap_index].block_count++;
+
+    ktrace(
+        "Vulkan memory block created (type %u, heap %u, size %llu bytes%s).",
+        memory_type_index, block->heap_index, size, is_dedicated ? ", dedicated" : ""
+    );
+    return block;
+}
+
+static void block_destroy(vulkan_context* context, vulkan_memory_block* block)
+{
+    vulkan_memory_allocator* allocator = context->memory_allocator;
+
+    if(block->list)
+    {
+        freelist_destroy(block->list);
+        kfree(block->freelist_memory, block->freelist_memory_requirement, MEMORY_TAG_RENDERER);
+    }
+
+    if(block->mapped)
+    {
+        vkUnmapMemory(context->device.logical, block->memory);
+    }
+
+    vkFreeMemory(context->device.logical, block->memory, context->allocator);
+
+    allocator->heaps[block->heap_index].allocated_size -= block->size;
+    allocator->heaps[block->heap_index].block_count--;
+
+    kfree_tc(block, vulkan_memory_block, 1, MEMORY_TAG_RENDERER);
+}
+
+static bool block_allocate(vulkan_memory_block* block, u64 size, u64 alignment, vulkan_memory_allocation* out_allocation)
+{
+    if(block->is_dedicated)
+    {
+        if(block->allocation_count)
+        {
+            return false;
+        }
+
+        out_allocation->range_offset = 0;
+        out_allocation->range_size = block->size;
+        out_allocation->offset = 0;
+    }
+    else if(block->usage == VULKAN_MEMORY_USAGE_STAGING)
+    {
+        u64 offset = get_aligned(block->linear_offset, alignment);
+        if(offset + size > block->size)
+        {
+            return false;
+        }
+
+        out_allocation->range_offset = block->linear_offset;
+        out_allocation->range_size = offset + size - block->linear_offset;
+        out_allocation->offset = offset;
+        block->linear_offset = offset + size;
+    }
+    else
+    {
+        // NOTE: Размеры участков кратны минимальной гранулярности, поэтому смещения выровнены по ней всегда,
+        //       а для большего выравнивания занимается запас.
+        u64 range_size = get_aligned(size, VULKAN_MEMORY_MIN_ALIGNMENT);
+        if(alignment > VULKAN_MEMORY_MIN_ALIGNMENT)
+        {
+            range_size += alignment - VULKAN_MEMORY_MIN_ALIGNMENT;
+        }
+
+        if(block->size - block->used_size < range_size)
+        {
+            return false;
+        }
+
+        u64 range_offset = 0;
+        if(!freelist_allocate_block(block->list, range_size, &range_offset))
+        {
+            return false;
+        }
+
+        out_allocation->range_offset = range_offset;
+        out_allocation->range_size = range_size;
+        out_allocation->offset = get_aligned(range_offset, alignment);
+    }
+
+    out_allocation->block = block;
+    out_allocation->memory = block->memory;
+    out_allocation->size = size;
+    out_allocation->mapped = block->mapped ? POINTER_GET_OFFSET(block->mapped, out_allocation->offset) : null;
+
+    block->allocation_count++;
+    block->used_size += out_allocation->range_size;
+    return true;
+}
+
+bool vulkan_memory_allocator_create(vulkan_context* context)
+{
+    if(context->memory_allocator)
+    {
+        kwarng("Function '%s' was called more than once!", __FUNCTION__);
+        return false;
+    }
+
+    vulkan_memory_allocator* allocator = kallocate_tc(vulkan_memory_allocator, 1, MEMORY_TAG_RENDERER);
+    kzero_tc(allocator, vulkan_memory_allocator, 1);
+
+    VkPhysicalDeviceMemoryProperties* memory = &context->device.memory;
+    for(u32 i = 0; i < memory->memoryHeapCount; ++i)
+    {
+        u64 heap_size = memory->memoryHeaps[i].size;
+        if(heap_size >= GIBIBYTES(1))
+        {
+            allocator->block_sizes[i] = VULKAN_MEMORY_BLOCK_SIZE;
+        }
+        else
+        {
+            allocator->block_sizes[i] = get_aligned(heap_size / VULKAN_MEMORY_SMALL_HEAP_DIVISOR, VULKAN_MEMORY_MIN_ALIGNMENT);
+        }
+    }
+
+    context->memory_allocator = allocator;
+    return true;
+}
+
+void vulkan_memory_allocator_destroy(vulkan_context* context)
+{
+    vulkan_memory_allocator* allocator = context->memory_allocator;
+    if(!allocator)
+    {
+        return;
+    }
+
+    for(u32 t = 0; t < VK_MAX_MEMORY_TYPES; ++t)
+    {
+        for(u32 u = 0; u < VULKAN_MEMORY_USAGE_MAX; ++u)
+        {
+            vulkan_memory_block** blocks = allocator->blocks[t][u];
+            if(!blocks)
+            {
+                continue;
+            }
+
+            u64 block_count = darray_length(blocks);
+            for(u64 i = 0; i < block_count; ++i)
+            {
+                if(blocks[i]->allocation_count)
+                {
+                    kwarng(
+                        "Function '%s': Memory block (type %u) still has %u allocation(s).",
+                        __FUNCTION__, t, blocks[i]->allocation_count
+                    );
+                }
+                block_destroy(context, blocks[i]);
+            }
+
+            darray_destroy(blocks);
+        }
+    }
+
+    kfree_tc(allocator, vulkan_memory_allocator, 1, MEMORY_TAG_RENDERER);
+    context->memory_allocator = null;
+}
+
+bool vulkan_memory_allocate(
+    vulkan_context* context, const VkMemoryRequirements* requirements, VkMemoryPropertyFlags property_flags,
+    vulkan_memory_usage usage, vulkan_memory_allocation* out_allocation
+)
+{
+    vulkan_memory_allocator* allocator = context->memory_allocator;
+    kzero_tc(out_allocation, vulkan_memory_allocation, 1);
+
+    if(!allocator || !requirements || !requirements->size || usage >= VULKAN_MEMORY_USAGE_MAX)
+    {
+        kerror("Function '%s' requires a created allocator, valid requirements and usage.", __FUNCTION__);
+        return false;
+    }
+
+    i32 memory_type_index = context->find_memory_index(requirements->memoryTypeBits, property_flags);
+    if(memory_type_index == INVALID_ID)
+    {
+        kerror("Function '%s': Failed to find required memory type index.", __FUNCTION__);
+        return false;
+    }
+
+    VkMemoryType* type = &context->device.memory.memoryTypes[memory_type_index];
+    u64 alignment = requirements->alignment ? requirements->alignment : 1;
+
+    // Границы сброса некогерентной памяти не должны задевать соседние участки.
+    if((type->propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && !(type->propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+    {
+        alignment = KMAX(alignment, context->device.properties.limits.nonCoherentAtomSize);
+    }
+
+    u64 block_size = allocator->block_sizes[type->heapIndex];
+    vulkan_memory_block** blocks = allocator->blocks[memory_type_index][usage];
+
+    if(!blocks)
+    {
+        blocks = darray_create(vulkan_memory_block*);
+        allocator->blocks[memory_type_index][usage] = blocks;
+    }
+
+    vulkan_memory_block* block = null;
+
+    // Крупные ресурсы получают отдельный блок, чтобы не фрагментировать общие.
+    if(requirements->size > block_size / 2)
+    {
+        block = block_create(context, memory_type_index, usage, requirements->size, true);
+        if(!block)
+        {
+            return false;
+        }
+        darray_push(allocator->blocks[memory_type_index][usage], block);
+        block_allocate(block, requirements->size, alignment, out_allocation);
+    }
+    else
+    {
+        u64 block_count = darray_length(blocks);
+        for(u64 i = 0; i < block_count; ++i)
+        {
+            if(!blocks[i]->is_dedicated && block_allocate(blocks[i], requirements->size, alignment, out_allocation))
+            {
+                block = blocks[i];
+                break;
+            }
+        }
+
+        if(!block)
+        {
+            block = block_create(context, memory_type_index, usage, block_size, false);
+            if(!block)
+            {
+                return false;
+            }
+            darray_push(allocator->blocks[memory_type_index][usage], block);
+
+            if(!block_allocate(block, requirements->size, alignment, out_allocation))
+            {
+                kerror("Function '%s': Failed to allocate %llu bytes from a new block.", __FUNCTION__, requirements->size);
+                return false;
+            }
+        }
+    }
+
+    allocator->heaps[block->heap_index].used_size += out_allocation->range_size;
+    allocator->heaps[block->heap_index].allocation_count++;
+    return true;
+}
+
+void vulkan_memory_free(vulkan_context* context, vulkan_memory_allocation* allocation)
+{
+    vulkan_memory_allocator* allocator = context->memory_allocator;
+    vulkan_memory_block* block = allocation->block;
+
+    if(!allocator || !block)
+    {
+        return;
+    }
+
+    if(block->list && !freelist_free_block(block->list, allocation->range_size, allocation->range_offset))
+    {
+        kerror("Function '%s': Failed to free memory range of block.", __FUNCTION__);
+    }
+
+    block->allocation_count--;
+    block->used_size -= allocation->range_size;
+    allocator->heaps[block->heap_index].used_size -= allocation->range_size;
+    allocator->heaps[block->heap_index].allocation_count--;
+
+    kzero_tc(allocation, vulkan_memory_allocation, 1);
+
+    if(block->allocation_count)
+    {
+        return;
+    }
+
+    // Линейный блок используется заново после освобождения всех участков.
+    block->linear_offset = 0;
+
+    // NOTE: Один пустой блок остается в запасе, чтобы избежать повторных выделений у драйвера.
+    vulkan_memory_block** blocks = allocator->blocks[block->memory_type_index][block->usage];
+    u64 block_count = darray_length(blocks);
+    u64 block_index = INVALID_ID_U64;
+    bool has_spare = false;
+
+    for(u64 i = 0; i < block_count; ++i)
+    {
+        if(blocks[i] == block)
+        {
+            block_index = i;
+        }
+        else if(!blocks[i]->is_dedicated && !blocks[i]->allocation_count)
+        {
+            has_spare = true;
+        }
+    }
+
+    if(block_index != INVALID_ID_U64 && (block->is_dedicated || has_spare))
+    {
+        darray_pop_at(blocks, block_index, null);
+        block_destroy(context, block);
+    }
+}
+
+void vulkan_memory_flush(vulkan_context* context, vulkan_memory_allocation* allocation, u64 offset, u64 size)
+{
+    vulkan_memory_block* block = allocation->block;
+    if(!block || !block->mapped)
+    {
+        return;
+    }
+
+    VkMemoryPropertyFlags flags = context->device.memory.memoryTypes[block->memory_type_index].propertyFlags;
+    if(flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    {
+        return;
+    }
+
+    u64 atom = context->device.properties.limits.nonCoherentAtomSize;
+    u64 start = allocation->offset + offset;
+    u64 end = size == VK_WHOLE_SIZE ? allocation->offset + allocation->size : start + size;
+
+    // Границы области должны быть кратны nonCoherentAtomSize.
+    start = start / atom * atom;
+    end = get_aligned(end, atom);
+    end = KMIN(end, block->size);
+
+    VkMappedMemoryRange range = { VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE };
+    range.memory = block->memory;
+    range.offset = start;
+    range.size = end - start;
+
+    VkResult result = vkFlushMappedMemoryRanges(context->device.logical, 1, &range);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to flush memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+    }
+}
+
+static f32 size_to_unit(u64 size, const char** out_unit)
+{
+    if(size >= GIBIBYTES(1))
+    {
+        *out_unit = "GiB";
+        return size / (f32)GIBIBYTES(1);
+    }
+    else if(size >= MEBIBYTES(1))
+    {
+        *out_unit = "MiB";
+        return size / (f32)MEBIBYTES(1);
+    }
+    else if(size >= KIBIBYTES(1))
+    {
+        *out_unit = "KiB";
+        return size / (f32)KIBIBYTES(1);
+    }
+
+    *out_unit = "B";
+    return (f32)size;
+}
+
+const char* vulkan_memory_usage_str(vulkan_context* context)
+{
+    vulkan_memory_allocator* allocator = context->memory_allocator;
+    if(!allocator)
+    {
+        return string_duplicate("Device memory allocator is not created.\n");
+    }
+
+    char buffer[4000] = "Device memory use (per heap):\n";
+    u64 offset = string_length(buffer);
+
+    VkPhysicalDeviceMemoryProperties* memory = &context->device.memory;
+    for(u32 i = 0; i < memory->memoryHeapCount; ++i)
+    {
+        vulkan_memory_heap_stats* stats = &allocator->heaps[i];
+        const char* used_unit;
+        const char* allocated_unit;
+        const char* heap_unit;
+        f32 used = size_to_unit(stats->used_size, &used_unit);
+        f32 allocated = size_to_unit(stats->allocated_size, &allocated_unit);
+        f32 heap = size_to_unit(memory->memoryHeaps[i].size, &heap_unit);
+
+        i32 length = string_format(
+            buffer + offset,
+            "\tHEAP %u %-8s: %7.2f %-3s used / %7.2f %-3s allocated (heap %.2f %s), %u block(s), %u allocation(s)\n",
+            i, memory->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT ? "(local)" : "(shared)",
+            used, used_unit, allocated, allocated_unit, heap, heap_unit, stats->block_count, stats->allocation_count
+        );
+        offset += length;
+    }
+
+    string_format(buffer + offset, "\tvkAllocateMemory calls: %llu\n", allocator->device_allocation_total);
+    return string_duplicate(buffer);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <defines.h>
+#include <renderer/vulkan/vulkan_types.h>
+
+/*
+    @brief Создает распределитель памяти устройства.
+    NOTE: Вызывать после создания логического устройства и до создания любых буферов и изображений.
+    @param context Указатель на контекст Vulkan.
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool vulkan_memory_allocator_create(vulkan_context* context);
+
+/*
+    @brief Уничтожает распределитель памяти устройства и освобождает все блоки памяти.
+    NOTE: Вызывать после уничтожения всех буферов и изображений.
+    @param context Указатель на контекст Vulkan.
+*/
+void vulkan_memory_allocator_destroy(vulkan_context* context);
+
+/*
+    @brief Выделяет участок памяти устройства из блока подходящего типа памяти.
+    NOTE: Блоки памяти видимой хосту отображаются постоянно, указатель доступен в out_allocation->mapped.
+    @param context Указатель на контекст Vulkan.
+    @param requirements Указатель на требования ресурса к памяти.
+    @param property_flags Требуемые флаги памяти.
+    @param usage Назначение памяти (группа блоков и стратегия выделения).
+    @param out_allocation Указатель на структуру для сохранения выделенного участка.
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool vulkan_memory_allocate(
+    vulkan_context* context, const VkMemoryRequirements* requirements, VkMemoryPropertyFlags property_flags,
+    vulkan_memory_usage usage, vulkan_memory_allocation* out_allocation
+);
+
+/*
+    @brief Освобождает участок памяти устройства.
+    NOTE: Ресурс, использующий участок, должен быть уничтожен или больше не использоваться устройством.
+    @param context Указатель на контекст Vulkan.
+    @param allocation Указатель на освобождаемый участок (обнуляется).
+*/
+void vulkan_memory_free(vulkan_context* context, vulkan_memory_allocation* allocation);
+
+/*
+    @brief Делает записанные хостом данные видимыми устройству (только для памяти без HOST_COHERENT).
+    @param context Указатель на контекст Vulkan.
+    @param allocation Указатель на участок памяти.
+    @param offset Смещение области относительно начала участка.
+    @param size Размер области или VK_WHOLE_SIZE до конца участка.
+*/
+void vulkan_memory_flush(vulkan_context* context, vulkan_memory_allocation* allocation, u64 offset, u64 size);
+
+/*
+    @brief Формирует строку с использованием памяти устройства по кучам.
+    NOTE: Полученную строку необходимо освободить с помощью string_free.
+    @param context Указатель на контекст Vulkan.
+    @return Строка с использованием памяти устройства.
+*/
+const char* vulkan_memory_usage_str(vulkan_context* context);
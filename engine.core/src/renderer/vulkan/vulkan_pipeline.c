@@ -122,18 +122,23 @@ bool vulkan_graphics_pipeline_create(
             return false;
         }
 
-        VkPushConstantRange ranges[32];
-        kzero_tc(ranges, VkPushConstantRange, 32);
-
-        for(u32 i = 0; i < push_constant_range_count; ++i)
+        // NOTE: Спецификация запрещает пересечение стадий у разных диапазонов, поэтому все диапазоны
+        //       объединяются в один, который покрывает их целиком.
+        u64 range_begin = push_constant_ranges[0].offset;
+        u64 range_end = push_constant_ranges[0].offset + push_constant_ranges[0].size;
+        for(u32 i = 1; i < push_constant_range_count; ++i)
         {
-            ranges[i].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-            ranges[i].offset = push_constant_ranges[i].offset;
-            ranges[i].size = push_constant_ranges[i].size;
+            range_begin = KMIN(range_begin, push_constant_ranges[i].offset);
+            range_end = KMAX(range_end, push_constant_ranges[i].offset + push_constant_ranges[i].size);
         }
 
-        pipeline_layout_info.pushConstantRangeCount = push_constant_range_count;
-        pipeline_layout_info.pPushConstantRanges = ranges;
+        VkPushConstantRange push_range;
+        push_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        push_range.offset = range_begin;
+        push_range.size = range_end - range_begin;
+
+        pipeline_layout_info.pushConstantRangeCount = 1;
+        pipeline_layout_info.pPushConstantRanges = &push_range;
     }
     else
     {
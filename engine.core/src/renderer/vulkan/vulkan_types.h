@@ -5,6 +5,7 @@
 #include <vulkan/vulkan.h>
 #include <containers/freelist.h>
 #include <containers/hashtable.h>
+#include <containers/handle_pool.h>
 #include <renderer/renderer_types.h>
 
 /*
@@ -13,6 +14,41 @@
 */
 #define VK_CHECK(expr) kassert(expr == VK_SUCCESS, "")
 
+// @brief Блок памяти устройства, из которого выделяются участки для буферов и изображений.
+typedef struct vulkan_memory_block vulkan_memory_block;
+
+// @brief Контекст распределителя памяти устройства.
+typedef struct vulkan_memory_allocator vulkan_memory_allocator;
+
+// @brief Назначение выделяемой памяти (определяет группу блоков и стратегию выделения).
+typedef enum vulkan_memory_usage {
+    // @brief Буферы и изображения с линейным размещением (стратегия списка свободной памяти).
+    VULKAN_MEMORY_USAGE_BUFFER,
+    // @brief Изображения с оптимальным размещением (стратегия списка свободной памяти).
+    VULKAN_MEMORY_USAGE_IMAGE,
+    // @brief Кратковременные промежуточные буферы (линейная стратегия).
+    VULKAN_MEMORY_USAGE_STAGING,
+    VULKAN_MEMORY_USAGE_MAX
+} vulkan_memory_usage;
+
+// @brief Участок памяти устройства, выделенный из блока.
+typedef struct vulkan_memory_allocation {
+    // @brief Блок, которому принадлежит участок (null - участок не выделен).
+    vulkan_memory_block* block;
+    // @brief Память устройства блока (используется для привязки к ресурсу).
+    VkDeviceMemory memory;
+    // @brief Выровненное смещение участка в памяти блока.
+    u64 offset;
+    // @brief Запрошенный размер участка.
+    u64 size;
+    // @brief Смещение занятой области в блоке (с учетом запаса на выравнивание).
+    u64 range_offset;
+    // @brief Размер занятой области в блоке (с учетом запаса на выравнивание).
+    u64 range_size;
+    // @brief Указатель на отображенную память участка (null - память не видна хосту).
+    void* mapped;
+} vulkan_memory_allocation;
+
 /*
     @brief Контекст буфер Vulkan.
     NOTE: Используется для загрузки данных на видеокарту.
@@ -26,10 +62,8 @@ typedef struct vulkan_buffer {
     bool is_locked;
     // @brief Размер буфера.
     u64 total_size;
-    // @brief Используемая память для буфера.
-    VkDeviceMemory memory;
-    // @brief Индекс используемый буфером.
-    i32 memory_index;
+    // @brief Участок памяти устройства, используемый буфером.
+    vulkan_memory_allocation allocation;
     // @brief Флаги памяти.
     u32 memory_property_flags;
     // @brief Требования памяти списка.
@@ -45,7 +79,7 @@ typedef struct vulkan_buffer {
 typedef struct vulkan_image {
     VkImage handle;
     VkImageView view;
-    VkDeviceMemory memory;
+    vulkan_memory_allocation allocation;
     u32 width;
     u32 height;
 } vulkan_image;
@@ -61,6 +95,7 @@ typedef enum vulkan_renderpass_state {
 
 typedef struct vulkan_renderpass {
     VkRenderPass handle;
+    char* name;
     f32 depth;
     u32 stencil;
     bool do_clear_color;
@@ -162,6 +197,12 @@ typedef struct vulkan_device {
     VkFormat depth_format;
     // @brief Количество каналов выбранного формата глубины.
     u8 depth_channel_count;
+    // @brief Поддержка индексирования дескрипторов (необходимо для режима bindless).
+    bool descriptor_indexing_support;
+    // @brief Поддержка запросов временных меток графической очередью.
+    bool timestamp_support;
+    // @brief Количество значащих бит временной метки графической очереди.
+    u32 timestamp_valid_bits;
 } vulkan_device;
 
 // @brief Контекст конвейера.
@@ -206,6 +247,46 @@ typedef struct vulkan_geometry_data {
     u64 index_buffer_offset;
 } vulkan_geometry_data;
 
+#define VULKAN_GEOMETRY_COMPACTION_MAX_RETIRED  256
+#define VULKAN_GEOMETRY_COMPACTION_MAX_MOVES    64
+#define VULKAN_GEOMETRY_COMPACTION_MAX_ATTEMPTS 32
+
+// @brief Диапазон буфера, освобождаемый после завершения всех кадров, которые могли его читать.
+typedef struct vulkan_retired_range {
+    // @brief Буфер, которому принадлежит диапазон.
+    vulkan_buffer* buffer;
+    // @brief Смещение диапазона.
+    u64 offset;
+    // @brief Размер диапазона.
+    u64 size;
+    // @brief Номер кадра, начиная с которого диапазон не используется.
+    u64 frame;
+} vulkan_retired_range;
+
+// @brief Состояние постепенной дефрагментации буферов вершин и индексов.
+typedef struct vulkan_geometry_compaction {
+    // @brief Указывает, что дефрагментация включена.
+    bool enabled;
+    // @brief Фрагментация свободной памяти (0..1), начиная с которой переносятся данные.
+    f32 fragmentation_threshold;
+    // @brief Максимальный объем данных, переносимых за кадр, в байтах.
+    u64 bytes_per_frame;
+    // @brief Указывает, что раскладка буфера вершин изменилась с последней проверки фрагментации.
+    bool vertex_dirty;
+    // @brief Указывает, что раскладка буфера индексов изменилась с последней проверки фрагментации.
+    bool index_dirty;
+    // @brief Количество отправленных кадров (для отложенного освобождения).
+    u64 frame;
+    // @brief Диапазоны, ожидающие освобождения.
+    vulkan_retired_range retired[VULKAN_GEOMETRY_COMPACTION_MAX_RETIRED];
+    // @brief Количество диапазонов, ожидающих освобождения.
+    u32 retired_count;
+    // @brief Общее количество перенесенных диапазонов.
+    u64 move_count;
+    // @brief Общий объем перенесенных данных в байтах.
+    u64 moved_bytes;
+} vulkan_geometry_compaction;
+
 // @brief Конкретная конфигурация стадии шейдера на конвейере.
 typedef struct vulkan_shader_stage_config {
     // @brief Стадия конвейера.
@@ -228,8 +309,8 @@ typedef struct vulkan_shader_config {
     u8 stage_count;
     // @brief Массив стадий конвейера.
     vulkan_shader_stage_config stages[VULKAN_SHADER_MAX_STAGES];
-    // @brief Массив резмеров пулов дескрипторных наборов (ubo, image sampler).
-    VkDescriptorPoolSize pool_sizes[2];
+    // @brief Массив резмеров пулов дескрипторных наборов (ubo, image sampler, storage buffer).
+    VkDescriptorPoolSize pool_sizes[3];
     // @brief Максимальное количество дескрипторных наборов, которое может предоставить шейдер.
     u16 max_descriptor_set_count;
     // @brief Количество дескрипторов.
@@ -296,6 +377,12 @@ typedef struct vulkan_shader {
     u32 instance_count;
     // @brief Массив состояний экземпляров.
     vulkan_shader_instance_state instance_states[VULKAN_SHADER_MAX_MATERIAL_COUNT];
+    // @brief Массив наборов дескрипторов экземпляров на кадр (только для режима bindless).
+    VkDescriptorSet bindless_descriptor_sets[5];     // TODO: image_count == 5!
+    // @brief Смещение в байтах блока данных экземпляров в uniform-буфере (только для режима bindless).
+    u64 bindless_instance_offset;
+    // @brief Количество текстур в массиве текстур (только для режима bindless).
+    u32 bindless_texture_count;
     // @brief Конвейер визуализации привязаный к шейдеру.
     vulkan_pipeline pipeline;
     // @brief Проходчик визуализации.
@@ -303,6 +390,21 @@ typedef struct vulkan_shader {
 } vulkan_shader;
 
 #define VULKAN_MAX_REGISTERED_RENDERPASSES 31
+#define VULKAN_MAX_TIMESTAMP_SCOPES        32
+
+// @brief Замеры времени графического процессора одного кадра в полете.
+typedef struct vulkan_timestamp_frame {
+    // @brief Пул запросов временных меток (две метки на область: начало и конец).
+    VkQueryPool pool;
+    // @brief Количество записанных областей.
+    u32 scope_count;
+    // @brief Имена областей.
+    const char* names[VULKAN_MAX_TIMESTAMP_SCOPES];
+    // @brief Глубина вложенности областей.
+    u8 depths[VULKAN_MAX_TIMESTAMP_SCOPES];
+    // @brief Указывает, что кадр отправлен и его результаты еще не прочитаны.
+    bool is_pending;
+} vulkan_timestamp_frame;
 
 // @brief Контекст визуализатора.
 typedef struct vulkan_context {
@@ -342,11 +444,38 @@ typedef struct vulkan_context {
     hashtable* renderpass_table;
     renderpass registered_passes[VULKAN_MAX_REGISTERED_RENDERPASSES];
 
+    // @brief Замеры времени графического процессора на кадр в полете.
+    vulkan_timestamp_frame* timestamp_frames;
+    // @brief Количество замеров кадров (равно max_frames_in_flight цепочки обмена).
+    u32 timestamp_frame_count;
+    // @brief Стек индексов открытых областей замеров текущего кадра.
+    u32 timestamp_stack[VULKAN_MAX_TIMESTAMP_SCOPES];
+    // @brief Глубина стека открытых областей замеров.
+    u32 timestamp_stack_depth;
+    // @brief Количество открытых областей, не попавших в стек из-за его переполнения.
+    u32 timestamp_skipped_depth;
+    // @brief Указывает, что идет запись команд кадра и области замеров могут быть записаны.
+    bool timestamp_recording;
+    // @brief Последние прочитанные результаты замеров времени графического процессора.
+    renderer_gpu_timing gpu_timings[VULKAN_MAX_TIMESTAMP_SCOPES];
+    // @brief Количество последних прочитанных результатов замеров.
+    u32 gpu_timing_count;
+
+    // @brief Распределитель памяти устройства для буферов и изображений.
+    vulkan_memory_allocator* memory_allocator;
+
     vulkan_buffer object_vertex_buffer;
     vulkan_buffer object_index_buffer;
 
     // TODO: Сделать динамическим размер.
     vulkan_geometry_data geometries[VULKAN_SHADER_MAX_GEOMETRY_COUNT];
+    // @brief Пул слотов массива геометрий.
+    u64 geometry_handles_memory_requirement;
+    void* geometry_handles_memory;
+    handle_pool* geometry_handles;
+
+    // @brief Состояние дефрагментации буферов вершин и индексов.
+    vulkan_geometry_compaction geometry_compaction;
 
     i32 (*find_memory_index)(u32 type_filter, u32 property_flags);
     void (*on_rendertarget_refresh_required)();
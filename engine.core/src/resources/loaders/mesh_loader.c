@@ -1,15 +1,18 @@
 // Собственные подключения.
 #include "resources/loaders/mesh_loader.h"
 #include "resources/loaders/loader_util.h"
+#include "resources/loaders/obj_parser.h"
 
 // Внутренние подключения.
 #include "logger.h"
 #include "kstring.h"
 #include "math/kmath.h"
 #include "math/geometry_utils.h"
+#include "math/geometry_optimizer.h"
 #include "memory/memory.h"
 #include "platform/file.h"
 #include "platform/string.h"
+#include "platform/time.h"
 #include "containers/darray.h"
 #include "resources/resource_types.h"
 #include "systems/resource_system.h"
@@ -25,9 +28,83 @@ static const loader_filetype_entry supported_filetypes[SUPPORTED_FILETYPE_COUNT]
     [FILETYPE_OBJ] = {".obj", LOADER_FILETYPE_MESH_OBJ, false }
 };
 
-bool load_obj_file(file* obj_file, const char* name, geometry_config** out_geometries_darray);
-bool load_ksm_file(file* ksm_file, geometry_config** out_geometries_darray);
-bool write_ksm_file(const char* name, geometry_config* geometries);
+// Версии формата ksm файла.
+#define KSM_VERSION_1 0x0001U
+#define KSM_VERSION_2 0x0002U
+#define KSM_VERSION_3 0x0003U
+// Выравнивание данных вершин и индексов в ksm файле версии 2 и выше.
+#define KSM_DATA_ALIGNMENT 16
+
+/*
+    Формат ksm файла версии 2 и 3 (все смещения от начала файла):
+    [ksm_header][ksm_geometry_entry * geometry_count][строки имен][данные вершин и индексов, выровненные по 16 байт]
+    NOTE: Структуры читаются напрямую из отображенного в память файла, порядок и размеры полей фиксированы.
+*/
+typedef struct ksm_header {
+    u16 version;
+    u16 reserved0;
+    // Размер заголовка в байтах.
+    u32 header_size;
+    // Размер всего файла в байтах (для проверки целостности).
+    u64 file_size;
+    u64 geometry_count;
+    // Смещение таблицы геометрий.
+    u64 table_offset;
+    // Смещение и длина имени сетки (с завершающим нулем).
+    u64 name_offset;
+    u32 name_length;
+    u32 reserved1;
+} ksm_header;
+
+typedef struct ksm_geometry_entry {
+    // Смещения и длины имени геометрии и имени материала (с завершающим нулем).
+    u64 name_offset;
+    u64 material_name_offset;
+    u32 name_length;
+    u32 material_name_length;
+    // Центр и крайние точки геометрии.
+    f32 center[3];
+    f32 extents_min[3];
+    f32 extents_max[3];
+    // Размеры и количество вершин и индексов.
+    u32 vertex_size;
+    u32 vertex_count;
+    u32 index_size;
+    u32 index_count;
+    // Количество уровней детализации (в версии 2 всегда 0).
+    u32 lod_count;
+    // Смещения данных вершин и индексов (выровнены по KSM_DATA_ALIGNMENT).
+    u64 vertex_offset;
+    u64 index_offset;
+    // Уровни детализации в общем массиве индексов (только версия 3).
+    struct {
+        u32 index_offset;
+        u32 index_count;
+        f32 error;
+        u32 reserved;
+    } lods[GEOMETRY_LOD_MAX];
+} ksm_geometry_entry;
+
+// Размер записи геометрии версии 2 (без уровней детализации).
+#define KSM_GEOMETRY_ENTRY_V2_SIZE 96
+
+STATIC_ASSERT(sizeof(ksm_header) == 48, "Assertion 'sizeof(ksm_header) == 48' failed.");
+STATIC_ASSERT(sizeof(ksm_geometry_entry) == 160, "Assertion 'sizeof(ksm_geometry_entry) == 160' failed.");
+STATIC_ASSERT(
+    __builtin_offsetof(ksm_geometry_entry, lods) == KSM_GEOMETRY_ENTRY_V2_SIZE,
+    "Assertion '__builtin_offsetof(ksm_geometry_entry, lods) == KSM_GEOMETRY_ENTRY_V2_SIZE' failed."
+);
+
+bool load_obj_file(const char* path, const char* name, geometry_config** out_geometries_darray);
+bool load_ksm_file(
+    file* ksm_file, const char* path, geometry_config** out_geometries_darray, file_mapping** out_mapping, u16* out_version
+);
+bool write_ksm_file(const char* name, geometry_config* geometries, bool overwrite);
+void detach_geometries(geometry_config* geometries, file_mapping* mapping);
+void unpack_geometries(geometry_config* geometries);
+void optimize_geometries(geometry_config* geometries);
+void generate_geometry_lods(geometry_config* geometries);
+void pack_geometries(geometry_config* geometries);
 
 bool mesh_loader_load(struct resource_loader* self, const char* name, resource* out_resource)
 {
@@ -65,17 +142,25 @@ bool mesh_loader_load(struct resource_loader* self, const char* name, resource*
     }
 
     out_resource->full_path = string_duplicate(filepath_str);
+    out_resource->internal_data = null;
     geometry_config* resource_data = darray_create(geometry_config);
+    u16 ksm_version = 0;
 
     bool result = false;
     switch(type)
     {
         case LOADER_FILETYPE_MESH_KSM:
-            result = load_ksm_file(f, &resource_data);
+            result = load_ksm_file(f, filepath_str, &resource_data, (file_mapping**)&out_resource->internal_data, &ksm_version);
             break;
         case LOADER_FILETYPE_MESH_OBJ:
-            result = load_obj_file(f, name, &resource_data);
-            write_ksm_file(name, resource_data);
+            result = load_obj_file(filepath_str, name, &resource_data);
+            if(result)
+            {
+                optimize_geometries(resource_data);
+                generate_geometry_lods(resource_data);
+                pack_geometries(resource_data);
+                write_ksm_file(name, resource_data, false);
+            }
             break;
         default:
             result = false;
@@ -94,6 +179,24 @@ bool mesh_loader_load(struct resource_loader* self, const char* name, resource*
         return false;
     }
 
+    // Преобразование ksm файла предыдущих версий в текущую (отображение в память, уровни детализации).
+    if(type == LOADER_FILETYPE_MESH_KSM && ksm_version != KSM_VERSION_3)
+    {
+        kinfor("Function '%s': Upgrading mesh file '%s' to version %u.", __FUNCTION__, filepath_str, KSM_VERSION_3);
+
+        if(out_resource->internal_data)
+        {
+            detach_geometries(resource_data, out_resource->internal_data);
+            out_resource->internal_data = null;
+        }
+
+        unpack_geometries(resource_data);
+        optimize_geometries(resource_data);
+        generate_geometry_lods(resource_data);
+        pack_geometries(resource_data);
+        write_ksm_file(name, resource_data, true);
+    }
+
     out_resource->data = resource_data;
     // Использование размера данных как количество конфигураций геометрий.
     out_resource->data_size = darray_length(resource_data);
@@ -107,14 +210,28 @@ void mesh_loader_unload(struct resource_loader* self, resource* resource)
 
     u32 count = resource->data_size;
     geometry_config* configs = resource->data;
+    file_mapping* mapping = resource->internal_data;
 
     for(u32 i = 0; i < count; ++i)
     {
+        // NOTE: Данные вершин и индексов указывают в отображенный файл и освобождаются вместе с ним.
+        if(mapping)
+        {
+            configs[i].vertices = null;
+            configs[i].indices = null;
+        }
+
         geometry_system_config_dispose(&configs[i]);
     }
 
     darray_destroy(resource->data);
 
+    if(mapping)
+    {
+        platform_file_unmap(mapping);
+        resource->internal_data = null;
+    }
+
     if(string_length(resource->full_path) > 0)
     {
         string_free(resource->full_path);
@@ -139,13 +256,14 @@ resource_loader mesh_resource_loader_create()
 
 //-------------------------------------- KSM ----------------------------------------------
 
-bool load_ksm_file(file* ksm_file, geometry_config** out_geometries_darray)
+/*
+    @brief Загружает ksm файл версии 1 (последовательное чтение полей).
+    NOTE: Версия файла уже прочитана.
+*/
+static bool load_ksm_file_v1(file* ksm_file, geometry_config** out_geometries_darray)
 {
     // NOTE: Ниже игнорируется результат чтения!
 
-    u16 version = 0;
-    platfrom_file_read(ksm_file, sizeof(u16), &version);
-
     u32 name_length = 0;
     char name[GEOMETRY_NAME_MAX_LENGTH];
     platfrom_file_read(ksm_file, sizeof(u32), &name_length);
@@ -190,379 +308,520 @@ bool load_ksm_file(file* ksm_file, geometry_config** out_geometries_darray)
     return true;
 }
 
-bool write_ksm_file(const char* name, geometry_config* geometries)
+// @brief Проверяет, что область [offset, offset + size) лежит внутри файла указанного размера.
+static bool ksm_range_valid(u64 offset, u64 size, u64 file_size)
 {
-    char ksm_filepath[GEOMETRY_NAME_MAX_LENGTH];
-    string_format(ksm_filepath, "%s/models/%s.ksm", resource_system_base_path(), name);
+    return offset <= file_size && size <= file_size - offset;
+}
 
-    if(platform_file_exists(ksm_filepath))
+// @brief Проверяет, что строка области [offset, offset + length) помещается в буфер и завершается нулем.
+static bool ksm_string_valid(const u8* data, u64 file_size, u64 offset, u32 length, u32 max_length)
+{
+    return length > 0 && length <= max_length && ksm_range_valid(offset, length, file_size) && data[offset + length - 1] == '\0';
+}
+
+/*
+    @brief Загружает ksm файл версии 2 или 3 через отображение файла в память без копирования данных.
+    NOTE: Данные вершин и индексов конфигураций указывают в отображение, которое необходимо
+          освободить после загрузки геометрий в память устройства.
+*/
+static bool load_ksm_file_v2(const char* path, u16 version, geometry_config** out_geometries_darray, file_mapping** out_mapping)
+{
+    file_mapping* mapping = null;
+    if(!platform_file_map(path, &mapping))
     {
-        // kwarng("Function '%s': File '%s' is already exists.", __FUNCTION__, ksm_filepath);
+        kerror("Function '%s': Failed to map file '%s'.", __FUNCTION__, path);
         return false;
     }
 
-    file* ksm_file;
-    if(!platform_file_open(ksm_filepath, FILE_MODE_WRITE | FILE_MODE_BINARY, &ksm_file))
+    const u8* data = platform_file_mapping_data(mapping);
+    u64 file_size = platform_file_mapping_size(mapping);
+    const ksm_header* header = (const ksm_header*)data;
+    // NOTE: Записи версии 2 не содержат таблицы уровней детализации.
+    u64 entry_size = version == KSM_VERSION_2 ? KSM_GEOMETRY_ENTRY_V2_SIZE : sizeof(ksm_geometry_entry);
+
+    if(file_size < sizeof(ksm_header) || header->version != version || header->header_size != sizeof(ksm_header)
+    || header->file_size != file_size || header->table_offset % 8 != 0 || header->table_offset > file_size
+    || header->geometry_count > (file_size - header->table_offset) / entry_size
+    || !ksm_range_valid(header->table_offset, header->geometry_count * entry_size, file_size))
     {
-        kerror("Function '%s': Cannot open file '%s' for binary writing. Skipping...", __FUNCTION__, ksm_filepath);
+        kerror("Function '%s': File '%s' has invalid header.", __FUNCTION__, path);
+        platform_file_unmap(mapping);
         return false;
     }
 
-    u16 version = 0x0001U;
-    platform_file_write(ksm_file, sizeof(u16), &version);
+    const u8* entries = data + header->table_offset;
 
-    u32 name_length = string_length(name) + 1;
-    platform_file_write(ksm_file, sizeof(u32), &name_length);
-    platform_file_write(ksm_file, sizeof(char) * name_length, name);
+    // Проверка всей таблицы до создания конфигураций.
+    for(u64 i = 0; i < header->geometry_count; ++i)
+    {
+        const ksm_geometry_entry* e = (const ksm_geometry_entry*)(entries + i * entry_size);
+        u64 vertices_size = (u64)e->vertex_size * e->vertex_count;
+        u64 indices_size = (u64)e->index_size * e->index_count;
+        u32 lod_count = version == KSM_VERSION_2 ? 0 : e->lod_count;
 
-    u64 geometry_count = darray_length(geometries);
-    platform_file_write(ksm_file, sizeof(u64), &geometry_count);
+        bool lods_valid = lod_count <= GEOMETRY_LOD_MAX;
+        for(u32 l = 0; lods_valid && l < lod_count; ++l)
+        {
+            lods_valid = e->lods[l].index_offset <= e->index_count
+                      && e->lods[l].index_count <= e->index_count - e->lods[l].index_offset;
+        }
 
-    for(u64 i = 0; i < geometry_count; ++i)
+        if(!ksm_string_valid(data, file_size, e->name_offset, e->name_length, GEOMETRY_NAME_MAX_LENGTH)
+        || !ksm_string_valid(data, file_size, e->material_name_offset, e->material_name_length, MATERIAL_NAME_MAX_LENGTH)
+        || e->vertex_offset % KSM_DATA_ALIGNMENT != 0 || !ksm_range_valid(e->vertex_offset, vertices_size, file_size)
+        || e->index_offset % KSM_DATA_ALIGNMENT != 0 || !ksm_range_valid(e->index_offset, indices_size, file_size)
+        || !lods_valid)
+        {
+            kerror("Function '%s': File '%s' has invalid geometry entry %llu.", __FUNCTION__, path, i);
+            platform_file_unmap(mapping);
+            return false;
+        }
+    }
+
+    for(u64 i = 0; i < header->geometry_count; ++i)
     {
-        geometry_config* g = &geometries[i];
+        const ksm_geometry_entry* e = (const ksm_geometry_entry*)(entries + i * entry_size);
+        geometry_config gconf = {};
 
-        // Имя сетки геометрии.
-        u32 g_name_length = string_length(g->name) + 1;
-        platform_file_write(ksm_file, sizeof(u32), &g_name_length);
-        platform_file_write(ksm_file, sizeof(char) * g_name_length, g->name);
+        string_ncopy(gconf.name, (const char*)(data + e->name_offset), GEOMETRY_NAME_MAX_LENGTH);
+        string_ncopy(gconf.material_name, (const char*)(data + e->material_name_offset), MATERIAL_NAME_MAX_LENGTH);
 
-        // Имя материала геометрии.
-        u32 m_name_length = string_length(g->material_name) + 1;
-        platform_file_write(ksm_file, sizeof(u32), &m_name_length);
-        platform_file_write(ksm_file, sizeof(char) * m_name_length, g->material_name);
+        gconf.center = vec3_create(e->center[0], e->center[1], e->center[2]);
+        gconf.extents.min = vec3_create(e->extents_min[0], e->extents_min[1], e->extents_min[2]);
+        gconf.extents.max = vec3_create(e->extents_max[0], e->extents_max[1], e->extents_max[2]);
 
-        // Размеры и центр геометрии.
-        platform_file_write(ksm_file, sizeof(vec3), &g->center);
-        platform_file_write(ksm_file, sizeof(extents_3d), &g->extents);
+        // NOTE: Отображение доступно только для чтения, данные не изменяются до освобождения.
+        gconf.vertex_size = e->vertex_size;
+        gconf.vertex_count = e->vertex_count;
+        gconf.vertices = (void*)(data + e->vertex_offset);
+        gconf.index_size = e->index_size;
+        gconf.index_count = e->index_count;
+        gconf.indices = (void*)(data + e->index_offset);
 
-        // Вершины (размер/количество/данные вершин)
-        platform_file_write(ksm_file, sizeof(u32), &g->vertex_size);
-        platform_file_write(ksm_file, sizeof(u32), &g->vertex_count);
-        platform_file_write(ksm_file, g->vertex_size * g->vertex_count, g->vertices);
+        if(version != KSM_VERSION_2)
+        {
+            gconf.lod_count = e->lod_count;
+            for(u32 l = 0; l < e->lod_count; ++l)
+            {
+                gconf.lods[l].index_offset = e->lods[l].index_offset;
+                gconf.lods[l].index_count = e->lods[l].index_count;
+                gconf.lods[l].error = e->lods[l].error;
+            }
+        }
 
-        // Индексы (размер/количество/данные индексов)
-        platform_file_write(ksm_file, sizeof(u32), &g->index_size);
-        platform_file_write(ksm_file, sizeof(u32), &g->index_count);
-        platform_file_write(ksm_file, g->index_size * g->index_count, g->indices);
+        darray_push(*out_geometries_darray, gconf);
     }
 
-    platform_file_close(ksm_file);
+    *out_mapping = mapping;
     return true;
 }
 
-//-------------------------------------- OBJ ----------------------------------------------
+bool load_ksm_file(
+    file* ksm_file, const char* path, geometry_config** out_geometries_darray, file_mapping** out_mapping, u16* out_version
+)
+{
+    u64 start_ns = platform_time_absolute_ns();
 
-typedef struct mesh_vertex_index_data {
-    u32 position_index;
-    u32 normal_index;
-    u32 texcoord_index;
-} mesh_vertex_index_data;
-
-typedef struct mesh_face_data {
-    mesh_vertex_index_data vertices[3];
-} mesh_face_data;
-
-typedef struct mesh_group_data {
-    // Используется darray.
-    mesh_face_data* faces;
-    char material_name[MATERIAL_NAME_MAX_LENGTH];
-    bool smooth;
-} mesh_group_data;
-
-typedef struct index_entry {
-    u32 id;                    // По сути собственный индекс.
-    u32 index;                 // Новый индекс.
-    bool has;                  // Указывает что запись существует.
-    struct index_entry *next;  // Следующая запись по текущему id.
-} index_entry;
+    u16 version = 0;
+    if(!platfrom_file_read(ksm_file, sizeof(u16), &version))
+    {
+        kerror("Function '%s': Failed to read version of file '%s'.", __FUNCTION__, path);
+        return false;
+    }
+
+    bool result = false;
+    switch(version)
+    {
+        case KSM_VERSION_1:
+            result = load_ksm_file_v1(ksm_file, out_geometries_darray);
+            break;
+        case KSM_VERSION_2:
+        case KSM_VERSION_3:
+            result = load_ksm_file_v2(path, version, out_geometries_darray, out_mapping);
+            break;
+        default:
+            kerror("Function '%s': Unsupported version %hu of file '%s'.", __FUNCTION__, version, path);
+            return false;
+    }
+
+    if(result)
+    {
+        f64 elapsed_ms = (platform_time_absolute_ns() - start_ns) * 0.000001;
+        kdebug(
+            "Function '%s': File '%s' (version %hu, %llu geometries) loaded in %.3f ms.",
+            __FUNCTION__, path, version, darray_length(*out_geometries_darray), elapsed_ms
+        );
+    }
+
+    *out_version = version;
+    return result;
+}
+
+// Допустимое ухудшение ACMR при упорядочивании кластеров для уменьшения перерисовки.
+#define KSM_OVERDRAW_THRESHOLD 1.05f
 
 /*
-    @brief Выполняет разбор obj файла модели и запись в предоставленные динамические массивы.
-    @param obj_file Указатель на открытый obj файл модели.
-    @param positions Указатель на динамический массив позиций вершин (указатель на darray).
-    @param normals Указатель на динамический массив нормалей вершин (указатель на darray).
-    @param texcoords Указатель на динамический массив координат текстур вершин (указатель на darray).
-    @param groups Указатель на динамический массив групп индексов вершин (указатель на darray).
-    @param out_material_filename Указатель на массив символов для записи имени файла материалов (без расширения).
+    @brief Оптимизирует геометрии перед записью в ksm файл: упорядочивает треугольники для кэша вершин
+           после преобразования и для уменьшения перерисовки, затем вершины в порядке выборки.
+    NOTE: Изменяет данные геометрий, статистика ACMR/ATVR до и после выводится в журнал.
+    @param geometries Динамический массив конфигураций геометрий.
 */
-bool parse_obj_file(file* obj_file, vec3** positions, vec3** normals, vec2** texcoords, mesh_group_data** groups, char* out_material_filename)
+void optimize_geometries(geometry_config* geometries)
 {
-    u64 normal_count = 0;
-    u64 texcoord_count = 0;
-    u64 group_current_index = 0;
-    char bufferline[512] = "";
-    u64 line_length = 0;
-    // u32 line_number = 1;
-    
-    while(platform_file_read_line(obj_file, 511, bufferline, &line_length))
+    u64 geometry_count = darray_length(geometries);
+    for(u64 i = 0; i < geometry_count; ++i)
     {
-        // Пропуск пустых строк и коментариев.
-        if(line_length < 1 || bufferline[0] == '#')
+        geometry_config* g = &geometries[i];
+
+        // NOTE: Переупорядочивание индексов нарушило бы диапазоны уровней детализации.
+        if(g->vertex_size != sizeof(vertex_3d) || g->index_size != sizeof(u32) || g->index_count < 3 || g->lod_count > 0)
         {
-            // line_number++;
             continue;
         }
 
-        if(string_nequali(bufferline, "mtllib ", 7))
-        {
-            // TODO: Может быть несколько файлов.
-            platform_string_sscanf(&bufferline[7], "%s", out_material_filename);
-        }
-        else if(string_nequali(bufferline, "v ", 2))
+        geometry_vertex_cache_stats before, after;
+        geometry_analyze_vertex_cache(g->index_count, g->indices, g->vertex_count, GEOMETRY_VERTEX_CACHE_SIZE, &before);
+
+        geometry_optimize_vertex_cache(g->index_count, g->indices, g->vertex_count);
+        geometry_optimize_overdraw(g->index_count, g->indices, g->vertex_count, g->vertices, KSM_OVERDRAW_THRESHOLD);
+        geometry_optimize_vertex_fetch(g->index_count, g->indices, g->vertex_count, g->vertex_size, g->vertices);
+
+        geometry_analyze_vertex_cache(g->index_count, g->indices, g->vertex_count, GEOMETRY_VERTEX_CACHE_SIZE, &after);
+        kdebug(
+            "Function '%s': Geometry '%s' optimized: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f.",
+            __FUNCTION__, g->name, before.acmr, after.acmr, before.atvr, after.atvr
+        );
+    }
+}
+
+/*
+    @brief Отделяет данные вершин и индексов геометрий от отображения файла (копирует в выделенную память).
+    NOTE: Отображение освобождается, после вызова данные конфигураций можно изменять.
+    @param geometries Динамический массив конфигураций геометрий.
+    @param mapping Отображение файла, в которое указывают данные геометрий.
+*/
+void detach_geometries(geometry_config* geometries, file_mapping* mapping)
+{
+    u64 geometry_count = darray_length(geometries);
+    for(u64 i = 0; i < geometry_count; ++i)
+    {
+        geometry_config* g = &geometries[i];
+        u64 vertices_size = (u64)g->vertex_size * g->vertex_count;
+        u64 indices_size = (u64)g->index_size * g->index_count;
+
+        void* vertices = null;
+        if(vertices_size > 0)
         {
-            vec3 pos;
-            string_to_vec3(&bufferline[2], &pos);
-            darray_push(*positions, pos);
+            vertices = kallocate(vertices_size, MEMORY_TAG_ARRAY);
+            kcopy(vertices, g->vertices, vertices_size);
         }
-        else if(string_nequali(bufferline, "vt ", 3))
+
+        void* indices = null;
+        if(indices_size > 0)
         {
-            vec2 tex;
-            string_to_vec2(&bufferline[3], &tex);
-            darray_push(*texcoords, tex);
-            texcoord_count++;
+            indices = kallocate(indices_size, MEMORY_TAG_ARRAY);
+            kcopy(indices, g->indices, indices_size);
         }
-        else if(string_nequali(bufferline, "vn ", 3))
+
+        g->vertices = vertices;
+        g->indices = indices;
+    }
+
+    platform_file_unmap(mapping);
+}
+
+/*
+    @brief Распаковывает вершины vertex_3d_packed геометрий в vertex_3d для повторной обработки.
+    NOTE: Диапазоном квантования положений являются крайние точки геометрии.
+    @param geometries Динамический массив конфигураций геометрий.
+*/
+void unpack_geometries(geometry_config* geometries)
+{
+    u64 geometry_count = darray_length(geometries);
+    for(u64 i = 0; i < geometry_count; ++i)
+    {
+        geometry_config* g = &geometries[i];
+
+        if(g->vertex_size != sizeof(vertex_3d_packed) || g->vertex_count == 0)
         {
-            vec3 nor;
-            string_to_vec3(&bufferline[3], &nor);
-            darray_push(*normals, nor);
-            normal_count++;
+            continue;
         }
-        else if(string_nequali(bufferline, "usemtl ", 7))
-        {
-            mesh_group_data new_group;
-            string_ncopy(new_group.material_name, &bufferline[7], MATERIAL_NAME_MAX_LENGTH);
-            string_trim(new_group.material_name);
-            new_group.faces = darray_reserve(mesh_face_data, 16384);
 
-            darray_push(*groups, new_group);
+        vertex_3d* vertices = kallocate_tc(vertex_3d, g->vertex_count, MEMORY_TAG_ARRAY);
+        geometry_unpack_vertices(g->vertex_count, g->vertices, &g->extents, vertices);
 
-            // Обновление индекса.
-            group_current_index = darray_length(*groups) - 1;
+        kfree_tc(g->vertices, vertex_3d_packed, g->vertex_count, MEMORY_TAG_ARRAY);
+        g->vertices = vertices;
+        g->vertex_size = sizeof(vertex_3d);
+    }
+}
 
-        }
-        else if(string_nequali(bufferline, "s ", 2))
+// Минимальное количество треугольников геометрии для создания уровней детализации.
+#define KSM_LOD_MIN_TRIANGLES 64
+// Допустимая ошибка первого упрощенного уровня относительно диагонали ограничивающего объема
+// (удваивается на каждом следующем уровне).
+#define KSM_LOD_BASE_ERROR 0.01f
+// Уровень отбрасывается, если упрощение сократило индексы предыдущего уровня меньше чем до этой доли.
+#define KSM_LOD_MIN_REDUCTION 0.8f
+
+/*
+    @brief Создает уровни детализации геометрий: каждый следующий уровень упрощается из исходной
+           геометрии до половины индексов предыдущего уровня с удвоенной допустимой ошибкой.
+    NOTE: Индексы всех уровней записываются в общий массив индексов геометрии друг за другом,
+          уровень 0 - исходные индексы. Вершины общие для всех уровней.
+    @param geometries Динамический массив конфигураций геометрий.
+*/
+void generate_geometry_lods(geometry_config* geometries)
+{
+    u64 geometry_count = darray_length(geometries);
+    for(u64 i = 0; i < geometry_count; ++i)
+    {
+        geometry_config* g = &geometries[i];
+
+        if(g->vertex_size != sizeof(vertex_3d) || g->index_size != sizeof(u32) || g->lod_count > 0
+        || g->index_count < KSM_LOD_MIN_TRIANGLES * 3)
         {
-            // TODO: Обработать!
+            continue;
         }
-        else if(string_nequali(bufferline, "g ", 2))
+
+        // Диагональ ограничивающего объема для перевода относительной ошибки в локальные единицы.
+        const vertex_3d* vertices = g->vertices;
+        vec3 min = vertices[0].position;
+        vec3 max = vertices[0].position;
+        for(u32 v = 1; v < g->vertex_count; ++v)
         {
-            // TODO: Обработать!
-            
+            min = vec3_min(min, vertices[v].position);
+            max = vec3_max(max, vertices[v].position);
         }
-        else if(string_nequali(bufferline, "f ", 2))
+        f32 diagonal = vec3_distance(min, max);
+
+        u32* lod_indices[GEOMETRY_LOD_MAX] = { g->indices };
+        g->lods[0].index_offset = 0;
+        g->lods[0].index_count = g->index_count;
+        g->lods[0].error = 0.0f;
+        u32 lod_count = 1;
+        u32 total_index_count = g->index_count;
+        f32 target_error = diagonal * KSM_LOD_BASE_ERROR;
+
+        while(lod_count < GEOMETRY_LOD_MAX)
         {
-            // face                        vert 1      vert 2      vert 3
-            // f 1 2 3             ==        1            2           3
-            // f 1/1/1 2/2/2 3/3/3 == pos/tex/norm pos/tex/norm pos/tex/norm
-            mesh_face_data face;
+            u32 previous_count = g->lods[lod_count - 1].index_count;
+            u32 target_count = (previous_count / 6) * 3;
 
-            if(normal_count == 0 || texcoord_count == 0)
-            {
-                platform_string_sscanf(
-                    &bufferline[2], "%d %d %d",
-                    &face.vertices[0].position_index, &face.vertices[1].position_index, &face.vertices[2].position_index
-                );
-            }
-            else
+            u32* indices = kallocate_tc(u32, g->index_count, MEMORY_TAG_ARRAY);
+            f32 error = 0.0f;
+            u32 count = geometry_simplify(
+                g->index_count, g->indices, g->vertex_count, vertices, target_count, target_error, indices, &error
+            );
+
+            if(count == 0 || count > previous_count * KSM_LOD_MIN_REDUCTION)
             {
-                platform_string_sscanf(
-                    &bufferline[2], "%d/%d/%d %d/%d/%d %d/%d/%d",
-                    &face.vertices[0].position_index, &face.vertices[0].texcoord_index, &face.vertices[0].normal_index,
-                    &face.vertices[1].position_index, &face.vertices[1].texcoord_index, &face.vertices[1].normal_index,
-                    &face.vertices[2].position_index, &face.vertices[2].texcoord_index, &face.vertices[2].normal_index
-                );
+                kfree_tc(indices, u32, g->index_count, MEMORY_TAG_ARRAY);
+                break;
             }
 
-            darray_push((*groups)[group_current_index].faces, face);
+            geometry_optimize_vertex_cache(count, indices, g->vertex_count);
+
+            lod_indices[lod_count] = indices;
+            g->lods[lod_count].index_offset = total_index_count;
+            g->lods[lod_count].index_count = count;
+            g->lods[lod_count].error = error;
+            total_index_count += count;
+            lod_count++;
+            target_error *= 2.0f;
         }
 
-        kzero_tc(bufferline, char, 512);
-        // line_number++;
-    }
+        if(lod_count == 1)
+        {
+            continue;
+        }
+
+        // Объединение уровней в общий массив индексов.
+        u32* indices = kallocate_tc(u32, total_index_count, MEMORY_TAG_ARRAY);
+        for(u32 l = 0; l < lod_count; ++l)
+        {
+            kcopy_tc(indices + g->lods[l].index_offset, lod_indices[l], u32, g->lods[l].index_count);
+        }
 
-    // NOTE: Раскоментировать для отладки.
-    // kdebug("PARSE OBJ FILE STATISTIC:");
-    // kdebug("Position count %llu", darray_length(*positions));
-    // kdebug("Texcoord count %llu", darray_length(*texcoords));
-    // kdebug("Normal   count %llu", darray_length(*normals));
+        for(u32 l = 1; l < lod_count; ++l)
+        {
+            kfree_tc(lod_indices[l], u32, g->index_count, MEMORY_TAG_ARRAY);
+        }
+        kfree_tc(g->indices, u32, g->index_count, MEMORY_TAG_ARRAY);
 
-    // u64 gcount = darray_length(*groups);
-    // kdebug("Group    count %llu", gcount);
-    // for(u64 i = 0; i < gcount; ++i)
-    // {
-    //     kdebug("->[%2llu]: %llu faces.", i, darray_length((*groups)[i].faces) * 3);
-    // }
+        g->indices = indices;
+        g->index_count = total_index_count;
+        g->lod_count = lod_count;
 
-    return true;
+        kdebug(
+            "Function '%s': Geometry '%s' LOD triangles: %u, %u, %u, %u.", __FUNCTION__, g->name,
+            g->lods[0].index_count / 3, g->lods[1].index_count / 3,
+            lod_count > 2 ? g->lods[2].index_count / 3 : 0, lod_count > 3 ? g->lods[3].index_count / 3 : 0
+        );
+    }
 }
 
 /*
-    @brief Конвертирует данные obj файла из предоставленных динамических массивов в geometry_config.
-    @param positions Указатель на динамический массив позиций вершин (указатель на darray).
-    @param normals Указатель на динамический массив нормалей вершин (указатель на darray).
-    @param texcoords Указатель на динамический массив координат текстур вершин (указатель на darray).
-    @param group Указатель на группу индексов вершин.
-    @param config Указатель на geometry_config элемент для выполнения записи данных.
+    @brief Упаковывает вершины vertex_3d геометрий в vertex_3d_packed перед записью в ksm файл.
+    NOTE: Крайние точки геометрий заменяются диапазоном квантования положений (совпадает с ограничивающим объемом).
+    @param geometries Динамический массив конфигураций геометрий.
 */
-bool convert_obj_group_to(vec3* positions, vec3* normals, vec2* texcoords, mesh_group_data* group, geometry_config* config)
+void pack_geometries(geometry_config* geometries)
 {
-    // Копирование имени материала.
-    string_ncopy(config->material_name, group->material_name, MATERIAL_NAME_MAX_LENGTH);
+    u64 size_before = 0;
+    u64 size_after = 0;
+
+    u64 geometry_count = darray_length(geometries);
+    for(u64 i = 0; i < geometry_count; ++i)
+    {
+        geometry_config* g = &geometries[i];
+        size_before += (u64)g->vertex_size * g->vertex_count;
 
-    bool extent_set = false;
-    kzero_tc(&config->extents, extents_3d, 1);
+        if(g->vertex_size == sizeof(vertex_3d) && g->vertex_count > 0)
+        {
+            vertex_3d_packed* packed = kallocate_tc(vertex_3d_packed, g->vertex_count, MEMORY_TAG_ARRAY);
+            geometry_pack_vertices(g->vertex_count, g->vertices, packed, &g->extents);
 
-    u32 position_index = 0;
-    u64 position_count = darray_length(positions);
-    u64 normal_count = darray_length(normals);
-    u64 texcoord_count = darray_length(texcoords);
+            kfree_tc(g->vertices, vertex_3d, g->vertex_count, MEMORY_TAG_ARRAY);
+            g->vertices = packed;
+            g->vertex_size = sizeof(vertex_3d_packed);
+        }
 
-    // Вспомогательная индексная таблица (помогает исключить дублирование).
-    u64 existing_index_next = position_count;
-    index_entry* existing_indices = darray_reserve(index_entry, position_count);
-    kzero_tc(existing_indices, index_entry, position_count);
+        size_after += (u64)g->vertex_size * g->vertex_count;
+    }
+
+    kdebug(
+        "Function '%s': Vertex data packed: %llu KiB -> %llu KiB.", __FUNCTION__, size_before / 1024, size_after / 1024
+    );
+}
 
-    // Преобразование лицевых поверхностей
-    u64 faces_count = darray_length(group->faces);
-    for(u64 f = 0; f < faces_count; ++f)
+// @brief Записывает нулевые байты выравнивания до указанного смещения.
+static void ksm_write_padding(file* ksm_file, u64* position, u64 alignment)
+{
+    static const u8 zeros[KSM_DATA_ALIGNMENT] = {};
+    u64 aligned = get_aligned(*position, alignment);
+    if(aligned > *position)
     {
-        mesh_face_data* face = &group->faces[f];
-        vertex_3d current_vert;
+        platform_file_write(ksm_file, aligned - *position, zeros);
+        *position = aligned;
+    }
+}
 
-        for(u64 i = 0; i < 3; ++i)
-        {
-            mesh_vertex_index_data* index_data = &face->vertices[i];
-            u32 obj_position_index = index_data->position_index - 1;
+bool write_ksm_file(const char* name, geometry_config* geometries, bool overwrite)
+{
+    char ksm_filepath[GEOMETRY_NAME_MAX_LENGTH];
+    string_format(ksm_filepath, "%s/models/%s.ksm", resource_system_base_path(), name);
 
-            // Создание вершины, вероятно новой.
-            current_vert.position = positions[obj_position_index];
-            current_vert.texcoord = texcoord_count ? texcoords[index_data->texcoord_index - 1] : vec2_zero();
-            current_vert.normal = normal_count ? normals[index_data->normal_index - 1] : vec3_create(0, 0, 1);
-            current_vert.color = vec4_one();    // TODO: Цвет. А пока по умолчанию белый цвет.
-            current_vert.tangent = vec4_zero(); // TODO: Тангент. А пока по умолчанию 0 вектор.
+    if(!overwrite && platform_file_exists(ksm_filepath))
+    {
+        // kwarng("Function '%s': File '%s' is already exists.", __FUNCTION__, ksm_filepath);
+        return false;
+    }
 
-            // Поиск существующего индекса. Вероятно это может быть та самая вершина, если это не так, то
-            // назначим ей новый индекс и по старому индексу сохраним ссылку на следующий индекс и т.д.
-            if(existing_indices[obj_position_index].has)
-            {
-                // Получение записи во вспомогательной индексной таблице.
-                index_entry* entry = &existing_indices[obj_position_index];
-                index_entry* prev  = null;
-                bool found = false;
-
-                // NOTE: Раскоментировать для отладки.
-                // kerror("Face trace: v/vt/vn: %u/%u/%u", index_data->position_index, index_data->texcoord_index, index_data->normal_index);
-                // kwarng(
-                //     "Current  pos: x=%.6f, y=%.6f, z=%.6f, tex: u=%.6f, v=%.6f, norm: x=%.6f, y=%.6f, z=%.6f",
-                //     current_vert.position.x, current_vert.position.y, current_vert.position.z,
-                //     current_vert.texcoord.u, current_vert.texcoord.v,
-                //     current_vert.normal.x, current_vert.normal.y, current_vert.normal.z
-                // );
-
-                // Поиск..
-                while(entry)
-                {
-                    // NOTE: тип config->vertices это void* из-за чего индексация будет побайтной, а потому необходимо
-                    //       привести к vertex_3d*.
-                    vertex_3d* exist_vert = &((vertex_3d*)config->vertices)[entry->index];
-
-                    // NOTE: Раскоментировать для отладки.
-                    // ktrace(
-                    //     "Existing pos: x=%.6f, y=%.6f, z=%.6f, tex: u=%.6f, v=%.6f, norm: x=%.6f, y=%.6f, z=%.6f",
-                    //     exist_vert->position.x, exist_vert->position.y, exist_vert->position.z,
-                    //     exist_vert->texcoord.u, exist_vert->texcoord.v,
-                    //     exist_vert->normal.x, exist_vert->normal.y, exist_vert->normal.z
-                    // );
-
-                    if(vertex_3d_equal(*exist_vert, current_vert))
-                    {
-                        obj_position_index = entry->id;
-                        found = true;
-                        break;
-                    }
-
-                    prev  = entry;
-                    entry = entry->next;
-                }
-
-                // Необходима дополнительная запись для одинаковых индексов.
-                if(!found)
-                {
-                    u64 current_capacity = darray_capacity(existing_indices);
-                    if(existing_index_next >= current_capacity)
-                    {
-                        u64 new_capacity = current_capacity * 2;
-                        index_entry* new = darray_reserve(index_entry, new_capacity);
-                        kzero_tc(new, index_entry, new_capacity);
-                        kcopy_tc(new, existing_indices, index_entry, current_capacity);
-
-                        darray_destroy(existing_indices);
-                        existing_indices = new;
-                    }
-
-                    prev->next = &existing_indices[existing_index_next];
-                    obj_position_index = existing_index_next++;
-                }
-            }
+    file* ksm_file;
+    if(!platform_file_open(ksm_filepath, FILE_MODE_WRITE | FILE_MODE_BINARY, &ksm_file))
+    {
+        kerror("Function '%s': Cannot open file '%s' for binary writing. Skipping...", __FUNCTION__, ksm_filepath);
+        return false;
+    }
 
-            // Добавление вершины и индекса.
-            if(!existing_indices[obj_position_index].has)
-            {
-                existing_indices[obj_position_index].id = obj_position_index;
-                existing_indices[obj_position_index].index = position_index;
-                existing_indices[obj_position_index].has = true;
-
-                darray_push(config->vertices, current_vert);
-                position_index++;
-
-                // Получаем минимальную точку занимаемой моделью в пространстве.
-                if(current_vert.position.x < config->extents.min.x || !extent_set)
-                {
-                    config->extents.min.x = current_vert.position.x;
-                }
-
-                if(current_vert.position.y < config->extents.min.y || !extent_set)
-                {
-                    config->extents.min.y = current_vert.position.y;
-                }
-
-                if(current_vert.position.z < config->extents.min.z || !extent_set)
-                {
-                    config->extents.min.z = current_vert.position.z;
-                }
-
-                // Получаем максимальную точку занимаемой моделью в пространстве.
-                if(current_vert.position.x > config->extents.max.x || !extent_set)
-                {
-                    config->extents.max.x = current_vert.position.x;
-                }
-
-                if(current_vert.position.y > config->extents.max.y || !extent_set)
-                {
-                    config->extents.max.y = current_vert.position.y;
-                }
-
-                if(current_vert.position.z > config->extents.max.z || !extent_set)
-                {
-                    config->extents.max.z = current_vert.position.z;
-                }
-
-                // Начальная инициализация крайних точек завершена.
-                extent_set = true;
-            }
+    u64 geometry_count = darray_length(geometries);
+    ksm_geometry_entry* entries = kallocate_tc(ksm_geometry_entry, geometry_count, MEMORY_TAG_ARRAY);
+    kzero_tc(entries, ksm_geometry_entry, geometry_count);
+
+    // Расчет расположения: заголовок, таблица геометрий, строки, данные.
+    ksm_header header = {};
+    header.version = KSM_VERSION_3;
+    header.header_size = sizeof(ksm_header);
+    header.geometry_count = geometry_count;
+    header.table_offset = sizeof(ksm_header);
+    header.name_offset = header.table_offset + sizeof(ksm_geometry_entry) * geometry_count;
+    header.name_length = string_length(name) + 1;
+
+    u64 position = header.name_offset + header.name_length;
+    for(u64 i = 0; i < geometry_count; ++i)
+    {
+        geometry_config* g = &geometries[i];
+        ksm_geometry_entry* e = &entries[i];
+
+        e->name_offset = position;
+        e->name_length = string_length(g->name) + 1;
+        position += e->name_length;
+
+        e->material_name_offset = position;
+        e->material_name_length = string_length(g->material_name) + 1;
+        position += e->material_name_length;
+    }
+
+    for(u64 i = 0; i < geometry_count; ++i)
+    {
+        geometry_config* g = &geometries[i];
+        ksm_geometry_entry* e = &entries[i];
+
+        for(u8 j = 0; j < 3; ++j)
+        {
+            e->center[j] = g->center.elements[j];
+            e->extents_min[j] = g->extents.min.elements[j];
+            e->extents_max[j] = g->extents.max.elements[j];
+        }
 
-            darray_push(config->indices, existing_indices[obj_position_index].index);
+        e->vertex_size = g->vertex_size;
+        e->vertex_count = g->vertex_count;
+        e->vertex_offset = get_aligned(position, KSM_DATA_ALIGNMENT);
+        position = e->vertex_offset + (u64)g->vertex_size * g->vertex_count;
+
+        e->index_size = g->index_size;
+        e->index_count = g->index_count;
+        e->index_offset = get_aligned(position, KSM_DATA_ALIGNMENT);
+        position = e->index_offset + (u64)g->index_size * g->index_count;
+
+        e->lod_count = g->lod_count;
+        for(u32 l = 0; l < g->lod_count; ++l)
+        {
+            e->lods[l].index_offset = g->lods[l].index_offset;
+            e->lods[l].index_count = g->lods[l].index_count;
+            e->lods[l].error = g->lods[l].error;
         }
     }
 
-    // Уничтожение вспомогательной таблицы индексов.
-    darray_destroy(existing_indices);
+    header.file_size = position;
+
+    // Запись в порядке расположения.
+    platform_file_write(ksm_file, sizeof(ksm_header), &header);
+    platform_file_write(ksm_file, sizeof(ksm_geometry_entry) * geometry_count, entries);
+    platform_file_write(ksm_file, header.name_length, name);
+    position = header.name_offset + header.name_length;
+
+    for(u64 i = 0; i < geometry_count; ++i)
+    {
+        platform_file_write(ksm_file, entries[i].name_length, geometries[i].name);
+        platform_file_write(ksm_file, entries[i].material_name_length, geometries[i].material_name);
+        position += entries[i].name_length + entries[i].material_name_length;
+    }
+
+    for(u64 i = 0; i < geometry_count; ++i)
+    {
+        geometry_config* g = &geometries[i];
+        u64 vertices_size = (u64)g->vertex_size * g->vertex_count;
+        u64 indices_size = (u64)g->index_size * g->index_count;
+
+        ksm_write_padding(ksm_file, &position, KSM_DATA_ALIGNMENT);
+        platform_file_write(ksm_file, vertices_size, g->vertices);
+        position += vertices_size;
+
+        ksm_write_padding(ksm_file, &position, KSM_DATA_ALIGNMENT);
+        platform_file_write(ksm_file, indices_size, g->indices);
+        position += indices_size;
+    }
 
+    kfree_tc(entries, ksm_geometry_entry, geometry_count, MEMORY_TAG_ARRAY);
+    platform_file_close(ksm_file);
     return true;
 }
 
+//-------------------------------------- OBJ ----------------------------------------------
+
 // TODO: Переработать!
 // NOTE: Выглядит ужасно, но это временная мера.
 bool import_mtl_file(const char* mtl_filename, const char* kmt_filename)
@@ -704,49 +963,56 @@ bool import_mtl_file(const char* mtl_filename, const char* kmt_filename)
     return true;
 }
 
-bool load_obj_file(file* obj_file, const char* name, geometry_config** out_geometries_darray)
+bool load_obj_file(const char* path, const char* name, geometry_config** out_geometries_darray)
 {
-    char mtl_filename[MATERIAL_NAME_MAX_LENGTH];
-    vec3* positions = darray_reserve(vec3, 16384);
-    vec3* normals = darray_reserve(vec3, 16384);
-    vec2* texcoords = darray_reserve(vec2, 16384);
-    mesh_group_data* groups = darray_reserve(mesh_group_data, 4);
+    u64 start_ns = platform_time_absolute_ns();
 
     // Разбор obj файла и формирование исходных данных.
-    parse_obj_file(obj_file, &positions, &normals, &texcoords, &groups, mtl_filename);
+    obj_data data;
+    if(!obj_parse_file(path, 0, &data))
+    {
+        return false;
+    }
 
-    u32 group_count = darray_length(groups);
-    u32 normal_count = darray_length(normals);
-    u32 texcoord_count = darray_length(texcoords);
+    u64 parse_ns = platform_time_absolute_ns();
 
     // Формирование групп геометрий.
-    for(u64 i = 0; i < group_count; ++i)
+    for(u64 i = 0; i < data.group_count; ++i)
     {
+        obj_group_data* group = &data.groups[i];
+
+        // Пропуск групп без лицевых поверхностей.
+        if(!group->face_count)
+        {
+            continue;
+        }
+
         // TODO: Временная функция импорта материалов из mtl в kmt.
-        import_mtl_file(mtl_filename, groups[i].material_name);
+        import_mtl_file(data.material_filename, group->material_name);
 
         geometry_config new_config;
         string_ncopy(new_config.name, name, GEOMETRY_NAME_MAX_LENGTH);
-        string_append_u64(new_config.name, new_config.name, i);
+        string_append_u64(new_config.name, new_config.name, darray_length(*out_geometries_darray));
 
-        u64 optimal_capacity = darray_length(groups[i].faces);
+        // NOTE: Индексов ровно по количеству углов лицевых поверхностей, вершин обычно не больше, чем позиций.
+        u64 corner_count = group->face_count * 3;
         new_config.vertex_size = sizeof(vertex_3d);
-        new_config.vertices = darray_reserve(vertex_3d, optimal_capacity);
+        new_config.vertices = darray_reserve(vertex_3d, KMIN(corner_count, data.position_count));
         new_config.index_size = sizeof(u32);
-        new_config.indices = darray_reserve(u32, optimal_capacity);
+        new_config.indices = darray_reserve(u32, corner_count);
 
-        if(!normal_count)
+        if(!data.normal_count)
         {
             kwarng("Function '%s': No normals are present in model '%s' (group %llu).", __FUNCTION__, name, i);
         }
 
-        if(!texcoord_count)
+        if(!data.texcoord_count)
         {
             kwarng("Function '%s': No texture coordinates are present in model '%s' (group %llu).", __FUNCTION__, name, i);
         }
 
         // Получение первой группы.
-        convert_obj_group_to(positions, normals, texcoords, &groups[i], &new_config);
+        obj_group_convert(&data, group, &new_config);
 
         // TODO: В отдельную функцию.
         // Расчет центра модели на основе крайних точек модели.
@@ -777,16 +1043,15 @@ bool load_obj_file(file* obj_file, const char* name, geometry_config** out_geome
 
         // Записть конечного результата.
         darray_push(*out_geometries_darray, new_config);
-
-        // Очистка текущей группы (генерируется в parse_obj_file).
-        darray_destroy(groups[i].faces);
     }
 
-    // Освобождение darray массивов.
-    darray_destroy(groups);
-    darray_destroy(positions);
-    darray_destroy(normals);
-    darray_destroy(texcoords);
+    obj_data_free(&data);
+
+    u64 end_ns = platform_time_absolute_ns();
+    kdebug(
+        "Function '%s': File '%s' imported in %.3f ms (parse %.3f ms, %llu geometries).",
+        __FUNCTION__, path, (end_ns - start_ns) * 0.000001, (parse_ns - start_ns) * 0.000001, darray_length(*out_geometries_darray)
+    );
 
     return true;
 }
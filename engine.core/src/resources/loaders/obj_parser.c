@@ -0,0 +1,662 @@
+// Собственные подключения.
+#include "resources/loaders/obj_parser.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "kstring.h"
+#include "math/kmath.h"
+#include "memory/memory.h"
+#include "platform/file.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "containers/darray.h"
+
+// Максимальное количество потоков разбора.
+#define OBJ_PARSER_MAX_THREADS 16
+// Минимальный размер части файла на поток (меньшие файлы разбираются меньшим количеством потоков).
+#define OBJ_PARSER_MIN_CHUNK_SIZE KIBIBYTES(256)
+
+// @brief Часть файла, разбираемая одним потоком.
+typedef struct obj_chunk {
+    const char* begin;
+    const char* end;
+
+    // Количество элементов в части (первый проход).
+    u64 position_count;
+    u64 normal_count;
+    u64 texcoord_count;
+    u64 face_count;
+    u64 group_count;
+
+    // Смещения элементов части в общих массивах (второй проход).
+    u64 position_offset;
+    u64 normal_offset;
+    u64 texcoord_offset;
+    u64 face_offset;
+    u64 group_offset;
+
+    // Первое упоминание файла материалов в части.
+    const char* mtllib;
+    u64 mtllib_length;
+
+    // Первая лицевая поверхность с индексом за пределами элементов файла (INVALID_ID_U64 - нет).
+    u64 invalid_face;
+
+    // Общий результат (второй проход).
+    obj_data* data;
+    // Текущий проход: false - подсчет, true - разбор.
+    bool parse;
+} obj_chunk;
+
+// Степени 10 точно представимые в f64.
+static const f64 obj_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+KINLINE bool obj_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+KINLINE bool obj_is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+KINLINE const char* obj_skip_spaces(const char* p, const char* end)
+{
+    while(p < end && obj_is_space(*p)) p++;
+    return p;
+}
+
+/*
+    @brief Проверяет, начинается ли строка с ключевого слова (без учета регистра), за которым следует пробел.
+    NOTE: Ключевое слово задается строчными буквами: 'c | 0x20' совпадает с ним только для той же буквы.
+*/
+KINLINE bool obj_keyword(const char* p, const char* end, const char* keyword, u64 length)
+{
+    if((u64)(end - p) <= length) return false;
+
+    for(u64 i = 0; i < length; ++i)
+    {
+        if((p[i] | 0x20) != keyword[i]) return false;
+    }
+
+    return obj_is_space(p[length]);
+}
+
+/*
+    @brief Разбирает число с плавающей точкой (знак, целая и дробная части, экспонента).
+    NOTE: Значащими считаются первые 19 цифр, чего достаточно для точности f32.
+*/
+static f32 obj_parse_f32(const char** cursor, const char* end)
+{
+    const char* p = obj_skip_spaces(*cursor, end);
+
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+
+    u64 mantissa = 0;
+    i32 digits = 0;
+    i32 exponent = 0;
+
+    for(; p < end && obj_is_digit(*p); ++p)
+    {
+        if(digits < 19)
+        {
+            mantissa = mantissa * 10 + (u64)(*p - '0');
+            if(mantissa) digits++;
+        }
+        else
+        {
+            exponent++;
+        }
+    }
+
+    if(p < end && *p == '.')
+    {
+        for(++p; p < end && obj_is_digit(*p); ++p)
+        {
+            if(digits < 19)
+            {
+                mantissa = mantissa * 10 + (u64)(*p - '0');
+                if(mantissa) digits++;
+                exponent--;
+            }
+        }
+    }
+
+    if(p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char* e = p + 1;
+        bool exponent_negative = false;
+        if(e < end && (*e == '-' || *e == '+'))
+        {
+            exponent_negative = *e == '-';
+            e++;
+        }
+
+        if(e < end && obj_is_digit(*e))
+        {
+            i32 value = 0;
+            for(; e < end && obj_is_digit(*e); ++e)
+            {
+                if(value < 10000) value = value * 10 + (*e - '0');
+            }
+            exponent += exponent_negative ? -value : value;
+            p = e;
+        }
+    }
+
+    f64 result = (f64)mantissa;
+    if(mantissa)
+    {
+        // NOTE: Деление на точную степень 10 дает корректное округление для типичных значений obj.
+        while(exponent < -22)
+        {
+            result /= obj_pow10[22];
+            exponent += 22;
+        }
+
+        while(exponent > 22)
+        {
+            result *= obj_pow10[22];
+            exponent -= 22;
+        }
+
+        result = exponent < 0 ? result / obj_pow10[-exponent] : result * obj_pow10[exponent];
+    }
+
+    *cursor = p;
+    return (f32)(negative ? -result : result);
+}
+
+// @brief Разбирает целое число со знаком, при отсутствии числа возвращает 0 и не сдвигает курсор.
+static i64 obj_parse_i64(const char** cursor, const char* end)
+{
+    const char* p = *cursor;
+
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+
+    if(p >= end || !obj_is_digit(*p))
+    {
+        return 0;
+    }
+
+    i64 value = 0;
+    for(; p < end && obj_is_digit(*p); ++p)
+    {
+        value = value * 10 + (*p - '0');
+    }
+
+    *cursor = p;
+    return negative ? -value : value;
+}
+
+/*
+    @brief Преобразует индекс obj (отрицательный - относительно текущего количества элементов) в индекс от 1.
+    @return Индекс от 1, INVALID_ID если индекс нулевой или выходит за пределы u32.
+*/
+KINLINE u32 obj_resolve_index(i64 index, u64 current_count)
+{
+    if(index < 0)
+    {
+        index += (i64)current_count + 1;
+    }
+
+    return index > 0 && index < INVALID_ID ? (u32)index : INVALID_ID;
+}
+
+// @brief Копирует имя до конца строки (без завершающих пробелов) в буфер с завершающим нулем.
+static void obj_copy_name(char* dest, u64 max_length, const char* p, const char* end)
+{
+    p = obj_skip_spaces(p, end);
+    while(end > p && obj_is_space(end[-1])) end--;
+
+    u64 length = KMIN((u64)(end - p), max_length - 1);
+    kcopy(dest, p, length);
+    dest[length] = '\0';
+}
+
+/*
+    @brief Обрабатывает часть файла: на первом проходе подсчитывает элементы,
+           на втором разбирает их в общие массивы по смещениям части.
+    NOTE: Выполняется в отдельном потоке, поэтому не выделяет память и не пишет в журнал.
+*/
+static void obj_chunk_process(void* params)
+{
+    obj_chunk* chunk = params;
+    obj_data* data = chunk->data;
+    const char* line = chunk->begin;
+    const char* chunk_end = chunk->end;
+
+    u64 position_count = 0;
+    u64 normal_count = 0;
+    u64 texcoord_count = 0;
+    u64 face_count = 0;
+    u64 group_count = 0;
+
+    while(line < chunk_end)
+    {
+        const char* end = platform_memory_find(line, chunk_end - line, '\n');
+        const char* next = end ? end + 1 : chunk_end;
+        if(!end) end = chunk_end;
+
+        const char* p = obj_skip_spaces(line, end);
+        line = next;
+
+        if(p >= end || *p == '#')
+        {
+            continue;
+        }
+
+        if(obj_keyword(p, end, "v", 1))
+        {
+            if(chunk->parse)
+            {
+                vec3* position = &data->positions[chunk->position_offset + position_count];
+                p += 1;
+                position->x = obj_parse_f32(&p, end);
+                position->y = obj_parse_f32(&p, end);
+                position->z = obj_parse_f32(&p, end);
+            }
+            position_count++;
+        }
+        else if(obj_keyword(p, end, "vt", 2))
+        {
+            if(chunk->parse)
+            {
+                vec2* texcoord = &data->texcoords[chunk->texcoord_offset + texcoord_count];
+                p += 2;
+                texcoord->x = obj_parse_f32(&p, end);
+                texcoord->y = obj_parse_f32(&p, end);
+            }
+            texcoord_count++;
+        }
+        else if(obj_keyword(p, end, "vn", 2))
+        {
+            if(chunk->parse)
+            {
+                vec3* normal = &data->normals[chunk->normal_offset + normal_count];
+                p += 2;
+                normal->x = obj_parse_f32(&p, end);
+                normal->y = obj_parse_f32(&p, end);
+                normal->z = obj_parse_f32(&p, end);
+            }
+            normal_count++;
+        }
+        else if(obj_keyword(p, end, "f", 1))
+        {
+            // face                        vert 1      vert 2      vert 3
+            // f 1 2 3             ==        1            2           3
+            // f 1/1/1 2/2/2 3/3/3 == pos/tex/norm pos/tex/norm pos/tex/norm
+            // f 1//1 2//2 3//3    == pos//norm    pos//norm    pos//norm
+            if(chunk->parse)
+            {
+                obj_face_data* face = &data->faces[chunk->face_offset + face_count];
+                u64 current_positions = chunk->position_offset + position_count;
+                u64 current_texcoords = chunk->texcoord_offset + texcoord_count;
+                u64 current_normals = chunk->normal_offset + normal_count;
+                p += 1;
+
+                for(u32 i = 0; i < 3; ++i)
+                {
+                    obj_vertex_index_data* vertex = &face->vertices[i];
+                    p = obj_skip_spaces(p, end);
+                    vertex->position_index = obj_resolve_index(obj_parse_i64(&p, end), current_positions);
+                    vertex->texcoord_index = 0;
+                    vertex->normal_index = 0;
+
+                    if(p < end && *p == '/')
+                    {
+                        p++;
+                        if(p < end && *p != '/')
+                        {
+                            vertex->texcoord_index = obj_resolve_index(obj_parse_i64(&p, end), current_texcoords);
+                        }
+
+                        if(p < end && *p == '/')
+                        {
+                            p++;
+                            vertex->normal_index = obj_resolve_index(obj_parse_i64(&p, end), current_normals);
+                        }
+                    }
+
+                    // NOTE: Индексы проверяются по общему количеству элементов, известному после первого прохода.
+                    if(
+                        vertex->position_index > data->position_count || vertex->texcoord_index > data->texcoord_count
+                        || vertex->normal_index > data->normal_count
+                    )
+                    {
+                        chunk->invalid_face = KMIN(chunk->invalid_face, chunk->face_offset + face_count);
+                    }
+                }
+            }
+            face_count++;
+        }
+        else if(obj_keyword(p, end, "usemtl", 6))
+        {
+            if(chunk->parse)
+            {
+                obj_group_data* group = &data->groups[chunk->group_offset + group_count];
+                obj_copy_name(group->material_name, MATERIAL_NAME_MAX_LENGTH, p + 6, end);
+                group->first_face = chunk->face_offset + face_count;
+            }
+            group_count++;
+        }
+        else if(obj_keyword(p, end, "mtllib", 6))
+        {
+            // TODO: Может быть несколько файлов, используется только первый.
+            if(!chunk->mtllib)
+            {
+                const char* name = obj_skip_spaces(p + 6, end);
+                const char* name_end = name;
+                while(name_end < end && !obj_is_space(*name_end)) name_end++;
+
+                chunk->mtllib = name;
+                chunk->mtllib_length = name_end - name;
+            }
+        }
+        // TODO: Обработать 's' и 'g'!
+    }
+
+    chunk->position_count = position_count;
+    chunk->normal_count = normal_count;
+    chunk->texcoord_count = texcoord_count;
+    chunk->face_count = face_count;
+    chunk->group_count = group_count;
+}
+
+// @brief Выполняет обработку всех частей: первая часть в текущем потоке, остальные в дополнительных.
+static void obj_chunks_process(obj_chunk* chunks, u32 chunk_count)
+{
+    platform_thread threads[OBJ_PARSER_MAX_THREADS];
+    bool started[OBJ_PARSER_MAX_THREADS] = {};
+
+    for(u32 i = 1; i < chunk_count; ++i)
+    {
+        started[i] = platform_thread_create(obj_chunk_process, &chunks[i], &threads[i]);
+    }
+
+    obj_chunk_process(&chunks[0]);
+
+    for(u32 i = 1; i < chunk_count; ++i)
+    {
+        if(started[i])
+        {
+            platform_thread_join(&threads[i]);
+        }
+        else
+        {
+            // Поток не был создан: обработка в текущем потоке.
+            obj_chunk_process(&chunks[i]);
+        }
+    }
+}
+
+bool obj_parse_file(const char* path, u32 thread_count, obj_data* out_data)
+{
+    kzero_tc(out_data, obj_data, 1);
+
+    file_mapping* mapping = null;
+    if(!platform_file_map(path, &mapping))
+    {
+        kerror("Function '%s': Failed to map file '%s'.", __FUNCTION__, path);
+        return false;
+    }
+
+    bool result = obj_parse_buffer(platform_file_mapping_data(mapping), platform_file_mapping_size(mapping), thread_count, out_data);
+    platform_file_unmap(mapping);
+    return result;
+}
+
+bool obj_parse_buffer(const char* text, u64 size, u32 thread_count, obj_data* out_data)
+{
+    kzero_tc(out_data, obj_data, 1);
+
+    if(!text && size)
+    {
+        kerror("Function '%s' requires a valid pointer to text.", __FUNCTION__);
+        return false;
+    }
+
+    // Разделение текста на части по границам строк.
+    if(!thread_count)
+    {
+        thread_count = platform_thread_processor_count();
+    }
+
+    u32 chunk_count = KMIN(thread_count, OBJ_PARSER_MAX_THREADS);
+    chunk_count = KMIN(chunk_count, size / OBJ_PARSER_MIN_CHUNK_SIZE + 1);
+
+    obj_chunk chunks[OBJ_PARSER_MAX_THREADS];
+    kzero_tc(chunks, obj_chunk, chunk_count);
+
+    const char* text_end = text + size;
+    const char* chunk_begin = text;
+    for(u32 i = 0; i < chunk_count; ++i)
+    {
+        const char* chunk_end = text_end;
+        if(i + 1 < chunk_count)
+        {
+            chunk_end = text + size / chunk_count * (i + 1);
+            chunk_end = chunk_end < chunk_begin ? chunk_begin : chunk_end;
+            const char* newline = platform_memory_find(chunk_end, text_end - chunk_end, '\n');
+            chunk_end = newline ? newline + 1 : text_end;
+        }
+
+        chunks[i].begin = chunk_begin;
+        chunks[i].end = chunk_end;
+        chunks[i].invalid_face = INVALID_ID_U64;
+        chunks[i].data = out_data;
+        chunk_begin = chunk_end;
+    }
+
+    // Первый проход: подсчет элементов.
+    obj_chunks_process(chunks, chunk_count);
+
+    // Расчет смещений частей, что делает результат независимым от порядка завершения потоков.
+    for(u32 i = 0; i < chunk_count; ++i)
+    {
+        obj_chunk* chunk = &chunks[i];
+        chunk->position_offset = out_data->position_count;
+        chunk->normal_offset = out_data->normal_count;
+        chunk->texcoord_offset = out_data->texcoord_count;
+        chunk->face_offset = out_data->face_count;
+        chunk->group_offset = out_data->group_count;
+        chunk->parse = true;
+
+        out_data->position_count += chunk->position_count;
+        out_data->normal_count += chunk->normal_count;
+        out_data->texcoord_count += chunk->texcoord_count;
+        out_data->face_count += chunk->face_count;
+        out_data->group_count += chunk->group_count;
+
+        if(chunk->mtllib && !out_data->material_filename[0])
+        {
+            obj_copy_name(out_data->material_filename, MATERIAL_NAME_MAX_LENGTH, chunk->mtllib, chunk->mtllib + chunk->mtllib_length);
+        }
+    }
+
+    // NOTE: Лицевые поверхности до первого 'usemtl' собираются в группу без материала (первую).
+    out_data->group_count++;
+    for(u32 i = 0; i < chunk_count; ++i)
+    {
+        chunks[i].group_offset++;
+    }
+
+    if(out_data->position_count) out_data->positions = kallocate_tc(vec3, out_data->position_count, MEMORY_TAG_ARRAY);
+    if(out_data->normal_count) out_data->normals = kallocate_tc(vec3, out_data->normal_count, MEMORY_TAG_ARRAY);
+    if(out_data->texcoord_count) out_data->texcoords = kallocate_tc(vec2, out_data->texcoord_count, MEMORY_TAG_ARRAY);
+    if(out_data->face_count) out_data->faces = kallocate_tc(obj_face_data, out_data->face_count, MEMORY_TAG_ARRAY);
+    out_data->groups = kallocate_tc(obj_group_data, out_data->group_count, MEMORY_TAG_ARRAY);
+    out_data->groups[0].material_name[0] = '\0';
+    out_data->groups[0].first_face = 0;
+
+    // Второй проход: разбор элементов.
+    obj_chunks_process(chunks, chunk_count);
+
+    // Проверка индексов лицевых поверхностей.
+    for(u32 i = 0; i < chunk_count; ++i)
+    {
+        if(chunks[i].invalid_face != INVALID_ID_U64)
+        {
+            kerror("Function '%s': Face %llu references a missing vertex element.", __FUNCTION__, chunks[i].invalid_face + 1);
+            obj_data_free(out_data);
+            return false;
+        }
+    }
+
+    // Расчет диапазонов групп.
+    for(u64 i = 0; i < out_data->group_count; ++i)
+    {
+        obj_group_data* group = &out_data->groups[i];
+        u64 next_face = i + 1 < out_data->group_count ? out_data->groups[i + 1].first_face : out_data->face_count;
+        group->face_count = next_face - group->first_face;
+    }
+
+    return true;
+}
+
+void obj_data_free(obj_data* data)
+{
+    if(data->positions) kfree_tc(data->positions, vec3, data->position_count, MEMORY_TAG_ARRAY);
+    if(data->normals) kfree_tc(data->normals, vec3, data->normal_count, MEMORY_TAG_ARRAY);
+    if(data->texcoords) kfree_tc(data->texcoords, vec2, data->texcoord_count, MEMORY_TAG_ARRAY);
+    if(data->faces) kfree_tc(data->faces, obj_face_data, data->face_count, MEMORY_TAG_ARRAY);
+    if(data->groups) kfree_tc(data->groups, obj_group_data, data->group_count, MEMORY_TAG_ARRAY);
+
+    kzero_tc(data, obj_data, 1);
+}
+
+// Запись хеш-таблицы вершин группы.
+typedef struct obj_vertex_entry {
+    u32 hash;
+    u32 position_index;
+    u32 vertex_index;  // INVALID_ID - запись свободна.
+} obj_vertex_entry;
+
+KINLINE u32 obj_hash_f32(u32 hash, f32 value)
+{
+    // NOTE: -0.0 и 0.0 равны, поэтому хешируются одинаково.
+    u32 bits = 0;
+    if(value != 0.0f)
+    {
+        kcopy_tc(&bits, &value, u32, 1);
+    }
+
+    hash = (hash ^ bits) * 0x9E3779B1U;
+    return hash ^ (hash >> 15);
+}
+
+// @brief Хеш вершины: индекс позиции и значения нормали и текстурных координат.
+KINLINE u32 obj_vertex_hash(u32 position_index, vec3 normal, vec2 texcoord)
+{
+    u32 hash = position_index * 0x85EBCA77U;
+    hash = obj_hash_f32(hash, normal.x);
+    hash = obj_hash_f32(hash, normal.y);
+    hash = obj_hash_f32(hash, normal.z);
+    hash = obj_hash_f32(hash, texcoord.x);
+    hash = obj_hash_f32(hash, texcoord.y);
+    return hash;
+}
+
+void obj_group_convert(const obj_data* data, const obj_group_data* group, geometry_config* config)
+{
+    // Копирование имени материала.
+    string_ncopy(config->material_name, group->material_name, MATERIAL_NAME_MAX_LENGTH);
+
+    bool extent_set = false;
+    kzero_tc(&config->extents, extents_3d, 1);
+
+    const obj_face_data* faces = &data->faces[group->first_face];
+    u64 faces_count = group->face_count;
+
+    // NOTE: Вершин не больше, чем углов лицевых поверхностей, поэтому таблица с заполнением не более
+    //       половины выделяется один раз и не растет.
+    u64 table_capacity = 64;
+    while(table_capacity < faces_count * 3 * 2) table_capacity <<= 1;
+    u64 table_mask = table_capacity - 1;
+
+    obj_vertex_entry* table = kallocate_tc(obj_vertex_entry, table_capacity, MEMORY_TAG_ARRAY);
+    kset_tc(table, obj_vertex_entry, table_capacity, 0xFF);
+
+    // Преобразование лицевых поверхностей
+    for(u64 f = 0; f < faces_count; ++f)
+    {
+        for(u64 i = 0; i < 3; ++i)
+        {
+            const obj_vertex_index_data* index_data = &faces[f].vertices[i];
+
+            // Создание вершины, вероятно новой.
+            vertex_3d current_vert;
+            current_vert.position = data->positions[index_data->position_index - 1];
+            current_vert.texcoord = index_data->texcoord_index ? data->texcoords[index_data->texcoord_index - 1] : vec2_zero();
+            current_vert.normal = index_data->normal_index ? data->normals[index_data->normal_index - 1] : vec3_create(0, 0, 1);
+            current_vert.color = vec4_one();    // TODO: Цвет. А пока по умолчанию белый цвет.
+            current_vert.tangent = vec4_zero(); // TODO: Тангент. А пока по умолчанию 0 вектор.
+
+            // Поиск равной вершины той же позиции.
+            // NOTE: Вершины сравниваются по значению, поэтому разные индексы нормалей или текстурных координат
+            //       с равными значениями дают одну вершину.
+            u32 hash = obj_vertex_hash(index_data->position_index, current_vert.normal, current_vert.texcoord);
+            u64 slot = hash & table_mask;
+            obj_vertex_entry* entry = &table[slot];
+
+            while(entry->vertex_index != INVALID_ID)
+            {
+                if(entry->hash == hash && entry->position_index == index_data->position_index)
+                {
+                    const vertex_3d* exist_vert = &((vertex_3d*)config->vertices)[entry->vertex_index];
+                    if(
+                        exist_vert->normal.x == current_vert.normal.x && exist_vert->normal.y == current_vert.normal.y
+                        && exist_vert->normal.z == current_vert.normal.z && exist_vert->texcoord.x == current_vert.texcoord.x
+                        && exist_vert->texcoord.y == current_vert.texcoord.y
+                    )
+                    {
+                        break;
+                    }
+                }
+
+                slot = (slot + 1) & table_mask;
+                entry = &table[slot];
+            }
+
+            // Добавление вершины.
+            if(entry->vertex_index == INVALID_ID)
+            {
+                entry->hash = hash;
+                entry->position_index = index_data->position_index;
+                entry->vertex_index = darray_length(config->vertices);
+                darray_push(config->vertices, current_vert);
+
+                // Получаем минимальную и максимальную точки занимаемой моделью в пространстве.
+                if(!extent_set)
+                {
+                    config->extents.min = current_vert.position;
+                    config->extents.max = current_vert.position;
+                    extent_set = true;
+                }
+                else
+                {
+                    config->extents.min = vec3_min(config->extents.min, current_vert.position);
+                    config->extents.max = vec3_max(config->extents.max, current_vert.position);
+                }
+            }
+
+            darray_push(config->indices, entry->vertex_index);
+        }
+    }
+
+    kfree_tc(table, obj_vertex_entry, table_capacity, MEMORY_TAG_ARRAY);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+#include <resources/resource_types.h>
+#include <systems/geometry_system.h>
+
+// @brief Индексы атрибутов вершины лицевой поверхности (начинаются с 1, 0 - атрибут отсутствует).
+typedef struct obj_vertex_index_data {
+    u32 position_index;
+    u32 normal_index;
+    u32 texcoord_index;
+} obj_vertex_index_data;
+
+// @brief Лицевая поверхность (треугольник).
+typedef struct obj_face_data {
+    obj_vertex_index_data vertices[3];
+} obj_face_data;
+
+// @brief Группа лицевых поверхностей с общим материалом (может быть пустой).
+typedef struct obj_group_data {
+    char material_name[MATERIAL_NAME_MAX_LENGTH];
+    // Диапазон лицевых поверхностей группы в obj_data.faces.
+    u64 first_face;
+    u64 face_count;
+} obj_group_data;
+
+// @brief Результат разбора obj файла.
+typedef struct obj_data {
+    u64 position_count;
+    vec3* positions;
+    u64 normal_count;
+    vec3* normals;
+    u64 texcoord_count;
+    vec2* texcoords;
+    u64 face_count;
+    obj_face_data* faces;
+    u64 group_count;
+    obj_group_data* groups;
+    // Имя файла материалов (пустая строка, если не указано).
+    char material_filename[MATERIAL_NAME_MAX_LENGTH];
+} obj_data;
+
+/*
+    @brief Выполняет разбор obj файла: файл отображается в память, делится на части по границам строк,
+           которые разбираются параллельно, после чего результаты объединяются в порядке следования в файле.
+    NOTE: Результат не зависит от количества потоков. Данные необходимо освободить с помощью obj_data_free.
+    @param path Путь к obj файлу.
+    @param thread_count Количество потоков разбора, 0 - по количеству логических процессоров.
+    @param out_data Указатель на структуру для сохранения результата.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool obj_parse_file(const char* path, u32 thread_count, obj_data* out_data);
+
+/*
+    @brief Выполняет разбор текста obj файла, находящегося в памяти (см. obj_parse_file).
+    NOTE: Части меньше OBJ_PARSER_MIN_CHUNK_SIZE не выделяются, поэтому малые тексты разбираются одним потоком.
+    @param text Указатель на текст (завершающий ноль не требуется).
+    @param size Размер текста в байтах.
+    @param thread_count Количество потоков разбора, 0 - по количеству логических процессоров.
+    @param out_data Указатель на структуру для сохранения результата.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool obj_parse_buffer(const char* text, u64 size, u32 thread_count, obj_data* out_data);
+
+/*
+    @brief Освобождает данные, полученные при разборе obj файла.
+    @param data Указатель на данные (обнуляются).
+*/
+KAPI void obj_data_free(obj_data* data);
+
+/*
+    @brief Преобразует группу лицевых поверхностей в вершины и индексы геометрии, равные вершины одной позиции
+           объединяются (по значению нормали и текстурных координат, как vertex_3d_equal без допуска).
+    NOTE: Индексы должны быть проверены при разборе (obj_parse_file, obj_parse_buffer), вершины и индексы
+          дописываются в динамические массивы config->vertices и config->indices (darray).
+    @param data Указатель на данные разобранного obj файла.
+    @param group Указатель на группу лицевых поверхностей.
+    @param config Указатель на geometry_config элемент для выполнения записи данных.
+*/
+KAPI void obj_group_convert(const obj_data* data, const obj_group_data* group, geometry_config* config);
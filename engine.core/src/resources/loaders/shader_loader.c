@@ -42,6 +42,7 @@ bool shader_loader_load(resource_loader* self, const char* name, resource* out_r
     resource_data->stage_filenames = darray_create(char*);
     resource_data->use_instances = false;
     resource_data->use_local = false;
+    resource_data->use_bindless = false;
     resource_data->renderpass_name = null;
     resource_data->name = null;
 
@@ -164,6 +165,10 @@ bool shader_loader_load(resource_loader* self, const char* name, resource* out_r
         {
             string_to_bool(trimmed_value, &resource_data->use_local);
         }
+        else if(string_equali(trimmed_var_name, "use_bindless"))
+        {
+            string_to_bool(trimmed_value, &resource_data->use_bindless);
+        }
         else if(string_equali(trimmed_var_name, "attribute"))
         {
             char** fields = darray_create(char*);
@@ -230,10 +235,30 @@ bool shader_loader_load(resource_loader* self, const char* name, resource* out_r
                     attribute.type = SHADER_ATTRIB_TYPE_INT32;
                     attribute.size = 4;
                 }
+                else if(string_equali(fields[0], "f16x2"))
+                {
+                    attribute.type = SHADER_ATTRIB_TYPE_FLOAT16_2;
+                    attribute.size = 4;
+                }
+                else if(string_equali(fields[0], "unorm8x4"))
+                {
+                    attribute.type = SHADER_ATTRIB_TYPE_UNORM8_4;
+                    attribute.size = 4;
+                }
+                else if(string_equali(fields[0], "unorm16x4"))
+                {
+                    attribute.type = SHADER_ATTRIB_TYPE_UNORM16_4;
+                    attribute.size = 8;
+                }
+                else if(string_equali(fields[0], "snorm16x4"))
+                {
+                    attribute.type = SHADER_ATTRIB_TYPE_SNORM16_4;
+                    attribute.size = 8;
+                }
                 else
                 {
                     kerror(
-                        "Function '%s': Invalid file layout. Attribute type must be f32, vec2, vec3, vec4, i8, i16, i32, u8, u16, or u32.",
+                        "Function '%s': Invalid file layout. Attribute type must be f32, vec2, vec3, vec4, i8, i16, i32, u8, u16, u32, f16x2, unorm8x4, unorm16x4 or snorm16x4.",
                         __FUNCTION__
                     );
 
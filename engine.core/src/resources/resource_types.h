@@ -2,6 +2,7 @@
 
 #include <defines.h>
 #include <math/math_types.h>
+#include <containers/handle_pool.h>
 
 #define TEXTURE_NAME_MAX_LENGTH 512
 #define MATERIAL_NAME_MAX_LENGTH 256
@@ -23,6 +24,8 @@ typedef struct resource {
     char* full_path;
     u64 data_size;
     void* data;
+    // Внутренние данные загрузчика (например, отображение файла в память).
+    void* internal_data;
 } resource;
 
 typedef struct image_resouce_data {
@@ -117,20 +120,41 @@ typedef struct material {
     u32 render_frame_number;
 } material;
 
+// @brief Максимальное количество уровней детализации геометрии.
+#define GEOMETRY_LOD_MAX 4
+
+// @brief Уровень детализации геометрии: диапазон общего буфера индексов.
+typedef struct geometry_lod {
+    // @brief Индекс первого индекса уровня.
+    u32 index_offset;
+    // @brief Количество индексов уровня.
+    u32 index_count;
+    // @brief Геометрическая ошибка упрощения относительно полной детализации (локальные).
+    f32 error;
+} geometry_lod;
+
 typedef struct geometry {
     // @brief Идентификатор геометрии.
     u32 id;
     // @brief Внутренний идентификатор визуализатора.
     u32 internal_id;
-    // @brief Генератор изменений, используется для обновления геометрии.
-    u16 generation;
+    // @brief Поколение слота геометрии в системе геометрий (вместе с id образует дескриптор).
+    u32 generation;
     // @brief Центр геометрии (локальные).
     vec3 center;
     // @brief Крайние точки геометрии (локальные).
     extents_3d extents;
+    // @brief Диапазон квантования положений упакованных вершин vertex_3d_packed (локальные).
+    extents_3d position_range;
+    // @brief Количество уровней детализации (не менее 1 у загруженной геометрии).
+    u32 lod_count;
+    // @brief Уровни детализации от полного (0) к самому грубому.
+    geometry_lod lods[GEOMETRY_LOD_MAX];
     // @brief Имя геометрии.
     char name[GEOMETRY_NAME_MAX_LENGTH];
     // @brief Используемый материал геометрии.
+    // NOTE: После смены материала геометрии сетки сцены вызывается scene_system_mesh_set_dirty,
+    //       т.к. прозрачность материала определяет список отрисовки.
     material* material;
 } geometry;
 
@@ -140,8 +164,8 @@ typedef struct mesh {
     u16 geometry_count;
     // @brief Массив указателей на геометрии.
     geometry** geometries;
-    // @brief Массив преобразований над сеткой геометрий из локальных в мировые.
-    transform transform;
+    // @brief Дескриптор преобразования сетки геометрий из локальных в мировые (см. transform_system).
+    khandle transform;
 } mesh;
 
 // @brief Стадия шейдера на конвейере (можно комбинировать).
@@ -164,7 +188,15 @@ typedef enum shader_attribute_type {
     SHADER_ATTRIB_TYPE_INT16     = 7U,
     SHADER_ATTRIB_TYPE_UINT16    = 8U,
     SHADER_ATTRIB_TYPE_INT32     = 9U,
-    SHADER_ATTRIB_TYPE_UINT32    = 10U
+    SHADER_ATTRIB_TYPE_UINT32    = 10U,
+    // @brief Два f16 (half float).
+    SHADER_ATTRIB_TYPE_FLOAT16_2 = 11U,
+    // @brief Четыре u8, нормализованные в [0, 1].
+    SHADER_ATTRIB_TYPE_UNORM8_4  = 12U,
+    // @brief Четыре u16, нормализованные в [0, 1].
+    SHADER_ATTRIB_TYPE_UNORM16_4 = 13U,
+    // @brief Четыре i16, нормализованные в [-1, 1].
+    SHADER_ATTRIB_TYPE_SNORM16_4 = 14U
 } shader_attribute_type;
 
 // @brief Тип данных uniform переменой шейдера.
@@ -226,6 +258,8 @@ typedef struct shader_config {
     bool use_instances;
     // @brief Указывает использует ли шейдер uniform-буферы локльного уровня.
     bool use_local;
+    // @brief Указывает использует ли шейдер режим bindless (единый массив текстур и буфер данных экземпляров).
+    bool use_bindless;
     // @brief Количество используемых атрибутов в шейдере.
     u8 attribute_count;
     // @brief Массив атрибутов (используется darray).
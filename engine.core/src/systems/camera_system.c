@@ -6,10 +6,12 @@
 #include "kstring.h"
 #include "memory/memory.h"
 #include "containers/hashtable.h"
+#include "containers/handle_pool.h"
 #include "renderer/camera.h"
 
 typedef struct camera_lookup {
-    u16 id;
+    // Дескриптор слота камеры (индекс и поколение), KHANDLE_INVALID - слот свободен.
+    khandle handle;
     u16 reference_count;
     camera c;
 } camera_lookup;
@@ -21,8 +23,10 @@ typedef struct camera_system_state {
     camera default_camera;
     // Массив камер.
     camera_lookup* cameras;
-    // Хэш таблица инентификаторов камер.
+    // Хэш таблица дескрипторов камер.
     hashtable* lookup;
+    // Пул слотов массива камер.
+    handle_pool* camera_handles;
 } camera_system_state;
 
 static camera_system_state* state_ptr = null;
@@ -57,18 +61,20 @@ bool camera_system_initialize(u64* memory_requirement, void* memory, camera_syst
         return false;
     }
 
-    if(!config->max_camera_count)
+    if(!config->max_camera_count || config->max_camera_count >= INVALID_ID_U16)
     {
-        kerror("Function '%s': config.max_camera_count must be greater then zero.", __FUNCTION__);
+        kerror("Function '%s': config.max_camera_count must be greater then zero and less then INVALID_ID_U16.", __FUNCTION__);
         return false;
     }
 
     u64 state_requirement = sizeof(camera_system_state);
     u64 array_requirement = sizeof(camera_lookup) * config->max_camera_count;
     u64 hashtable_requirement = 0;
-    hashtable_config hcfg = { sizeof(u16), config->max_camera_count };
+    hashtable_config hcfg = { sizeof(khandle), config->max_camera_count };
     hashtable_create(&hashtable_requirement, null, &hcfg, null);
-    *memory_requirement = state_requirement + array_requirement + hashtable_requirement;
+    u64 pool_requirement = 0;
+    handle_pool_create(config->max_camera_count, &pool_requirement, null);
+    *memory_requirement = state_requirement + array_requirement + hashtable_requirement + pool_requirement;
 
     if(!memory)
     {
@@ -94,10 +100,14 @@ bool camera_system_initialize(u64* memory_requirement, void* memory, camera_syst
         return false;
     }
 
+    // Получение и запись указателя на пул слотов.
+    void* pool_block = POINTER_GET_OFFSET(hashtable_block, hashtable_requirement);
+    state_ptr->camera_handles = handle_pool_create(config->max_camera_count, &pool_requirement, pool_block);
+
     // Отмечает все камеры как недействительные.
     for(u32 i = 0; i < state_ptr->config.max_camera_count; ++i)
     {
-        state_ptr->cameras[i].id = INVALID_ID_U16;
+        state_ptr->cameras[i].handle = KHANDLE_INVALID;
         state_ptr->cameras[i].reference_count = 0;
     }
 
@@ -111,9 +121,25 @@ void camera_system_shutdown()
 {
     if(!system_status_valid(__FUNCTION__)) return;
     hashtable_destroy(state_ptr->lookup);
+    handle_pool_destroy(state_ptr->camera_handles);
     state_ptr = null;
 }
 
+void camera_system_update()
+{
+    if(!system_status_valid(__FUNCTION__)) return;
+
+    camera_update(&state_ptr->default_camera);
+
+    for(u32 i = 0; i < state_ptr->config.max_camera_count; ++i)
+    {
+        if(state_ptr->cameras[i].handle.index != INVALID_ID)
+        {
+            camera_update(&state_ptr->cameras[i].c);
+        }
+    }
+}
+
 camera* camera_system_acquire(const char* name)
 {
     if(!system_status_valid(__FUNCTION__)) return null;
@@ -123,42 +149,34 @@ camera* camera_system_acquire(const char* name)
         return &state_ptr->default_camera;
     }
 
-    u16 id = INVALID_ID_U16;
-    if(!hashtable_get(state_ptr->lookup, name, &id) || id == INVALID_ID_U16)
+    khandle handle = KHANDLE_INVALID;
+    if(!hashtable_get(state_ptr->lookup, name, &handle) || handle.index == INVALID_ID)
     {
-        // Поиск свободного слота памяти.
-        for(u16 i = 0; i < state_ptr->config.max_camera_count; ++i)
-        {
-            if(state_ptr->cameras[i].id == INVALID_ID_U16)
-            {
-                id = i;
-                break;
-            }
-        }
-
-        if(id == INVALID_ID_U16)
+        // Получение свободного слота памяти.
+        if(!handle_pool_acquire(state_ptr->camera_handles, &handle))
         {
             kerror("Function '%s' failed to acquire new slot. Adjust camera system config to allow more.", __FUNCTION__);
             return null;
         }
 
         ktrace("Function '%s': Creating new camera named '%s'.", __FUNCTION__, name);
-        state_ptr->cameras[id].id = id;
-        state_ptr->cameras[id].c = camera_create();
+        state_ptr->cameras[handle.index].handle = handle;
+        state_ptr->cameras[handle.index].c = camera_create();
 
         // Обновление записи в таблице.
-        if(!hashtable_set(state_ptr->lookup, name, &id, true))
+        if(!hashtable_set(state_ptr->lookup, name, &handle, true))
         {
             kerror("Function '%s' Failed to update camera id.", __FUNCTION__);
-            state_ptr->cameras[id].id = INVALID_ID_U16;
-            state_ptr->cameras[id].reference_count = 0;
+            handle_pool_release(state_ptr->camera_handles, handle);
+            state_ptr->cameras[handle.index].handle = KHANDLE_INVALID;
+            state_ptr->cameras[handle.index].reference_count = 0;
             return null;
         }
     }
 
-    state_ptr->cameras[id].reference_count++;
+    state_ptr->cameras[handle.index].reference_count++;
 
-    return &state_ptr->cameras[id].c;
+    return &state_ptr->cameras[handle.index].c;
 }
 
 void camera_system_release(const char* name)
@@ -171,23 +189,32 @@ void camera_system_release(const char* name)
         return;
     }
 
-    u16 id = INVALID_ID_U16;
-    if(!hashtable_get(state_ptr->lookup, name, &id) || id == INVALID_ID_U16)
+    khandle handle = KHANDLE_INVALID;
+    if(!hashtable_get(state_ptr->lookup, name, &handle) || handle.index == INVALID_ID)
     {
         kwarng("Function '%s': Tried to release non-existent camera '%s'.", __FUNCTION__, name);
         return;
     }
 
-    state_ptr->cameras[id].reference_count--;
+    // NOTE: Слот мог быть освобожден и занят другой камерой, тогда поколение не совпадет.
+    camera_lookup* lookup = &state_ptr->cameras[handle.index];
+    if(!handle_pool_valid(state_ptr->camera_handles, handle) || lookup->handle.generation != handle.generation)
+    {
+        kerror("Function '%s': Camera '%s' refers to a stale slot %u. Skipping...", __FUNCTION__, name, handle.index);
+        return;
+    }
+
+    lookup->reference_count--;
 
-    if(state_ptr->cameras[id].reference_count < 1)
+    if(lookup->reference_count < 1)
     {
-        camera_reset(&state_ptr->cameras[id].c);
-        state_ptr->cameras[id].id = INVALID_ID_U16;
+        camera_reset(&lookup->c);
+        lookup->handle = KHANDLE_INVALID;
+        handle_pool_release(state_ptr->camera_handles, handle);
 
         // Обновление записи в таблице.
-        id = INVALID_ID_U16;
-        if(!hashtable_set(state_ptr->lookup, name, &id, true))
+        handle = KHANDLE_INVALID;
+        if(!hashtable_set(state_ptr->lookup, name, &handle, true))
         {
             kerror("Function '%s' Failed to update camera id.", __FUNCTION__);
         }
@@ -18,12 +18,18 @@ typedef struct camera_system_config {
     @param config Конфигурация используемая для инициализации системы и получения требований к памяти.
     @return True в случае успеха, false если есть ошибки.
 */
-bool camera_system_initialize(u64* memory_requirement, void* memory, camera_system_config* config);
+KAPI bool camera_system_initialize(u64* memory_requirement, void* memory, camera_system_config* config);
 
 /*
     @brief Завершает работу системы камер и освобождает выделеные ей ресурсы.
 */
-void camera_system_shutdown();
+KAPI void camera_system_shutdown();
+
+/*
+    @brief Пересчитывает блоки данных измененных камер.
+    NOTE: Вызывается один раз за кадр после обработки ввода и игровой логики и до построения пакетов отрисовки.
+*/
+KAPI void camera_system_update();
 
 /*
     @brief Получает камеру с указаным имененм и возвращает указатель на нее.
@@ -6,6 +6,7 @@
 #include "logger.h"
 #include "kstring.h"
 #include "memory/memory.h"
+#include "containers/handle_pool.h"
 #include "math/geometry_utils.h"
 #include "renderer/renderer_frontend.h"
 
@@ -27,6 +28,8 @@ typedef struct geometry_system_state {
     geometry default_2d_geometry;
     // @brief Массив геометрий.
     geometry_reference* geometries;
+    // @brief Пул слотов массива геометрий.
+    handle_pool* geometry_handles;
 } geometry_system_state;
 
 static geometry_system_state* state_ptr = null;
@@ -34,6 +37,7 @@ static const char* message_not_initialized =
     "Function '%s' requires the geometry system to be initialized. Call 'geometry_system_initialize' first.";
 
 bool default_geometries_create();
+bool geometry_upload(geometry* g, const geometry_config* config);
 bool geometry_create(geometry_config* config, geometry* g);
 void geometry_destroy(geometry* g);
 
@@ -59,7 +63,9 @@ bool geometry_system_initialize(u64* memory_requirement, void* memory, geometry_
 
     u64 state_requirement = sizeof(geometry_system_state);
     u64 geometries_requirement = sizeof(geometry_reference) * config->max_geometry_count;
-    *memory_requirement = state_requirement + geometries_requirement;
+    u64 pool_requirement = 0;
+    handle_pool_create(config->max_geometry_count, &pool_requirement, null);
+    *memory_requirement = state_requirement + geometries_requirement + pool_requirement;
 
     if(!memory)
     {
@@ -77,11 +83,15 @@ bool geometry_system_initialize(u64* memory_requirement, void* memory, geometry_
     void* geometries_block = (void*)((u8*)state_ptr + state_requirement);
     state_ptr->geometries = geometries_block;
 
+    // Получение и запись указателя на пул слотов.
+    void* pool_block = POINTER_GET_OFFSET(geometries_block, geometries_requirement);
+    state_ptr->geometry_handles = handle_pool_create(config->max_geometry_count, &pool_requirement, pool_block);
+
     // Отмечает все геометрии как недействительные.
     for(u32 i = 0; i < state_ptr->config.max_geometry_count; ++i)
     {
         state_ptr->geometries[i].geometry.id = INVALID_ID;
-        state_ptr->geometries[i].geometry.generation = INVALID_ID_U16;
+        state_ptr->geometries[i].geometry.generation = INVALID_ID;
         state_ptr->geometries[i].geometry.internal_id = INVALID_ID;
     }
 
@@ -104,6 +114,7 @@ void geometry_system_shutdown()
     }
 
     // NOTE: Нечего уничтожать.
+    handle_pool_destroy(state_ptr->geometry_handles);
 
     state_ptr = null;
 }
@@ -116,7 +127,8 @@ geometry* geometry_system_acquire_by_id(u32 id)
         return null;
     }
 
-    if(id != INVALID_ID && state_ptr->geometries[id].geometry.id != INVALID_ID)
+    khandle handle;
+    if(handle_pool_handle_get(state_ptr->geometry_handles, id, &handle))
     {
         state_ptr->geometries[id].reference_count++;
         return &state_ptr->geometries[id].geometry;
@@ -134,30 +146,24 @@ geometry* geometry_system_acquire_from_config(geometry_config* config, bool auto
         return null;
     }
 
-    geometry* g = null;
-
-    for(u32 i = 0; i < state_ptr->config.max_geometry_count; ++i)
-    {
-        geometry_reference* ref = &state_ptr->geometries[i];
-        if(ref->geometry.id == INVALID_ID)
-        {
-            ref->auto_release = auto_release;
-            ref->reference_count = 1;
-
-            g = &ref->geometry;
-            g->id = i;
-            break;
-        }
-    }
-
-    if(!g)
+    khandle handle;
+    if(!handle_pool_acquire(state_ptr->geometry_handles, &handle))
     {
         kerror(
             "Function '%s': Unable to obtain free slot for geometry. Adjust configuration to allow more space. Return null!",
             __FUNCTION__
         );
+        return null;
     }
 
+    geometry_reference* ref = &state_ptr->geometries[handle.index];
+    ref->auto_release = auto_release;
+    ref->reference_count = 1;
+
+    geometry* g = &ref->geometry;
+    g->id = handle.index;
+    g->generation = handle.generation;
+
     if(!geometry_create(config, g))
     {
         kerror("Function '%s': Failed to create geometry. Return null!", __FUNCTION__);
@@ -202,9 +208,10 @@ void geometry_system_release(geometry* geometry)
         return;
     }
 
-    if(geometry->id == INVALID_ID)
+    khandle handle = { geometry->id, geometry->generation };
+    if(!handle_pool_valid(state_ptr->geometry_handles, handle))
     {
-        kwarng("Function '%s' cannot release invalid geometry id.", __FUNCTION__);
+        kwarng("Function '%s' cannot release invalid or stale geometry id.", __FUNCTION__);
         return;
     }
 
@@ -279,11 +286,19 @@ bool default_geometries_create()
 
     // Настройка геометрии по умолчанию.
     state_ptr->default_geometry.material = material_system_get_default();
+    state_ptr->default_geometry.id = INVALID_ID;
     state_ptr->default_geometry.internal_id = INVALID_ID;
+    state_ptr->default_geometry.generation = INVALID_ID;
 
-    if(!renderer_geometry_create(
-        &state_ptr->default_geometry, sizeof(vertex_3d), VERT_COUNT, verts, sizeof(u32), INDEX_COUNT, indices
-    ))
+    geometry_config config = {0};
+    config.vertex_size = sizeof(vertex_3d);
+    config.vertex_count = VERT_COUNT;
+    config.vertices = verts;
+    config.index_size = sizeof(u32);
+    config.index_count = INDEX_COUNT;
+    config.indices = indices;
+
+    if(!geometry_upload(&state_ptr->default_geometry, &config))
     {
         kerror("Function '%s': Failed to create default geometry.", __FUNCTION__);
         return false;
@@ -318,7 +333,9 @@ bool default_geometries_create()
 
     // Настройка 2d геометрии по умолчанию.
     state_ptr->default_2d_geometry.material = material_system_get_default();
+    state_ptr->default_2d_geometry.id = INVALID_ID;
     state_ptr->default_2d_geometry.internal_id = INVALID_ID;
+    state_ptr->default_2d_geometry.generation = INVALID_ID;
 
     if(!renderer_geometry_create(
         &state_ptr->default_2d_geometry, sizeof(vertex_2d), VERT_COUNT, verts2d, sizeof(u32), INDEX_COUNT, indices2d
@@ -331,19 +348,58 @@ bool default_geometries_create()
     return true;
 }
 
+bool geometry_upload(geometry* g, const geometry_config* config)
+{
+    // Уровни детализации (без них используется весь массив индексов).
+    if(config->lod_count > 0)
+    {
+        g->lod_count = KMIN(config->lod_count, GEOMETRY_LOD_MAX);
+        kcopy_tc(g->lods, config->lods, geometry_lod, g->lod_count);
+    }
+    else
+    {
+        g->lod_count = 1;
+        g->lods[0].index_offset = 0;
+        g->lods[0].index_count = config->index_count;
+        g->lods[0].error = 0.0f;
+    }
+
+    if(config->vertex_size != sizeof(vertex_3d) || !config->vertex_count)
+    {
+        // Упакованные вершины квантованы относительно крайних точек геометрии.
+        g->position_range = config->extents;
+
+        return renderer_geometry_create(
+            g, config->vertex_size, config->vertex_count, config->vertices, config->index_size, config->index_count,
+            config->indices
+        );
+    }
+
+    // Упаковка вершин: меньше памяти и пропускной способности при выборке вершин.
+    vertex_3d_packed* packed = kallocate_tc(vertex_3d_packed, config->vertex_count, MEMORY_TAG_ARRAY);
+    geometry_pack_vertices(config->vertex_count, config->vertices, packed, &g->position_range);
+
+    bool result = renderer_geometry_create(
+        g, sizeof(vertex_3d_packed), config->vertex_count, packed, config->index_size, config->index_count, config->indices
+    );
+
+    kfree_tc(packed, vertex_3d_packed, config->vertex_count, MEMORY_TAG_ARRAY);
+    return result;
+}
+
 bool geometry_create(geometry_config* config, geometry* g)
 {
     // Загрузка геометрии в память графического процессора.
-    if(!renderer_geometry_create(
-        g, config->vertex_size, config->vertex_count, config->vertices, config->index_size, config->index_count,
-        config->indices
-    ))
+    if(!geometry_upload(g, config))
     {
+        khandle handle = { g->id, g->generation };
+        handle_pool_release(state_ptr->geometry_handles, handle);
+
         state_ptr->geometries[g->id].reference_count = 0;
         state_ptr->geometries[g->id].auto_release = false;
         g->id = INVALID_ID;
         g->internal_id = INVALID_ID;
-        g->generation = INVALID_ID_U16;
+        g->generation = INVALID_ID;
 
         return false;
     }
@@ -366,12 +422,22 @@ bool geometry_create(geometry_config* config, geometry* g)
 
 void geometry_destroy(geometry* g)
 {
+    // NOTE: Геометрия может читаться записываемым кадром до ее обнуления.
+    renderer_resources_lock();
+
     // Уничтожение геометрии в памяти графического процессора.
     renderer_geometry_destroy(g);
 
+    // NOTE: Геометрии по умолчанию не занимают слотов пула.
+    if(g->id != INVALID_ID)
+    {
+        khandle handle = { g->id, g->generation };
+        handle_pool_release(state_ptr->geometry_handles, handle);
+    }
+
     g->id = INVALID_ID;
     g->internal_id = INVALID_ID;
-    g->generation = INVALID_ID_U16;
+    g->generation = INVALID_ID;
 
     string_empty(g->name);
 
@@ -380,6 +446,8 @@ void geometry_destroy(geometry* g)
         material_system_release(g->material->name);
         g->material = null;
     }
+
+    renderer_resources_unlock();
 }
 
 geometry_config geometry_system_generate_plane_config(
@@ -13,6 +13,8 @@ typedef struct geometry_system_config {
     u32 max_geometry_count;
 } geometry_system_config;
 
+// NOTE: Вершины vertex_3d упаковываются в vertex_3d_packed при загрузке в память графического процессора.
+//       Для уже упакованных вершин extents является диапазоном квантования их положений.
 typedef struct geometry_config {
     u32 vertex_size;
     u32 vertex_count;
@@ -20,6 +22,10 @@ typedef struct geometry_config {
     u32 index_size;
     u32 index_count;
     void* indices;
+    // NOTE: Уровни детализации хранятся последовательно в общем массиве индексов,
+    //       0 - уровни не заданы (весь массив индексов является полной детализацией).
+    u32 lod_count;
+    geometry_lod lods[GEOMETRY_LOD_MAX];
     vec3 center;
     extents_3d extents;
     char name[GEOMETRY_NAME_MAX_LENGTH];
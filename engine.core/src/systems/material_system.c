@@ -8,6 +8,7 @@
 #include "kstring.h"
 #include "memory/memory.h"
 #include "containers/hashtable.h"
+#include "containers/handle_pool.h"
 #include "math/kmath.h"
 #include "renderer/renderer_frontend.h"
 
@@ -22,7 +23,11 @@ typedef struct material_shader_uniform_locations {
     u16 specular_texture;
     u16 normal_texture;
     u16 model;
+    u16 position_offset;
+    u16 position_scale;
     u16 render_mode;
+    // NOTE: Только для режима bindless, иначе INVALID_ID_U16.
+    u16 material_index;
 } material_shader_uniform_locations;
 
 typedef struct ui_shader_uniform_locations {
@@ -42,6 +47,8 @@ typedef struct material_system_state {
     material* materials;
     // Таблица ссылок на материалы.
     hashtable* material_references_table;
+    // Пул слотов массива материалов.
+    handle_pool* material_handles;
     // Местоположение для материала шейдера и идентификатор шейдера.
     material_shader_uniform_locations material_locations;
     u32 material_shader_id;
@@ -53,8 +60,8 @@ typedef struct material_system_state {
 typedef struct material_reference {
     // Количество ссылок на материал.
     u64 reference_count;
-    // Индекс материала в массиве материалов.
-    u32 index;
+    // Дескриптор слота материала в массиве материалов (индекс и поколение).
+    khandle handle;
     // Авто уничтожение материала.
     bool auto_release;
 } material_reference;
@@ -115,7 +122,9 @@ bool material_system_initialize(u64* memory_requirement, void* memory, material_
     u64 hashtable_requirement = 0;
     hashtable_config hconf = { sizeof(material_reference), config->max_material_count };
     hashtable_create(&hashtable_requirement, null, &hconf, null);
-    *memory_requirement = state_requirement + materials_requirement + hashtable_requirement;
+    u64 pool_requirement = 0;
+    handle_pool_create(config->max_material_count, &pool_requirement, null);
+    *memory_requirement = state_requirement + materials_requirement + hashtable_requirement + pool_requirement;
 
     if(!memory)
     {
@@ -140,7 +149,10 @@ bool material_system_initialize(u64* memory_requirement, void* memory, material_
     state_ptr->material_locations.specular_texture = INVALID_ID_U16;
     state_ptr->material_locations.normal_texture = INVALID_ID_U16;
     state_ptr->material_locations.model = INVALID_ID_U16;
+    state_ptr->material_locations.position_offset = INVALID_ID_U16;
+    state_ptr->material_locations.position_scale = INVALID_ID_U16;
     state_ptr->material_locations.render_mode = INVALID_ID_U16;
+    state_ptr->material_locations.material_index = INVALID_ID_U16;
 
     state_ptr->ui_shader_id = INVALID_ID;
     state_ptr->ui_locations.projection = INVALID_ID_U16;
@@ -161,6 +173,10 @@ bool material_system_initialize(u64* memory_requirement, void* memory, material_
         return false;
     }
 
+    // Получение и запись указателя на пул слотов.
+    void* pool_block = POINTER_GET_OFFSET(hashtable_block, hashtable_requirement);
+    state_ptr->material_handles = handle_pool_create(config->max_material_count, &pool_requirement, pool_block);
+
     // Отмечает все материалы как недействительные.
     for(u32 i = 0; i < state_ptr->config.max_material_count; ++i)
     {
@@ -200,6 +216,7 @@ void material_system_shutdown()
     // Уничтожение материалов по умолчанию.
     default_materials_destroy();
 
+    handle_pool_destroy(state_ptr->material_handles);
     state_ptr = null;
 }
 
@@ -248,29 +265,19 @@ material* material_system_acquire_from_config(material_config* config)
 
     // TODO: Может возникнуть когда количество записей в таблице закончится!
     material_reference ref;
-    if(!hashtable_get(state_ptr->material_references_table, config->name, &ref) || ref.index == INVALID_ID)
+    if(!hashtable_get(state_ptr->material_references_table, config->name, &ref) || ref.handle.index == INVALID_ID)
     {
         ref.reference_count = 0;
         ref.auto_release = config->auto_release;
-        ref.index = INVALID_ID;
+        ref.handle = KHANDLE_INVALID;
     }
 
     ref.reference_count++;
 
-    if(ref.index == INVALID_ID)
+    if(ref.handle.index == INVALID_ID)
     {
-        // Поиск свободной памяти для материала.
-        for(u32 i = 0; i < state_ptr->config.max_material_count; ++i)
-        {
-            if(state_ptr->materials[i].id == INVALID_ID)
-            {
-                ref.index = i;
-                break;
-            }
-        }
-
-        // Если свободный участок памяти не найден.
-        if(ref.index == INVALID_ID)
+        // Получение свободной памяти для материала.
+        if(!handle_pool_acquire(state_ptr->material_handles, &ref.handle))
         {
             kerror(
                 "Function '%s': Material system cannot hold anymore materials. Adjust configuration to allow more.",
@@ -279,16 +286,20 @@ material* material_system_acquire_from_config(material_config* config)
             return null;
         }
 
-        material* m = &state_ptr->materials[ref.index];
-        m->id = ref.index;
+        material* m = &state_ptr->materials[ref.handle.index];
 
         // Создание материала.
         if(!material_load(config, m))
         {
             kerror("Function '%s': Failed to load material '%s'.", __FUNCTION__, config->name);
+            handle_pool_release(state_ptr->material_handles, ref.handle);
+            m->id = INVALID_ID;
             return null;
         }
 
+        // NOTE: material_load обнуляет материал, поэтому идентификатор записывается после загрузки.
+        m->id = ref.handle.index;
+
         shader* s = shader_system_get_by_id(m->shader_id);
 
         // Сохранение местоположения известных типов для быстрого поиска.
@@ -305,7 +316,10 @@ material* material_system_acquire_from_config(material_config* config)
             state_ptr->material_locations.specular_texture = shader_system_uniform_index(s, "specular_texture");
             state_ptr->material_locations.normal_texture = shader_system_uniform_index(s, "normal_texture");
             state_ptr->material_locations.model = shader_system_uniform_index(s, "model");
+            state_ptr->material_locations.position_offset = shader_system_uniform_index(s, "position_offset");
+            state_ptr->material_locations.position_scale = shader_system_uniform_index(s, "position_scale");
             state_ptr->material_locations.render_mode = shader_system_uniform_index(s, "mode");
+            state_ptr->material_locations.material_index = s->use_bindless ? shader_system_uniform_index(s, "material_index") : INVALID_ID_U16;
         }
         else if(state_ptr->ui_shader_id == INVALID_ID && string_equal(config->shader_name, BUILTIN_SHADER_NAME_UI))
         {
@@ -347,7 +361,7 @@ material* material_system_acquire_from_config(material_config* config)
         return null;
     }
 
-    return &state_ptr->materials[ref.index];
+    return &state_ptr->materials[ref.handle.index];
 }
 
 void material_system_release(const char* name)
@@ -374,13 +388,18 @@ void material_system_release(const char* name)
 
     if(ref.reference_count == 0 && ref.auto_release)
     {
-        material* m = &state_ptr->materials[ref.index];
+        // NOTE: Слот мог быть освобожден и занят другим материалом, тогда поколение не совпадет.
+        if(!handle_pool_release(state_ptr->material_handles, ref.handle))
+        {
+            kerror("Function '%s': Material '%s' refers to a stale slot %u. Skipping...", __FUNCTION__, name, ref.handle.index);
+            return;
+        }
 
         // Освобождение/восстановление памяти материала для нового.
-        material_destroy(m);
+        material_destroy(&state_ptr->materials[ref.handle.index]);
 
         // Освобождение ссылки.
-        ref.index = INVALID_ID;
+        ref.handle = KHANDLE_INVALID;
         ref.auto_release = false;
 
         ktrace(
@@ -463,6 +482,12 @@ bool material_system_apply_instance(material* m, bool needs_update)
 
     MATERIAL_APPLY_OR_FAIL(shader_system_bind_instance(m->internal_id));
 
+    // В режиме bindless экземпляр выбирается в шейдере по индексу, который передается на каждую отрисовку.
+    if(m->shader_id == state_ptr->material_shader_id && state_ptr->material_locations.material_index != INVALID_ID_U16)
+    {
+        MATERIAL_APPLY_OR_FAIL(shader_system_uniform_set_by_index(state_ptr->material_locations.material_index, &m->internal_id));
+    }
+
     if(needs_update)
     {
         if(m->shader_id == state_ptr->material_shader_id)
@@ -489,7 +514,7 @@ bool material_system_apply_instance(material* m, bool needs_update)
     return true;
 }
 
-bool material_system_apply_local(material* m, const mat4* model)
+bool material_system_apply_local(material* m, const mat4* model, const extents_3d* position_range)
 {
     if(!material_system_status_valid(__FUNCTION__))
     {
@@ -498,7 +523,13 @@ bool material_system_apply_local(material* m, const mat4* model)
 
     if(m->shader_id == state_ptr->material_shader_id)
     {
-        return shader_system_uniform_set_by_index(state_ptr->material_locations.model, model);
+        // Параметры восстановления положений упакованных вершин.
+        vec4 position_offset = vec4_from_vec3(position_range->min, 0.0f);
+        vec4 position_scale = vec4_from_vec3(vec3_sub(position_range->max, position_range->min), 0.0f);
+
+        MATERIAL_APPLY_OR_FAIL(shader_system_uniform_set_by_index(state_ptr->material_locations.model, model));
+        MATERIAL_APPLY_OR_FAIL(shader_system_uniform_set_by_index(state_ptr->material_locations.position_offset, &position_offset));
+        return shader_system_uniform_set_by_index(state_ptr->material_locations.position_scale, &position_scale);
     }
     else if(m->shader_id == state_ptr->ui_shader_id)
     {
@@ -677,6 +708,9 @@ bool material_load(material_config* config, material* m)
 
 void material_destroy(material* m)
 {
+    // NOTE: Материал может читаться записываемым кадром до его обнуления.
+    renderer_resources_lock();
+
     // Освобождение загруженых текстур.
     if(m->diffuse_map.texture)
     {
@@ -711,4 +745,6 @@ void material_destroy(material* m)
     m->generation = INVALID_ID;
     m->internal_id = INVALID_ID;
     m->render_frame_number = INVALID_ID;
+
+    renderer_resources_unlock();
 }
@@ -86,6 +86,7 @@ bool material_system_apply_instance(material* m, bool needs_update);
     @brief Применяет данные материала на локальном уровне для предоставленного материала.
     @param m Указатель на материал для которого нужно применить данные.
     @param model Указатель на матрицу модели, которая будет применена.
+    @param position_range Указатель на диапазон квантования положений вершин геометрии (только для материалов мира).
     @return True в случае успеха, false если есть ошибки.
 */
-bool material_system_apply_local(material* m, const mat4* model);
+bool material_system_apply_local(material* m, const mat4* model, const extents_3d* position_range);
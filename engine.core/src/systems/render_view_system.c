@@ -7,6 +7,7 @@
 #include "memory/memory.h"
 #include "containers/hashtable.h"
 #include "renderer/renderer_frontend.h"
+#include "debug/profiler.h"
 
 // TODO: Временно - сделать фабрику и регистрировать вместо этого.
 #include "renderer/views/render_view_world.h"
@@ -230,6 +231,8 @@ render_view* render_view_system_get(const char* name)
 
 bool render_view_system_build_packet(render_view* view, void* data, render_view_packet* out_packet)
 {
+    KPROFILE_FUNCTION();
+
     if(!system_status_valid(__FUNCTION__)) return false;
 
     if(!out_packet)
@@ -243,6 +246,8 @@ bool render_view_system_build_packet(render_view* view, void* data, render_view_
 
 bool render_view_system_on_render(render_view* view, render_view_packet* packet, u64 frame_number, u64 render_target_index)
 {
+    KPROFILE_FUNCTION();
+
     if(!system_status_valid(__FUNCTION__)) return false;
 
     if(!packet)
@@ -5,6 +5,7 @@
 #include "logger.h"
 #include "kstring.h"
 #include "memory/memory.h"
+#include "debug/profiler.h"
 
 // Известые загрузчики ресурсов.
 #include "resources/loaders/image_loader.h"
@@ -147,6 +148,8 @@ KAPI bool resource_system_register_loader(resource_loader loader)
 
 KAPI bool resource_system_load(const char* name, resource_type type, resource* out_resource)
 {
+    KPROFILE_FUNCTION();
+
     if(!state_ptr)
     {
         kerror(message_not_initialized, __FUNCTION__);
@@ -172,6 +175,8 @@ KAPI bool resource_system_load(const char* name, resource_type type, resource* o
 
 KAPI bool resource_system_load_custom(const char* name, const char* custom_type, resource* out_resource)
 {
+    KPROFILE_FUNCTION();
+
     if(!state_ptr)
     {
         kerror(message_not_initialized, __FUNCTION__);
@@ -0,0 +1,453 @@
+// Собственные подключения.
+#include "systems/scene_system.h"
+#include "systems/transform_system.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+#include "math/kmath.h"
+#include "math/bvh.h"
+
+typedef struct scene_system_state {
+    // Конфигурация системы сцены.
+    scene_system_config config;
+
+    // Пул дескрипторов сеток.
+    handle_pool* mesh_handles;
+    // Количество сеток сцены.
+    u32 mesh_count;
+    // Сетки (индексируется плотным индексом).
+    mesh* meshes;
+    // Мировые матрицы сеток на момент последнего обновления (индексируется плотным индексом).
+    mat4* mesh_models;
+    // Первый узел списка геометрий сетки (индексируется плотным индексом).
+    u32* mesh_first_nodes;
+    // Индексы слотов пула для плотных индексов.
+    u32* mesh_dense_to_slot;
+    // Плотные индексы для слотов пула (индексируется слотом).
+    u32* mesh_slot_to_dense;
+    // Память сеток (MEMORY_TAG_ENTITY).
+    void* mesh_memory;
+    u64 mesh_memory_requirement;
+
+    // NOTE: Узел - объект сцены для одной геометрии сетки, индекс узла постоянен до удаления сетки.
+    //       Узлы сетки связаны в список по порядку геометрий.
+
+    // Объекты узлов (геометрия null у свободных узлов).
+    mesh_packet_item* node_items;
+    // Дескрипторы объектов иерархии узлов или KHANDLE_INVALID для отсутствующей геометрии.
+    khandle* node_proxies;
+    // Следующий узел списка сетки или списка свободных узлов, INVALID_ID в конце списка.
+    u32* node_next;
+    // Признаки нахождения узла в списках изменений (бит на список).
+    u8* node_change_flags;
+    // Первый свободный узел.
+    u32 node_free_head;
+    // Количество свободных узлов.
+    u32 node_free_count;
+
+    // NOTE: Изменения накапливаются в списке change_current, при обновлении он публикуется,
+    //       а накопление продолжается в другом списке.
+
+    // Списки измененных узлов.
+    u32* changes[2];
+    // Количество узлов в списках изменений.
+    u32 change_counts[2];
+    // Индекс списка, в котором накапливаются изменения.
+    u32 change_current;
+    // Номер последнего обновления.
+    u64 generation;
+    // Память узлов (MEMORY_TAG_ENTITY_NODE).
+    void* node_memory;
+    u64 node_memory_requirement;
+
+    // Иерархия мировых границ геометрий для отсечения.
+    bvh* tree;
+    // Память иерархии (MEMORY_TAG_NODE).
+    void* tree_memory;
+    u64 tree_memory_requirement;
+} scene_system_state;
+
+static scene_system_state* state_ptr = null;
+
+static bool system_status_valid(const char* func_name)
+{
+    if(!state_ptr)
+    {
+        if(func_name)
+        {
+            kerror("Function '%s' requires the scene system to be initialized. Call 'scene_system_initialize' first.", func_name);
+        }
+        return false;
+    }
+    return true;
+}
+
+// Получает плотный индекс сетки или INVALID_ID если дескриптор недействителен.
+static u32 dense_index_get(khandle m, const char* func_name)
+{
+    if(!system_status_valid(func_name)) return INVALID_ID;
+
+    if(!handle_pool_valid(state_ptr->mesh_handles, m))
+    {
+        if(func_name)
+        {
+            kerror("Function '%s' requires a valid mesh handle.", func_name);
+        }
+        return INVALID_ID;
+    }
+
+    return state_ptr->mesh_slot_to_dense[m.index];
+}
+
+// Добавляет узел в накапливаемый список изменений (однократно).
+static void change_push(u32 node)
+{
+    u32 current = state_ptr->change_current;
+    u8 bit = 1 << current;
+
+    if(state_ptr->node_change_flags[node] & bit) return;
+
+    state_ptr->node_change_flags[node] |= bit;
+    state_ptr->changes[current][state_ptr->change_counts[current]++] = node;
+}
+
+// Обновляет мировые границы геометрий сетки.
+static void mesh_bounds_update(u32 dense_index)
+{
+    mesh* m = &state_ptr->meshes[dense_index];
+    mat4 model = transform_system_get_world(m->transform);
+    state_ptr->mesh_models[dense_index] = model;
+
+    u32 node = state_ptr->mesh_first_nodes[dense_index];
+    for(u32 j = 0; j < m->geometry_count; ++j, node = state_ptr->node_next[node])
+    {
+        khandle proxy = state_ptr->node_proxies[node];
+        if(proxy.index == INVALID_ID) continue;
+
+        mesh_packet_item* item = &state_ptr->node_items[node];
+        item->bounds = extents_3d_transform(item->geometry->extents, model);
+        bvh_move(state_ptr->tree, proxy, item->bounds);
+        change_push(node);
+    }
+}
+
+bool scene_system_initialize(u64* memory_requirement, void* memory, scene_system_config* config)
+{
+    if(state_ptr)
+    {
+        kwarng("Function '%s' was called more than once!", __FUNCTION__);
+        return false;
+    }
+
+    if(!memory_requirement || !config)
+    {
+        kerror("Function '%s' requires a valid pointers to memory_requirement and config.", __FUNCTION__);
+        return false;
+    }
+
+    if(!config->max_mesh_count || config->max_mesh_count >= INVALID_ID)
+    {
+        kerror("Function '%s': config.max_mesh_count must be greater then zero and less then INVALID_ID.", __FUNCTION__);
+        return false;
+    }
+
+    if(!config->max_geometry_count || config->max_geometry_count >= INVALID_ID / 2)
+    {
+        kerror("Function '%s': config.max_geometry_count must be greater then zero and less then INVALID_ID / 2.", __FUNCTION__);
+        return false;
+    }
+
+    *memory_requirement = sizeof(scene_system_state);
+
+    if(!memory)
+    {
+        return true;
+    }
+
+    // Обнуление заголовка системы сцены.
+    kzero_tc(memory, scene_system_state, 1);
+    state_ptr = memory;
+
+    // Запись данных конфигурации системы.
+    state_ptr->config = *config;
+
+    // Сетки.
+    u32 max_meshes = config->max_mesh_count;
+    u64 pool_requirement = 0;
+    handle_pool_create(max_meshes, &pool_requirement, null);
+    u64 models_requirement = sizeof(mat4) * max_meshes;
+    u64 meshes_requirement = sizeof(mesh) * max_meshes;
+    u64 u32_requirement = sizeof(u32) * max_meshes;
+    state_ptr->mesh_memory_requirement = pool_requirement + models_requirement + meshes_requirement + u32_requirement * 3;
+    state_ptr->mesh_memory = kallocate(state_ptr->mesh_memory_requirement, MEMORY_TAG_ENTITY);
+
+    state_ptr->mesh_handles = handle_pool_create(max_meshes, &pool_requirement, state_ptr->mesh_memory);
+    void* block = POINTER_GET_OFFSET(state_ptr->mesh_memory, pool_requirement);
+    state_ptr->mesh_models        = block; block = POINTER_GET_OFFSET(block, models_requirement);
+    state_ptr->meshes             = block; block = POINTER_GET_OFFSET(block, meshes_requirement);
+    state_ptr->mesh_first_nodes   = block; block = POINTER_GET_OFFSET(block, u32_requirement);
+    state_ptr->mesh_dense_to_slot = block; block = POINTER_GET_OFFSET(block, u32_requirement);
+    state_ptr->mesh_slot_to_dense = block;
+    kset_tc(state_ptr->mesh_slot_to_dense, u32, max_meshes, 0xff);
+
+    // Узлы геометрий.
+    u32 max_nodes = config->max_geometry_count;
+    u64 items_requirement = sizeof(mesh_packet_item) * max_nodes;
+    u64 proxies_requirement = sizeof(khandle) * max_nodes;
+    u64 nodes_u32_requirement = sizeof(u32) * max_nodes;
+    u64 flags_requirement = sizeof(u8) * max_nodes;
+    state_ptr->node_memory_requirement = items_requirement + proxies_requirement + nodes_u32_requirement * 3 + flags_requirement;
+    state_ptr->node_memory = kallocate(state_ptr->node_memory_requirement, MEMORY_TAG_ENTITY_NODE);
+
+    block = state_ptr->node_memory;
+    state_ptr->node_items        = block; block = POINTER_GET_OFFSET(block, items_requirement);
+    state_ptr->node_proxies      = block; block = POINTER_GET_OFFSET(block, proxies_requirement);
+    state_ptr->node_next         = block; block = POINTER_GET_OFFSET(block, nodes_u32_requirement);
+    state_ptr->changes[0]        = block; block = POINTER_GET_OFFSET(block, nodes_u32_requirement);
+    state_ptr->changes[1]        = block; block = POINTER_GET_OFFSET(block, nodes_u32_requirement);
+    state_ptr->node_change_flags = block;
+
+    // Геометрии свободных узлов null, флаги изменений сброшены.
+    kzero(state_ptr->node_memory, state_ptr->node_memory_requirement);
+    for(u32 i = 0; i < max_nodes; ++i)
+    {
+        state_ptr->node_next[i] = i + 1 < max_nodes ? i + 1 : INVALID_ID;
+    }
+    state_ptr->node_free_head = 0;
+    state_ptr->node_free_count = max_nodes;
+
+    // Иерархия границ.
+    bvh_create(max_nodes, &state_ptr->tree_memory_requirement, null);
+    state_ptr->tree_memory = kallocate(state_ptr->tree_memory_requirement, MEMORY_TAG_NODE);
+    state_ptr->tree = bvh_create(max_nodes, &state_ptr->tree_memory_requirement, state_ptr->tree_memory);
+
+    if(!state_ptr->mesh_handles || !state_ptr->tree)
+    {
+        kerror("Function '%s': Failed to create scene storage.", __FUNCTION__);
+        scene_system_shutdown();
+        return false;
+    }
+
+    return true;
+}
+
+void scene_system_shutdown()
+{
+    if(!system_status_valid(__FUNCTION__)) return;
+
+    for(u32 i = 0; i < state_ptr->mesh_count; ++i)
+    {
+        transform_system_destroy(state_ptr->meshes[i].transform);
+    }
+
+    if(state_ptr->tree)
+    {
+        bvh_destroy(state_ptr->tree);
+    }
+    if(state_ptr->mesh_handles)
+    {
+        handle_pool_destroy(state_ptr->mesh_handles);
+    }
+
+    kfree(state_ptr->tree_memory, state_ptr->tree_memory_requirement, MEMORY_TAG_NODE);
+    kfree(state_ptr->node_memory, state_ptr->node_memory_requirement, MEMORY_TAG_ENTITY_NODE);
+    kfree(state_ptr->mesh_memory, state_ptr->mesh_memory_requirement, MEMORY_TAG_ENTITY);
+    state_ptr = null;
+}
+
+void scene_system_update()
+{
+    if(!system_status_valid(__FUNCTION__)) return;
+
+    for(u32 i = 0; i < state_ptr->mesh_count; ++i)
+    {
+        if(transform_system_is_world_changed(state_ptr->meshes[i].transform))
+        {
+            mesh_bounds_update(i);
+        }
+    }
+
+    bvh_update(state_ptr->tree);
+
+    // Публикация накопленных изменений, накопление продолжается в ранее опубликованном списке.
+    u32 next = state_ptr->change_current ^ 1;
+    u8 next_mask = ~(1 << next);
+    for(u32 i = 0; i < state_ptr->change_counts[next]; ++i)
+    {
+        state_ptr->node_change_flags[state_ptr->changes[next][i]] &= next_mask;
+    }
+    state_ptr->change_counts[next] = 0;
+    state_ptr->change_current = next;
+    state_ptr->generation++;
+}
+
+khandle scene_system_mesh_add(u16 geometry_count, geometry** geometries, khandle transform)
+{
+    if(!system_status_valid(__FUNCTION__)) return KHANDLE_INVALID;
+
+    if(!geometry_count || !geometries)
+    {
+        kerror("Function '%s' requires a valid pointer to geometries and geometry_count greater than zero.", __FUNCTION__);
+        return KHANDLE_INVALID;
+    }
+
+    if(!transform_system_valid(transform))
+    {
+        kerror("Function '%s' requires a valid transform handle.", __FUNCTION__);
+        return KHANDLE_INVALID;
+    }
+
+    if(state_ptr->node_free_count < geometry_count)
+    {
+        kerror("Function '%s': No free geometry nodes. Increase max_geometry_count of scene system.", __FUNCTION__);
+        return KHANDLE_INVALID;
+    }
+
+    khandle handle;
+    if(!handle_pool_acquire(state_ptr->mesh_handles, &handle))
+    {
+        kerror("Function '%s': No free mesh slots. Increase max_mesh_count of scene system.", __FUNCTION__);
+        return KHANDLE_INVALID;
+    }
+
+    u32 index = state_ptr->mesh_count++;
+    state_ptr->mesh_dense_to_slot[index] = handle.index;
+    state_ptr->mesh_slot_to_dense[handle.index] = index;
+
+    mesh* m = &state_ptr->meshes[index];
+    m->geometry_count = geometry_count;
+    m->geometries = geometries;
+    m->transform = transform;
+
+    // Список узлов в порядке геометрий: узлы берутся из начала списка свободных.
+    mat4 model = transform_system_get_world(transform);
+    state_ptr->mesh_models[index] = model;
+
+    u32 first = state_ptr->node_free_head;
+    u32 node = first;
+    u32 last = INVALID_ID;
+
+    for(u32 j = 0; j < geometry_count; ++j)
+    {
+        khandle* proxy = &state_ptr->node_proxies[node];
+        mesh_packet_item* item = &state_ptr->node_items[node];
+        *proxy = KHANDLE_INVALID;
+        item->geometry = geometries[j];
+        item->mesh_index = index;
+
+        if(item->geometry)
+        {
+            item->bounds = extents_3d_transform(item->geometry->extents, model);
+            bvh_insert(state_ptr->tree, item->bounds, node, proxy);
+        }
+
+        change_push(node);
+        last = node;
+        node = state_ptr->node_next[node];
+    }
+
+    state_ptr->node_free_head = node;
+    state_ptr->node_free_count -= geometry_count;
+    state_ptr->node_next[last] = INVALID_ID;
+    state_ptr->mesh_first_nodes[index] = first;
+
+    return handle;
+}
+
+bool scene_system_mesh_remove(khandle m)
+{
+    u32 index = dense_index_get(m, __FUNCTION__);
+    if(index == INVALID_ID) return false;
+
+    // Возврат узлов в начало списка свободных.
+    u32 node = state_ptr->mesh_first_nodes[index];
+    u32 last = INVALID_ID;
+    while(node != INVALID_ID)
+    {
+        khandle proxy = state_ptr->node_proxies[node];
+        if(proxy.index != INVALID_ID)
+        {
+            bvh_remove(state_ptr->tree, proxy);
+        }
+        state_ptr->node_items[node].geometry = null;
+        state_ptr->node_items[node].mesh_index = INVALID_ID;
+        change_push(node);
+
+        last = node;
+        node = state_ptr->node_next[node];
+    }
+
+    state_ptr->node_next[last] = state_ptr->node_free_head;
+    state_ptr->node_free_head = state_ptr->mesh_first_nodes[index];
+    state_ptr->node_free_count += state_ptr->meshes[index].geometry_count;
+
+    transform_system_destroy(state_ptr->meshes[index].transform);
+
+    // Перенос последней сетки на место удаленной.
+    u32 last_index = --state_ptr->mesh_count;
+    if(index != last_index)
+    {
+        state_ptr->meshes[index] = state_ptr->meshes[last_index];
+        state_ptr->mesh_models[index] = state_ptr->mesh_models[last_index];
+        state_ptr->mesh_first_nodes[index] = state_ptr->mesh_first_nodes[last_index];
+        state_ptr->mesh_dense_to_slot[index] = state_ptr->mesh_dense_to_slot[last_index];
+        state_ptr->mesh_slot_to_dense[state_ptr->mesh_dense_to_slot[index]] = index;
+
+        for(node = state_ptr->mesh_first_nodes[index]; node != INVALID_ID; node = state_ptr->node_next[node])
+        {
+            state_ptr->node_items[node].mesh_index = index;
+        }
+    }
+
+    state_ptr->mesh_slot_to_dense[m.index] = INVALID_ID;
+    handle_pool_release(state_ptr->mesh_handles, m);
+    return true;
+}
+
+void scene_system_mesh_set_dirty(khandle m)
+{
+    u32 index = dense_index_get(m, __FUNCTION__);
+    if(index == INVALID_ID) return;
+
+    for(u32 node = state_ptr->mesh_first_nodes[index]; node != INVALID_ID; node = state_ptr->node_next[node])
+    {
+        change_push(node);
+    }
+}
+
+mesh* scene_system_mesh_get(khandle m)
+{
+    u32 index = dense_index_get(m, __FUNCTION__);
+    if(index == INVALID_ID) return null;
+    return &state_ptr->meshes[index];
+}
+
+u32 scene_system_mesh_count()
+{
+    if(!system_status_valid(__FUNCTION__)) return 0;
+    return state_ptr->mesh_count;
+}
+
+void scene_system_get_mesh_packet_data(mesh_packet_data* out_data)
+{
+    if(!out_data)
+    {
+        kerror("Function '%s' requires a valid pointer to out_data.", __FUNCTION__);
+        return;
+    }
+
+    kzero_tc(out_data, mesh_packet_data, 1);
+    if(!system_status_valid(__FUNCTION__)) return;
+
+    u32 published = state_ptr->change_current ^ 1;
+    out_data->mesh_count = state_ptr->mesh_count;
+    out_data->meshes = state_ptr->meshes;
+    out_data->mesh_models = state_ptr->mesh_models;
+    out_data->culling_tree = state_ptr->tree;
+    out_data->item_capacity = state_ptr->config.max_geometry_count;
+    out_data->items = state_ptr->node_items;
+    out_data->generation = state_ptr->generation;
+    out_data->changed_item_count = state_ptr->change_counts[published];
+    out_data->changed_items = state_ptr->changes[published];
+}
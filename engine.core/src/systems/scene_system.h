@@ -0,0 +1,85 @@
+#pragma once
+
+#include <defines.h>
+#include <resources/resource_types.h>
+#include <renderer/renderer_types.h>
+
+// @brief Конфигурация системы сцены.
+typedef struct scene_system_config {
+    // @brief Максимальное количество сеток сцены.
+    u32 max_mesh_count;
+    // @brief Максимальное суммарное количество геометрий всех сеток сцены.
+    u32 max_geometry_count;
+} scene_system_config;
+
+/*
+    @brief Инициализирует систему сцены используя предоставленную конфигурацию.
+    NOTE: Сетки хранятся плотным массивом, поэтому пакеты отрисовки строятся линейным проходом.
+          Каждая геометрия сетки является объектом сцены с постоянным индексом, мировые границы объектов
+          хранятся в иерархии ограничивающих объемов для отсечения. Изменения объектов за обновление
+          публикуются списком, по которому представления исправляют свои списки отрисовки.
+    @param memory_requirement Указатель на переменную для сохранения требований системы к памяти в байтах.
+    @param memory Указатель на выделенный блок памяти, или null для получения требований.
+    @param config Конфигурация используемая для инициализации системы и получения требований к памяти.
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool scene_system_initialize(u64* memory_requirement, void* memory, scene_system_config* config);
+
+/*
+    @brief Завершает работу системы сцены и освобождает выделеные ей ресурсы.
+    NOTE: Преобразования оставшихся сеток уничтожаются, поэтому вызывается до завершения системы преобразований.
+*/
+void scene_system_shutdown();
+
+/*
+    @brief Обновляет мировые границы геометрий сеток, преобразования которых изменились, и публикует
+           список объектов, измененных с предыдущего обновления.
+    NOTE: Вызывается один раз за кадр после transform_system_update и до построения пакетов отрисовки.
+*/
+KAPI void scene_system_update();
+
+/*
+    @brief Добавляет сетку в сцену.
+    NOTE: Массив геометрий не копируется и должен существовать до удаления сетки, поэтому экземпляры
+          одной модели могут использовать общий массив. Сцена становится владельцем преобразования.
+    @param geometry_count Количество геометрий.
+    @param geometries Массив указателей на геометрии.
+    @param transform Дескриптор преобразования сетки.
+    @return Дескриптор сетки или KHANDLE_INVALID при ошибках.
+*/
+KAPI khandle scene_system_mesh_add(u16 geometry_count, geometry** geometries, khandle transform);
+
+/*
+    @brief Удаляет сетку из сцены и уничтожает ее преобразование, дескриптор становится недействительным.
+    @param m Дескриптор сетки.
+    @return True в случае успеха, false если дескриптор недействителен.
+*/
+KAPI bool scene_system_mesh_remove(khandle m);
+
+/*
+    @brief Отмечает все геометрии сетки измененными (например, после смены их материалов).
+    NOTE: Смена материала не отслеживается сценой автоматически. Без вызова представления переносят
+          геометрию в список с прозрачностью или без нее только при следующем движении камеры.
+    @param m Дескриптор сетки.
+*/
+KAPI void scene_system_mesh_set_dirty(khandle m);
+
+/*
+    @brief Получает сетку сцены.
+    NOTE: Указатель действителен до следующего добавления или удаления сетки.
+    @param m Дескриптор сетки.
+    @return Указатель на сетку или null если дескриптор недействителен.
+*/
+KAPI mesh* scene_system_mesh_get(khandle m);
+
+/*
+    @brief Возвращает количество сеток сцены.
+    @return Количество сеток или 0 при ошибках.
+*/
+KAPI u32 scene_system_mesh_count();
+
+/*
+    @brief Заполняет данные для построения пакета отрисовки по всем сеткам сцены.
+    @param out_data Указатель для сохранения данных пакета.
+*/
+KAPI void scene_system_get_mesh_packet_data(mesh_packet_data* out_data);
@@ -164,6 +164,7 @@ bool shader_system_create(const shader_config* config)
     shader->name = string_duplicate(config->name);
     shader->use_instances = config->use_instances;
     shader->use_locals = config->use_local;
+    shader->use_bindless = config->use_bindless;
     shader->bound_instance_id = INVALID_ID;
 
     // Создание динамаических массивов.
@@ -500,9 +501,13 @@ bool add_attribute(shader* shader, shader_attribute_config* config)
         case SHADER_ATTRIB_TYPE_FLOAT32:
         case SHADER_ATTRIB_TYPE_INT32:
         case SHADER_ATTRIB_TYPE_UINT32:
+        case SHADER_ATTRIB_TYPE_FLOAT16_2:
+        case SHADER_ATTRIB_TYPE_UNORM8_4:
             size = 4;
             break;
         case SHADER_ATTRIB_TYPE_FLOAT32_2:
+        case SHADER_ATTRIB_TYPE_UNORM16_4:
+        case SHADER_ATTRIB_TYPE_SNORM16_4:
             size = 8;
             break;
         case SHADER_ATTRIB_TYPE_FLOAT32_3:
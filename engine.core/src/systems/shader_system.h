@@ -67,6 +67,9 @@ typedef struct shader {
     bool use_instances;
     // @brief Указывает на использование uniform переменых локального уровня.
     bool use_locals;
+    // @brief Указывает на использование режима bindless: текстуры экземпляров в едином массиве, а данные
+    //        экземпляров в буфере хранения, экземпляр выбирается индексом через push-константу.
+    bool use_bindless;
     // @brief Запрашиваемое выравнивание в байтах объекта uniform-буфера.
     u64 required_ubo_alignment;
     // @brief Размер глобального объекта uniform-буфера.
@@ -7,6 +7,7 @@
 #include "kstring.h"
 #include "memory/memory.h"
 #include "containers/hashtable.h"
+#include "containers/handle_pool.h"
 #include "renderer/renderer_frontend.h"
 
 typedef struct texture_system_state {
@@ -21,13 +22,15 @@ typedef struct texture_system_state {
     texture* textures;
     // Таблица ссылок на текстуры.
     hashtable* texture_references_table;
+    // Пул слотов массива текстур.
+    handle_pool* texture_handles;
 } texture_system_state;
 
 // TODO: Умную выгрузку текстур. Например вугружать те материалы которые можно выгружать
 //       и только при достижении определенной границы памяти для загрузки новых.
 typedef struct texture_reference {
-    // Индекс текстуры в массиве текстур.
-    u32 id;
+    // Дескриптор слота текстуры в массиве текстур (индекс и поколение).
+    khandle handle;
     // Количество ссылок на текстуру.
     u64 reference_count;
     // Авто уничтожение текстуры.
@@ -85,7 +88,9 @@ bool texture_system_initialize(u64* memory_requirement, void* memory, texture_sy
     u64 hashtable_requirement = 0;
     hashtable_config hconf = { sizeof(texture_reference), config->max_texture_count };
     hashtable_create(&hashtable_requirement, null, &hconf, null);
-    *memory_requirement = state_requirement + textures_requirement + hashtable_requirement;
+    u64 pool_requirement = 0;
+    handle_pool_create(config->max_texture_count, &pool_requirement, null);
+    *memory_requirement = state_requirement + textures_requirement + hashtable_requirement + pool_requirement;
 
     if(!memory)
     {
@@ -111,6 +116,10 @@ bool texture_system_initialize(u64* memory_requirement, void* memory, texture_sy
         return false;
     }
 
+    // Получение и запись указателя на пул слотов.
+    void* pool_block = POINTER_GET_OFFSET(hashtable_block, hashtable_requirement);
+    state_ptr->texture_handles = handle_pool_create(config->max_texture_count, &pool_requirement, pool_block);
+
     // Отмечает все текстуры как недействительные.
     for(u32 i = 0; i < state_ptr->config.max_texture_count; ++i)
     {
@@ -151,6 +160,7 @@ void texture_system_shutdown()
     // Уничтожение текстур по умолчанию.
     default_textures_destroy();
 
+    handle_pool_destroy(state_ptr->texture_handles);
     state_ptr = null;
 }
 
@@ -484,6 +494,9 @@ bool texture_load(const char* texture_name, texture* t)
 
 void texture_destroy(texture* t)
 {
+    // NOTE: Текстура может читаться записываемым кадром до ее обнуления.
+    renderer_resources_lock();
+
     // Удаление из памяти графического процессора.
     renderer_texture_destroy(t);
 
@@ -491,6 +504,8 @@ void texture_destroy(texture* t)
     kzero_tc(t, texture, 1);
     t->id = INVALID_ID;
     t->generation = INVALID_ID;
+
+    renderer_resources_unlock();
 }
 
 bool texture_process_acquire(const char* name, bool auto_release, bool skip_load, u32* out_texture_id)
@@ -498,23 +513,13 @@ bool texture_process_acquire(const char* name, bool auto_release, bool skip_load
     texture_reference ref;
 
     // Когда текстуры нет или запись помечена как не действительная, то это момент создания новой текстуры.
-    if(!hashtable_get(state_ptr->texture_references_table, name, &ref) || ref.id == INVALID_ID)
+    if(!hashtable_get(state_ptr->texture_references_table, name, &ref) || ref.handle.index == INVALID_ID)
     {
         ref.reference_count = 0;
         ref.auto_release = auto_release;
 
-        // Поиск свободной памяти для текстуры.
-        for(u32 i = 0; i < state_ptr->config.max_texture_count; ++i)
-        {
-            if(state_ptr->textures[i].id == INVALID_ID)
-            {
-                ref.id = i;
-                break;
-            }
-        }
-
-        // Если свободный участок памяти не найден.
-        if(ref.id == INVALID_ID)
+        // Получение свободной памяти для текстуры.
+        if(!handle_pool_acquire(state_ptr->texture_handles, &ref.handle))
         {
             kerror(
                 "Function '%s': Texture system cannot hold anymore textures. Adjust configuration to allow more.",
@@ -523,13 +528,15 @@ bool texture_process_acquire(const char* name, bool auto_release, bool skip_load
             return false;
         }
 
-        texture* t = &state_ptr->textures[ref.id];
-        t->id = ref.id;
+        texture* t = &state_ptr->textures[ref.handle.index];
+        t->id = ref.handle.index;
 
         // Создание текстуры.
         if(!skip_load && !texture_load(name, t))
         {
             kerror("Function '%s': Failed to load texture '%s'.", __FUNCTION__, name);
+            handle_pool_release(state_ptr->texture_handles, ref.handle);
+            t->id = INVALID_ID;
             return false;
         }
 
@@ -556,7 +563,7 @@ bool texture_process_acquire(const char* name, bool auto_release, bool skip_load
         return false;
     }
 
-    *out_texture_id = ref.id;
+    *out_texture_id = ref.handle.index;
     return true;
 }
 
@@ -573,13 +580,18 @@ bool texture_process_release(const char* name)
 
     if(ref.reference_count == 0 && ref.auto_release)
     {
-        texture* t = &state_ptr->textures[ref.id];
+        // NOTE: Слот мог быть освобожден и занят другой текстурой, тогда поколение не совпадет.
+        if(!handle_pool_release(state_ptr->texture_handles, ref.handle))
+        {
+            kerror("Function '%s': Texture '%s' refers to a stale slot %u. Skipping...", __FUNCTION__, name, ref.handle.index);
+            return false;
+        }
 
         // Освобождение/восстановление памяти текстуры для новой.
-        texture_destroy(t);
+        texture_destroy(&state_ptr->textures[ref.handle.index]);
 
         // Освобождение ссылки.
-        ref.id = INVALID_ID;
+        ref.handle = KHANDLE_INVALID;
         ref.auto_release = false;
 
         ktrace(
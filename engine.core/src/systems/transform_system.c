@@ -0,0 +1,544 @@
+// Собственные подключения.
+#include "systems/transform_system.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+#include "math/kmath.h"
+
+// @brief Локальная матрица должна быть пересчитана.
+#define TRANSFORM_FLAG_LOCAL_DIRTY   0x01
+// @brief Мировая матрица изменилась при последнем обновлении (потомки должны быть пересчитаны).
+#define TRANSFORM_FLAG_WORLD_CHANGED 0x02
+// @brief Преобразование уничтожено и будет удалено из массивов при следующем обновлении.
+#define TRANSFORM_FLAG_DESTROYED     0x04
+
+typedef struct transform_system_state {
+    // Конфигурация системы преобразований.
+    transform_system_config config;
+    // Пул дескрипторов преобразований.
+    handle_pool* handles;
+    // Количество занятых элементов массивов (включая уничтоженные до обновления).
+    u32 count;
+    // Порядок массивов нарушен (родитель после потомка) или есть уничтоженные элементы.
+    bool needs_rebuild;
+
+    // NOTE: Массивы ниже индексируются плотным индексом, родитель всегда раньше потомков.
+
+    // Локальные матрицы.
+    mat4* locals;
+    // Мировые матрицы.
+    mat4* worlds;
+    // Повороты относительно родителя.
+    quat* rotations;
+    // Позиции относительно родителя.
+    vec3* positions;
+    // Масштабы относительно родителя.
+    vec3* scales;
+    // Плотные индексы родителей или INVALID_ID для корневых преобразований.
+    u32* parents;
+    // Индексы слотов пула для плотных индексов.
+    u32* dense_to_slot;
+    // Флаги состояния преобразований.
+    u8* flags;
+
+    // Плотные индексы для слотов пула (индексируется слотом).
+    u32* slot_to_dense;
+
+    // Временные массивы для восстановления порядка.
+    u32* scratch_depths;
+    u32* scratch_order;
+    u32* scratch_remap;
+    u32* scratch_counts;
+    void* scratch_elements;
+} transform_system_state;
+
+static transform_system_state* state_ptr = null;
+
+static bool system_status_valid(const char* func_name)
+{
+    if(!state_ptr)
+    {
+        if(func_name)
+        {
+            kerror(
+                "Function '%s' requires the transform system to be initialized. Call 'transform_system_initialize' first.",
+                func_name
+            );
+        }
+        return false;
+    }
+    return true;
+}
+
+// Получает плотный индекс преобразования или INVALID_ID если дескриптор недействителен.
+static u32 dense_index_get(khandle t, const char* func_name)
+{
+    if(!system_status_valid(func_name)) return INVALID_ID;
+
+    if(!handle_pool_valid(state_ptr->handles, t))
+    {
+        if(func_name)
+        {
+            kerror("Function '%s' requires a valid transform handle.", func_name);
+        }
+        return INVALID_ID;
+    }
+
+    return state_ptr->slot_to_dense[t.index];
+}
+
+static khandle handle_get(u32 dense_index)
+{
+    khandle handle = KHANDLE_INVALID;
+    handle_pool_handle_get(state_ptr->handles, state_ptr->dense_to_slot[dense_index], &handle);
+    return handle;
+}
+
+// Вычисляет локальную матрицу (как transform_get_local: масштаб, затем поворот, затем перенос).
+static void local_compose(u32 index)
+{
+    vec3 s = state_ptr->scales[index];
+    vec3 p = state_ptr->positions[index];
+    mat4* local = &state_ptr->locals[index];
+
+    *local = quat_to_mat4(state_ptr->rotations[index]);
+    for(u32 col = 0; col < 3; ++col)
+    {
+        local->data[col]     *= s.x;
+        local->data[col + 4] *= s.y;
+        local->data[col + 8] *= s.z;
+    }
+    local->data[12] = p.x;
+    local->data[13] = p.y;
+    local->data[14] = p.z;
+}
+
+static void elements_permute(void* array, u64 stride, u32 count)
+{
+    for(u32 i = 0; i < count; ++i)
+    {
+        void* dest = POINTER_GET_OFFSET(state_ptr->scratch_elements, stride * i);
+        void* src = POINTER_GET_OFFSET(array, stride * state_ptr->scratch_order[i]);
+        kcopy(dest, src, stride);
+    }
+    kcopy(array, state_ptr->scratch_elements, stride * count);
+}
+
+/*
+    Удаляет уничтоженные элементы и упорядочивает массивы по глубине в иерархии. Сортировка подсчетом
+    устойчивая, поэтому относительный порядок элементов одной глубины сохраняется.
+*/
+static void arrays_rebuild()
+{
+    transform_system_state* s = state_ptr;
+    u32* depths = s->scratch_depths;
+    u32* stack = s->scratch_remap;
+    u32 max_depth = 0;
+
+    // Потомки уничтоженных преобразований становятся корневыми.
+    for(u32 i = 0; i < s->count; ++i)
+    {
+        u32 parent = s->parents[i];
+        if(parent != INVALID_ID && (s->flags[parent] & TRANSFORM_FLAG_DESTROYED))
+        {
+            s->parents[i] = INVALID_ID;
+            s->flags[i] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+        }
+        depths[i] = INVALID_ID;
+    }
+
+    // Глубина вычисляется подъемом до первого предка с известной глубиной.
+    for(u32 i = 0; i < s->count; ++i)
+    {
+        u32 length = 0;
+        u32 node = i;
+        while(node != INVALID_ID && depths[node] == INVALID_ID)
+        {
+            stack[length++] = node;
+            node = s->parents[node];
+        }
+
+        u32 depth = node == INVALID_ID ? 0 : depths[node] + 1;
+        while(length)
+        {
+            depths[stack[--length]] = depth++;
+        }
+        max_depth = KMAX(max_depth, depths[i]);
+    }
+
+    // Сортировка подсчетом по глубине.
+    u32 depth_count = max_depth + 1;
+    kzero_tc(s->scratch_counts, u32, depth_count);
+    for(u32 i = 0; i < s->count; ++i)
+    {
+        if(s->flags[i] & TRANSFORM_FLAG_DESTROYED) continue;
+        s->scratch_counts[depths[i]]++;
+    }
+
+    u32 offset = 0;
+    for(u32 d = 0; d < depth_count; ++d)
+    {
+        u32 nodes = s->scratch_counts[d];
+        s->scratch_counts[d] = offset;
+        offset += nodes;
+    }
+
+    u32 new_count = offset;
+    for(u32 i = 0; i < s->count; ++i)
+    {
+        if(s->flags[i] & TRANSFORM_FLAG_DESTROYED)
+        {
+            s->scratch_remap[i] = INVALID_ID;
+            continue;
+        }
+        u32 new_index = s->scratch_counts[depths[i]]++;
+        s->scratch_order[new_index] = i;
+        s->scratch_remap[i] = new_index;
+    }
+
+    // Перестановка массивов.
+    elements_permute(s->locals, sizeof(mat4), new_count);
+    elements_permute(s->worlds, sizeof(mat4), new_count);
+    elements_permute(s->rotations, sizeof(quat), new_count);
+    elements_permute(s->positions, sizeof(vec3), new_count);
+    elements_permute(s->scales, sizeof(vec3), new_count);
+    elements_permute(s->dense_to_slot, sizeof(u32), new_count);
+    elements_permute(s->flags, sizeof(u8), new_count);
+    elements_permute(s->parents, sizeof(u32), new_count);
+
+    for(u32 i = 0; i < new_count; ++i)
+    {
+        if(s->parents[i] != INVALID_ID)
+        {
+            s->parents[i] = s->scratch_remap[s->parents[i]];
+        }
+        s->slot_to_dense[s->dense_to_slot[i]] = i;
+    }
+
+    s->count = new_count;
+    s->needs_rebuild = false;
+}
+
+bool transform_system_initialize(u64* memory_requirement, void* memory, transform_system_config* config)
+{
+    if(state_ptr)
+    {
+        kwarng("Function '%s' was called more than once!", __FUNCTION__);
+        return false;
+    }
+
+    if(!memory_requirement || !config)
+    {
+        kerror("Function '%s' requires a valid pointers to memory_requirement and config.", __FUNCTION__);
+        return false;
+    }
+
+    if(!config->max_transform_count || config->max_transform_count >= INVALID_ID)
+    {
+        kerror("Function '%s': config.max_transform_count must be greater then zero and less then INVALID_ID.", __FUNCTION__);
+        return false;
+    }
+
+    u32 max = config->max_transform_count;
+    u64 state_requirement = sizeof(transform_system_state);
+    u64 pool_requirement = 0;
+    handle_pool_create(max, &pool_requirement, null);
+    u64 mat4_requirement = sizeof(mat4) * max;
+    u64 quat_requirement = sizeof(quat) * max;
+    u64 vec3_requirement = sizeof(vec3) * max;
+    u64 u32_requirement = sizeof(u32) * max;
+    u64 arrays_requirement = mat4_requirement * 3 + quat_requirement + vec3_requirement * 2 + u32_requirement * 7
+                           + sizeof(u32) + sizeof(u8) * max;
+    *memory_requirement = state_requirement + pool_requirement + arrays_requirement;
+
+    if(!memory)
+    {
+        return true;
+    }
+
+    // Обнуление заголовка системы преобразований.
+    kzero_tc(memory, transform_system_state, 1);
+    state_ptr = memory;
+
+    // Запись данных конфигурации системы.
+    state_ptr->config = *config;
+
+    // Получение и запись указателя на пул дескрипторов.
+    void* pool_block = POINTER_GET_OFFSET(state_ptr, state_requirement);
+    state_ptr->handles = handle_pool_create(max, &pool_requirement, pool_block);
+    if(!state_ptr->handles)
+    {
+        kerror("Function '%s': Failed to create handle pool of transforms.", __FUNCTION__);
+        state_ptr = null;
+        return false;
+    }
+
+    // Получение и запись указателей на массивы (от больших элементов к меньшим).
+    void* block = POINTER_GET_OFFSET(pool_block, pool_requirement);
+    state_ptr->locals           = block; block = POINTER_GET_OFFSET(block, mat4_requirement);
+    state_ptr->worlds           = block; block = POINTER_GET_OFFSET(block, mat4_requirement);
+    state_ptr->scratch_elements = block; block = POINTER_GET_OFFSET(block, mat4_requirement);
+    state_ptr->rotations        = block; block = POINTER_GET_OFFSET(block, quat_requirement);
+    state_ptr->positions        = block; block = POINTER_GET_OFFSET(block, vec3_requirement);
+    state_ptr->scales           = block; block = POINTER_GET_OFFSET(block, vec3_requirement);
+    state_ptr->parents          = block; block = POINTER_GET_OFFSET(block, u32_requirement);
+    state_ptr->dense_to_slot    = block; block = POINTER_GET_OFFSET(block, u32_requirement);
+    state_ptr->slot_to_dense    = block; block = POINTER_GET_OFFSET(block, u32_requirement);
+    state_ptr->scratch_depths   = block; block = POINTER_GET_OFFSET(block, u32_requirement);
+    state_ptr->scratch_order    = block; block = POINTER_GET_OFFSET(block, u32_requirement);
+    state_ptr->scratch_remap    = block; block = POINTER_GET_OFFSET(block, u32_requirement);
+    state_ptr->scratch_counts   = block; block = POINTER_GET_OFFSET(block, u32_requirement + sizeof(u32));
+    state_ptr->flags            = block;
+
+    kset_tc(state_ptr->slot_to_dense, u32, max, 0xff);
+
+    return true;
+}
+
+void transform_system_shutdown()
+{
+    if(!system_status_valid(__FUNCTION__)) return;
+    handle_pool_destroy(state_ptr->handles);
+    state_ptr = null;
+}
+
+void transform_system_update()
+{
+    if(!system_status_valid(__FUNCTION__)) return;
+
+    if(state_ptr->needs_rebuild)
+    {
+        arrays_rebuild();
+    }
+
+    u32 count = state_ptr->count;
+    const u32* parents = state_ptr->parents;
+    mat4* locals = state_ptr->locals;
+    mat4* worlds = state_ptr->worlds;
+    u8* flags = state_ptr->flags;
+
+    // NOTE: Родитель обработан раньше потомка, поэтому его флаг уже относится к текущему обновлению.
+    for(u32 i = 0; i < count; ++i)
+    {
+        u8 flag = flags[i];
+        u32 parent = parents[i];
+
+        if(flag & TRANSFORM_FLAG_LOCAL_DIRTY)
+        {
+            local_compose(i);
+        }
+
+        bool changed = (flag & TRANSFORM_FLAG_LOCAL_DIRTY)
+                    || (parent != INVALID_ID && (flags[parent] & TRANSFORM_FLAG_WORLD_CHANGED));
+
+        if(changed)
+        {
+            worlds[i] = parent == INVALID_ID ? locals[i] : mat4_mul(locals[i], worlds[parent]);
+        }
+
+        flags[i] = changed ? TRANSFORM_FLAG_WORLD_CHANGED : 0;
+    }
+}
+
+khandle transform_system_create(vec3 position, quat rotation, vec3 scale, khandle parent)
+{
+    if(!system_status_valid(__FUNCTION__)) return KHANDLE_INVALID;
+
+    u32 parent_index = INVALID_ID;
+    if(parent.index != INVALID_ID)
+    {
+        parent_index = dense_index_get(parent, __FUNCTION__);
+        if(parent_index == INVALID_ID) return KHANDLE_INVALID;
+    }
+
+    // Массивы заполнены уничтоженными элементами, которые еще не удалены.
+    if(state_ptr->count == state_ptr->config.max_transform_count && state_ptr->needs_rebuild)
+    {
+        khandle parent_handle = parent_index != INVALID_ID ? handle_get(parent_index) : KHANDLE_INVALID;
+        arrays_rebuild();
+        parent_index = parent_handle.index != INVALID_ID ? state_ptr->slot_to_dense[parent_handle.index] : INVALID_ID;
+    }
+
+    khandle handle;
+    if(!handle_pool_acquire(state_ptr->handles, &handle))
+    {
+        kerror("Function '%s' failed to acquire new slot. Adjust transform system config to allow more.", __FUNCTION__);
+        return KHANDLE_INVALID;
+    }
+
+    // NOTE: Новый элемент добавляется в конец, поэтому он всегда находится после своего родителя.
+    u32 index = state_ptr->count++;
+    state_ptr->positions[index] = position;
+    state_ptr->rotations[index] = rotation;
+    state_ptr->scales[index] = scale;
+    state_ptr->parents[index] = parent_index;
+    state_ptr->dense_to_slot[index] = handle.index;
+    state_ptr->slot_to_dense[handle.index] = index;
+
+    // Матрицы доступны сразу, мировая матрица уточняется при обновлении, если родитель изменен.
+    local_compose(index);
+    state_ptr->worlds[index] = parent_index == INVALID_ID
+                             ? state_ptr->locals[index] : mat4_mul(state_ptr->locals[index], state_ptr->worlds[parent_index]);
+    state_ptr->flags[index] = TRANSFORM_FLAG_LOCAL_DIRTY;
+
+    return handle;
+}
+
+void transform_system_destroy(khandle t)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return;
+
+    // NOTE: Элемент удаляется из массивов при следующем обновлении, чтобы не нарушать порядок.
+    state_ptr->flags[index] |= TRANSFORM_FLAG_DESTROYED;
+    state_ptr->slot_to_dense[t.index] = INVALID_ID;
+    state_ptr->needs_rebuild = true;
+    handle_pool_release(state_ptr->handles, t);
+}
+
+bool transform_system_valid(khandle t)
+{
+    if(!system_status_valid(__FUNCTION__)) return false;
+    return handle_pool_valid(state_ptr->handles, t);
+}
+
+khandle transform_system_get_parent(khandle t)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return KHANDLE_INVALID;
+
+    u32 parent = state_ptr->parents[index];
+    if(parent == INVALID_ID || (state_ptr->flags[parent] & TRANSFORM_FLAG_DESTROYED))
+    {
+        return KHANDLE_INVALID;
+    }
+
+    return handle_get(parent);
+}
+
+bool transform_system_set_parent(khandle t, khandle parent)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return false;
+
+    u32 parent_index = INVALID_ID;
+    if(parent.index != INVALID_ID)
+    {
+        parent_index = dense_index_get(parent, __FUNCTION__);
+        if(parent_index == INVALID_ID) return false;
+
+        // Проверка цикла: новый родитель не должен быть самим преобразованием или его потомком.
+        for(u32 node = parent_index; node != INVALID_ID; node = state_ptr->parents[node])
+        {
+            if(node == index)
+            {
+                kerror("Function '%s': Transform cannot be parented to itself or to its descendant.", __FUNCTION__);
+                return false;
+            }
+        }
+    }
+
+    state_ptr->parents[index] = parent_index;
+    state_ptr->flags[index] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+
+    if(parent_index != INVALID_ID && parent_index > index)
+    {
+        state_ptr->needs_rebuild = true;
+    }
+
+    return true;
+}
+
+vec3 transform_system_get_position(khandle t)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return vec3_zero();
+    return state_ptr->positions[index];
+}
+
+void transform_system_set_position(khandle t, vec3 position)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return;
+    state_ptr->positions[index] = position;
+    state_ptr->flags[index] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+void transform_system_translate(khandle t, vec3 translation)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return;
+    state_ptr->positions[index] = vec3_add(state_ptr->positions[index], translation);
+    state_ptr->flags[index] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+quat transform_system_get_rotation(khandle t)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return quat_identity();
+    return state_ptr->rotations[index];
+}
+
+void transform_system_set_rotation(khandle t, quat rotation)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return;
+    state_ptr->rotations[index] = rotation;
+    state_ptr->flags[index] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+void transform_system_rotate(khandle t, quat rotation)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return;
+    state_ptr->rotations[index] = quat_mul(state_ptr->rotations[index], rotation);
+    state_ptr->flags[index] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+vec3 transform_system_get_scale(khandle t)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return vec3_one();
+    return state_ptr->scales[index];
+}
+
+void transform_system_set_scale(khandle t, vec3 scale)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return;
+    state_ptr->scales[index] = scale;
+    state_ptr->flags[index] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+void transform_system_scale(khandle t, vec3 scale)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return;
+    state_ptr->scales[index] = vec3_mul(state_ptr->scales[index], scale);
+    state_ptr->flags[index] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+void transform_system_set_position_rotation_scale(khandle t, vec3 position, quat rotation, vec3 scale)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return;
+    state_ptr->positions[index] = position;
+    state_ptr->rotations[index] = rotation;
+    state_ptr->scales[index] = scale;
+    state_ptr->flags[index] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+bool transform_system_is_world_changed(khandle t)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return false;
+    return (state_ptr->flags[index] & TRANSFORM_FLAG_WORLD_CHANGED) != 0;
+}
+
+mat4 transform_system_get_world(khandle t)
+{
+    u32 index = dense_index_get(t, __FUNCTION__);
+    if(index == INVALID_ID) return mat4_identity();
+    return state_ptr->worlds[index];
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+#include <containers/handle_pool.h>
+
+// @brief Конфигурация системы преобразований.
+typedef struct transform_system_config {
+    // @brief Максимальное количество преобразований.
+    u32 max_transform_count;
+} transform_system_config;
+
+/*
+    @brief Инициализирует систему преобразований используя предоставленную конфигурацию.
+    NOTE: Позиции, повороты, масштабы и матрицы хранятся отдельными массивами (SoA), упорядоченными так,
+          что родитель всегда находится раньше своих потомков. Поэтому мировые матрицы всех преобразований
+          обновляются за один линейный проход в transform_system_update.
+    @param memory_requirement Указатель на переменную для сохранения требований системы к памяти в байтах.
+    @param memory Указатель на выделенный блок памяти, или null для получения требований.
+    @param config Конфигурация используемая для инициализации системы и получения требований к памяти.
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool transform_system_initialize(u64* memory_requirement, void* memory, transform_system_config* config);
+
+/*
+    @brief Завершает работу системы преобразований и освобождает выделеные ей ресурсы.
+*/
+void transform_system_shutdown();
+
+/*
+    @brief Обновляет локальные и мировые матрицы измененных преобразований и их потомков.
+    NOTE: Вызывается один раз за кадр после изменения преобразований и до построения пакетов отрисовки.
+          Неизмененные поддеревья пропускаются, их мировые матрицы берутся из кэша.
+*/
+KAPI void transform_system_update();
+
+/*
+    @brief Создает преобразование.
+    @param position Позиция относительно родителя.
+    @param rotation Поворот относительно родителя.
+    @param scale Масштаб относительно родителя.
+    @param parent Дескриптор родителя или KHANDLE_INVALID для корневого преобразования.
+    @return Дескриптор преобразования или KHANDLE_INVALID при ошибках.
+*/
+KAPI khandle transform_system_create(vec3 position, quat rotation, vec3 scale, khandle parent);
+
+/*
+    @brief Уничтожает преобразование, дескриптор становится недействительным.
+    NOTE: Потомки уничтоженного преобразования становятся корневыми.
+    @param t Дескриптор преобразования.
+*/
+KAPI void transform_system_destroy(khandle t);
+
+/*
+    @brief Проверяет, что дескриптор указывает на существующее преобразование.
+    @param t Дескриптор преобразования.
+    @return True если преобразование существует, false если нет.
+*/
+KAPI bool transform_system_valid(khandle t);
+
+/*
+    @brief Получает родителя преобразования.
+    @param t Дескриптор преобразования.
+    @return Дескриптор родителя или KHANDLE_INVALID если преобразование корневое или при ошибках.
+*/
+KAPI khandle transform_system_get_parent(khandle t);
+
+/*
+    @brief Устанавливает родителя преобразования.
+    NOTE: Если родитель находится в массивах после потомка, порядок восстанавливается при следующем обновлении.
+    @param t Дескриптор преобразования.
+    @param parent Дескриптор родителя или KHANDLE_INVALID чтобы сделать преобразование корневым.
+    @return True в случае успеха, false если дескрипторы недействительны или образуется цикл.
+*/
+KAPI bool transform_system_set_parent(khandle t, khandle parent);
+
+KAPI vec3 transform_system_get_position(khandle t);
+
+KAPI void transform_system_set_position(khandle t, vec3 position);
+
+KAPI void transform_system_translate(khandle t, vec3 translation);
+
+KAPI quat transform_system_get_rotation(khandle t);
+
+KAPI void transform_system_set_rotation(khandle t, quat rotation);
+
+KAPI void transform_system_rotate(khandle t, quat rotation);
+
+KAPI vec3 transform_system_get_scale(khandle t);
+
+KAPI void transform_system_set_scale(khandle t, vec3 scale);
+
+KAPI void transform_system_scale(khandle t, vec3 scale);
+
+KAPI void transform_system_set_position_rotation_scale(khandle t, vec3 position, quat rotation, vec3 scale);
+
+/*
+    @brief Проверяет, изменилась ли мировая матрица преобразования при последнем обновлении.
+    NOTE: Используется для обновления зависящих от положения данных (границ, списков отрисовки) только у измененных объектов.
+    @param t Дескриптор преобразования.
+    @return True если мировая матрица пересчитана последним вызовом transform_system_update, false если нет или при ошибках.
+*/
+KAPI bool transform_system_is_world_changed(khandle t);
+
+/*
+    @brief Получает мировую матрицу преобразования.
+    NOTE: Возвращает кэшированную матрицу, вычисленную при последнем вызове transform_system_update.
+    @param t Дескриптор преобразования.
+    @return Мировая матрица или единичная матрица при ошибках.
+*/
+KAPI mat4 transform_system_get_world(khandle t);